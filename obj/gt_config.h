@@ -0,0 +1,10 @@
+#ifndef GT_CONFIG_H
+#define GT_CONFIG_H
+#define GT_CC "cc (Debian 12.2.0-14+deb12u1) 12.2.0"
+#define GT_CFLAGS "-fcommon -g -Wall -Wunused-parameter -pipe -fPIC -Wpointer-arith -O3"
+#define GT_CPPFLAGS "-D_LARGEFILE_SOURCE -D_FILE_OFFSET_BITS=64 -DHAVE_MEMMOVE -D_LARGEFILE64_SOURCE=1 -DHAVE_HIDDEN -DLUA_DL_DLOPEN -DLUA_USE_MKSTEMP -DWITHOUT_CAIRO -DGT_THREADS_ENABLED -DSQLITE_THREADSAFE=1 -DHAVE_SQLITE -I/root/repo/src -I/root/repo/obj -I/root/repo/src/external/zlib-1.2.8 -I/root/repo/src/external/md5-1.1.2/src -I/root/repo/src/external/lua-5.1.5/src -I/root/repo/src/external/luafilesystem-1.5.0/src -I/root/repo/src/external/lpeg-0.10.2 -I/root/repo/src/external/expat-2.0.1/lib -I/root/repo/src/external/bzip2-1.0.6 -I/root/repo/src/external/samtools-0.1.18 -I/root/repo/src/external/sqlite-3.8.7.1 -I/root/repo/src/external/tre/include/tre -I/root/repo/src/external/sqlite-3.8.7.1"
+#define GT_VERSION "1.5.7"
+#define GT_MAJOR_VERSION 1
+#define GT_MINOR_VERSION 5
+#define GT_MICRO_VERSION 7
+#endif
@@ -0,0 +1,565 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#include <stdlib.h>
+#include <string.h>
+#include <zlib.h>
+#include "core/fa.h"
+#include "core/ma.h"
+#include "core/minmax.h"
+#include "core/multithread_api.h"
+#include "core/str.h"
+#include "core/thread_api.h"
+#include "core/unused_api.h"
+#include "core/xansi_api.h"
+#include "core/xposix.h"
+#include "core/xzlib.h"
+#include "core/bgzf.h"
+#include "core/ensure.h"
+
+/* the total size of a block and the size of its uncompressed data */
+#define GT_BGZF_MAX_BLOCKSIZE  65536
+/* the fixed part of the gzip header, up to and including XLEN */
+#define GT_BGZF_HEADERSIZE     12
+/* CRC32 and ISIZE */
+#define GT_BGZF_TRAILERSIZE    8
+/* number of blocks inflated in parallel */
+#define GT_BGZF_BATCHSIZE      32
+
+typedef struct {
+  unsigned char *cdata, /* deflated data, followed by the trailer */
+                *udata;
+  GtUword clength,
+          ulength;
+  bool valid;
+} GtBGZFBlock;
+
+struct GtBGZFReader {
+  FILE *fp;
+  GtBGZFBlock blocks[GT_BGZF_BATCHSIZE];
+  GtUword numofblocks,
+          nextblock, /* next block to be inflated by a thread */
+          currentblock,
+          currentpos;
+  GtMutex *mutex;
+  /* after the first gzip member which is not a BGZF block, the rest of the
+     file is inflated sequentially with <stream> */
+  bool plain,
+       in_member;
+  z_stream stream;
+  unsigned char *plainbuf;
+};
+
+typedef enum {
+  GT_BGZF_BLOCK,
+  GT_BGZF_PLAIN_MEMBER,
+  GT_BGZF_EOF
+} GtBGZFReadResult;
+
+static void bgzf_error(const char *msg)
+{
+  fprintf(stderr, "cannot read from BGZF file: %s\n", msg);
+  exit(EXIT_FAILURE);
+}
+
+static GtUword bgzf_get_le(const unsigned char *ptr, unsigned int numofbytes)
+{
+  GtUword value = 0;
+  unsigned int i;
+  for (i = 0; i < numofbytes; i++)
+    value |= ((GtUword) ptr[i]) << (8 * i);
+  return value;
+}
+
+/* Returns the total size of the block with the given <header> and <extra>
+   field, or 0 if the header does not start a BGZF block. The flags must be
+   exactly FEXTRA, as members with a file name or comment are ordinary gzip
+   members, whose header does not end after the extra field. */
+static GtUword bgzf_blocksize(const unsigned char *header,
+                              const unsigned char *extra, GtUword xlen)
+{
+  GtUword pos = 0, slen;
+  if (header[0] != 31 || header[1] != 139 || header[2] != 8 ||
+      header[3] != 4) {
+    return 0;
+  }
+  while (pos + 4 <= xlen) {
+    slen = bgzf_get_le(extra + pos + 2, 2);
+    if (extra[pos] == 'B' && extra[pos + 1] == 'C' && slen == 2 &&
+        pos + 6 <= xlen) {
+      return bgzf_get_le(extra + pos + 4, 2) + 1;
+    }
+    pos += 4 + slen;
+  }
+  return 0;
+}
+
+/* Read the next block from <fp> into <block>. If the next gzip member is not
+   a BGZF block, <fp> is positioned at its start again and
+   <GT_BGZF_PLAIN_MEMBER> is returned. */
+static GtBGZFReadResult bgzf_read_block(GtBGZFBlock *block, FILE *fp)
+{
+  unsigned char header[GT_BGZF_HEADERSIZE];
+  GtUword xlen, blocksize, rest;
+  size_t numofbytes;
+
+  if ((numofbytes = fread(header, 1, sizeof header, fp)) == 0 && feof(fp))
+    return GT_BGZF_EOF;
+  if (numofbytes != sizeof header)
+    bgzf_error("truncated block header");
+  xlen = bgzf_get_le(header + 10, 2);
+  if (header[3] != 4 ||
+      GT_BGZF_HEADERSIZE + xlen + GT_BGZF_TRAILERSIZE > GT_BGZF_MAX_BLOCKSIZE) {
+    gt_xfseek(fp, -(GtWord) GT_BGZF_HEADERSIZE, SEEK_CUR);
+    return GT_BGZF_PLAIN_MEMBER;
+  }
+  /* the extra field is stored in the data buffer until it is parsed */
+  if (fread(block->cdata, 1, (size_t) xlen, fp) != (size_t) xlen)
+    bgzf_error("truncated block header");
+  if ((blocksize = bgzf_blocksize(header, block->cdata, xlen)) == 0) {
+    gt_xfseek(fp, -(GtWord) (GT_BGZF_HEADERSIZE + xlen), SEEK_CUR);
+    return GT_BGZF_PLAIN_MEMBER;
+  }
+  if (blocksize < GT_BGZF_HEADERSIZE + xlen + GT_BGZF_TRAILERSIZE)
+    bgzf_error("invalid BGZF block size");
+  rest = blocksize - GT_BGZF_HEADERSIZE - xlen;
+  if (fread(block->cdata, 1, (size_t) rest, fp) != (size_t) rest)
+    bgzf_error("truncated block");
+  block->clength = rest - GT_BGZF_TRAILERSIZE;
+  block->ulength = 0;
+  return GT_BGZF_BLOCK;
+}
+
+/* Switch <reader> to inflating the rest of the file sequentially, starting
+   with the gzip member at the current position. */
+static void bgzf_start_plain(GtBGZFReader *reader)
+{
+  memset(&reader->stream, 0, sizeof reader->stream);
+  /* gzip members only */
+  if (inflateInit2(&reader->stream, MAX_WBITS + 16) != Z_OK)
+    bgzf_error("cannot initialize zlib");
+  if (reader->plainbuf == NULL) {
+    reader->plainbuf = gt_malloc(sizeof (unsigned char) *
+                                 GT_BGZF_MAX_BLOCKSIZE);
+  }
+  reader->plain = true;
+  reader->in_member = false;
+}
+
+static void bgzf_end_plain(GtBGZFReader *reader)
+{
+  if (reader->plain) {
+    (void) inflateEnd(&reader->stream);
+    reader->plain = false;
+  }
+}
+
+/* Inflate at most <nbytes> bytes of the concatenated gzip members following
+   the BGZF blocks into <buf>. Returns the number of bytes inflated. */
+static size_t bgzf_plain_read(GtBGZFReader *reader, unsigned char *buf,
+                              size_t nbytes)
+{
+  z_stream *stream = &reader->stream;
+  size_t numofbytes;
+  int rval;
+
+  stream->next_out = buf;
+  stream->avail_out = (uInt) nbytes;
+  while (stream->avail_out > 0) {
+    if (stream->avail_in == 0) {
+      numofbytes = fread(reader->plainbuf, 1, GT_BGZF_MAX_BLOCKSIZE,
+                         reader->fp);
+      if (numofbytes == 0) {
+        if (reader->in_member)
+          bgzf_error("truncated gzip member");
+        break;
+      }
+      stream->next_in = reader->plainbuf;
+      stream->avail_in = (uInt) numofbytes;
+    }
+    if (!reader->in_member) {
+      (void) inflateReset(stream);
+      reader->in_member = true;
+    }
+    rval = inflate(stream, Z_NO_FLUSH);
+    if (rval == Z_STREAM_END)
+      reader->in_member = false;
+    else if (rval != Z_OK)
+      bgzf_error("corrupt gzip member");
+  }
+  return nbytes - stream->avail_out;
+}
+
+static bool bgzf_inflate_block(GtBGZFBlock *block)
+{
+  const unsigned char *trailer = block->cdata + block->clength;
+  GtUword isize = bgzf_get_le(trailer + 4, 4);
+  z_stream stream;
+  int rval;
+
+  if (isize > (GtUword) GT_BGZF_MAX_BLOCKSIZE)
+    return false;
+  memset(&stream, 0, sizeof stream);
+  /* raw deflate data, the gzip header has already been parsed */
+  if (inflateInit2(&stream, -MAX_WBITS) != Z_OK)
+    return false;
+  stream.next_in = block->cdata;
+  stream.avail_in = (uInt) block->clength;
+  stream.next_out = block->udata;
+  stream.avail_out = (uInt) GT_BGZF_MAX_BLOCKSIZE;
+  rval = inflate(&stream, Z_FINISH);
+  block->ulength = (GtUword) stream.total_out;
+  (void) inflateEnd(&stream);
+  return rval == Z_STREAM_END && block->ulength == isize &&
+         crc32(0L, block->udata, (uInt) block->ulength) ==
+         bgzf_get_le(trailer, 4);
+}
+
+static void* bgzf_inflate_thread(void *data)
+{
+  GtBGZFReader *reader = data;
+  GtBGZFBlock *block;
+
+  while (true) {
+    gt_mutex_lock(reader->mutex);
+    if (reader->nextblock == reader->numofblocks) {
+      gt_mutex_unlock(reader->mutex);
+      break;
+    }
+    block = reader->blocks + reader->nextblock++;
+    gt_mutex_unlock(reader->mutex);
+    block->valid = bgzf_inflate_block(block);
+  }
+  return NULL;
+}
+
+/* Read and inflate the next batch of blocks. Returns false at the end of the
+   file. */
+static bool bgzf_next_batch(GtBGZFReader *reader)
+{
+  GtError *err;
+  GtUword i;
+  GtBGZFReadResult result = GT_BGZF_BLOCK;
+
+  reader->numofblocks = reader->nextblock = 0;
+  reader->currentblock = reader->currentpos = 0;
+  while (reader->numofblocks < (GtUword) GT_BGZF_BATCHSIZE &&
+         (result = bgzf_read_block(reader->blocks + reader->numofblocks,
+                                   reader->fp)) == GT_BGZF_BLOCK) {
+    reader->numofblocks++;
+  }
+  if (result == GT_BGZF_PLAIN_MEMBER)
+    bgzf_start_plain(reader);
+  if (reader->numofblocks == 0)
+    return false;
+  err = gt_error_new();
+  /* if no threads can be started, the blocks are inflated sequentially */
+  if (reader->numofblocks == 1 ||
+      gt_multithread(bgzf_inflate_thread, reader, err) != 0) {
+    (void) bgzf_inflate_thread(reader);
+  }
+  gt_error_delete(err);
+  for (i = 0; i < reader->numofblocks; i++) {
+    if (!reader->blocks[i].valid)
+      bgzf_error("corrupt block");
+  }
+  return true;
+}
+
+bool gt_bgzf_check(const char *path)
+{
+  unsigned char header[GT_BGZF_HEADERSIZE], *extra;
+  GtUword xlen;
+  GtError *err;
+  FILE *fp;
+  bool is_bgzf = false;
+
+  gt_assert(path);
+  err = gt_error_new();
+  if ((fp = gt_fa_fopen(path, "rb", err)) != NULL) {
+    if (fread(header, 1, sizeof header, fp) == sizeof header) {
+      xlen = bgzf_get_le(header + 10, 2);
+      extra = gt_malloc(sizeof *extra * (xlen + 1));
+      if (fread(extra, 1, (size_t) xlen, fp) == (size_t) xlen)
+        is_bgzf = bgzf_blocksize(header, extra, xlen) > 0;
+      gt_free(extra);
+    }
+    gt_fa_fclose(fp);
+  }
+  gt_error_delete(err);
+  return is_bgzf;
+}
+
+GtBGZFReader* gt_bgzf_reader_new(FILE *fp)
+{
+  GtBGZFReader *reader;
+  GtUword i;
+  gt_assert(fp);
+  reader = gt_calloc(1, sizeof *reader);
+  reader->fp = fp;
+  for (i = 0; i < (GtUword) GT_BGZF_BATCHSIZE; i++) {
+    reader->blocks[i].cdata = gt_malloc(sizeof (unsigned char) *
+                                        GT_BGZF_MAX_BLOCKSIZE);
+    reader->blocks[i].udata = gt_malloc(sizeof (unsigned char) *
+                                        GT_BGZF_MAX_BLOCKSIZE);
+  }
+  reader->mutex = gt_mutex_new();
+  return reader;
+}
+
+int gt_bgzf_reader_xread(GtBGZFReader *reader, void *buf, size_t nbytes)
+{
+  GtBGZFBlock *block;
+  size_t copied = 0, length;
+
+  gt_assert(reader && buf);
+  while (copied < nbytes) {
+    if (reader->currentblock == reader->numofblocks) {
+      /* a new batch can end at a plain gzip member */
+      if (!reader->plain && bgzf_next_batch(reader))
+        continue;
+      if (reader->plain) {
+        copied += bgzf_plain_read(reader, (unsigned char*) buf + copied,
+                                  nbytes - copied);
+      }
+      break;
+    }
+    block = reader->blocks + reader->currentblock;
+    length = MIN((size_t) (block->ulength - reader->currentpos),
+                 nbytes - copied);
+    memcpy((unsigned char*) buf + copied, block->udata + reader->currentpos,
+           length);
+    copied += length;
+    reader->currentpos += length;
+    if (reader->currentpos == block->ulength) {
+      reader->currentblock++;
+      reader->currentpos = 0;
+    }
+  }
+  return (int) copied;
+}
+
+void gt_bgzf_reader_reset(GtBGZFReader *reader)
+{
+  gt_assert(reader);
+  reader->numofblocks = reader->nextblock = 0;
+  reader->currentblock = reader->currentpos = 0;
+  bgzf_end_plain(reader);
+}
+
+void gt_bgzf_reader_delete(GtBGZFReader *reader)
+{
+  GtUword i;
+  if (!reader) return;
+  for (i = 0; i < (GtUword) GT_BGZF_BATCHSIZE; i++) {
+    gt_free(reader->blocks[i].cdata);
+    gt_free(reader->blocks[i].udata);
+  }
+  bgzf_end_plain(reader);
+  gt_free(reader->plainbuf);
+  gt_mutex_delete(reader->mutex);
+  gt_free(reader);
+}
+
+static void bgzf_put_le(unsigned char *ptr, GtUword value,
+                        unsigned int numofbytes)
+{
+  unsigned int i;
+  for (i = 0; i < numofbytes; i++)
+    ptr[i] = (unsigned char) ((value >> (8 * i)) & 0xff);
+}
+
+/* Writes a BGZF block with the given <data> to <fp>. If <name> is not NULL,
+   it is stored as the file name (FNAME) after the extra field. */
+static void bgzf_write_test_block(FILE *fp, const unsigned char *data,
+                                  GtUword length, const char *name)
+{
+  unsigned char block[GT_BGZF_MAX_BLOCKSIZE] = { 31, 139, 8, 4, 0, 0, 0, 0,
+                                                 0, 255, 6, 0, 'B', 'C', 2,
+                                                 0 };
+  GtUword headersize = GT_BGZF_HEADERSIZE + 6, blocksize;
+  z_stream stream;
+  GT_UNUSED int rval;
+
+  if (name != NULL) {
+    block[3] |= 8;
+    memcpy(block + headersize, name, strlen(name) + 1);
+    headersize += strlen(name) + 1;
+  }
+  memset(&stream, 0, sizeof stream);
+  rval = deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS,
+                      8, Z_DEFAULT_STRATEGY);
+  gt_assert(rval == Z_OK);
+  stream.next_in = (unsigned char*) data;
+  stream.avail_in = (uInt) length;
+  stream.next_out = block + headersize;
+  stream.avail_out = (uInt) (GT_BGZF_MAX_BLOCKSIZE - headersize -
+                             GT_BGZF_TRAILERSIZE);
+  rval = deflate(&stream, Z_FINISH);
+  gt_assert(rval == Z_STREAM_END);
+  blocksize = headersize + stream.total_out + GT_BGZF_TRAILERSIZE;
+  (void) deflateEnd(&stream);
+  bgzf_put_le(block + 16, blocksize - 1, 2);
+  bgzf_put_le(block + blocksize - GT_BGZF_TRAILERSIZE,
+              crc32(0L, data, (uInt) length), 4);
+  bgzf_put_le(block + blocksize - 4, length, 4);
+  gt_xfwrite(block, 1, (size_t) blocksize, fp);
+}
+
+/* Writes the <length> bytes at <data> as an ordinary gzip member to <fp>. */
+static void bgzf_write_test_member(FILE *fp, const unsigned char *data,
+                                   GtUword length)
+{
+  unsigned char *member;
+  GtUword membersize;
+  z_stream stream;
+  GT_UNUSED int rval;
+
+  memset(&stream, 0, sizeof stream);
+  rval = deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                      MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY);
+  gt_assert(rval == Z_OK);
+  membersize = (GtUword) deflateBound(&stream, (uLong) length);
+  member = gt_malloc(sizeof *member * membersize);
+  stream.next_in = (unsigned char*) data;
+  stream.avail_in = (uInt) length;
+  stream.next_out = member;
+  stream.avail_out = (uInt) membersize;
+  rval = deflate(&stream, Z_FINISH);
+  gt_assert(rval == Z_STREAM_END);
+  gt_xfwrite(member, 1, (size_t) stream.total_out, fp);
+  (void) deflateEnd(&stream);
+  gt_free(member);
+}
+
+int gt_bgzf_unit_test(GtError *err)
+{
+  unsigned char *data, *readdata;
+  GtUword i, datalength = 50 * 65280 + 4711, chunksizes[] = { 1, 997, 100000 };
+  GtBGZFReader *reader;
+  GtStr *path;
+  FILE *fp;
+  int had_err = 0;
+
+  gt_error_check(err);
+  data = gt_malloc(sizeof *data * datalength);
+  readdata = gt_malloc(sizeof *readdata * datalength);
+  for (i = 0; i < datalength; i++)
+    data[i] = (unsigned char) "ACGT\n"[(i * 7919UL + i / 61) % 5];
+
+  /* blocks of 65280 bytes like written by bgzip, followed by an empty one */
+  path = gt_str_new();
+  fp = gt_xtmpfp(path);
+  for (i = 0; i < datalength; i += 65280UL)
+    bgzf_write_test_block(fp, data + i, MIN(65280UL, datalength - i), NULL);
+  bgzf_write_test_block(fp, data, 0, NULL);
+  gt_fa_xfclose(fp);
+
+  gt_ensure(gt_bgzf_check(gt_str_get(path)));
+  for (i = 0; !had_err && i < sizeof chunksizes / sizeof chunksizes[0]; i++) {
+    GtUword pos = 0;
+    int numofbytes;
+    fp = gt_fa_xfopen(gt_str_get(path), "rb");
+    reader = gt_bgzf_reader_new(fp);
+    while (pos < datalength &&
+           (numofbytes = gt_bgzf_reader_xread(reader, readdata + pos,
+                                              MIN(chunksizes[i],
+                                                  datalength - pos))) > 0) {
+      pos += numofbytes;
+    }
+    gt_ensure(pos == datalength);
+    gt_ensure(memcmp(data, readdata, (size_t) datalength) == 0);
+    gt_ensure(gt_bgzf_reader_xread(reader, readdata, 1) == 0);
+    /* read the first bytes again after rewinding */
+    rewind(fp);
+    gt_bgzf_reader_reset(reader);
+    gt_ensure(gt_bgzf_reader_xread(reader, readdata, 1000) == 1000);
+    gt_ensure(memcmp(data, readdata, 1000) == 0);
+    gt_bgzf_reader_delete(reader);
+    gt_fa_xfclose(fp);
+  }
+  gt_xunlink(gt_str_get(path));
+
+  /* ordinary gzip members after BGZF blocks are inflated with zlib */
+  if (!had_err) {
+    GtUword pos = 0, split = 3 * 65280UL;
+    int numofbytes;
+    gt_str_reset(path);
+    fp = gt_xtmpfp(path);
+    for (i = 0; i < split; i += 65280UL)
+      bgzf_write_test_block(fp, data + i, 65280UL, NULL);
+    bgzf_write_test_member(fp, data + split, 100000UL);
+    bgzf_write_test_block(fp, data + split + 100000UL, 1000UL, NULL);
+    bgzf_write_test_member(fp, data + split + 101000UL,
+                           datalength - split - 101000UL);
+    gt_fa_xfclose(fp);
+    gt_ensure(gt_bgzf_check(gt_str_get(path)));
+    fp = gt_fa_xfopen(gt_str_get(path), "rb");
+    reader = gt_bgzf_reader_new(fp);
+    memset(readdata, 0, (size_t) datalength);
+    while (pos < datalength &&
+           (numofbytes = gt_bgzf_reader_xread(reader, readdata + pos,
+                                              MIN(4711UL,
+                                                  datalength - pos))) > 0) {
+      pos += numofbytes;
+    }
+    gt_ensure(pos == datalength);
+    gt_ensure(memcmp(data, readdata, (size_t) datalength) == 0);
+    gt_ensure(gt_bgzf_reader_xread(reader, readdata, 1) == 0);
+    /* rewinding leaves the zlib mode */
+    rewind(fp);
+    gt_bgzf_reader_reset(reader);
+    gt_ensure(gt_bgzf_reader_xread(reader, readdata, 1000) == 1000);
+    gt_ensure(memcmp(data, readdata, 1000) == 0);
+    gt_bgzf_reader_delete(reader);
+    gt_fa_xfclose(fp);
+    gt_xunlink(gt_str_get(path));
+  }
+
+  /* an ordinary gzip file is not recognized */
+  if (!had_err) {
+    gzFile gzfp;
+    gt_str_reset(path);
+    fp = gt_xtmpfp(path);
+    gt_fa_xfclose(fp);
+    gzfp = gt_fa_xgzopen(gt_str_get(path), "wb");
+    gt_xgzwrite(gzfp, data, 1000);
+    gt_fa_xgzclose(gzfp);
+    gt_ensure(!gt_bgzf_check(gt_str_get(path)));
+    gt_xunlink(gt_str_get(path));
+  }
+
+  /* neither is a gzip member with a BC subfield and a file name, zlib reads
+     it */
+  if (!had_err) {
+    gzFile gzfp;
+    gt_str_reset(path);
+    fp = gt_xtmpfp(path);
+    bgzf_write_test_block(fp, data, 1000UL, "reads.fa");
+    gt_fa_xfclose(fp);
+    gt_ensure(!gt_bgzf_check(gt_str_get(path)));
+    gzfp = gt_fa_xgzopen(gt_str_get(path), "rb");
+    gt_ensure(gt_xgzread(gzfp, readdata, 1000) == 1000);
+    gt_ensure(memcmp(data, readdata, 1000) == 0);
+    gt_fa_xgzclose(gzfp);
+    gt_xunlink(gt_str_get(path));
+  }
+  gt_str_delete(path);
+  gt_free(data);
+  gt_free(readdata);
+  return had_err;
+}
@@ -0,0 +1,54 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+
+#ifndef BGZF_H
+#define BGZF_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include "core/error_api.h"
+
+/*
+  This module reads files in the blocked gzip format (BGZF) used by
+  samtools and tabix. Such a file is a concatenation of gzip members, each
+  with at most 64 KB of uncompressed data and with its compressed size in
+  the 'BC' subfield of the gzip header. Therefore the members can be located
+  without decompressing them and are inflated in batches on <gt_jobs>
+  threads. If a gzip member without the 'BC' subfield follows, the rest of
+  the file is inflated sequentially with zlib.
+  Like in the xzlib module, all errors terminate the program.
+*/
+
+typedef struct GtBGZFReader GtBGZFReader;
+
+/* Returns true if the file <path> starts with a BGZF block. */
+bool          gt_bgzf_check(const char *path);
+/* Returns a new reader for the BGZF file <fp>, which must be positioned at
+   the start of a block. */
+GtBGZFReader* gt_bgzf_reader_new(FILE *fp);
+/* Read at most <nbytes> uncompressed bytes from <reader> into <buf>. Returns
+   the number of bytes read, 0 at the end of the file. */
+int           gt_bgzf_reader_xread(GtBGZFReader *reader, void *buf,
+                                   size_t nbytes);
+/* Discard the buffered data of <reader>, to be called after the underlying
+   file has been rewound. */
+void          gt_bgzf_reader_reset(GtBGZFReader *reader);
+void          gt_bgzf_reader_delete(GtBGZFReader *reader);
+
+int           gt_bgzf_unit_test(GtError *err);
+
+#endif
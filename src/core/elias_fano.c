@@ -0,0 +1,440 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/elias_fano.h"
+#include "core/ensure.h"
+#include "core/fa.h"
+#include "core/intbits.h"
+#include "core/ma.h"
+#include "core/mapspec.h"
+#include "core/mathsupport.h"
+#include "core/str.h"
+#include "core/unused_api.h"
+#include "core/xansi_api.h"
+
+/* Every <GT_ELIAS_FANO_SAMPLE>-th one and zero in the upper bits has its
+   position sampled, so a select query scans at most a few words. */
+#define GT_ELIAS_FANO_LOGSAMPLE  8
+#define GT_ELIAS_FANO_SAMPLE     (((GtUword) 1) << GT_ELIAS_FANO_LOGSAMPLE)
+#define GT_ELIAS_FANO_HEADERSIZE 2
+
+/* Value <i> is split into its <lowbits> lower bits, which are stored
+   verbatim, and its upper bits <h>, which are stored as a one at position
+   <h + i> in <upperbits>. So the zeros in <upperbits> separate the buckets of
+   values with the same upper bits. In contrast to <GtBitsequence> tables,
+   bit <j> of a word is the <j>-th least significant bit. */
+struct GtEliasFano
+{
+  GtUword headerspace[GT_ELIAS_FANO_HEADERSIZE],
+          *header, /* numofvalues, universe */
+          *lowerbits,
+          *upperbits,
+          *onesamples,
+          *zerosamples,
+          numofvalues,
+          universe,
+          numofbuckets,
+          numoflowerwords,
+          numofupperwords,
+          numofonesamples,
+          numofzerosamples,
+          nextidx,
+          nextzero,
+          lastvalue,
+          lowmask;
+  unsigned int lowbits;
+  bool unassigned;
+  void *mappedptr;
+};
+
+static void gt_elias_fano_dimensions(GtEliasFano *ef, GtUword numofvalues,
+                                     GtUword universe)
+{
+  GtUword quotient;
+
+  ef->numofvalues = numofvalues;
+  ef->universe = universe;
+  ef->lowbits = 0;
+  if (numofvalues > 0) {
+    for (quotient = universe/numofvalues; quotient > 1UL; quotient >>= 1)
+      ef->lowbits++;
+  }
+  ef->lowmask = (((GtUword) 1) << ef->lowbits) - 1;
+  ef->numofbuckets = universe == 0 ? 1UL : ((universe - 1) >> ef->lowbits) + 1;
+  ef->numoflowerwords = GT_DIVWORDSIZE(numofvalues * ef->lowbits) + 1;
+  ef->numofupperwords = GT_DIVWORDSIZE(numofvalues + ef->numofbuckets) + 1;
+  ef->numofonesamples = (numofvalues >> GT_ELIAS_FANO_LOGSAMPLE) + 1;
+  ef->numofzerosamples = (ef->numofbuckets >> GT_ELIAS_FANO_LOGSAMPLE) + 1;
+}
+
+GtUword gt_elias_fano_size(GtUword numofvalues, GtUword universe)
+{
+  GtEliasFano ef;
+
+  gt_elias_fano_dimensions(&ef, numofvalues, universe);
+  return (GtUword) sizeof (GtUword) * (GT_ELIAS_FANO_HEADERSIZE +
+                                       ef.numoflowerwords +
+                                       ef.numofupperwords +
+                                       ef.numofonesamples +
+                                       ef.numofzerosamples);
+}
+
+/* Records the positions of the zeros numbered <nextzero> up to <bucket>-1,
+   which all precede the one of the value added next. */
+static void gt_elias_fano_samplezeros(GtEliasFano *ef, GtUword bucket)
+{
+  GtUword zero = (ef->nextzero + GT_ELIAS_FANO_SAMPLE - 1) &
+                 ~(GT_ELIAS_FANO_SAMPLE - 1);
+
+  for (/* Nothing */; zero < bucket; zero += GT_ELIAS_FANO_SAMPLE)
+    ef->zerosamples[zero >> GT_ELIAS_FANO_LOGSAMPLE] = zero + ef->nextidx;
+  if (bucket > ef->nextzero)
+    ef->nextzero = bucket;
+}
+
+GtEliasFano* gt_elias_fano_new(GtUword numofvalues, GtUword universe)
+{
+  GtEliasFano *ef = gt_calloc((size_t) 1, sizeof (*ef));
+
+  gt_assert(numofvalues == 0 || universe > 0);
+  gt_elias_fano_dimensions(ef, numofvalues, universe);
+  ef->header = ef->headerspace;
+  ef->header[0] = numofvalues;
+  ef->header[1] = universe;
+  ef->lowerbits = gt_calloc((size_t) ef->numoflowerwords,
+                            sizeof (*ef->lowerbits));
+  ef->upperbits = gt_calloc((size_t) ef->numofupperwords,
+                            sizeof (*ef->upperbits));
+  ef->onesamples = gt_calloc((size_t) ef->numofonesamples,
+                             sizeof (*ef->onesamples));
+  ef->zerosamples = gt_calloc((size_t) ef->numofzerosamples,
+                              sizeof (*ef->zerosamples));
+  if (numofvalues == 0)
+    gt_elias_fano_samplezeros(ef, ef->numofbuckets);
+  return ef;
+}
+
+void gt_elias_fano_add(GtEliasFano *ef, GtUword value)
+{
+  GtUword idx, bucket, pos;
+
+  gt_assert(ef != NULL && ef->mappedptr == NULL && !ef->unassigned);
+  idx = ef->nextidx;
+  gt_assert(idx < ef->numofvalues && value < ef->universe);
+  gt_assert(idx == 0 || ef->lastvalue <= value);
+  bucket = value >> ef->lowbits;
+  gt_elias_fano_samplezeros(ef, bucket);
+  pos = bucket + idx;
+  ef->upperbits[GT_DIVWORDSIZE(pos)] |= ((GtUword) 1) << GT_MODWORDSIZE(pos);
+  if ((idx & (GT_ELIAS_FANO_SAMPLE - 1)) == 0)
+    ef->onesamples[idx >> GT_ELIAS_FANO_LOGSAMPLE] = pos;
+  if (ef->lowbits > 0) {
+    GtUword low = value & ef->lowmask,
+            bitoffset = idx * ef->lowbits;
+    unsigned int shift = (unsigned int) GT_MODWORDSIZE(bitoffset);
+
+    ef->lowerbits[GT_DIVWORDSIZE(bitoffset)] |= low << shift;
+    if (shift + ef->lowbits > (unsigned int) GT_INTWORDSIZE)
+      ef->lowerbits[GT_DIVWORDSIZE(bitoffset) + 1]
+        |= low >> (GT_INTWORDSIZE - shift);
+  }
+  ef->lastvalue = value;
+  ef->nextidx++;
+  if (ef->nextidx == ef->numofvalues)
+    gt_elias_fano_samplezeros(ef, ef->numofbuckets);
+}
+
+GtUword gt_elias_fano_num_of_values(const GtEliasFano *ef)
+{
+  gt_assert(ef != NULL);
+  return ef->numofvalues;
+}
+
+static inline unsigned int gt_elias_fano_popcount(GtUword word)
+{
+#ifdef __GNUC__
+  return (unsigned int) __builtin_popcountll((unsigned long long) word);
+#else
+  unsigned int count;
+
+  for (count = 0; word != 0; count++)
+    word &= word - 1;
+  return count;
+#endif
+}
+
+/* Returns the position of the <rank>-th (counting from 0) set bit of
+   <word>, which must have more than <rank> bits set. */
+static inline GtUword gt_elias_fano_select_in_word(GtUword word, GtUword rank)
+{
+  GtUword pos;
+
+  for (/* Nothing */; rank > 0; rank--)
+    word &= word - 1;
+#ifdef __GNUC__
+  pos = (GtUword) __builtin_ctzll((unsigned long long) word);
+#else
+  for (pos = 0; (word & 1) == 0; pos++)
+    word >>= 1;
+#endif
+  return pos;
+}
+
+/* Returns the position of the <rank>-th one (if <flip> is 0) or zero (if
+   <flip> has all bits set) in <upperbits>, starting from the sample
+   preceding it. */
+static GtUword gt_elias_fano_select(const GtUword *upperbits, GtUword flip,
+                                    const GtUword *samples, GtUword rank)
+{
+  GtUword pos = samples[rank >> GT_ELIAS_FANO_LOGSAMPLE],
+          rest = rank & (GT_ELIAS_FANO_SAMPLE - 1),
+          wordidx = GT_DIVWORDSIZE(pos),
+          word, count;
+
+  word = (upperbits[wordidx] ^ flip) & (~((GtUword) 0) << GT_MODWORDSIZE(pos));
+  while ((count = (GtUword) gt_elias_fano_popcount(word)) <= rest) {
+    rest -= count;
+    word = upperbits[++wordidx] ^ flip;
+  }
+  return GT_MULWORDSIZE(wordidx) + gt_elias_fano_select_in_word(word, rest);
+}
+
+static inline GtUword gt_elias_fano_low(const GtEliasFano *ef, GtUword idx)
+{
+  GtUword bitoffset, value;
+  unsigned int shift;
+
+  if (ef->lowbits == 0)
+    return 0;
+  bitoffset = idx * ef->lowbits;
+  shift = (unsigned int) GT_MODWORDSIZE(bitoffset);
+  value = ef->lowerbits[GT_DIVWORDSIZE(bitoffset)] >> shift;
+  if (shift + ef->lowbits > (unsigned int) GT_INTWORDSIZE)
+    value |= ef->lowerbits[GT_DIVWORDSIZE(bitoffset) + 1]
+             << (GT_INTWORDSIZE - shift);
+  return value & ef->lowmask;
+}
+
+GtUword gt_elias_fano_get(const GtEliasFano *ef, GtUword idx)
+{
+  GtUword pos;
+
+  gt_assert(ef != NULL && idx < ef->numofvalues &&
+            ef->nextidx == ef->numofvalues);
+  pos = gt_elias_fano_select(ef->upperbits, 0, ef->onesamples, idx);
+  return ((pos - idx) << ef->lowbits) | gt_elias_fano_low(ef, idx);
+}
+
+GtUword gt_elias_fano_rank(const GtEliasFano *ef, GtUword value)
+{
+  GtUword bucket, pos, idx, low;
+
+  gt_assert(ef != NULL && ef->nextidx == ef->numofvalues);
+  if (value >= ef->universe)
+    return ef->numofvalues;
+  bucket = value >> ef->lowbits;
+  pos = bucket == 0
+          ? 0
+          : gt_elias_fano_select(ef->upperbits, ~((GtUword) 0),
+                                 ef->zerosamples, bucket - 1) + 1;
+  idx = pos - bucket;
+  /* the ones following <pos> are the values in <bucket> in ascending order,
+     of which there are only a few */
+  low = value & ef->lowmask;
+  while ((ef->upperbits[GT_DIVWORDSIZE(pos)] >> GT_MODWORDSIZE(pos)) & 1 &&
+         gt_elias_fano_low(ef, idx) < low) {
+    idx++;
+    pos++;
+  }
+  return idx;
+}
+
+void gt_elias_fano_add_to_mapspec(GtEliasFano *ef, GtMapspec *mapspec)
+{
+  gt_assert(ef != NULL);
+  gt_mapspec_add_ulong(mapspec, ef->header, GT_ELIAS_FANO_HEADERSIZE);
+  gt_mapspec_add_ulong(mapspec, ef->lowerbits, ef->numoflowerwords);
+  gt_mapspec_add_ulong(mapspec, ef->upperbits, ef->numofupperwords);
+  gt_mapspec_add_ulong(mapspec, ef->onesamples, ef->numofonesamples);
+  gt_mapspec_add_ulong(mapspec, ef->zerosamples, ef->numofzerosamples);
+}
+
+static void gt_elias_fano_mapspec(GtMapspec *mapspec, void *data,
+                                  GT_UNUSED bool writemode)
+{
+  gt_elias_fano_add_to_mapspec((GtEliasFano *) data, mapspec);
+}
+
+int gt_elias_fano_write(GtEliasFano *ef, FILE *fp, GtError *err)
+{
+  gt_error_check(err);
+  gt_assert(ef != NULL && ef->nextidx == ef->numofvalues);
+  return gt_mapspec_write(gt_elias_fano_mapspec, fp, ef,
+                          gt_elias_fano_size(ef->numofvalues, ef->universe),
+                          err);
+}
+
+GtEliasFano* gt_elias_fano_new_from_file(const char *filename,
+                                         GtUword numofvalues,
+                                         GtUword universe,
+                                         GtError *err)
+{
+  GtEliasFano *ef = gt_calloc((size_t) 1, sizeof (*ef));
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_elias_fano_dimensions(ef, numofvalues, universe);
+  if (gt_mapspec_read(gt_elias_fano_mapspec, ef, filename,
+                      gt_elias_fano_size(numofvalues, universe),
+                      &ef->mappedptr, err) != 0) {
+    had_err = -1;
+  }
+  if (!had_err &&
+      (ef->header[0] != numofvalues || ef->header[1] != universe)) {
+    gt_error_set(err, "%s stores " GT_WU " values smaller than " GT_WU
+                 ", but " GT_WU " values smaller than " GT_WU " are expected",
+                 filename, ef->header[0], ef->header[1], numofvalues,
+                 universe);
+    had_err = -1;
+  }
+  if (had_err) {
+    gt_elias_fano_delete(ef);
+    return NULL;
+  }
+  ef->nextidx = numofvalues;
+  return ef;
+}
+
+GtEliasFano* gt_elias_fano_new_unassigned(GtUword numofvalues,
+                                          GtUword universe)
+{
+  GtEliasFano *ef = gt_calloc((size_t) 1, sizeof (*ef));
+
+  gt_elias_fano_dimensions(ef, numofvalues, universe);
+  ef->unassigned = true;
+  ef->nextidx = numofvalues;
+  return ef;
+}
+
+void gt_elias_fano_delete(GtEliasFano *ef)
+{
+  if (ef == NULL)
+    return;
+  if (ef->mappedptr != NULL)
+    gt_fa_xmunmap(ef->mappedptr);
+  else if (!ef->unassigned) {
+    gt_free(ef->lowerbits);
+    gt_free(ef->upperbits);
+    gt_free(ef->onesamples);
+    gt_free(ef->zerosamples);
+  }
+  gt_free(ef);
+}
+
+static int gt_elias_fano_check(const GtEliasFano *ef, const GtUword *values,
+                               GtUword numofvalues, GtUword universe,
+                               GtError *err)
+{
+  GtUword idx, value;
+  int had_err = 0;
+
+  gt_ensure(gt_elias_fano_num_of_values(ef) == numofvalues);
+  for (idx = 0; !had_err && idx < numofvalues; idx++)
+    gt_ensure(gt_elias_fano_get(ef, idx) == values[idx]);
+  for (idx = 0, value = 0; !had_err && value <= universe; value++) {
+    while (idx < numofvalues && values[idx] < value)
+      idx++;
+    gt_ensure(gt_elias_fano_rank(ef, value) == idx);
+  }
+  return had_err;
+}
+
+int gt_elias_fano_unit_test(GtError *err)
+{
+  const GtUword universes[] = {1UL, 7UL, 64UL, 1000UL, 5000UL, 100000UL},
+                numofvalues[] = {0, 1UL, 2UL, 63UL, 257UL, 1000UL, 3000UL};
+  GtUword *values, u, n, idx;
+  int had_err = 0;
+
+  gt_error_check(err);
+  values = gt_malloc(sizeof (*values) * 3000UL);
+  for (u = 0; !had_err && u < sizeof universes/sizeof universes[0]; u++) {
+    for (n = 0; !had_err && n < sizeof numofvalues/sizeof numofvalues[0];
+         n++) {
+      GtUword universe = universes[u];
+      GtEliasFano *ef = gt_elias_fano_new(numofvalues[n], universe);
+
+      for (idx = 0; idx < numofvalues[n]; idx++)
+        values[idx] = universe > 1UL ? gt_rand_max(universe - 1) : 0;
+      for (idx = 1UL; idx < numofvalues[n]; idx++) {
+        /* insertion sort keeps duplicates */
+        GtUword j, tmp = values[idx];
+        for (j = idx; j > 0 && values[j-1] > tmp; j--)
+          values[j] = values[j-1];
+        values[j] = tmp;
+      }
+      for (idx = 0; idx < numofvalues[n]; idx++)
+        gt_elias_fano_add(ef, values[idx]);
+      had_err = gt_elias_fano_check(ef, values, numofvalues[n], universe,
+                                    err);
+      if (!had_err && u == sizeof universes/sizeof universes[0] - 1) {
+        GtStr *tmpfilename = gt_str_new();
+        FILE *fp = gt_xtmpfp(tmpfilename);
+        GtEliasFano *mapped;
+
+        had_err = gt_elias_fano_write(ef, fp, err);
+        gt_fa_xfclose(fp);
+        if (!had_err) {
+          mapped = gt_elias_fano_new_from_file(gt_str_get(tmpfilename),
+                                               numofvalues[n], universe, err);
+          gt_ensure(mapped != NULL);
+          if (!had_err)
+            had_err = gt_elias_fano_check(mapped, values, numofvalues[n],
+                                          universe, err);
+          gt_elias_fano_delete(mapped);
+        }
+        if (!had_err) {
+          void *mappedptr = NULL;
+
+          mapped = gt_elias_fano_new_unassigned(numofvalues[n], universe);
+          if (gt_mapspec_read(gt_elias_fano_mapspec, mapped,
+                              gt_str_get(tmpfilename),
+                              gt_elias_fano_size(numofvalues[n], universe),
+                              &mappedptr, err) != 0)
+            had_err = -1;
+          if (!had_err)
+            had_err = gt_elias_fano_check(mapped, values, numofvalues[n],
+                                          universe, err);
+          gt_elias_fano_delete(mapped);
+          if (mappedptr != NULL)
+            gt_fa_xmunmap(mappedptr);
+        }
+        if (!had_err) {
+          mapped = gt_elias_fano_new_from_file(gt_str_get(tmpfilename),
+                                               numofvalues[n], universe + 1,
+                                               err);
+          gt_ensure(mapped == NULL && gt_error_is_set(err));
+          gt_error_unset(err);
+        }
+        gt_xremove(gt_str_get(tmpfilename));
+        gt_str_delete(tmpfilename);
+      }
+      gt_elias_fano_delete(ef);
+    }
+  }
+  gt_free(values);
+  return had_err;
+}
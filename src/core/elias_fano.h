@@ -0,0 +1,83 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef ELIAS_FANO_H
+#define ELIAS_FANO_H
+
+#include <stdio.h>
+#include "core/error_api.h"
+#include "core/mapspec.h"
+#include "core/types_api.h"
+
+/* The <GtEliasFano> class stores a non-decreasing sequence of integers from
+   a universe [0,u) in the Elias-Fano representation, using about
+   2 + log(u/n) bits per value. Accessing the <i>-th value and counting the
+   values smaller than a given value take constant time, using sampled
+   positions of the ones and zeros in the upper bits. */
+typedef struct GtEliasFano GtEliasFano;
+
+/* Returns a new <GtEliasFano> object for <numofvalues> values smaller than
+   <universe>. The values are added with <gt_elias_fano_add()>; the structure
+   can be queried once all <numofvalues> values are added. */
+GtEliasFano* gt_elias_fano_new(GtUword numofvalues, GtUword universe);
+
+/* Appends <value> to <ef>. <value> must be smaller than the universe of <ef>
+   and must not be smaller than the previously added value. */
+void         gt_elias_fano_add(GtEliasFano *ef, GtUword value);
+
+/* Returns the number of values stored in <ef>. */
+GtUword      gt_elias_fano_num_of_values(const GtEliasFano *ef);
+
+/* Returns the value with index <idx> in <ef>. */
+GtUword      gt_elias_fano_get(const GtEliasFano *ef, GtUword idx);
+
+/* Returns the number of values in <ef> which are smaller than <value>. */
+GtUword      gt_elias_fano_rank(const GtEliasFano *ef, GtUword value);
+
+/* Returns the number of bytes of the file representation of a
+   <GtEliasFano> object for <numofvalues> values smaller than <universe>,
+   without padding. */
+GtUword      gt_elias_fano_size(GtUword numofvalues, GtUword universe);
+
+/* Writes <ef> to <fp>. Returns 0 on success, -1 otherwise. <err> is set
+   accordingly. */
+int          gt_elias_fano_write(GtEliasFano *ef, FILE *fp, GtError *err);
+
+/* Returns a <GtEliasFano> object with <numofvalues> values smaller than
+   <universe> by mapping the file <filename> written by
+   <gt_elias_fano_write()>. Returns NULL on error, <err> is set
+   accordingly. */
+GtEliasFano* gt_elias_fano_new_from_file(const char *filename,
+                                         GtUword numofvalues,
+                                         GtUword universe,
+                                         GtError *err);
+
+/* Returns a <GtEliasFano> object for <numofvalues> values smaller than
+   <universe> without tables of its own. The tables are assigned when a
+   <GtMapspec> to which <ef> was added with <gt_elias_fano_add_to_mapspec()>
+   is read, and they stay in the memory mapped by the caller. This allows to
+   store <GtEliasFano> objects as part of other index files. */
+GtEliasFano* gt_elias_fano_new_unassigned(GtUword numofvalues,
+                                          GtUword universe);
+
+/* Adds the tables of <ef> to <mapspec>. */
+void         gt_elias_fano_add_to_mapspec(GtEliasFano *ef, GtMapspec *mapspec);
+
+void         gt_elias_fano_delete(GtEliasFano *ef);
+
+int          gt_elias_fano_unit_test(GtError *err);
+
+#endif
@@ -35,9 +35,11 @@
 #include "core/defined-types.h"
 #include "core/desc_buffer.h"
 #include "core/divmodmul.h"
+#include "core/elias_fano.h"
 #include "core/encseq.h"
 #include "core/encseq_access_type.h"
 #include "core/encseq_metadata.h"
+#include "core/encseq_workload.h"
 #include "core/encseq_rep.h"
 #include "core/ensure.h"
 #include "core/error.h"
@@ -470,7 +472,8 @@ bool gt_encseq_position_is_separator(const GtEncseq *encseq,
 /* The following components are only accessed when the encseq access is one of
    GT_ACCESS_TYPE_UCHARTABLES,
    GT_ACCESS_TYPE_USHORTTABLES,
-   GT_ACCESS_TYPE_UINT32TABLES */
+   GT_ACCESS_TYPE_UINT32TABLES,
+   GT_ACCESS_TYPE_ELIASFANO */
 
 typedef struct {
   GtUword firstcell, /* first index of tables with startpos and length */
@@ -726,13 +729,171 @@ void gt_encseq_extract_encoded(const GtEncseq *encseq,
   gt_encseq_reader_delete(esr);
 }
 
+/* Decodes the twobit encoding from <frompos> to <topos> into <buffer>,
+   one byte of the encoding, i.e. four characters, at a time. Special
+   positions are decoded as the character their twobit code stands for. */
+static void twobitdecodeforward(const GtEncseq *encseq,
+                                char *buffer,
+                                GtUword frompos,
+                                GtUword topos)
+{
+  const GtTwobitencoding *tbe = encseq->twobitencoding;
+  GtUword pos = frompos;
+  int shift;
+
+  while (pos <= topos && GT_MODBYUNITSIN2BITENC(pos) > 0) {
+    *buffer++ = encseq->decodetab[EXTRACTENCODEDCHAR(tbe, pos)];
+    pos++;
+  }
+  while (pos <= topos && topos - pos >= (GtUword) (GT_UNITSIN2BITENC - 1)) {
+    GtTwobitencoding code = tbe[GT_DIVBYUNITSIN2BITENC(pos)];
+
+    for (shift = (int) GT_MULT2(GT_UNITSIN2BITENC) - CHAR_BIT; shift >= 0;
+         shift -= CHAR_BIT) {
+      memcpy(buffer, encseq->twobitdecodetab[(code >> shift) & UCHAR_MAX],
+             (size_t) 4);
+      buffer += 4;
+    }
+    pos += GT_UNITSIN2BITENC;
+  }
+  for (/* Nothing */; pos <= topos; pos++) {
+    *buffer++ = encseq->decodetab[EXTRACTENCODEDCHAR(tbe, pos)];
+  }
+}
+
+/* Overwrites the special positions from <frompos> to <topos> in <buffer>,
+   which is decoded from the twobit encoding. */
+static void twobitdecodepatchspecials(const GtEncseq *encseq,
+                                      GtEncseqReader *esr,
+                                      char *buffer,
+                                      GtUword frompos,
+                                      GtUword topos)
+{
+  GtUword pos;
+
+  if (!encseq->has_specialranges)
+    return;
+  if (encseq->sat == GT_ACCESS_TYPE_BITACCESS) {
+    GtUword unit;
+
+    for (unit = GT_DIVWORDSIZE(frompos); unit <= GT_DIVWORDSIZE(topos);
+         unit++) {
+      GtUword bit;
+
+      if (encseq->specialbits[unit] == 0)
+        continue;
+      for (bit = 0; bit < (GtUword) GT_INTWORDSIZE; bit++) {
+        if ((encseq->specialbits[unit] & GT_ITHBIT(bit)) == 0)
+          continue;
+        pos = (unit << GT_LOGWORDSIZE) + bit;
+        if (pos >= frompos && pos <= topos) {
+          GtUword twobits = EXTRACTENCODEDCHAR(encseq->twobitencoding, pos);
+
+          if (twobits <= (GtUword) GT_TWOBITS_FOR_SEPARATOR) {
+            buffer[pos - frompos]
+              = (twobits == (GtUword) GT_TWOBITS_FOR_SEPARATOR)
+                  ? (char) SEPARATOR
+                  : encseq->decodetab[WILDCARD];
+          }
+        }
+      }
+    }
+    return;
+  }
+  if (encseq->sat == GT_ACCESS_TYPE_EQUALLENGTH) {
+    /* the separators are at the positions p with (p+1) a multiple of
+       eqlen+1 */
+    GtUword step = encseq->equallength.valueunsignedlong + 1;
+
+    gt_assert(!encseq->has_wildcardranges);
+    for (pos = (frompos / step + 1) * step - 1; pos <= topos; pos += step)
+      buffer[pos - frompos] = (char) SEPARATOR;
+    return;
+  }
+  if (!encseq->has_wildcardranges) {
+    /* the separators are the only special positions. Determine the sequence
+       number from a position which is not a separator. */
+    GtUword seqnum;
+
+    for (pos = frompos; gt_encseq_position_is_separator(encseq, pos,
+                                                        GT_READMODE_FORWARD);
+         pos++) {
+      buffer[pos - frompos] = (char) SEPARATOR;
+      if (pos == topos)
+        return;
+    }
+    seqnum = gt_encseq_seqnum(encseq, pos);
+    for (;;) {
+      pos = gt_encseq_seqstartpos(encseq, seqnum) +
+            gt_encseq_seqlength(encseq, seqnum);
+      if (pos > topos)
+        break;
+      buffer[pos - frompos] = (char) SEPARATOR;
+      seqnum++;
+    }
+    return;
+  }
+  gt_assert(encseq->accesstype_via_utables);
+  gt_encseq_reader_reinit_with_readmode(esr, encseq, GT_READMODE_FORWARD,
+                                        frompos);
+  for (;;) {
+    GtUchar cc;
+
+    pos = gt_getnexttwobitencodingstoppos(true, esr);
+    if (pos > topos)
+      break;
+    /* the state of <esr> refers to the special range starting at <pos> or
+       to a later one, so the reader can skip to <pos>. The special range is
+       short in general, so step through it. */
+    esr->currentpos = pos;
+    do {
+      cc = gt_encseq_reader_next_encoded_char(esr);
+      if (ISSPECIAL(cc))
+        buffer[pos - frompos] = encseq->decodetab[cc];
+      pos++;
+    } while (ISSPECIAL(cc) && pos <= topos);
+  }
+}
+
+void gt_encseq_extract_decoded_with_reader(const GtEncseq *encseq,
+                                           GtEncseqReader *esr,
+                                           char *buffer,
+                                           GtUword frompos,
+                                           GtUword topos)
+{
+  GtUword idx, pos;
+
+  gt_assert(frompos <= topos && encseq != NULL &&
+            topos < encseq->logicaltotallength);
+  gt_assert(esr != NULL && buffer != NULL);
+  if (!encseq->has_exceptiontable && topos < encseq->totallength) {
+    if (encseq->twobitencoding != NULL &&
+        (encseq->sat == GT_ACCESS_TYPE_BITACCESS ||
+         gt_encseq_has_twobitencoding_stoppos_support(encseq))) {
+      twobitdecodeforward(encseq, buffer, frompos, topos);
+      twobitdecodepatchspecials(encseq, esr, buffer, frompos, topos);
+      return;
+    }
+    if (encseq->sat == GT_ACCESS_TYPE_DIRECTACCESS) {
+      for (pos = frompos, idx = 0; pos <= topos; pos++, idx++) {
+        buffer[idx] = encseq->decodetab[encseq->plainseq[pos]];
+      }
+      return;
+    }
+  }
+  gt_encseq_reader_reinit_with_readmode(esr, encseq, GT_READMODE_FORWARD,
+                                        frompos);
+  for (pos=frompos, idx = 0; pos <= topos; pos++, idx++) {
+    buffer[idx] = gt_encseq_reader_next_decoded_char(esr);
+  }
+}
+
 void gt_encseq_extract_decoded(const GtEncseq *encseq,
                                char *buffer,
                                GtUword frompos,
                                GtUword topos)
 {
   GtEncseqReader *esr;
-  GtUword idx, pos;
 
   gt_assert(frompos <= topos && encseq != NULL &&
             topos < encseq->logicaltotallength);
@@ -740,9 +901,7 @@ void gt_encseq_extract_decoded(const GtEncseq *encseq,
   esr = gt_encseq_create_reader_with_readmode(encseq,
                                               GT_READMODE_FORWARD,
                                               frompos);
-  for (pos=frompos, idx = 0; pos <= topos; pos++, idx++) {
-    buffer[idx] = gt_encseq_reader_next_decoded_char(esr);
-  }
+  gt_encseq_extract_decoded_with_reader(encseq, esr, buffer, frompos, topos);
   gt_encseq_reader_delete(esr);
 }
 
@@ -767,6 +926,7 @@ static int getsatforcevalue(const char *str, GtError *err)
     case GT_ACCESS_TYPE_UCHARTABLES: return 0;
     case GT_ACCESS_TYPE_USHORTTABLES: return 1;
     case GT_ACCESS_TYPE_UINT32TABLES: return 2;
+    case GT_ACCESS_TYPE_ELIASFANO: return 4;
     default: return 3;
   }
 }
@@ -857,6 +1017,33 @@ static void addswtabletomapspectable(GtMapspec *mapspec,
   }
 }
 
+static void addEFrangetabletomapspectable(GtMapspec *mapspec,
+                                          GtEFrangetable *eftable,
+                                          GtUword totallength,
+                                          bool writemode)
+{
+  if (eftable->numofranges > 0) {
+    if (!writemode) {
+      gt_assert(eftable->starts == NULL && eftable->ends == NULL);
+      eftable->starts = gt_elias_fano_new_unassigned(eftable->numofranges,
+                                                     totallength);
+      eftable->ends = gt_elias_fano_new_unassigned(eftable->numofranges,
+                                                   totallength + 1);
+    }
+    gt_elias_fano_add_to_mapspec(eftable->starts, mapspec);
+    gt_elias_fano_add_to_mapspec(eftable->ends, mapspec);
+  }
+}
+
+static uint64_t gt_encseq_sizeofEFrangetable(GtUword totallength,
+                                             GtUword numofranges)
+{
+  if (numofranges == 0)
+    return 0;
+  return (uint64_t) gt_elias_fano_size(numofranges, totallength) +
+         (uint64_t) gt_elias_fano_size(numofranges, totallength + 1);
+}
+
 typedef struct
 {
   GtUword totallength,
@@ -973,6 +1160,23 @@ static int fillssptabmapspecstartptr(GtEncseq *encseq,
   return haserr ? -1 : 0;
 }
 
+static int fillseftabmapspecstartptr(GtEncseq *encseq,
+                                     const char *indexname,
+                                     GtError *err)
+{
+  GtStr *tmpfilename;
+
+  gt_error_check(err);
+  tmpfilename = gt_str_new_cstr(indexname);
+  gt_str_append_cstr(tmpfilename, GT_SEFTABFILESUFFIX);
+  encseq->seftab = gt_elias_fano_new_from_file(gt_str_get(tmpfilename),
+                                               encseq->numofdbsequences - 1,
+                                               encseq->totallength,
+                                               err);
+  gt_str_delete(tmpfilename);
+  return encseq->seftab == NULL ? -1 : 0;
+}
+
 static void assignoistabmapspecification(GtMapspec *mapspec,
                                          void *voidinfo,
                                          bool writemode)
@@ -1355,6 +1559,14 @@ static void gt_encseq_assign_sequence_mapspec(GtMapspec *mapspec,
                                encseq->totallength,
                                encseq->sat);
       break;
+    case GT_ACCESS_TYPE_ELIASFANO:
+      gt_mapspec_add_twobitencoding(mapspec, encseq->twobitencoding,
+                                    encseq->unitsoftwobitencoding);
+      addEFrangetabletomapspectable(mapspec,
+                                    &encseq->efwildcardranges,
+                                    encseq->totallength,
+                                    writemode);
+      break;
     default: break;
   }
 }
@@ -1948,6 +2160,9 @@ void gt_encseq_delete(GtEncseq *encseq)
         gt_free(encseq->wildcardrangetable.st_uint32.endidxinpage);
         gt_free(encseq->wildcardrangetable.st_uint32.rangelengths);
         break;
+      case GT_ACCESS_TYPE_ELIASFANO:
+        gt_free(encseq->twobitencoding);
+        break;
       default: break;
     }
     if (encseq->has_exceptiontable) {
@@ -2002,6 +2217,9 @@ void gt_encseq_delete(GtEncseq *encseq)
   encseq->headerptr.filelengthtab = NULL;
   if (encseq->md5_tab != NULL)
     gt_md5_tab_delete(encseq->md5_tab);
+  gt_elias_fano_delete(encseq->seftab);
+  gt_elias_fano_delete(encseq->efwildcardranges.starts);
+  gt_elias_fano_delete(encseq->efwildcardranges.ends);
   if (encseq->indexname != NULL)
     gt_free(encseq->indexname);
   gt_mutex_unlock(encseq->refcount_lock);
@@ -2009,6 +2227,280 @@ void gt_encseq_delete(GtEncseq *encseq)
   gt_free(encseq);
 }
 
+/* While the input files are read to determine the key values of the
+   encoding, the two bit encoding of a DNA sequence, the wildcard ranges and
+   the separator positions are collected as well. For the access types based
+   on the two bit encoding, the final encoding is then derived from these
+   instead of reading and parsing the input files a second time. The special
+   characters are stored as 0 until the least probable character is known.
+   As there may be a separator for every short read, the separator positions
+   and the wildcard ranges are stored as varint coded differences, which
+   mostly need one or two bytes instead of a GtUword per value. */
+
+typedef struct
+{
+  GtUchar *bytes;
+  GtUword allocated,
+          nextfree,
+          numofvalues,
+          previous; /* the last position coded */
+} GtEncseqPrescanList;
+
+typedef struct
+{
+  GtTwobitencoding *twobitencoding,
+                   bitwise;
+  GtUword allocatedunits,
+          nextfreeunit,
+          widthbuffer,
+          currentposition,
+          lastwildcardrangelength;
+  GtEncseqPrescanList wildcardranges, /* maximal ranges as distance of the
+                                         start to the end of the previous
+                                         range plus one and length minus one */
+                      separators;     /* distances to the previous
+                                         separator */
+} GtEncseqPrescan;
+
+/* Decodes the positions of a <GtEncseqPrescanList> in the order in which
+   they were added. */
+typedef struct
+{
+  const GtUchar *ptr;
+  GtUword previous;
+} GtEncseqPrescanReader;
+
+#define GT_PRESCAN_MAXVARINTLENGTH\
+        ((sizeof (GtUword) * CHAR_BIT + 6) / 7)
+
+static void gt_encseq_prescan_list_init(GtEncseqPrescanList *list)
+{
+  list->bytes = NULL;
+  list->allocated = list->nextfree = list->numofvalues = list->previous = 0;
+}
+
+static void gt_encseq_prescan_list_appendvarint(GtEncseqPrescanList *list,
+                                                GtUword value)
+{
+  if (list->nextfree + GT_PRESCAN_MAXVARINTLENGTH > list->allocated) {
+    list->allocated += list->allocated/2 + GT_PRESCAN_MAXVARINTLENGTH + 1024UL;
+    list->bytes = gt_realloc(list->bytes,
+                             sizeof (*list->bytes) * list->allocated);
+  }
+  while (value >= (GtUword) 0x80) {
+    list->bytes[list->nextfree++] = (GtUchar) ((value & 0x7f) | 0x80);
+    value >>= 7;
+  }
+  list->bytes[list->nextfree++] = (GtUchar) value;
+}
+
+static void gt_encseq_prescan_reader_init(GtEncseqPrescanReader *reader,
+                                          const GtEncseqPrescanList *list)
+{
+  reader->ptr = list->bytes;
+  reader->previous = 0;
+}
+
+static inline GtUword gt_encseq_prescan_reader_nextvarint(
+                                                GtEncseqPrescanReader *reader)
+{
+  GtUword value = 0;
+  unsigned int shift = 0;
+
+  while (*reader->ptr & 0x80) {
+    value |= ((GtUword) (*reader->ptr++ & 0x7f)) << shift;
+    shift += 7;
+  }
+  return value | (((GtUword) *reader->ptr++) << shift);
+}
+
+/* Returns the next separator position of <reader>. */
+static inline GtUword gt_encseq_prescan_nextseparator(
+                                                GtEncseqPrescanReader *reader)
+{
+  reader->previous += gt_encseq_prescan_reader_nextvarint(reader);
+  return reader->previous;
+}
+
+/* Stores the next wildcard range of <reader> in <range>. */
+static inline void gt_encseq_prescan_nextwildcardrange(
+                                                GtEncseqPrescanReader *reader,
+                                                GtRange *range)
+{
+  range->start = reader->previous + gt_encseq_prescan_reader_nextvarint(reader);
+  range->end = range->start + gt_encseq_prescan_reader_nextvarint(reader);
+  reader->previous = range->end + 1;
+}
+
+static GtEncseqPrescan *gt_encseq_prescan_new(void)
+{
+  GtEncseqPrescan *prescan = gt_malloc(sizeof (*prescan));
+
+  prescan->allocatedunits = 1024UL;
+  prescan->twobitencoding = gt_malloc(sizeof (*prescan->twobitencoding) *
+                                      prescan->allocatedunits);
+  prescan->bitwise = 0;
+  prescan->nextfreeunit = 0;
+  prescan->widthbuffer = 0;
+  prescan->currentposition = 0;
+  prescan->lastwildcardrangelength = 0;
+  gt_encseq_prescan_list_init(&prescan->wildcardranges);
+  gt_encseq_prescan_list_init(&prescan->separators);
+  return prescan;
+}
+
+static void gt_encseq_prescan_delete(GtEncseqPrescan *prescan)
+{
+  if (prescan != NULL) {
+    gt_free(prescan->twobitencoding);
+    gt_free(prescan->wildcardranges.bytes);
+    gt_free(prescan->separators.bytes);
+    gt_free(prescan);
+  }
+}
+
+static void gt_encseq_prescan_endwildcardrange(GtEncseqPrescan *prescan)
+{
+  if (prescan->lastwildcardrangelength > 0) {
+    GtEncseqPrescanList *list = &prescan->wildcardranges;
+    GtUword start = prescan->currentposition
+                    - prescan->lastwildcardrangelength;
+
+    gt_encseq_prescan_list_appendvarint(list, start - list->previous);
+    gt_encseq_prescan_list_appendvarint(list,
+                                        prescan->lastwildcardrangelength - 1);
+    list->previous = prescan->currentposition;
+    list->numofvalues++;
+    prescan->lastwildcardrangelength = 0;
+  }
+}
+
+static inline void gt_encseq_prescan_add(GtEncseqPrescan *prescan,
+                                         GtUchar charcode)
+{
+  prescan->bitwise <<= 2;
+  if (ISNOTSPECIAL(charcode)) {
+    gt_assert(charcode < (GtUchar) GT_DNAALPHASIZE);
+    prescan->bitwise |= (GtTwobitencoding) charcode;
+    if (prescan->lastwildcardrangelength > 0)
+      gt_encseq_prescan_endwildcardrange(prescan);
+  } else {
+    if (charcode == (GtUchar) WILDCARD)
+      prescan->lastwildcardrangelength++;
+    else {
+      gt_assert(charcode == (GtUchar) SEPARATOR);
+      gt_encseq_prescan_endwildcardrange(prescan);
+      gt_encseq_prescan_list_appendvarint(&prescan->separators,
+                                          prescan->currentposition
+                                          - prescan->separators.previous);
+      prescan->separators.previous = prescan->currentposition;
+      prescan->separators.numofvalues++;
+    }
+  }
+  prescan->currentposition++;
+  if (prescan->widthbuffer < (GtUword) (GT_UNITSIN2BITENC - 1))
+    prescan->widthbuffer++;
+  else {
+    if (prescan->nextfreeunit == prescan->allocatedunits) {
+      prescan->allocatedunits += prescan->allocatedunits/2;
+      prescan->twobitencoding
+        = gt_realloc(prescan->twobitencoding,
+                     sizeof (*prescan->twobitencoding) *
+                     prescan->allocatedunits);
+    }
+    prescan->twobitencoding[prescan->nextfreeunit++] = prescan->bitwise;
+    prescan->widthbuffer = 0;
+    prescan->bitwise = 0;
+  }
+}
+
+/* Brings the two bit encoding into the layout produced by
+   DECLARESEQBUFFER and UPDATESEQBUFFERFINAL. */
+static void gt_encseq_prescan_finish(GtEncseqPrescan *prescan,
+                                     GtUword totallength)
+{
+  GtUword units = gt_unitsoftwobitencoding(totallength), idx;
+
+  gt_assert(prescan->currentposition == totallength);
+  gt_encseq_prescan_endwildcardrange(prescan);
+  gt_assert(prescan->nextfreeunit < units);
+  prescan->twobitencoding = gt_realloc(prescan->twobitencoding,
+                                       sizeof (*prescan->twobitencoding) *
+                                       units);
+  prescan->allocatedunits = units;
+  idx = prescan->nextfreeunit;
+  if (prescan->widthbuffer > 0) {
+    prescan->twobitencoding[idx++]
+      = prescan->bitwise << GT_MULT2(GT_UNITSIN2BITENC -
+                                     prescan->widthbuffer);
+  }
+  for (/* Nothing */; idx < units; idx++)
+    prescan->twobitencoding[idx] = 0;
+}
+
+/* Moves the two bit encoding of <prescan> to <encseq> and stores
+   <wildcardcode> and <separatorcode> at the positions of the special
+   characters. */
+static void gt_encseq_prescan_transfertwobitencoding(GtEncseq *encseq,
+                                                  GtEncseqPrescan *prescan,
+                                                  GtTwobitencoding wildcardcode,
+                                                  GtTwobitencoding
+                                                    separatorcode)
+{
+  GtUword idx, pos;
+  GtEncseqPrescanReader reader;
+
+#define GT_PRESCAN_SETCODE(POS, CODE)\
+        encseq->twobitencoding[GT_DIVBYUNITSIN2BITENC(POS)]\
+          |= (CODE) << GT_MULT2(GT_UNITSIN2BITENC - 1 -\
+                                GT_MODBYUNITSIN2BITENC(POS))
+
+  encseq->unitsoftwobitencoding = prescan->allocatedunits;
+  encseq->twobitencoding = prescan->twobitencoding;
+  prescan->twobitencoding = NULL;
+  if (wildcardcode > 0) {
+    gt_encseq_prescan_reader_init(&reader, &prescan->wildcardranges);
+    for (idx = 0; idx < prescan->wildcardranges.numofvalues; idx++) {
+      GtRange range;
+
+      gt_encseq_prescan_nextwildcardrange(&reader, &range);
+      for (pos = range.start; pos <= range.end; pos++)
+        GT_PRESCAN_SETCODE(pos, wildcardcode);
+    }
+  }
+  if (separatorcode > 0) {
+    gt_encseq_prescan_reader_init(&reader, &prescan->separators);
+    for (idx = 0; idx < prescan->separators.numofvalues; idx++) {
+      pos = gt_encseq_prescan_nextseparator(&reader);
+      GT_PRESCAN_SETCODE(pos, separatorcode);
+    }
+  }
+#undef GT_PRESCAN_SETCODE
+}
+
+/* Fills the ssptab like the calls of ssptaboutinfo_processseppos() and
+   ssptaboutinfo_processanyposition() for every position do. */
+static void ssptaboutinfo_processprescan(Gtssptaboutinfo *ssptaboutinfo,
+                                         const GtEncseqPrescan *prescan)
+{
+  GtUword idx, seppos;
+  GtEncseqPrescanReader reader;
+
+  if (ssptaboutinfo == NULL)
+    return;
+  gt_encseq_prescan_reader_init(&reader, &prescan->separators);
+  for (idx = 0; idx < prescan->separators.numofvalues; idx++) {
+    seppos = gt_encseq_prescan_nextseparator(&reader);
+    while (ssptaboutinfo->nextcheckpos < seppos &&
+           ssptaboutinfo->pagenumber < ssptaboutinfo->numofpages) {
+      ssptaboutinfo_setendidx(ssptaboutinfo);
+      ssptaboutinfo->nextcheckpos += ssptaboutinfo->nextcheckincrement;
+    }
+    ssptaboutinfo_processseppos(ssptaboutinfo, seppos);
+  }
+  ssptaboutinfo_finalize(ssptaboutinfo);
+}
+
 static GtEncseqReaderViatablesinfo *assignSWstate(GtEncseqReader *esr,
                                                   KindofSWtable kindsw)
 {
@@ -2060,6 +2552,342 @@ static GtEncseqReaderViatablesinfo *assignSWstate(GtEncseqReader *esr,
 #undef GT_PAGENUM2OFFSET
 #undef GT_POS2PAGENUM
 
+/* GT_ACCESS_TYPE_ELIASFANO: the separators are stored in the ssptab as for
+   the u-tables, but the wildcard ranges are not split into pages. Instead
+   the start positions and the end positions (plus one) of the maximal
+   wildcard ranges are each stored as an Elias-Fano coded sequence. So the
+   wildcard range containing or following a position is found by a rank
+   query in constant time, independent of the number of ranges in between. */
+
+static void determinerangeViaeliasfano(GtRange *range,
+                                       const GtEFrangetable *eftable,
+                                       GtUword cellnum)
+{
+  gt_assert(cellnum < eftable->numofranges);
+  range->start = gt_elias_fano_get(eftable->starts, cellnum);
+  range->end = gt_elias_fano_get(eftable->ends, cellnum);
+}
+
+static bool issinglepositioninwildcardrangeViaeliasfano(const GtEncseq *encseq,
+                                                        GtUword pos)
+{
+  GtUword idx;
+
+  if (!encseq->has_wildcardranges)
+    return false;
+  /* the number of ranges starting at or before pos */
+  idx = gt_elias_fano_rank(encseq->efwildcardranges.starts, pos + 1);
+  return (idx > 0 &&
+          pos < gt_elias_fano_get(encseq->efwildcardranges.ends, idx - 1))
+         ? true : false;
+}
+
+/* In contrast to the u-tables, <firstcell> is the index of the next range to
+   deliver when moving forward, and <lastcell> is the index plus one of the
+   next range to deliver when moving backward. There are no pages. */
+
+static void binpreparenextrangeViaeliasfano(GtEncseqReader *esr)
+{
+  const GtEFrangetable *eftable = &esr->encseq->efwildcardranges;
+  GtEncseqReaderViatablesinfo *swstate = esr->wildcardrangestate;
+  GtUword idx;
+
+  swstate->hasprevious = swstate->hascurrent = swstate->hasmore = false;
+  swstate->exhausted = false;
+  swstate->morepagesleft = false;
+  swstate->nextpage = 0;
+  if (!GT_ISDIRREVERSE(esr->readmode)) {
+    idx = gt_elias_fano_rank(eftable->starts, esr->currentpos + 1);
+    if (idx > 0 &&
+        esr->currentpos < gt_elias_fano_get(eftable->ends, idx - 1)) {
+      determinerangeViaeliasfano(&swstate->previousrange, eftable, idx - 1);
+      swstate->hasprevious = true;
+    }
+    swstate->firstcell = idx;
+  }
+  else {
+    /* the number of ranges ending at or before currentpos */
+    idx = gt_elias_fano_rank(eftable->ends, esr->currentpos + 1);
+    if (idx < eftable->numofranges &&
+        gt_elias_fano_get(eftable->starts, idx) <= esr->currentpos) {
+      determinerangeViaeliasfano(&swstate->previousrange, eftable, idx);
+      swstate->hasprevious = true;
+    }
+    swstate->lastcell = idx;
+  }
+}
+
+static void advancerangeViaeliasfano(GtEncseqReader *esr)
+{
+  const GtEFrangetable *eftable = &esr->encseq->efwildcardranges;
+  GtEncseqReaderViatablesinfo *swstate = esr->wildcardrangestate;
+  bool moveforward = GT_ISDIRREVERSE(esr->readmode) ? false : true;
+
+  gt_assert(swstate != NULL);
+  while (true) {
+    if (swstate->hascurrent) {
+      swstate->previousrange = swstate->currentrange;
+      swstate->hascurrent = false;
+    }
+    if (moveforward ? swstate->firstcell < eftable->numofranges
+                    : swstate->lastcell > 0) {
+      determinerangeViaeliasfano(&swstate->currentrange, eftable,
+                                 moveforward ? swstate->firstcell++
+                                             : --swstate->lastcell);
+      swstate->hasmore = true;
+    }
+    else {
+      swstate->hasmore = false;
+      break;
+    }
+    /* maximal ranges are never adjacent, so nothing is merged */
+    if (swstate->hasprevious) {
+      swstate->hascurrent = true;
+      break;
+    }
+    swstate->previousrange = swstate->currentrange;
+    swstate->hasprevious = true;
+  }
+  gt_assert(swstate->hasprevious || !swstate->hasmore);
+}
+
+static GtUchar seqdelivercharSpecialViaeliasfano(GtEncseqReader *esr)
+{
+  GtUchar cc = 0;
+  bool defined = false;
+
+  /* checknextSW only depends on the reader state, not on the type of the
+     table. As in seqdelivercharSpecial_*, both calls are necessary to
+     maintain the states */
+  if (esr->encseq->numofdbsequences > 1UL &&
+      checknextSW_uint32(esr, SWtable_ssptab)) {
+    cc = (GtUchar) SEPARATOR;
+    defined = true;
+  }
+  if (esr->encseq->has_wildcardranges &&
+      checknextSW_uint32(esr, SWtable_wildcardrange)) {
+    gt_assert(!defined);
+    cc = (GtUchar) WILDCARD;
+    defined = true;
+  }
+  if (defined)
+    return cc;
+  return (GtUchar) EXTRACTENCODEDCHAR(esr->encseq->twobitencoding,
+                                      esr->currentpos);
+}
+
+/* If the reader has moved beyond the current range, then the state is
+   repositioned by a rank query instead of stepping through the ranges in
+   between. */
+
+static GtUword fwdgetnexttwobitencodingstopposViaeliasfano(GtEncseqReader *esr)
+{
+  GtEncseqReaderViatablesinfo *swstate = esr->wildcardrangestate;
+
+  gt_assert(!GT_ISDIRREVERSE(esr->readmode) && swstate != NULL);
+  if (swstate->hasprevious && swstate->hasmore &&
+      esr->currentpos >= swstate->previousrange.end) {
+    binpreparenextrangeViaeliasfano(esr);
+    advancerangeViaeliasfano(esr);
+  }
+  if (swstate->hasprevious) {
+    if (esr->currentpos < swstate->previousrange.start)
+      return swstate->previousrange.start;
+    if (esr->currentpos < swstate->previousrange.end)
+      return esr->currentpos; /* is in current wildcard range */
+  }
+  return esr->encseq->totallength;
+}
+
+static GtUword revgetnexttwobitencodingstopposViaeliasfano(GtEncseqReader *esr)
+{
+  GtEncseqReaderViatablesinfo *swstate = esr->wildcardrangestate;
+
+  gt_assert(GT_ISDIRREVERSE(esr->readmode) && swstate != NULL);
+  if (swstate->hasprevious && swstate->hasmore &&
+      esr->currentpos < swstate->previousrange.start) {
+    binpreparenextrangeViaeliasfano(esr);
+    advancerangeViaeliasfano(esr);
+  }
+  if (swstate->hasprevious) {
+    if (esr->currentpos >= swstate->previousrange.end)
+      return swstate->previousrange.end;
+    if (esr->currentpos >= swstate->previousrange.start)
+      return esr->currentpos + 1; /* is in current wildcard range */
+  }
+  return 0; /* virtual stop at -1 */
+}
+
+static void allocEFrangetable(GtEncseq *encseq)
+{
+  GtEFrangetable *eftable = &encseq->efwildcardranges;
+
+  if (eftable->numofranges > 0) {
+    eftable->starts = gt_elias_fano_new(eftable->numofranges,
+                                        encseq->totallength);
+    eftable->ends = gt_elias_fano_new(eftable->numofranges,
+                                      encseq->totallength + 1);
+  }
+}
+
+static int fillViaeliasfano(GtEncseq *encseq,
+                            Gtssptaboutinfo *ssptaboutinfo,
+                            GtSequenceBuffer *fb,
+                            GtError *err)
+{
+  GtUword currentposition,
+          fillexceptionrangeidx = 0,
+          mapposition = 0,
+          nextcheckpos = GT_UNDEF_UWORD,
+          pagenumber = 0,
+          lastexceptionrangelength = 0;
+  bool inwildcardrange = false;
+  int retval;
+  GtUchar cc;
+  char orig;
+  GtEFrangetable *eftable = &encseq->efwildcardranges;
+  GtSWtable_uint32 *exceptiontable = &(encseq->exceptiontable.st_uint32);
+  DECLARESEQBUFFER(encseq->twobitencoding); /* in fillViaeliasfano */
+  gt_error_check(err);
+
+  allocEFrangetable(encseq);
+  if (encseq->has_exceptiontable) {
+    exceptiontable->positions = gt_malloc(sizeof (*exceptiontable->positions) *
+                                         exceptiontable->numofpositionstostore);
+    exceptiontable->rangelengths =
+                               gt_malloc(sizeof(*exceptiontable->rangelengths) *
+                                         exceptiontable->numofpositionstostore);
+    exceptiontable->endidxinpage =
+                               gt_malloc(sizeof(*exceptiontable->endidxinpage) *
+                                         exceptiontable->numofpages);
+    exceptiontable->mappositions =
+                              gt_malloc(sizeof (*exceptiontable->mappositions) *
+                                        exceptiontable->numofpositionstostore);
+    nextcheckpos = exceptiontable->maxrangevalue;
+  }
+  for (currentposition=0; /* Nothing */; currentposition++) {
+    retval = gt_sequence_buffer_next_with_original(fb, &cc, &orig, err);
+    if (retval == 1) {
+      if (encseq->has_exceptiontable && cc != (GtUchar) SEPARATOR) {
+        if (orig == encseq->maxchars[cc]) {
+          if (lastexceptionrangelength > 0) {
+            exceptiontable->rangelengths[fillexceptionrangeidx-1]
+              = (uint32_t) (lastexceptionrangelength-1);
+            lastexceptionrangelength = 0;
+          }
+        }
+        else {
+          /* at beginning of exception range */
+          if (lastexceptionrangelength == 0) {
+            /* store remainder of currentposition: this value is not larger
+               than maxrangevalue and this can be stored in a page */
+            exceptiontable->positions[fillexceptionrangeidx++]
+              = (uint32_t) (currentposition & exceptiontable->maxrangevalue);
+            exceptiontable->mappositions[fillexceptionrangeidx-1]
+              = mapposition;
+            lastexceptionrangelength = 1UL;
+          }
+          else /* extend exception range */ {
+            if (lastexceptionrangelength == exceptiontable->maxrangevalue) {
+              gt_assert(fillexceptionrangeidx > 0);
+              exceptiontable->rangelengths[fillexceptionrangeidx-1]
+                = (uint32_t) exceptiontable->maxrangevalue;
+              lastexceptionrangelength = 0;
+            }
+            else {
+              lastexceptionrangelength++;
+            }
+          }
+          bitpackarray_store_uint32(encseq->exceptions,
+                                   (BitOffset) mapposition,
+                                   (uint32_t) encseq->subsymbolmap[(int) orig]);
+          mapposition++;
+        }
+      }
+      if (cc == (GtUchar) WILDCARD) {
+        if (!inwildcardrange) {
+          gt_elias_fano_add(eftable->starts, currentposition);
+          inwildcardrange = true;
+        }
+      }
+      else {
+        if (inwildcardrange) {
+          gt_elias_fano_add(eftable->ends, currentposition);
+          inwildcardrange = false;
+        }
+        if (cc == (GtUchar) SEPARATOR)
+          ssptaboutinfo_processseppos(ssptaboutinfo, currentposition);
+      }
+      if (encseq->has_exceptiontable && currentposition == nextcheckpos) {
+        exceptiontable->endidxinpage[pagenumber] = fillexceptionrangeidx;
+        pagenumber++;
+        nextcheckpos += 1UL + exceptiontable->maxrangevalue;
+      }
+      ssptaboutinfo_processanyposition(ssptaboutinfo, currentposition);
+      bitwise <<= 2;
+      if (ISNOTSPECIAL(cc))
+        bitwise |= (GtTwobitencoding) cc;
+      else
+        bitwise |= (GtTwobitencoding) encseq->leastprobablecharacter;
+      if (widthbuffer < (GtUword) (GT_UNITSIN2BITENC - 1))
+        widthbuffer++;
+      else {
+        *twobitencodingptr++ = bitwise;
+        widthbuffer = 0;
+        bitwise = 0;
+      }
+    }
+    else {
+      if (retval < 0)
+        return -1;
+      if (encseq->has_exceptiontable && lastexceptionrangelength > 0) {
+        /* note that we store one less than the length to prevent overflows */
+        gt_assert(fillexceptionrangeidx > 0 &&
+                  fillexceptionrangeidx <=
+                  exceptiontable->numofpositionstostore);
+        exceptiontable->rangelengths[fillexceptionrangeidx-1]
+          = (uint32_t) (lastexceptionrangelength-1);
+      }
+      gt_assert(retval == 0);
+      break;
+    }
+  }
+  if (inwildcardrange)
+    gt_elias_fano_add(eftable->ends, currentposition);
+  if (encseq->has_exceptiontable) {
+    while (pagenumber < exceptiontable->numofpages) {
+      exceptiontable->endidxinpage[pagenumber] = fillexceptionrangeidx;
+      pagenumber++;
+    }
+  }
+  UPDATESEQBUFFERFINAL(bitwise, twobitencodingptr); /* in fillViaeliasfano */
+  ssptaboutinfo_finalize(ssptaboutinfo);
+  return 0;
+}
+
+/* Fills the Elias-Fano coded wildcard ranges and the ssptab like
+   fillViaeliasfano, but from the ranges collected by <prescan>. */
+static void fillViaeliasfanofromprescan(GtEncseq *encseq,
+                                        Gtssptaboutinfo *ssptaboutinfo,
+                                        const GtEncseqPrescan *prescan)
+{
+  GtUword idx;
+  GtEFrangetable *eftable = &encseq->efwildcardranges;
+  GtEncseqPrescanReader reader;
+
+  gt_assert(prescan->wildcardranges.numofvalues == eftable->numofranges);
+  allocEFrangetable(encseq);
+  gt_encseq_prescan_reader_init(&reader, &prescan->wildcardranges);
+  for (idx = 0; idx < eftable->numofranges; idx++) {
+    GtRange range;
+
+    gt_encseq_prescan_nextwildcardrange(&reader, &range);
+    gt_elias_fano_add(eftable->starts, range.start);
+    gt_elias_fano_add(eftable->ends, range.end + 1);
+  }
+  ssptaboutinfo_processprescan(ssptaboutinfo, prescan);
+}
+
 #ifdef GT_RANGEDEBUG
 
 static void showallSWtablewithpages(GtEncseqAccessType sat,
@@ -2088,7 +2916,8 @@ static void showallSWtablewithpages(GtEncseqAccessType sat,
 
 static void showallSWtables(const GtEncseq *encseq)
 {
-  if (encseq->accesstype_via_utables) {
+  if (encseq->accesstype_via_utables &&
+      encseq->sat != GT_ACCESS_TYPE_ELIASFANO) {
     if (encseq->has_wildcardranges) {
       printf("wildcardrangetable\n");
       showallSWtablewithpages(encseq->sat, &encseq->wildcardrangetable);
@@ -2964,6 +3793,10 @@ static void advancerangeGtEncseqReader(GtEncseqReader *esr,
     case GT_ACCESS_TYPE_UINT32TABLES:
       advancerangeGtEncseqReader_uint32(esr, kindsw);
       break;
+    case GT_ACCESS_TYPE_ELIASFANO:
+      gt_assert(kindsw == SWtable_wildcardrange);
+      advancerangeViaeliasfano(esr);
+      break;
     default:
       fprintf(stderr, "advancerangeGtEncseqReader(sat = %s is undefined)\n",
               gt_encseq_access_type_str(sat));
@@ -2986,6 +3819,10 @@ static void binpreparenextrangeGtEncseqReader(GtEncseqReader *esr,
     case GT_ACCESS_TYPE_UINT32TABLES:
       binpreparenextrangeGtEncseqReader_uint32(esr, kindsw);
       break;
+    case GT_ACCESS_TYPE_ELIASFANO:
+      gt_assert(kindsw == SWtable_wildcardrange);
+      binpreparenextrangeViaeliasfano(esr);
+      break;
     default: fprintf(stderr, "binpreparenextrangeGtEncseqReader(sat = %s "
                             "is undefined)\n",
                      gt_encseq_access_type_str(sat));
@@ -3136,6 +3973,10 @@ void gt_encseq_reader_delete(GtEncseqReader *esr)
 static GtUword gt_encseq_seqstartpos_viautables(const GtEncseq *encseq,
                                                       GtUword seqnum)
 {
+  if (encseq->seftab != NULL) {
+    return seqnum > 0 ? gt_elias_fano_get(encseq->seftab, seqnum - 1) + 1
+                      : 0;
+  }
   switch (encseq->satsep) {
     case GT_ACCESS_TYPE_UCHARTABLES:
       return gt_encseq_seqstartposSW_uchar(&encseq->ssptab.st_uchar,
@@ -3822,6 +4663,8 @@ GtUword gt_encseq_seqnum_ssptab(const GtEncseq *encseq,
                                          GtUword position)
 {
   gt_assert(position < encseq->totallength);
+  if (encseq->seftab != NULL)
+    return gt_elias_fano_rank(encseq->seftab, position);
   switch (encseq->satsep) {
     case GT_ACCESS_TYPE_UCHARTABLES:
       return gt_encseq_seqnum_uchar(&encseq->ssptab.st_uchar,position);
@@ -3981,6 +4824,28 @@ static double determine_spaceinbitsperchar(GtUword sizeofrep,
                   (double) totallength;
 }
 
+static void fillencseqdecodetabs(GtEncseq *encseq)
+{
+  unsigned int cc, numofchars, byte, idx;
+  char wildcardshow;
+
+  numofchars = gt_alphabet_num_of_chars(encseq->alpha);
+  wildcardshow = (char) gt_alphabet_wildcard_show(encseq->alpha);
+  for (cc = 0; cc <= (unsigned int) UCHAR_MAX; cc++) {
+    encseq->decodetab[cc] = (cc < numofchars)
+                              ? gt_alphabet_decode(encseq->alpha, (GtUchar) cc)
+                              : wildcardshow;
+  }
+  encseq->decodetab[SEPARATOR] = (char) SEPARATOR;
+  /* the first character of a byte is stored in its two leftmost bits */
+  for (byte = 0; byte <= (unsigned int) UCHAR_MAX; byte++) {
+    for (idx = 0; idx < 4U; idx++) {
+      encseq->twobitdecodetab[byte][idx]
+        = encseq->decodetab[(byte >> GT_MULT2(3U - idx)) & 3U];
+    }
+  }
+}
+
 static GtEncseq *determineencseqkeyvalues(GtEncseqAccessType sat,
                                           GtUword totallength,
                                           GtUword numofsequences,
@@ -4014,8 +4879,15 @@ static GtEncseq *determineencseqkeyvalues(GtEncseqAccessType sat,
                                                   numofsequences-1);
   }
   encseq->has_exceptiontable = oistab;
-  if (encseq->accesstype_via_utables)
-    initSWtable(&encseq->wildcardrangetable, totallength, sat, wildcardranges);
+  encseq->efwildcardranges.starts = encseq->efwildcardranges.ends = NULL;
+  encseq->efwildcardranges.numofranges = 0;
+  if (sat == GT_ACCESS_TYPE_ELIASFANO)
+    encseq->efwildcardranges.numofranges = wildcardranges;
+  else {
+    if (encseq->accesstype_via_utables)
+      initSWtable(&encseq->wildcardrangetable, totallength, sat,
+                  wildcardranges);
+  }
   if (encseq->satsep != GT_ACCESS_TYPE_UNDEFINED)
     initSWtable(&encseq->ssptab, totallength, encseq->satsep, numofsequences-1);
   if (encseq->has_exceptiontable) {
@@ -4049,6 +4921,7 @@ static GtEncseq *determineencseqkeyvalues(GtEncseqAccessType sat,
   encseq->destablength = 0;
   encseq->fsptab = NULL;
   encseq->md5_tab = NULL;
+  encseq->seftab = NULL;
   encseq->hasallocatedssptab = false;
   if (equallength == NULL) {
     encseq->equallength.defined = false;
@@ -4058,6 +4931,8 @@ static GtEncseq *determineencseqkeyvalues(GtEncseqAccessType sat,
     encseq->equallength = *equallength;
   }
   encseq->alpha = alpha;
+  if (alpha != NULL)
+    fillencseqdecodetabs(encseq);
   alphabet_to_key_values(alpha, &encseq->alphatype, &encseq->lengthofalphadef,
                          &encseq->alphadef, customalphabet);
   encseq->totallength = totallength;
@@ -4335,6 +5210,20 @@ static GtEncseqfunctions encodedseqfunctab[] =
            issinglepositionseparatorViauint32),
       NFCT(getexceptionmapping,
            issinglepositioninexceptionrangeViauint32)
+    },
+
+    { /* GT_ACCESS_TYPE_ELIASFANO */
+      NFCT(fillposition, fillViaeliasfano),
+      NFCT(seqdelivercharnospecial, seqdelivercharnospecial2bitenc),
+      NFCT(seqdelivercharspecial, seqdelivercharSpecialViaeliasfano),
+      NFCT(delivercontainsspecial, containsspecialViatables),
+      NFCT(issinglepositioninwildcardrange,
+           issinglepositioninwildcardrangeViaeliasfano),
+      NFCT(issinglepositionseparator,
+           NULL), /* the separators are in the ssptab, so the function of
+                     satsep is used */
+      NFCT(getexceptionmapping,
+           issinglepositioninexceptionrangeViauint32)
     }
   };
 
@@ -4446,6 +5335,83 @@ int gt_encseq_seppos2ssptab(const char *indexname,
 
 #define SIZEOFFUNCTAB sizeof (encodedseqfunctab)/sizeof (encodedseqfunctab[0])
 
+static bool gt_encseq_prescan_applicable(GtEncseqAccessType sat)
+{
+  return (sat == GT_ACCESS_TYPE_EQUALLENGTH ||
+          sat == GT_ACCESS_TYPE_BITACCESS ||
+          sat == GT_ACCESS_TYPE_UCHARTABLES ||
+          sat == GT_ACCESS_TYPE_USHORTTABLES ||
+          sat == GT_ACCESS_TYPE_UINT32TABLES ||
+          sat == GT_ACCESS_TYPE_ELIASFANO) ? true : false;
+}
+
+/* Does the same as the fillposition function of the access type of <encseq>
+   without an exception table, but with the data collected by <prescan>. */
+static void gt_encseq_fill_from_prescan(GtEncseq *encseq,
+                                        Gtssptaboutinfo *ssptaboutinfo,
+                                        GtEncseqPrescan *prescan)
+{
+  GtTwobitencoding lpc = (GtTwobitencoding) encseq->leastprobablecharacter;
+
+  gt_assert(!encseq->has_exceptiontable);
+  switch (encseq->sat) {
+    case GT_ACCESS_TYPE_EQUALLENGTH:
+      gt_assert(prescan->wildcardranges.numofvalues == 0);
+      gt_encseq_prescan_transfertwobitencoding(encseq, prescan, lpc, lpc);
+      break;
+    case GT_ACCESS_TYPE_BITACCESS:
+      {
+        GtUword idx, pos;
+        GtEncseqPrescanReader reader;
+
+        gt_encseq_prescan_transfertwobitencoding(encseq, prescan,
+                                              GT_TWOBITS_FOR_WILDCARD,
+                                              GT_TWOBITS_FOR_SEPARATOR);
+        GT_INITBITTAB(encseq->specialbits,
+                      encseq->totallength + GT_INTWORDSIZE);
+        for (pos = encseq->totallength;
+             pos < encseq->totallength + GT_INTWORDSIZE; pos++) {
+          GT_SETIBIT(encseq->specialbits, pos);
+        }
+        gt_encseq_prescan_reader_init(&reader, &prescan->wildcardranges);
+        for (idx = 0; idx < prescan->wildcardranges.numofvalues; idx++) {
+          GtRange range;
+
+          gt_encseq_prescan_nextwildcardrange(&reader, &range);
+          for (pos = range.start; pos <= range.end; pos++)
+            GT_SETIBIT(encseq->specialbits, pos);
+        }
+        gt_encseq_prescan_reader_init(&reader, &prescan->separators);
+        for (idx = 0; idx < prescan->separators.numofvalues; idx++) {
+          pos = gt_encseq_prescan_nextseparator(&reader);
+          GT_SETIBIT(encseq->specialbits, pos);
+        }
+        ssptaboutinfo_processprescan(ssptaboutinfo, prescan);
+      }
+      break;
+    case GT_ACCESS_TYPE_UCHARTABLES:
+      fillSWtablefromprescan_uchar(encseq, ssptaboutinfo, prescan);
+      gt_encseq_prescan_transfertwobitencoding(encseq, prescan, lpc, lpc);
+      break;
+    case GT_ACCESS_TYPE_USHORTTABLES:
+      fillSWtablefromprescan_uint16(encseq, ssptaboutinfo, prescan);
+      gt_encseq_prescan_transfertwobitencoding(encseq, prescan, lpc, lpc);
+      break;
+    case GT_ACCESS_TYPE_UINT32TABLES:
+      fillSWtablefromprescan_uint32(encseq, ssptaboutinfo, prescan);
+      gt_encseq_prescan_transfertwobitencoding(encseq, prescan, lpc, lpc);
+      break;
+    case GT_ACCESS_TYPE_ELIASFANO:
+      fillViaeliasfanofromprescan(encseq, ssptaboutinfo, prescan);
+      gt_encseq_prescan_transfertwobitencoding(encseq, prescan, lpc, lpc);
+      break;
+    default:
+      fprintf(stderr, "%s(sat = %s is not supported)\n", __func__,
+              gt_encseq_access_type_str(encseq->sat));
+      exit(GT_EXIT_PROGRAMMING_ERROR);
+  }
+}
+
 static GtEncseq *files2encodedsequence(const GtStrArray *filenametab,
                                        const GtFilelengthvalues *filelengthtab,
                                        bool plainformat,
@@ -4469,11 +5435,12 @@ static GtEncseq *files2encodedsequence(const GtStrArray *filenametab,
                                        GtUword wildcardranges,
                                        GtUword minseqlength,
                                        GtUword maxseqlength,
+                                       GtEncseqPrescan *prescan,
                                        GtLogger *logger,
                                        GtError *err)
 {
   GtEncseq *encseq = NULL;
-  bool haserr = false;
+  bool haserr = false, useprescan = false;
   GtSequenceBuffer *fb = NULL;
   Gtssptaboutinfo *ssptaboutinfo = NULL;
 
@@ -4515,14 +5482,20 @@ static GtEncseq *files2encodedsequence(const GtStrArray *filenametab,
     encseq->subsymbolmap = subsymbolmap;
     encseq->maxsubalphasize = maxsubalphasize;
     gt_assert(filenametab != NULL);
-    if (plainformat) {
-      fb = gt_sequence_buffer_plain_new(filenametab);
+    if (prescan != NULL && !encseq->has_exceptiontable &&
+        gt_encseq_prescan_applicable(sat)) {
+      useprescan = true;
     }
     else {
-      fb = gt_sequence_buffer_new_guess_type(filenametab, err);
+      if (plainformat) {
+        fb = gt_sequence_buffer_plain_new(filenametab);
+      }
+      else {
+        fb = gt_sequence_buffer_new_guess_type(filenametab, err);
+      }
+      if (!fb)
+        haserr = true;
     }
-    if (!fb)
-      haserr = true;
   }
   if (!haserr) {
     gt_assert(encseq != NULL);
@@ -4547,11 +5520,17 @@ static GtEncseq *files2encodedsequence(const GtStrArray *filenametab,
                                        specialcharinfo.exceptioncharacters,
                            true);
     }
-    gt_sequence_buffer_set_symbolmap(fb, gt_alphabet_symbolmap(alphabet));
-    if (encodedseqfunctab[(int) sat].fillposition.function(encseq,
-                                                           ssptaboutinfo,
-                                                           fb, err) != 0)
-      haserr = true;
+    if (useprescan) {
+      gt_log_log("derive encoding from first scan of input");
+      gt_encseq_fill_from_prescan(encseq, ssptaboutinfo, prescan);
+    }
+    else {
+      gt_sequence_buffer_set_symbolmap(fb, gt_alphabet_symbolmap(alphabet));
+      if (encodedseqfunctab[(int) sat].fillposition.function(encseq,
+                                                             ssptaboutinfo,
+                                                             fb, err) != 0)
+        haserr = true;
+    }
     ssptaboutinfo_delete(ssptaboutinfo);
   }
 #ifdef GT_RANGEDEBUG
@@ -4684,6 +5663,13 @@ static GtEncseq* gt_encseq_new_from_index(const char *indexname,
         haserr = true;
     }
   }
+  if (!haserr && encseq != NULL &&
+      encseq->sat != GT_ACCESS_TYPE_EQUALLENGTH &&
+      encseq->numofdbsequences > 1UL &&
+      gt_file_exists_with_suffix(indexname, GT_SEFTABFILESUFFIX)) {
+    if (fillseftabmapspecstartptr(encseq, indexname, err) != 0)
+      haserr = true;
+  }
   if (!haserr && withoistab) {
     gt_assert(encseq != NULL);
     encseq->has_exceptiontable = true;
@@ -4864,6 +5850,7 @@ bool gt_encseq_has_multiseq_support(const GtEncseq *encseq)
 {
   bool ret =  encseq->sat == GT_ACCESS_TYPE_EQUALLENGTH ||
               encseq->has_ssptab ||
+              encseq->seftab != NULL ||
               encseq->accesstype_via_utables;
   return ret;
 }
@@ -5042,6 +6029,7 @@ static GtUword calcswranges(const char *kind,
     rangestab[0] = updatesumrangeinfo.ranges_uint8_t;
     rangestab[1] = updatesumrangeinfo.ranges_uint16_t;
     rangestab[2] = updatesumrangeinfo.ranges_uint32_t;
+    rangestab[3] = updatesumrangeinfo.realranges;
   }
   return updatesumrangeinfo.realranges;
 }
@@ -5107,6 +6095,10 @@ uint64_t gt_encseq_determine_size(GtEncseqAccessType sat,
                gt_encseq_sizeofSWtable(sat, true, false, totallength,
                                        wildcardranges);
          break;
+    case GT_ACCESS_TYPE_ELIASFANO:
+         sum = sizeoftwobitencoding +
+               gt_encseq_sizeofEFrangetable(totallength, wildcardranges);
+         break;
     default:
          fprintf(stderr, "gt_encseq_determine_size(%d) undefined\n", (int) sat);
          exit(GT_EXIT_PROGRAMMING_ERROR);
@@ -5156,7 +6148,13 @@ static void doupdatesumranges(GtSpecialcharinfo *specialcharinfo,
   specialcharinfo->realwildcardranges
     = calcswranges("wildcard", true, wildcardrangestab, distwildcardrangelength,
                    logger);
-  gt_assert(forcetable <= 3U);
+  gt_assert(forcetable <= 4U);
+  if (forcetable == 4U) {
+    /* the Elias-Fano representation stores the maximal ranges */
+    specialcharinfo->specialranges = specialrangestab[3];
+    specialcharinfo->wildcardranges = wildcardrangestab[3];
+    return;
+  }
   for (c = 0; c<3; c++) {
     if (forcetable == 3U || c == (int) forcetable) {
       tmp = detencseqofsatviautables(c, totallength, numofsequences,
@@ -5365,6 +6363,7 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
                                            GtUword *minseqlen,
                                            GtUword *maxseqlen,
                                            bool clip_desc,
+                                           GtEncseqPrescan *prescan,
                                            GtLogger *logger,
                                            GtError *err)
 {
@@ -5460,6 +6459,8 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
 #define WITHORIGDIST
 #define WITHMD5FP
 #include "encseq_charproc.gen"
+        if (prescan != NULL)
+          gt_encseq_prescan_add(prescan, charcode);
       }
       else {
         if (retval == 0) {
@@ -5542,6 +6543,8 @@ static int gt_inputfiles2sequencekeyvalues(const char *indexname,
                                       .des files */
     }
     *totallength = currentpos;
+    if (prescan != NULL)
+      gt_encseq_prescan_finish(prescan, currentpos);
     specialcharinfo->lengthofspecialsuffix = lastspecialrangelength;
     specialcharinfo->lengthofwildcardsuffix = lastwildcardrangelength;
     doupdatesumranges(specialcharinfo,
@@ -5871,6 +6874,9 @@ static GtUword fwdgetnexttwobitencodingstopposSW(GtEncseqReader *esr,
         return fwdgetnexttwobitencodingstopposSW_uint16(esr, kindsw);
       case GT_ACCESS_TYPE_UINT32TABLES:
         return fwdgetnexttwobitencodingstopposSW_uint32(esr, kindsw);
+      case GT_ACCESS_TYPE_ELIASFANO:
+        gt_assert(kindsw == SWtable_wildcardrange);
+        return fwdgetnexttwobitencodingstopposViaeliasfano(esr);
       default:
        fprintf(stderr, "%s(%d) undefined\n", __func__, (int) sat);
        exit(GT_EXIT_PROGRAMMING_ERROR);
@@ -5937,6 +6943,9 @@ static GtUword revgetnexttwobitencodingstopposSW(GtEncseqReader *esr,
         return revgetnexttwobitencodingstopposSW_uint16(esr, kindsw);
       case GT_ACCESS_TYPE_UINT32TABLES:
         return revgetnexttwobitencodingstopposSW_uint32(esr, kindsw);
+      case GT_ACCESS_TYPE_ELIASFANO:
+        gt_assert(kindsw == SWtable_wildcardrange);
+        return revgetnexttwobitencodingstopposViaeliasfano(esr);
       default:
        fprintf(stderr, "%s(%d) undefined\n", __func__, (int) sat);
        exit(GT_EXIT_PROGRAMMING_ERROR);
@@ -6329,6 +7338,13 @@ unsigned int gt_encseq_lcpofdifferenttwobitencodings(GtTwobitencoding tbe1,
                                 requiredUIntBits(tbe1 ^ tbe2));
 }
 
+unsigned int gt_encseq_lcsofdifferenttwobitencodings(GtTwobitencoding tbe1,
+                                                      GtTwobitencoding tbe2)
+{
+  gt_assert((tbe1 ^ tbe2) > 0);
+  return (unsigned int) GT_DIV2(numberoftrailingzeros(tbe1 ^ tbe2));
+}
+
 static int suffixofdifferenttwobitencodings(bool complement,
                                             GtCommonunits *commonunits,
                                             GtTwobitencoding tbe1,
@@ -7417,6 +8433,36 @@ static GtUword *initcharacterdistribution(const GtAlphabet *alpha)
   return characterdistribution;
 }
 
+/* Stores the separator positions of <encseq>, which must have its ssptab,
+   in Elias-Fano representation in the .sef table and keeps them in <encseq>
+   for the following queries. */
+static int flushseftab2file(const char *indexname,
+                            GtEncseq *encseq,
+                            GtError *err)
+{
+  GtEliasFano *seftab;
+  GtUword seqnum;
+  FILE *fp;
+  bool haserr = false;
+
+  gt_error_check(err);
+  gt_assert(encseq->seftab == NULL && encseq->numofdbsequences > 1UL);
+  seftab = gt_elias_fano_new(encseq->numofdbsequences - 1,
+                             encseq->totallength);
+  for (seqnum = 1UL; seqnum < encseq->numofdbsequences; seqnum++) {
+    gt_elias_fano_add(seftab,
+                      gt_encseq_seqstartpos_viautables(encseq, seqnum) - 1);
+  }
+  fp = gt_fa_fopen_with_suffix(indexname, GT_SEFTABFILESUFFIX, "wb", err);
+  if (fp == NULL)
+    haserr = true;
+  if (!haserr && gt_elias_fano_write(seftab, fp, err) != 0)
+    haserr = true;
+  gt_fa_xfclose(fp);
+  encseq->seftab = seftab;
+  return haserr ? -1 : 0;
+}
+
 static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
                                           const char *indexname,
                                           const GtStr *str_smap,
@@ -7428,6 +8474,7 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
                                           bool outdestab,
                                           bool outsdstab,
                                           bool outssptab,
+                                          bool outseftab,
                                           bool outoistab,
                                           bool outmd5tab,
                                           bool esq_no_header,
@@ -7442,7 +8489,7 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
   GtAlphabet *alphabet = NULL;
   bool alphabetisbound = false, customalphabet = false;
   GtFilelengthvalues *filelengthtab = NULL;
-  GtUword totallength = 0, specialrangestab[3], wildcardrangestab[3],
+  GtUword totallength = 0, specialrangestab[4], wildcardrangestab[4],
                 numofseparators = 0,
                 *characterdistribution = NULL,
                 *classstartpositions = NULL,
@@ -7458,6 +8505,7 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
                                       length and no WILDCARD appears in the
                                       sequence */
   GtEncseqAccessType sat = GT_ACCESS_TYPE_UNDEFINED;
+  GtEncseqPrescan *prescan = NULL;
   char *allchars = NULL,
        *maxchars = NULL;
 
@@ -7495,6 +8543,13 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
     classstartpositions = gt_calloc((size_t) UCHAR_MAX,
                                     sizeof (*classstartpositions));
     memset(&subsymbolmap, 0, ((size_t) UCHAR_MAX+1) * sizeof (unsigned char));
+    /* the exception table needs the original characters, so the input
+       is read again in this case */
+    if (gt_alphabet_num_of_chars(alphabet) == GT_DNAALPHASIZE && !outoistab &&
+        (gt_str_length(str_sat) == 0 ||
+         gt_encseq_prescan_applicable(
+                              gt_encseq_access_type_get(gt_str_get(str_sat)))))
+      prescan = gt_encseq_prescan_new();
     if (gt_inputfiles2sequencekeyvalues(indexname,
                                         &totallength,
                                         &specialcharinfo,
@@ -7522,6 +8577,7 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
                                         &minseqlen,
                                         &maxseqlen,
                                         clip_desc,
+                                        prescan,
                                         logger,
                                         err) != 0) {
       char buf[BUFSIZ];
@@ -7586,11 +8642,13 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
                                    wildcardranges,
                                    minseqlen,
                                    maxseqlen,
+                                   prescan,
                                    logger,
                                    err);
     if (encseq == NULL)
       haserr = true;
   }
+  gt_encseq_prescan_delete(prescan);
   if (!haserr) {
     alphabetisbound = true;
     if (gt_encseq_flush2file(indexname, encseq, esq_no_header, err) != 0)
@@ -7609,6 +8667,23 @@ static GtEncseq* gt_encseq_new_from_files(GtTimer *sfxprogress,
         haserr = true;
     }
   }
+  if (!haserr) {
+    gt_assert(encseq != NULL);
+    if (outseftab && encseq->satsep != GT_ACCESS_TYPE_UNDEFINED) {
+      if (flushseftab2file(indexname, encseq, err) != 0)
+        haserr = true;
+    }
+    else {
+      /* a table left from a previous encoding would not match */
+      if (gt_file_exists_with_suffix(indexname, GT_SEFTABFILESUFFIX)) {
+        GtStr *seffilename = gt_str_new_cstr(indexname);
+
+        gt_str_append_cstr(seffilename, GT_SEFTABFILESUFFIX);
+        gt_xremove(gt_str_get(seffilename));
+        gt_str_delete(seffilename);
+      }
+    }
+  }
   if (!haserr && encseq != NULL && encseq->has_exceptiontable) {
     if (flushoistab2file(indexname, encseq, err) != 0)
       haserr = true;
@@ -8058,6 +9133,7 @@ void gt_encseq_check_specialranges(const GtEncseq *encseq)
 struct GtEncseqEncoder {
   bool destab,
        ssptab,
+       seftab,
        sdstab,
        oistab,
        md5tab,
@@ -8068,6 +9144,7 @@ struct GtEncseqEncoder {
        clip_desc;
   GtStr *sat,
         *smapfile;
+  GtEncseqWorkload satworkload;
   GtLogger *logger;
   GtTimer *pt;
 };
@@ -8083,6 +9160,7 @@ GtEncseqEncoder* gt_encseq_encoder_new()
   ee->isdna = ee->isprotein = ee->isplain = false;
   ee->sat = gt_str_new();
   ee->smapfile = gt_str_new();
+  ee->satworkload = GT_ENCSEQ_WORKLOAD_UNDEFINED;
   return ee;
 }
 
@@ -8105,6 +9183,8 @@ GtEncseqEncoder* gt_encseq_encoder_new_from_options(GtEncseqOptions *opts,
     gt_encseq_encoder_create_des_tab(ee);
   if (gt_encseq_options_ssp_value(opts))
     gt_encseq_encoder_create_ssp_tab(ee);
+  if (gt_encseq_options_sef_value(opts))
+    gt_encseq_encoder_create_sef_tab(ee);
   if (gt_encseq_options_sds_value(opts))
     gt_encseq_encoder_create_sds_tab(ee);
   if (gt_encseq_options_dna_value(opts))
@@ -8127,6 +9207,10 @@ GtEncseqEncoder* gt_encseq_encoder_new_from_options(GtEncseqOptions *opts,
     had_err = gt_encseq_encoder_use_representation(ee,
                                   gt_str_get(gt_encseq_options_sat_value(opts)),
                                   err);
+  if (!had_err && gt_str_length(gt_encseq_options_satfor_value(opts)) > 0)
+    had_err = gt_encseq_encoder_use_representation_for_workload(ee,
+                               gt_str_get(gt_encseq_options_satfor_value(opts)),
+                               err);
   if (had_err) {
     gt_encseq_encoder_delete(ee);
     ee = NULL;
@@ -8204,6 +9288,24 @@ bool gt_encseq_encoder_ssp_tab_requested(const GtEncseqEncoder *ee)
   return ee->ssptab;
 }
 
+void gt_encseq_encoder_create_sef_tab(GtEncseqEncoder *ee)
+{
+  gt_assert(ee);
+  ee->seftab = true;
+}
+
+void gt_encseq_encoder_do_not_create_sef_tab(GtEncseqEncoder *ee)
+{
+  gt_assert(ee);
+  ee->seftab = false;
+}
+
+bool gt_encseq_encoder_sef_tab_requested(const GtEncseqEncoder *ee)
+{
+  gt_assert(ee);
+  return ee->seftab;
+}
+
 void gt_encseq_encoder_create_sds_tab(GtEncseqEncoder *ee)
 {
   gt_assert(ee);
@@ -8371,6 +9473,21 @@ GtStr* gt_encseq_encoder_representation(const GtEncseqEncoder *ee)
   return ee->sat;
 }
 
+int gt_encseq_encoder_use_representation_for_workload(GtEncseqEncoder *ee,
+                                                       const char *workload,
+                                                       GtError *err)
+{
+  gt_assert(ee && workload);
+  ee->satworkload = gt_encseq_workload_get(workload);
+  if (ee->satworkload == GT_ENCSEQ_WORKLOAD_UNDEFINED) {
+    gt_error_set(err, "undefined workload: '%s', must be one of the "
+                      "following keywords: %s", workload,
+                      gt_encseq_workload_list());
+    return -1;
+  }
+  return 0;
+}
+
 int gt_encseq_encoder_use_symbolmap_file(GtEncseqEncoder *ee, const char *smap,
                                          GT_UNUSED GtError *err)
 {
@@ -8393,28 +9510,139 @@ void gt_encseq_encoder_set_logger(GtEncseqEncoder *ee, GtLogger *l)
   ee->logger = l;
 }
 
+static GtEncseq* gt_encseq_encoder_encode_with_sat(GtEncseqEncoder *ee,
+                                                   const GtStr *sat,
+                                                   GtStrArray *seqfiles,
+                                                   const char *indexname,
+                                                   GtError *err)
+{
+  return gt_encseq_new_from_files(ee->pt,
+                                  indexname,
+                                  ee->smapfile,
+                                  sat,
+                                  seqfiles,
+                                  ee->isdna,
+                                  ee->isprotein,
+                                  ee->isplain,
+                                  ee->destab,
+                                  ee->sdstab,
+                                  ee->ssptab,
+                                  ee->seftab,
+                                  ee->oistab,
+                                  ee->md5tab,
+                                  ee->esq_no_header,
+                                  ee->clip_desc,
+                                  ee->logger,
+                                  err);
+}
+
+/* Encodes <seqfiles> in each representation, runs the workload of <ee> on
+   the index as it is loaded by the tools and keeps the fastest one. The
+   first encoding uses the smallest representation, so errors in the input
+   are reported as usual. Representations which are not applicable to the
+   input are skipped. */
+static int gt_encseq_encoder_encode_fastest(GtEncseqEncoder *ee,
+                                            GtStrArray *seqfiles,
+                                            const char *indexname,
+                                            GtError *err)
+{
+  GtEncseqAccessType fastestsat = GT_ACCESS_TYPE_UNDEFINED,
+                     smallestsat = GT_ACCESS_TYPE_UNDEFINED,
+                     lastsat = GT_ACCESS_TYPE_UNDEFINED;
+  GtEncseqLoader *el;
+  GtStr *satstr;
+  double fastesttime = 0.0;
+  int had_err = 0, candidate;
+  gt_assert(ee->satworkload != GT_ENCSEQ_WORKLOAD_UNDEFINED);
+
+  el = gt_encseq_loader_new();
+  gt_encseq_loader_disable_autosupport(el);
+  gt_encseq_loader_do_not_require_des_tab(el);
+  gt_encseq_loader_do_not_require_sds_tab(el);
+  if (ee->ssptab)
+    gt_encseq_loader_require_ssp_tab(el);
+  satstr = gt_str_new();
+  /* candidate -1 is the smallest representation */
+  for (candidate = -1; !had_err && candidate < (int) GT_ACCESS_TYPE_UNDEFINED;
+       candidate++) {
+    GtEncseq *encseq;
+    if (candidate >= 0 && (GtEncseqAccessType) candidate == smallestsat)
+      continue;
+    gt_str_reset(satstr);
+    if (candidate >= 0)
+      gt_str_append_cstr(satstr,
+                         gt_encseq_access_type_str((GtEncseqAccessType)
+                                                   candidate));
+    encseq = gt_encseq_encoder_encode_with_sat(ee, satstr, seqfiles,
+                                               indexname, err);
+    if (encseq == NULL) {
+      if (candidate >= 0) {
+        /* the index files may be partly overwritten now */
+        gt_error_unset(err);
+        lastsat = GT_ACCESS_TYPE_UNDEFINED;
+        continue;
+      }
+      had_err = -1;
+      break;
+    }
+    lastsat = encseq->sat;
+    if (candidate < 0)
+      smallestsat = lastsat;
+    gt_encseq_delete(encseq);
+    if (!(encseq = gt_encseq_loader_load(el, indexname, err)))
+      had_err = -1;
+    else {
+      if (gt_encseq_total_length(encseq) == 0 ||
+          !gt_encseq_workload_applicable(encseq, ee->satworkload)) {
+        gt_error_set(err, "workload %s is not applicable to the input of "
+                          "index %s",
+                     gt_encseq_workload_str(ee->satworkload), indexname);
+        had_err = -1;
+      } else {
+        GtUword processed;
+        double elapsed = gt_encseq_workload_run(encseq, ee->satworkload,
+                                                GT_ENCSEQ_WORKLOAD_DEFAULT_OPS,
+                                                &processed);
+        gt_logger_log(ee->logger, "representation %s: %.3f seconds for "
+                                  "workload %s",
+                      gt_encseq_access_type_str(lastsat), elapsed,
+                      gt_encseq_workload_str(ee->satworkload));
+        if (fastestsat == GT_ACCESS_TYPE_UNDEFINED || elapsed < fastesttime) {
+          fastestsat = lastsat;
+          fastesttime = elapsed;
+        }
+      }
+      gt_encseq_delete(encseq);
+    }
+  }
+  if (!had_err && lastsat != fastestsat) {
+    GtEncseq *encseq;
+    gt_str_set(satstr, gt_encseq_access_type_str(fastestsat));
+    encseq = gt_encseq_encoder_encode_with_sat(ee, satstr, seqfiles,
+                                               indexname, err);
+    if (encseq == NULL)
+      had_err = -1;
+    gt_encseq_delete(encseq);
+  }
+  if (!had_err)
+    gt_logger_log(ee->logger, "chose representation %s for workload %s",
+                  gt_encseq_access_type_str(fastestsat),
+                  gt_encseq_workload_str(ee->satworkload));
+  gt_str_delete(satstr);
+  gt_encseq_loader_delete(el);
+  return had_err;
+}
+
 int gt_encseq_encoder_encode(GtEncseqEncoder *ee, GtStrArray *seqfiles,
                              const char *indexname, GtError *err)
 {
   GtEncseq *encseq = NULL;
   gt_assert(ee && seqfiles && indexname);
-  encseq = gt_encseq_new_from_files(ee->pt,
-                                    indexname,
-                                    ee->smapfile,
-                                    ee->sat,
-                                    seqfiles,
-                                    ee->isdna,
-                                    ee->isprotein,
-                                    ee->isplain,
-                                    ee->destab,
-                                    ee->sdstab,
-                                    ee->ssptab,
-                                    ee->oistab,
-                                    ee->md5tab,
-                                    ee->esq_no_header,
-                                    ee->clip_desc,
-                                    ee->logger,
-                                    err);
+  if (ee->satworkload != GT_ENCSEQ_WORKLOAD_UNDEFINED &&
+      gt_str_length(ee->sat) == 0)
+    return gt_encseq_encoder_encode_fastest(ee, seqfiles, indexname, err);
+  encseq = gt_encseq_encoder_encode_with_sat(ee, ee->sat, seqfiles, indexname,
+                                             err);
   if (!encseq)
     return -1;
   gt_encseq_delete(encseq);
@@ -39,6 +39,10 @@
 
 #define GT_ENCSEQ_VERSION  3
 
+/* The file suffix used for the Elias-Fano representation of the sequence
+   separator positions. */
+#define GT_SEFTABFILESUFFIX ".sef"
+
 #define GT_REVERSEPOS(TOTALLENGTH,POS) \
           ((TOTALLENGTH) - 1 - (POS))
 
@@ -61,6 +65,28 @@ GtEncseqLoader* gt_encseq_loader_new_from_options(GtEncseqOptions *opts,
 
 void gt_encseq_encoder_disable_esq_header(GtEncseqEncoder *ee);
 
+/* Enables creation of the .sef table, an Elias-Fano representation of the
+   sequence separator positions which answers <gt_encseq_seqnum()> and
+   <gt_encseq_seqstartpos()> queries in constant time. It is only created
+   along with the .ssp table and if the sequences are not all of equal
+   length. */
+void gt_encseq_encoder_create_sef_tab(GtEncseqEncoder *ee);
+/* Disables creation of the .sef table. */
+void gt_encseq_encoder_do_not_create_sef_tab(GtEncseqEncoder *ee);
+/* Returns <true> if the creation of the .sef table has been requested,
+   <false> otherwise. */
+bool gt_encseq_encoder_sef_tab_requested(const GtEncseqEncoder *ee);
+
+/* Let <ee> choose the representation by speed instead of by size: the input
+   is encoded in every applicable representation and the one which runs
+   <workload> (see <GtEncseqWorkload>) fastest is kept. A representation set
+   with <gt_encseq_encoder_use_representation()> takes precedence. Returns 0
+   on success, and a negative value if <workload> is not a valid keyword
+   (<err> is set accordingly). */
+int  gt_encseq_encoder_use_representation_for_workload(GtEncseqEncoder *ee,
+                                                       const char *workload,
+                                                       GtError *err);
+
 /* The following type stores a two bit encoding in <tbe> with information
   about the number of two bit units which do not store a special
   character in <unitsnotspecial>. To allow the comparison of these
@@ -257,6 +283,17 @@ int gt_encseq_twobitencoding_strcmp(GtCommonunits *commonunits,
                                     GtViatwobitkeyvalues *vtk1,
                                     GtViatwobitkeyvalues *vtk2);
 
+/* Stores the decoded characters from position <frompos> to <topos> of
+   <encseq> in <buffer>, like <gt_encseq_extract_decoded()>, but uses <esr>
+   instead of creating a new reader. For the twobit encoding the characters
+   are decoded bytewise by table lookup, and the special ranges are patched
+   in afterwards. */
+void gt_encseq_extract_decoded_with_reader(const GtEncseq *encseq,
+                                           GtEncseqReader *esr,
+                                           char *buffer,
+                                           GtUword frompos,
+                                           GtUword topos);
+
 bool gt_encseq_has_twobitencoding(const GtEncseq *encseq);
 
 bool gt_encseq_has_twobitencoding_stoppos_support(const GtEncseq *encseq);
@@ -320,6 +357,12 @@ int gt_encseq_compare_pairof_twobitencodings(bool fwd,
 unsigned int gt_encseq_lcpofdifferenttwobitencodings(GtTwobitencoding tbe1,
                                                       GtTwobitencoding tbe2);
 
+/* The following function compares the two bit encodings and returns the
+   length of the longest common suffix of the sequence they represent */
+
+unsigned int gt_encseq_lcsofdifferenttwobitencodings(GtTwobitencoding tbe1,
+                                                      GtTwobitencoding tbe2);
+
 /* The following function compares the two bit encodings <tbe1> and <tbe2>
   and stores the result of the comparison in <commonunits>. The comparison is
   done in forward direction iff <fwd> is true.
@@ -371,7 +414,8 @@ GtUword gt_encseq_wildcards(const GtEncseq *encseq);
 /* Return the number of ranges of consecutive runs of special characters
   where the length of each range is limited by UCHAR_MAX, USHORT_MAX, and
   UINT32_MAX, depending on whether the GT_ACCESS_TYPE_UCHARTABLES,
-  GT_ACCESS_TYPE_USHORTTABLES, GT_ACCESS_TYPE_UINT32TABLES are used */
+  GT_ACCESS_TYPE_USHORTTABLES, GT_ACCESS_TYPE_UINT32TABLES are used. For
+  GT_ACCESS_TYPE_ELIASFANO the length is not limited. */
 GtUword gt_encseq_specialranges(const GtEncseq *encseq);
 
 GtUword gt_encseq_exceptioncharacters(const GtEncseq *encseq);
@@ -383,7 +427,8 @@ GtUword gt_encseq_max_subalpha_size(const GtEncseq *encseq);
 /* Return the number of ranges of consecutive runs of wildcards
   where the length of each range is limited by UCHAR_MAX, USHORT_MAX, and
   UINT32_MAX, depending on whether the GT_ACCESS_TYPE_UCHARTABLES,
-  GT_ACCESS_TYPE_USHORTTABLES, GT_ACCESS_TYPE_UINT32TABLES are used */
+  GT_ACCESS_TYPE_USHORTTABLES, GT_ACCESS_TYPE_UINT32TABLES are used. For
+  GT_ACCESS_TYPE_ELIASFANO the length is not limited. */
 GtUword gt_encseq_wildcardranges(const GtEncseq *encseq);
 
 /* Return the number of ranges of consecutive runs of special characters */
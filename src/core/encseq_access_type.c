@@ -41,12 +41,13 @@ static GtWrittenAccessType wpa[] = {
   {GT_ACCESS_TYPE_BITACCESS, "bit"},
   {GT_ACCESS_TYPE_UCHARTABLES, "uchar"},
   {GT_ACCESS_TYPE_USHORTTABLES, "ushort"},
-  {GT_ACCESS_TYPE_UINT32TABLES, "uint32"}
+  {GT_ACCESS_TYPE_UINT32TABLES, "uint32"},
+  {GT_ACCESS_TYPE_ELIASFANO, "ef"}
 };
 
 const char* gt_encseq_access_type_list(void)
 {
-  return "direct, bytecompress, eqlen, bit, uchar, ushort, uint32";
+  return "direct, bytecompress, eqlen, bit, uchar, ushort, uint32, ef";
 }
 
 const char* gt_encseq_access_type_str(GtEncseqAccessType at)
@@ -179,6 +180,10 @@ int gt_encseq_access_type_determine(GtUword *specialranges,
           *specialranges = specialrangestab[2];
           *wildcardranges = wildcardrangestab[2];
           break;
+        case GT_ACCESS_TYPE_ELIASFANO:
+          *specialranges = specialrangestab[3];
+          *wildcardranges = wildcardrangestab[3];
+          break;
         case GT_ACCESS_TYPE_DIRECTACCESS:
         case GT_ACCESS_TYPE_BITACCESS:
           break;
@@ -33,12 +33,15 @@ typedef enum {
 struct GtEncseqOptions {
   GtStr *indexname,
         *sat,
+        *satfor,
         *smap,
         *dir;
   GtOption *optiondb,
            *optionindexname,
            *optionsat,
+           *optionsatfor,
            *optionssp,
+           *optionsef,
            *optiondes,
            *optionsds,
            *optionlossless,
@@ -54,6 +57,7 @@ struct GtEncseqOptions {
   GtStrArray *db;
   bool des,
        ssp,
+       sef,
        sds,
        lossless,
        dna,
@@ -72,11 +76,13 @@ static GtEncseqOptions* gt_encseq_options_new(void)
   GtEncseqOptions *oi = gt_malloc(sizeof *oi);
   oi->indexname = gt_str_new();
   oi->sat = gt_str_new();
+  oi->satfor = gt_str_new();
   oi->smap = gt_str_new();
   oi->dir = gt_str_new();
   oi->db = gt_str_array_new();
   oi->des = false;
   oi->ssp = false;
+  oi->sef = false;
   oi->sds = false;
   oi->md5 = false;
   oi->lossless = false;
@@ -87,7 +93,9 @@ static GtEncseqOptions* gt_encseq_options_new(void)
   oi->optiondb = NULL;
   oi->optionindexname = NULL;
   oi->optionsat = NULL;
+  oi->optionsatfor = NULL;
   oi->optionssp = NULL;
+  oi->optionsef = NULL;
   oi->optiondes = NULL;
   oi->optionlossless = NULL;
   oi->optionsds = NULL;
@@ -141,6 +149,12 @@ static int gt_encseq_options_check(void *oip, GtError *err)
       had_err = -1;
     }
   }
+  if (!had_err) {
+    if (!oi->ssp && oi->sef) {
+      gt_error_set(err, "option \"-sef yes\" requires \"-ssp yes\"");
+      had_err = -1;
+    }
+  }
   if (!had_err) {
     if (oi->optionplain != NULL && gt_option_is_set(oi->optionplain)) {
       if (oi->optiondna != NULL && !gt_option_is_set(oi->optiondna) &&
@@ -194,6 +208,16 @@ gt_encseq_options_register_generic(GtOptionParser *op,
                                        true);
     gt_option_parser_add_option(op, oi->optionssp);
 
+    oi->optionsef = gt_option_new_bool("sef",
+                                       "output sequence separator positions "
+                                       "in Elias-Fano representation to "
+                                       "file, for constant time lookup of "
+                                       "sequence numbers",
+                                       &oi->sef,
+                                       false);
+    gt_option_parser_add_option(op, oi->optionsef);
+    gt_option_is_extended_option(oi->optionsef);
+
     oi->optiondes = gt_option_new_bool("des",
                                        "output sequence descriptions to file",
                                        &oi->des,
@@ -226,10 +250,24 @@ gt_encseq_options_register_generic(GtOptionParser *op,
                                          "representation\n"
                                          "by one of the keywords direct, "
                                          "bytecompress, eqlen, bit, uchar, "
-                                         "ushort, uint32",
+                                         "ushort, uint32, ef",
                                          oi->sat, NULL);
     gt_option_parser_add_option(op, oi->optionsat);
 
+    oi->optionsatfor = gt_option_new_string("satfor",
+                                            "choose the sequence "
+                                            "representation which runs the "
+                                            "given workload fastest instead "
+                                            "of the smallest one\n"
+                                            "by one of the keywords "
+                                            "sequential, random, range, "
+                                            "seqnum, seqstartpos, "
+                                            "specialranges",
+                                            oi->satfor, NULL);
+    gt_option_parser_add_option(op, oi->optionsatfor);
+    gt_option_is_extended_option(oi->optionsatfor);
+    gt_option_exclude(oi->optionsat, oi->optionsatfor);
+
     oi->optiondna = gt_option_new_bool("dna","input is DNA sequence",
                                        &oi->dna, false);
     gt_option_parser_add_option(op, oi->optiondna);
@@ -362,7 +400,9 @@ GT_ENCSEQ_OPTS_GETTER_DEF(mirrored, bool);
 GT_ENCSEQ_OPTS_GETTER_DEF(plain, bool);
 GT_ENCSEQ_OPTS_GETTER_DEF(protein, bool);
 GT_ENCSEQ_OPTS_GETTER_DEF(sat, GtStr*);
+GT_ENCSEQ_OPTS_GETTER_DEF(satfor, GtStr*);
 GT_ENCSEQ_OPTS_GETTER_DEF(sds, bool);
+GT_ENCSEQ_OPTS_GETTER_DEF(sef, bool);
 GT_ENCSEQ_OPTS_GETTER_DEF(smap, GtStr*);
 GT_ENCSEQ_OPTS_GETTER_DEF(ssp, bool);
 GT_ENCSEQ_OPTS_GETTER_DEF(tis, bool);
@@ -375,6 +415,7 @@ void gt_encseq_options_delete(GtEncseqOptions *oi)
   gt_str_delete(oi->indexname);
   gt_str_delete(oi->smap);
   gt_str_delete(oi->sat);
+  gt_str_delete(oi->satfor);
   gt_str_delete(oi->dir);
   gt_str_array_delete(oi->db);
   if (!oi->withdb) {
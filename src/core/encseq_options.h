@@ -74,7 +74,9 @@ GT_ENCSEQ_OPTS_GETTER_DECL(mirrored, bool);
 GT_ENCSEQ_OPTS_GETTER_DECL(plain, bool);
 GT_ENCSEQ_OPTS_GETTER_DECL(protein, bool);
 GT_ENCSEQ_OPTS_GETTER_DECL(sat, GtStr*);
+GT_ENCSEQ_OPTS_GETTER_DECL(satfor, GtStr*);
 GT_ENCSEQ_OPTS_GETTER_DECL(sds, bool);
+GT_ENCSEQ_OPTS_GETTER_DECL(sef, bool);
 GT_ENCSEQ_OPTS_GETTER_DECL(smap, GtStr*);
 GT_ENCSEQ_OPTS_GETTER_DECL(ssp, bool);
 GT_ENCSEQ_OPTS_GETTER_DECL(tis, bool);
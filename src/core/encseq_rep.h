@@ -25,6 +25,7 @@
   implementation detail.
 */
 
+#include <limits.h>
 #include "core/alphabet.h"
 #include "core/bitpackarray.h"
 #include "core/chardef.h"
@@ -36,6 +37,7 @@
 #include "core/types_api.h"
 #include "core/str_array_api.h"
 #include "core/defined-types.h"
+#include "core/elias_fano.h"
 #include "core/types_api.h"
 #include "core/thread_api.h"
 
@@ -79,6 +81,13 @@ typedef union
   GtSWtable_uint32 st_uint32;
 } GtSWtable;
 
+typedef struct
+{
+  GtEliasFano *starts, /* start positions of the maximal ranges */
+              *ends;   /* end positions plus one of the maximal ranges */
+  GtUword numofranges;
+} GtEFrangetable;
+
 typedef struct
 {
   GtUchar *is64bitptr;
@@ -167,9 +176,16 @@ struct GtEncseq
   char *alphadef;
   GtUword lengthofalphadef,
                 alphatype;
+  /* decoded character for each encoded character and the four decoded
+     characters for each byte of the twobit encoding, for bulk decoding */
+  char decodetab[UCHAR_MAX+1],
+       twobitdecodetab[UCHAR_MAX+1][4];
 
   /* separator index structure */
   GtSWtable ssptab;
+  /* NULL or the separator positions in Elias-Fano representation, which
+     take precedence over <ssptab> for seqnum and seqstartpos queries */
+  GtEliasFano *seftab;
 
   /* file start position table */
   GtUword *fsptab; /* is NULL when numofdbfiles is 1
@@ -179,7 +195,8 @@ struct GtEncseq
               GT_ACCESS_TYPE_BITACCESS,
               GT_ACCESS_TYPE_UCHARTABLES,
               GT_ACCESS_TYPE_USHORTTABLES,
-              GT_ACCESS_TYPE_UINT32TABLES */
+              GT_ACCESS_TYPE_UINT32TABLES,
+              GT_ACCESS_TYPE_ELIASFANO */
   GtTwobitencoding *twobitencoding;
   GtUword unitsoftwobitencoding;
 
@@ -199,6 +216,9 @@ struct GtEncseq
               GT_ACCESS_TYPE_UINT32TABLES */
   GtSWtable wildcardrangetable;
 
+  /* only for GT_ACCESS_TYPE_ELIASFANO */
+  GtEFrangetable efwildcardranges;
+
   /* for lossless reproduction of original sequences */
   bool has_exceptiontable;
   GtSWtable exceptiontable;
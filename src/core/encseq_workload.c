@@ -0,0 +1,183 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <string.h>
+#include <sys/time.h>
+#include "core/assert_api.h"
+#include "core/encseq.h"
+#include "core/encseq_workload.h"
+#include "core/ma.h"
+
+typedef struct
+{
+  GtEncseqWorkload workload;
+  char *name;
+} GtWrittenWorkload;
+
+static GtWrittenWorkload wwl[] = {
+  {GT_ENCSEQ_WORKLOAD_SEQUENTIAL, "sequential"},
+  {GT_ENCSEQ_WORKLOAD_RANDOM, "random"},
+  {GT_ENCSEQ_WORKLOAD_RANGE, "range"},
+  {GT_ENCSEQ_WORKLOAD_SEQNUM, "seqnum"},
+  {GT_ENCSEQ_WORKLOAD_SEQSTARTPOS, "seqstartpos"},
+  {GT_ENCSEQ_WORKLOAD_SPECIALRANGES, "specialranges"}
+};
+
+const char* gt_encseq_workload_list(void)
+{
+  return "sequential, random, range, seqnum, seqstartpos, specialranges";
+}
+
+const char* gt_encseq_workload_str(GtEncseqWorkload workload)
+{
+  gt_assert((int) workload < (int) GT_ENCSEQ_WORKLOAD_UNDEFINED);
+  return wwl[workload].name;
+}
+
+GtEncseqWorkload gt_encseq_workload_get(const char *str)
+{
+  size_t i;
+
+  for (i = 0; i < sizeof (wwl)/sizeof (wwl[0]); i++)
+  {
+    gt_assert(wwl[i].workload == (GtEncseqWorkload) i);
+    if (strcmp(str,wwl[i].name) == 0)
+    {
+      return wwl[i].workload;
+    }
+  }
+  return GT_ENCSEQ_WORKLOAD_UNDEFINED;
+}
+
+bool gt_encseq_workload_applicable(const GtEncseq *encseq,
+                                   GtEncseqWorkload workload)
+{
+  gt_assert(encseq != NULL);
+  switch (workload)
+  {
+    case GT_ENCSEQ_WORKLOAD_SEQNUM:
+    case GT_ENCSEQ_WORKLOAD_SEQSTARTPOS:
+      return gt_encseq_num_of_sequences(encseq) == 1UL ||
+             gt_encseq_has_multiseq_support(encseq);
+    case GT_ENCSEQ_WORKLOAD_SPECIALRANGES:
+      return gt_encseq_has_specialranges(encseq);
+    default:
+      return true;
+  }
+}
+
+/* xorshift generator with a fixed seed, so that all access types are
+   measured at the same positions */
+static GtUword workload_next_random(GtUword *state, GtUword bound)
+{
+  *state ^= *state << 13;
+  *state ^= *state >> 7;
+  *state ^= *state << 17;
+  return *state % bound;
+}
+
+static double workload_seconds(void)
+{
+  struct timeval tv;
+
+  gettimeofday(&tv, NULL);
+  return (double) tv.tv_sec + (double) tv.tv_usec / 1e6;
+}
+
+double gt_encseq_workload_run(const GtEncseq *encseq,
+                              GtEncseqWorkload workload,
+                              GtUword numofops,
+                              GtUword *processed)
+{
+  GtUword idx, state = 88172645463325252ULL,
+          totallength = gt_encseq_total_length(encseq),
+          numofsequences = gt_encseq_num_of_sequences(encseq);
+  double start;
+
+  gt_assert(gt_encseq_workload_applicable(encseq, workload) &&
+            totallength > 0 && processed != NULL);
+  *processed = 0;
+  start = workload_seconds();
+  switch (workload)
+  {
+    case GT_ENCSEQ_WORKLOAD_SEQUENTIAL:
+      {
+        GtEncseqReader *esr
+          = gt_encseq_create_reader_with_readmode(encseq,
+                                                  GT_READMODE_FORWARD, 0);
+        for (idx = 0; idx < totallength; idx++)
+          (void) gt_encseq_reader_next_encoded_char(esr);
+        gt_encseq_reader_delete(esr);
+        *processed = totallength;
+      }
+      break;
+    case GT_ENCSEQ_WORKLOAD_RANDOM:
+      for (idx = 0; idx < numofops; idx++)
+      {
+        GtUword pos = workload_next_random(&state, totallength);
+        (void) gt_encseq_get_encoded_char(encseq, pos, GT_READMODE_FORWARD);
+      }
+      *processed = numofops;
+      break;
+    case GT_ENCSEQ_WORKLOAD_RANGE:
+      {
+        GtUword rangelength = totallength < GT_ENCSEQ_WORKLOAD_RANGELENGTH
+                              ? totallength : GT_ENCSEQ_WORKLOAD_RANGELENGTH;
+        GtUword numofranges = numofops / rangelength > 0
+                              ? numofops / rangelength : 1UL;
+        GtUchar *buffer = gt_malloc(sizeof (*buffer) * rangelength);
+
+        for (idx = 0; idx < numofranges; idx++)
+        {
+          GtUword pos = workload_next_random(&state,
+                                             totallength - rangelength + 1);
+          gt_encseq_extract_encoded(encseq, buffer, pos, pos + rangelength - 1);
+        }
+        gt_free(buffer);
+        *processed = numofranges * rangelength;
+      }
+      break;
+    case GT_ENCSEQ_WORKLOAD_SEQNUM:
+      for (idx = 0; idx < numofops; idx++)
+      {
+        GtUword pos = workload_next_random(&state, totallength);
+        (void) gt_encseq_seqnum(encseq, pos);
+      }
+      *processed = numofops;
+      break;
+    case GT_ENCSEQ_WORKLOAD_SEQSTARTPOS:
+      for (idx = 0; idx < numofops; idx++)
+      {
+        GtUword seqnum = workload_next_random(&state, numofsequences);
+        (void) gt_encseq_seqstartpos(encseq, seqnum);
+      }
+      *processed = numofops;
+      break;
+    case GT_ENCSEQ_WORKLOAD_SPECIALRANGES:
+      {
+        GtRange range;
+        GtSpecialrangeiterator *sri = gt_specialrangeiterator_new(encseq,
+                                                                  true);
+        while (gt_specialrangeiterator_next(sri, &range))
+          (*processed)++;
+        gt_specialrangeiterator_delete(sri);
+      }
+      break;
+    default:
+      gt_assert(false);
+  }
+  return workload_seconds() - start;
+}
@@ -0,0 +1,64 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef ENCSEQ_WORKLOAD_H
+#define ENCSEQ_WORKLOAD_H
+
+#include <stdbool.h>
+#include "core/encseq_api.h"
+
+/* Typical access patterns on a <GtEncseq>, used to measure how fast an
+   access type serves them. */
+typedef enum
+{
+  GT_ENCSEQ_WORKLOAD_SEQUENTIAL,    /* read all characters with a reader */
+  GT_ENCSEQ_WORKLOAD_RANDOM,        /* extract single characters */
+  GT_ENCSEQ_WORKLOAD_RANGE,         /* extract substrings */
+  GT_ENCSEQ_WORKLOAD_SEQNUM,        /* map positions to sequence numbers */
+  GT_ENCSEQ_WORKLOAD_SEQSTARTPOS,   /* map sequence numbers to positions */
+  GT_ENCSEQ_WORKLOAD_SPECIALRANGES, /* iterate over all special ranges */
+  GT_ENCSEQ_WORKLOAD_UNDEFINED
+} GtEncseqWorkload;
+
+/* Number of random operations performed by default. */
+#define GT_ENCSEQ_WORKLOAD_DEFAULT_OPS  1000000UL
+
+/* Length of the substrings extracted by <GT_ENCSEQ_WORKLOAD_RANGE>. */
+#define GT_ENCSEQ_WORKLOAD_RANGELENGTH  1000UL
+
+GtEncseqWorkload gt_encseq_workload_get(const char *str);
+const char*      gt_encseq_workload_str(GtEncseqWorkload workload);
+const char*      gt_encseq_workload_list(void);
+
+/* Returns true if <workload> can be run on <encseq>. The sequence number
+   workloads need multiseq support, <GT_ENCSEQ_WORKLOAD_SPECIALRANGES> needs
+   special characters. */
+bool             gt_encseq_workload_applicable(const GtEncseq *encseq,
+                                               GtEncseqWorkload workload);
+
+/* Runs <workload> on <encseq> and returns the elapsed time in seconds. The
+   random workloads perform <numofops> operations at positions drawn from a
+   fixed seed, so each run on the same sequence does the same work. For
+   <GT_ENCSEQ_WORKLOAD_RANGE>, an operation is the extraction of one
+   character of a substring. The sequential and special range workloads make
+   one pass over the whole sequence. The number of characters, ranges or
+   lookups processed is stored in <processed>. */
+double           gt_encseq_workload_run(const GtEncseq *encseq,
+                                        GtEncseqWorkload workload,
+                                        GtUword numofops,
+                                        GtUword *processed);
+
+#endif
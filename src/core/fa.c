@@ -17,12 +17,16 @@
 
 #ifndef _WIN32
 #include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/time.h>
 #else
 #include <windows.h>
 #endif
 #include <fcntl.h>
+#include <string.h>
 #include <unistd.h>
 #include "core/compat.h"
+#include "core/cstr_api.h"
 #include "core/dynalloc.h"
 #include "core/eansi.h"
 #include "core/ebzlib.h"
@@ -30,6 +34,7 @@
 #include "core/hashmap.h"
 #include "core/fa.h"
 #include "core/ma.h"
+#include "core/multithread_api.h"
 #include "core/spacepeak.h"
 #include "core/thread_api.h"
 #include "core/types_api.h"
@@ -40,6 +45,19 @@
 #include "core/xposix.h"
 #include "core/xzlib.h"
 
+#define GT_FA_NUM_OF_MAP_POLICIES  (GT_FA_MAP_WARMUP + 1)
+
+/* number of bytes of a memory map touched at once during the warm-up */
+#define GT_FA_WARMUP_CHUNKSIZE     ((size_t) 1 << 24)
+
+static const char *map_policy_names[GT_FA_NUM_OF_MAP_POLICIES] =
+  {"default", "willneed", "populate", "hugepage", "warmup"};
+
+typedef struct {
+  char *indexname;
+  GtFaMapPolicy policy;
+} FAIndexMapPolicy;
+
 /* the file allocator class */
 typedef struct {
   GtMutex *file_mutex,
@@ -49,6 +67,17 @@ typedef struct {
   GtUword current_size,
                 max_size;
   bool global_space_peak;
+  /* mapping policies */
+  GtFaMapPolicy map_policy;
+  FAIndexMapPolicy *index_map_policies;
+  GtUword num_of_index_map_policies;
+  /* mapping statistics */
+  bool map_stats;
+  GtUword mapped_files[GT_FA_NUM_OF_MAP_POLICIES],
+          mapped_bytes[GT_FA_NUM_OF_MAP_POLICIES],
+          warmup_minflt,
+          warmup_majflt;
+  double warmup_time;
 } FA;
 
 static FA *fa = NULL;
@@ -94,6 +123,7 @@ void gt_fa_init(void)
   fa->memory_maps = gt_hashmap_new(GT_HASH_DIRECT, NULL,
                                    (GtFree) free_FAMapInfo);
   fa->global_space_peak = false;
+  fa->map_policy = GT_FA_MAP_DEFAULT;
 }
 
 static void* fileopen_generic(FA *fa, const char *path, const char *mode,
@@ -380,6 +410,138 @@ FILE* gt_xtmpfp_generic_func(GtStr *template_arg, enum tmpfp_flags flags,
   return fp;
 }
 
+int gt_fa_set_map_policy(const char *spec, GtError *err)
+{
+  const char *colon;
+  size_t namelen;
+  int policy;
+  gt_error_check(err);
+  gt_assert(fa && spec);
+  colon = strchr(spec, ':');
+  namelen = colon != NULL ? (size_t) (colon - spec) : strlen(spec);
+  for (policy = 0; policy < GT_FA_NUM_OF_MAP_POLICIES; policy++) {
+    if (strlen(map_policy_names[policy]) == namelen &&
+        strncmp(spec, map_policy_names[policy], namelen) == 0)
+      break;
+  }
+  if (policy == GT_FA_NUM_OF_MAP_POLICIES) {
+    gt_error_set(err, "unknown mapping policy \"%s\", must be one of "
+                      "default, willneed, populate, hugepage or warmup", spec);
+    return -1;
+  }
+  if (colon == NULL) {
+    fa->map_policy = (GtFaMapPolicy) policy;
+    return 0;
+  }
+  if (colon[1] == '\0') {
+    gt_error_set(err, "missing index name in mapping policy \"%s\"", spec);
+    return -1;
+  }
+  fa->index_map_policies
+    = gt_realloc(fa->index_map_policies,
+                 sizeof (*fa->index_map_policies) *
+                 (fa->num_of_index_map_policies + 1));
+  fa->index_map_policies[fa->num_of_index_map_policies].indexname
+    = gt_cstr_dup(colon + 1);
+  fa->index_map_policies[fa->num_of_index_map_policies].policy
+    = (GtFaMapPolicy) policy;
+  fa->num_of_index_map_policies++;
+  return 0;
+}
+
+/* Returns the policy for mapping <filename>. The policy given last for an
+   index <filename> belongs to wins. */
+static GtFaMapPolicy map_policy_for_file(const char *filename)
+{
+  GtUword idx;
+  for (idx = fa->num_of_index_map_policies; idx > 0; idx--) {
+    const FAIndexMapPolicy *entry = fa->index_map_policies + idx - 1;
+    size_t len = strlen(entry->indexname);
+    if (strncmp(filename, entry->indexname, len) == 0 && filename[len] == '.')
+      return entry->policy;
+  }
+  return fa->map_policy;
+}
+
+#ifndef _WIN32
+typedef struct {
+  const char *map;
+  size_t len,
+         pagesize,
+         nextchunk;
+  GtMutex *mutex;
+} FAWarmupInfo;
+
+static void* warmup_thread(void *data)
+{
+  FAWarmupInfo *info = data;
+  volatile char touched = 0;
+  size_t start, end, offset;
+  for (;;) {
+    gt_mutex_lock(info->mutex);
+    start = info->nextchunk;
+    end = info->len - start < GT_FA_WARMUP_CHUNKSIZE
+          ? info->len : start + GT_FA_WARMUP_CHUNKSIZE;
+    info->nextchunk = end;
+    gt_mutex_unlock(info->mutex);
+    if (start == end)
+      break;
+    /* reading one byte of each page faults it in */
+    for (offset = start; offset < end; offset += info->pagesize)
+      touched ^= info->map[offset];
+  }
+  return NULL;
+}
+
+/* Touches all pages of <map> in chunks, which are spread over <gt_jobs>
+   threads. */
+static void warmup_map(const void *map, size_t len)
+{
+  FAWarmupInfo info;
+  GtError *err;
+  long pagesize = sysconf(_SC_PAGESIZE);
+  info.map = map;
+  info.len = len;
+  info.pagesize = pagesize > 0 ? (size_t) pagesize : (size_t) 4096;
+  info.nextchunk = 0;
+  info.mutex = gt_mutex_new();
+  err = gt_error_new();
+  /* if no threads can be started, the pages are touched sequentially */
+  if (gt_jobs == 1U || len <= GT_FA_WARMUP_CHUNKSIZE ||
+      gt_multithread(warmup_thread, &info, err) != 0) {
+    (void) warmup_thread(&info);
+  }
+  gt_error_delete(err);
+  gt_mutex_delete(info.mutex);
+}
+
+static void apply_map_policy(void *map, size_t len, GtFaMapPolicy policy)
+{
+  switch (policy) {
+    case GT_FA_MAP_HUGEPAGE:
+#ifdef MADV_HUGEPAGE
+      (void) madvise(map, len, MADV_HUGEPAGE);
+#endif
+      /* fall through */
+    case GT_FA_MAP_WILLNEED:
+#ifdef MADV_WILLNEED
+      (void) madvise(map, len, MADV_WILLNEED);
+#endif
+      break;
+    case GT_FA_MAP_POPULATE:
+#ifndef MAP_POPULATE
+      warmup_map(map, len);
+#endif
+      break;
+    case GT_FA_MAP_WARMUP:
+      warmup_map(map, len);
+      break;
+    default:
+      break;
+  }
+}
+#endif
+
 void* gt_fa_mmap_generic_fd_func(GT_UNUSED int fd, const char *filename,
                                  size_t len, GT_UNUSED size_t offset,
                                  bool mapwritable, bool hard_fail,
@@ -388,25 +550,58 @@ void* gt_fa_mmap_generic_fd_func(GT_UNUSED int fd, const char *filename,
 {
   FAMapInfo *mapinfo;
   void *map = NULL;
+  GtFaMapPolicy policy;
+#ifndef _WIN32
+  int flags = MAP_SHARED;
+  struct timeval warmup_start;
+  struct rusage usage_start;
+#endif
   gt_error_check(err);
   gt_assert(fa);
   mapinfo = gt_calloc(1, sizeof *mapinfo);
   mapinfo->src_file = src_file;
   mapinfo->src_line = src_line;
   mapinfo->len = len;
+  policy = mapwritable ? GT_FA_MAP_DEFAULT : map_policy_for_file(filename);
 
 #ifndef _WIN32
+  if (fa->map_stats && policy != GT_FA_MAP_DEFAULT) {
+    gettimeofday(&warmup_start, NULL);
+    (void) getrusage(RUSAGE_SELF, &usage_start);
+  }
+#ifdef MAP_POPULATE
+  if (policy == GT_FA_MAP_POPULATE)
+    flags |= MAP_POPULATE;
+#endif
   if (hard_fail) {
     map = gt_xmmap(0, len, PROT_READ | (mapwritable ? PROT_WRITE : 0),
-                   MAP_SHARED, fd, offset);
+                   flags, fd, offset);
   }
   else {
     if ((map = mmap(0, len, PROT_READ | (mapwritable ? PROT_WRITE : 0),
-                    MAP_SHARED, fd, offset)) == MAP_FAILED) {
+                    flags, fd, offset)) == MAP_FAILED) {
       gt_error_set(err,"cannot map file \"%s\": %s", filename, strerror(errno));
       map = NULL;
     }
   }
+  if (map != NULL && policy != GT_FA_MAP_DEFAULT) {
+    apply_map_policy(map, len, policy);
+    if (fa->map_stats) {
+      struct timeval warmup_end;
+      struct rusage usage_end;
+      gettimeofday(&warmup_end, NULL);
+      (void) getrusage(RUSAGE_SELF, &usage_end);
+      gt_mutex_lock(fa->mmap_mutex);
+      fa->warmup_time += (double) (warmup_end.tv_sec - warmup_start.tv_sec)
+                         + (double) (warmup_end.tv_usec - warmup_start.tv_usec)
+                           / 1000000.0;
+      fa->warmup_minflt += (GtUword) (usage_end.ru_minflt
+                                      - usage_start.ru_minflt);
+      fa->warmup_majflt += (GtUword) (usage_end.ru_majflt
+                                      - usage_start.ru_majflt);
+      gt_mutex_unlock(fa->mmap_mutex);
+    }
+  }
 #else
   mapinfo->filehandle = CreateFile(filename,
                                    mapwritable ? GENERIC_READ | GENERIC_WRITE
@@ -455,6 +650,10 @@ void* gt_fa_mmap_generic_fd_func(GT_UNUSED int fd, const char *filename,
       gt_spacepeak_add(mapinfo->len);
     if (fa->current_size > fa->max_size)
       fa->max_size = fa->current_size;
+    if (fa->map_stats) {
+      fa->mapped_files[policy]++;
+      fa->mapped_bytes[policy] += mapinfo->len;
+    }
     gt_mutex_unlock(fa->mmap_mutex);
   }
   else
@@ -822,9 +1021,44 @@ void gt_fa_show_space_peak(FILE *fp)
           (double) fa->max_size / (1 << 20));
 }
 
+void gt_fa_enable_map_stats(void)
+{
+  gt_assert(fa);
+  fa->map_stats = true;
+}
+
+void gt_fa_show_map_stats(FILE *fp)
+{
+  int policy;
+#ifndef _WIN32
+  struct rusage usage;
+#endif
+  gt_assert(fa);
+  for (policy = 0; policy < GT_FA_NUM_OF_MAP_POLICIES; policy++) {
+    if (fa->mapped_files[policy] > 0) {
+      fprintf(fp, "# files mapped with policy %s: "GT_WU" (%.2f megabytes)\n",
+              map_policy_names[policy], fa->mapped_files[policy],
+              (double) fa->mapped_bytes[policy] / (1 << 20));
+    }
+  }
+  fprintf(fp, "# warm-up time in seconds: %.2f\n", fa->warmup_time);
+  fprintf(fp, "# page faults during warm-up: "GT_WU" minor, "GT_WU" major\n",
+          fa->warmup_minflt, fa->warmup_majflt);
+#ifndef _WIN32
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    fprintf(fp, "# page faults in total: %ld minor, %ld major\n",
+            usage.ru_minflt, usage.ru_majflt);
+  }
+#endif
+}
+
 void gt_fa_clean(void)
 {
+  GtUword idx;
   if (!fa) return;
+  for (idx = 0; idx < fa->num_of_index_map_policies; idx++)
+    gt_free(fa->index_map_policies[idx].indexname);
+  gt_free(fa->index_map_policies);
   gt_mutex_delete(fa->file_mutex);
   gt_mutex_delete(fa->mmap_mutex);
   gt_hashmap_delete(fa->file_pointer);
@@ -174,6 +174,29 @@ void    gt_fa_enable_global_spacepeak(void);
 GtUword gt_fa_get_space_peak(void);
 GtUword gt_fa_get_space_current(void);
 void    gt_fa_show_space_peak(FILE*);
+
+/* policies for mapping files read-only into memory */
+typedef enum {
+  GT_FA_MAP_DEFAULT,  /* pages are read on first access */
+  GT_FA_MAP_WILLNEED, /* pages are read ahead in the background */
+  GT_FA_MAP_POPULATE, /* all pages are read when the file is mapped */
+  GT_FA_MAP_HUGEPAGE, /* ask for transparent huge pages, read ahead */
+  GT_FA_MAP_WARMUP    /* all pages are touched by <gt_jobs> threads when the
+                         file is mapped */
+} GtFaMapPolicy;
+
+/* Sets the mapping policy given by <spec>, which is either the name of a
+   policy (default, willneed, populate, hugepage or warmup), applying to all
+   files mapped read-only, or <name>:<indexname>, applying to the files
+   <indexname>.<suffix> only. A policy for an index takes precedence over the
+   policy for all files. Returns 0 on success, -1 otherwise. <err> is set
+   accordingly. Must be called before files are mapped by several threads. */
+int     gt_fa_set_map_policy(const char *spec, GtError *err);
+/* enable statistics about mapped files and their warm-up */
+void    gt_fa_enable_map_stats(void);
+/* show the number of mapped files per policy, the time spent to warm them up
+   and the number of page faults on <fp> */
+void    gt_fa_show_map_stats(FILE *fp);
 void    gt_fa_clean(void);
 
 #endif /* S_SPLINT_S */
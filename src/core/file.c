@@ -17,13 +17,35 @@
 
 #include <stdio.h>
 #include <string.h>
+#include "core/bgzf.h"
 #include "core/cstr_api.h"
 #include "core/fa.h"
 #include "core/ma.h"
+#include "core/minmax.h"
+#include "core/thread_api.h"
 #include "core/xansi_api.h"
 #include "core/xbzlib.h"
 #include "core/xzlib.h"
 
+/* the size of each of the two buffers of a read-ahead file */
+#define GT_FILE_READAHEAD_SIZE  (1UL << 20)
+
+/*
+  Compressed files opened for reading with more than one job are
+  decompressed by a background thread: while the caller consumes the current
+  buffer, the thread fills the other one. BGZF files are not read through
+  zlib's gzFile, but block-wise with a GtBGZFReader, which inflates its
+  blocks on all threads.
+*/
+typedef struct {
+  unsigned char *buffers[2];
+  size_t filled[2],
+         nextpos;
+  unsigned int current;
+  bool eof;         /* the other buffer is not filled anymore */
+  GtThread *thread; /* fills the other buffer */
+} GtFileReadAhead;
+
 struct GtFile {
   GtFileMode mode;
   GtUword reference_count;
@@ -37,8 +59,137 @@ struct GtFile {
        unget_char;
   bool is_stdin,
        unget_used;
+  GtFileReadAhead *readahead;
+  GtBGZFReader *bgzf; /* for BGZF files, <fileptr.file> is used */
 };
 
+static size_t file_decompress(GtFile *file, unsigned char *buf, size_t nbytes)
+{
+  size_t filled = 0;
+  int rval;
+  while (filled < nbytes) {
+    if (file->bgzf)
+      rval = gt_bgzf_reader_xread(file->bgzf, buf + filled, nbytes - filled);
+    else if (file->mode == GT_FILE_MODE_GZIP)
+      rval = gt_xgzread(file->fileptr.gzfile, buf + filled, nbytes - filled);
+    else {
+      gt_assert(file->mode == GT_FILE_MODE_BZIP2);
+      rval = gt_xbzread(file->fileptr.bzfile, buf + filled, nbytes - filled);
+    }
+    if (rval <= 0)
+      break;
+    filled += rval;
+  }
+  return filled;
+}
+
+static void* file_readahead_fill(void *data)
+{
+  GtFile *file = data;
+  GtFileReadAhead *readahead = file->readahead;
+  unsigned int other = 1 - readahead->current;
+  readahead->filled[other] = file_decompress(file, readahead->buffers[other],
+                                             GT_FILE_READAHEAD_SIZE);
+  return NULL;
+}
+
+static void file_readahead_start(GtFile *file)
+{
+  GtError *err = gt_error_new();
+  gt_assert(!file->readahead->thread);
+  /* if no thread can be started, the buffer is filled right away */
+  if (!(file->readahead->thread = gt_thread_new(file_readahead_fill, file,
+                                                err))) {
+    (void) file_readahead_fill(file);
+  }
+  gt_error_delete(err);
+}
+
+static void file_readahead_wait(GtFileReadAhead *readahead)
+{
+  if (readahead->thread) {
+    gt_thread_join(readahead->thread);
+    gt_thread_delete(readahead->thread);
+    readahead->thread = NULL;
+  }
+}
+
+static void file_readahead_reset(GtFile *file)
+{
+  GtFileReadAhead *readahead = file->readahead;
+  readahead->current = 1;
+  readahead->filled[1] = readahead->nextpos = 0;
+  readahead->eof = false;
+  file_readahead_start(file);
+}
+
+/* Use read-ahead for compressed files opened only for reading, if more than
+   one job is requested. */
+static bool file_readahead_wanted(GtFileMode file_mode, const char *path,
+                                  const char *mode)
+{
+  return gt_jobs > 1 && path && file_mode != GT_FILE_MODE_UNCOMPRESSED &&
+         mode[0] == 'r' && !strchr(mode, '+');
+}
+
+static void file_readahead_new(GtFile *file)
+{
+  GtFileReadAhead *readahead = gt_calloc(1, sizeof *readahead);
+  readahead->buffers[0] = gt_malloc(sizeof (unsigned char) *
+                                    GT_FILE_READAHEAD_SIZE);
+  readahead->buffers[1] = gt_malloc(sizeof (unsigned char) *
+                                    GT_FILE_READAHEAD_SIZE);
+  file->readahead = readahead;
+  file_readahead_reset(file);
+}
+
+static void file_readahead_delete(GtFileReadAhead *readahead)
+{
+  if (!readahead) return;
+  file_readahead_wait(readahead);
+  gt_free(readahead->buffers[0]);
+  gt_free(readahead->buffers[1]);
+  gt_free(readahead);
+}
+
+/* Switch to the buffer filled in the background and start filling the other
+   one. Returns false at the end of the file. */
+static bool file_readahead_next(GtFile *file)
+{
+  GtFileReadAhead *readahead = file->readahead;
+  file_readahead_wait(readahead);
+  if (readahead->eof)
+    return false;
+  readahead->current = 1 - readahead->current;
+  readahead->nextpos = 0;
+  /* a buffer which is not full ends the file */
+  if (readahead->filled[readahead->current] < GT_FILE_READAHEAD_SIZE)
+    readahead->eof = true;
+  else
+    file_readahead_start(file);
+  return readahead->filled[readahead->current] > 0;
+}
+
+static int file_readahead_read(GtFile *file, void *buf, size_t nbytes)
+{
+  GtFileReadAhead *readahead = file->readahead;
+  size_t copied = 0, length;
+  while (copied < nbytes) {
+    if (readahead->nextpos == readahead->filled[readahead->current] &&
+        !file_readahead_next(file)) {
+      break;
+    }
+    length = MIN(readahead->filled[readahead->current] - readahead->nextpos,
+                 nbytes - copied);
+    memcpy((unsigned char*) buf + copied,
+           readahead->buffers[readahead->current] + readahead->nextpos,
+           length);
+    readahead->nextpos += length;
+    copied += length;
+  }
+  return (int) copied;
+}
+
 GtFileMode gt_file_mode_determine(const char *path)
 {
   size_t path_length;
@@ -117,6 +268,16 @@ GtFile* gt_file_open(GtFileMode file_mode, const char *path, const char *mode,
         }
         break;
       case GT_FILE_MODE_GZIP:
+        if (file_readahead_wanted(file_mode, path, mode) &&
+            gt_bgzf_check(path)) {
+          file->fileptr.file = gt_fa_fopen(path, mode, err);
+          if (!file->fileptr.file) {
+            gt_file_delete_without_handle(file);
+            return NULL;
+          }
+          file->bgzf = gt_bgzf_reader_new(file->fileptr.file);
+          break;
+        }
         file->fileptr.gzfile = gt_fa_gzopen(path, mode, err);
         if (!file->fileptr.gzfile) {
           gt_file_delete_without_handle(file);
@@ -140,6 +301,8 @@ GtFile* gt_file_open(GtFileMode file_mode, const char *path, const char *mode,
     file->fileptr.file = stdin;
     file->is_stdin = true;
   }
+  if (file_readahead_wanted(file_mode, path, mode))
+    file_readahead_new(file);
   return file;
 }
 
@@ -157,7 +320,13 @@ GtFile* gt_file_xopen_file_mode(GtFileMode file_mode, const char *path,
         file->fileptr.file = gt_fa_xfopen(path, mode);
         break;
       case GT_FILE_MODE_GZIP:
-        file->fileptr.gzfile = gt_fa_xgzopen(path, mode);
+        if (file_readahead_wanted(file_mode, path, mode) &&
+            gt_bgzf_check(path)) {
+          file->fileptr.file = gt_fa_xfopen(path, mode);
+          file->bgzf = gt_bgzf_reader_new(file->fileptr.file);
+        }
+        else
+          file->fileptr.gzfile = gt_fa_xgzopen(path, mode);
         break;
       case GT_FILE_MODE_BZIP2:
         file->fileptr.bzfile = gt_fa_xbzopen(path, mode);
@@ -172,6 +341,8 @@ GtFile* gt_file_xopen_file_mode(GtFileMode file_mode, const char *path,
     file->fileptr.file = stdin;
     file->is_stdin = true;
   }
+  if (file_readahead_wanted(file_mode, path, mode))
+    file_readahead_new(file);
   return file;
 }
 
@@ -206,6 +377,11 @@ int gt_file_xfgetc(GtFile *file)
       c = file->unget_char;
       file->unget_used = false;
     }
+    else if (file->readahead) {
+      char cc;
+      /* like gt_xgzfgetc() and gt_xbzfgetc() */
+      c = file_readahead_read(file, &cc, 1) ? cc : EOF;
+    }
     else {
       switch (file->mode) {
         case GT_FILE_MODE_UNCOMPRESSED:
@@ -364,7 +540,9 @@ void gt_file_xfputs(const char *cstr, GtFile *file)
 int gt_file_xread(GtFile *file, void *buf, size_t nbytes)
 {
   int rval = -1;
-  if (file) {
+  if (file && file->readahead)
+    rval = file_readahead_read(file, buf, nbytes);
+  else if (file) {
     switch (file->mode) {
       case GT_FILE_MODE_UNCOMPRESSED:
         rval = gt_xfread(buf, 1, nbytes, file->fileptr.file);
@@ -406,18 +584,27 @@ void gt_file_xwrite(GtFile *file, void *buf, size_t nbytes)
 void gt_file_xrewind(GtFile *file)
 {
   gt_assert(file);
+  if (file->readahead)
+    file_readahead_wait(file->readahead);
   switch (file->mode) {
     case GT_FILE_MODE_UNCOMPRESSED:
       rewind(file->fileptr.file);
       break;
     case GT_FILE_MODE_GZIP:
-      gt_xgzrewind(file->fileptr.gzfile);
+      if (file->bgzf) {
+        rewind(file->fileptr.file);
+        gt_bgzf_reader_reset(file->bgzf);
+      }
+      else
+        gt_xgzrewind(file->fileptr.gzfile);
       break;
     case GT_FILE_MODE_BZIP2:
       gt_xbzrewind(&file->fileptr.bzfile, file->orig_path, file->orig_mode);
       break;
     default: gt_assert(0);
   }
+  if (file->readahead)
+    file_readahead_reset(file);
 }
 
 void gt_file_delete_without_handle(GtFile *file)
@@ -435,6 +622,13 @@ void gt_file_delete(GtFile *file)
     file->reference_count--;
     return;
   }
+  file_readahead_delete(file->readahead);
+  if (file->bgzf) {
+    gt_bgzf_reader_delete(file->bgzf);
+    gt_fa_fclose(file->fileptr.file);
+    gt_file_delete_without_handle(file);
+    return;
+  }
   switch (file->mode) {
     case GT_FILE_MODE_UNCOMPRESSED:
         if (!file->is_stdin)
@@ -35,6 +35,7 @@
 #include "core/showtime.h"
 #include "core/spacepeak.h"
 #include "core/splitter.h"
+#include "core/str_array_api.h"
 #include "core/symbol.h"
 #include "core/versionfunc.h"
 #include "core/warning_api.h"
@@ -43,6 +44,9 @@
 
 static bool spacepeak = false;
 static bool showtime = false;
+static bool mapstats = false;
+static GtStrArray *mappolicies = NULL,
+                  *tableallocs = NULL;
 
 static GtOPrval parse_env_options(int argc, const char **argv, GtError *err)
 {
@@ -58,6 +62,22 @@ static GtOPrval parse_env_options(int argc, const char **argv, GtError *err)
   o = gt_option_new_bool("showtime", "enable output for run-time statistics",
                          &showtime, false);
   gt_option_parser_add_option(op, o);
+  o = gt_option_new_string_array("mappolicy", "set policies for mapping "
+                                 "index files; a policy applies to all files "
+                                 "or, given as <policy>:<indexname>, to the "
+                                 "files of an index only\n"
+                                 "choose from default|willneed|populate|"
+                                 "hugepage|warmup", mappolicies);
+  gt_option_parser_add_option(op, o);
+  o = gt_option_new_string_array("tablealloc", "set policies for allocating "
+                                 "large tables during index construction\n"
+                                 "choose any of hugepage|interleave|"
+                                 "firsttouch", tableallocs);
+  gt_option_parser_add_option(op, o);
+  o = gt_option_new_bool("mapstats", "show statistics about mapped files "
+                         "and their warm-up on stderr upon deletion",
+                         &mapstats, false);
+  gt_option_parser_add_option(op, o);
   gt_option_parser_set_max_args(op, 0);
   oprval = gt_option_parser_parse(op, NULL, argc, argv, gt_versionfunc, err);
   gt_option_parser_delete(op);
@@ -82,6 +102,8 @@ static void proc_env_options(void)
                              "env");
   argc++;
   /* parse options contained in $GT_ENV_OPTIONS */
+  mappolicies = gt_str_array_new();
+  tableallocs = gt_str_array_new();
   err = gt_error_new();
   switch (parse_env_options(argc, (const char**) argv, err)) {
     case GT_OPTION_PARSER_OK: break;
@@ -106,6 +128,36 @@ void gt_lib_init(void)
   if (spacepeak && !(bookkeeping && !strcmp(bookkeeping, "on")))
     gt_warning("GT_ENV_OPTIONS=-spacepeak used without GT_MEM_BOOKKEEPING=on");
   gt_fa_init();
+  if (mappolicies != NULL) {
+    GtError *err = gt_error_new();
+    GtUword i;
+    for (i = 0; i < gt_str_array_size(mappolicies); i++) {
+      if (gt_fa_set_map_policy(gt_str_array_get(mappolicies, i), err)) {
+        fprintf(stderr, "error parsing $GT_ENV_OPTIONS: %s\n",
+                gt_error_get(err));
+        gt_error_unset(err);
+      }
+    }
+    gt_error_delete(err);
+    gt_str_array_delete(mappolicies);
+    mappolicies = NULL;
+  }
+  if (tableallocs != NULL) {
+    GtError *err = gt_error_new();
+    GtUword i;
+    for (i = 0; i < gt_str_array_size(tableallocs); i++) {
+      if (gt_ma_add_large_policy(gt_str_array_get(tableallocs, i), err)) {
+        fprintf(stderr, "error parsing $GT_ENV_OPTIONS: %s\n",
+                gt_error_get(err));
+        gt_error_unset(err);
+      }
+    }
+    gt_error_delete(err);
+    gt_str_array_delete(tableallocs);
+    tableallocs = NULL;
+  }
+  if (mapstats)
+    gt_fa_enable_map_stats();
   if (spacepeak) {
     gt_spacepeak_init();
     gt_ma_enable_global_spacepeak();
@@ -141,6 +193,8 @@ int gt_lib_clean(void)
     gt_spacepeak_show_space_peak(stdout);
     gt_ma_disable_global_spacepeak();
   }
+  if (mapstats)
+    gt_fa_show_map_stats(stderr);
   fa_fptr_rval = gt_fa_check_fptr_leak();
   fa_mmap_rval = gt_fa_check_mmap_leak();
   gt_fa_clean();
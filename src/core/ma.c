@@ -17,13 +17,22 @@
 
 #include <errno.h>
 #include <string.h>
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
 #include "core/array_api.h"
 #include "core/compat.h"
+#include "core/ensure.h"
 #include "core/hashmap.h"
 #include "core/ma.h"
 #include "core/multithread_api.h"
 #include "core/spacecalc.h"
 #include "core/spacepeak.h"
+#include "core/thread_api.h"
 #include "core/types_api.h"
 #include "core/unused_api.h"
 #include "core/xansi_api.h"
@@ -35,7 +44,10 @@ typedef struct {
        global_space_peak;
   GtUint64 mallocevents;
   GtUword current_size,
-                max_size;
+                max_size,
+                large_tables,
+                large_bytes;
+  unsigned int large_policy;
 } MA;
 
 static MA *ma = NULL;
@@ -51,6 +63,16 @@ typedef struct {
   bool has_leak;
 } CheckSpaceLeakInfo;
 
+/* size of a huge page on x86_64; large tables are aligned to it and smaller
+   tables are allocated without a policy */
+#define GT_MA_LARGE_ALIGNMENT  ((size_t) 2 * 1024 * 1024)
+/* number of bytes of a large table initialised at once by one thread */
+#define GT_MA_LARGE_CHUNKSIZE  ((size_t) 16 * 1024 * 1024)
+/* constants of the Linux mempolicy interface, see <linux/mempolicy.h> */
+#define GT_MA_MPOL_INTERLEAVE      3
+#define GT_MA_MPOL_F_MEMS_ALLOWED  (1 << 2)
+#define GT_MA_MAXNUMANODES         1024
+
 static void* xcalloc(size_t nmemb, size_t size, GtUword current_size,
                      const char *src_file, int src_line)
 {
@@ -230,6 +252,199 @@ void gt_free_mem(void *ptr, GT_UNUSED const char *src_file,
   }
 }
 
+int gt_ma_add_large_policy(const char *name, GtError *err)
+{
+  gt_error_check(err);
+  gt_assert(ma && name);
+  if (strcmp(name, "default") == 0)
+    ma->large_policy = GT_MA_LARGE_DEFAULT;
+  else if (strcmp(name, "hugepage") == 0)
+    ma->large_policy |= GT_MA_LARGE_HUGEPAGE;
+  else if (strcmp(name, "interleave") == 0)
+    ma->large_policy |= GT_MA_LARGE_INTERLEAVE;
+  else if (strcmp(name, "firsttouch") == 0)
+    ma->large_policy |= GT_MA_LARGE_FIRSTTOUCH;
+  else {
+    gt_error_set(err, "unknown allocation policy \"%s\" for large tables "
+                      "(use default, hugepage, interleave or firsttouch)",
+                 name);
+    return -1;
+  }
+  return 0;
+}
+
+unsigned int gt_ma_get_large_policy(void)
+{
+  gt_assert(ma);
+  return ma->large_policy;
+}
+
+void gt_ma_get_large_stats(GtUword *numoftables, GtUword *numofbytes)
+{
+  gt_assert(ma && numoftables && numofbytes);
+  gt_mutex_lock(bookkeeping_lock);
+  *numoftables = ma->large_tables;
+  *numofbytes = ma->large_bytes;
+  gt_mutex_unlock(bookkeeping_lock);
+}
+
+#ifndef _WIN32
+typedef struct {
+  char *mem;
+  size_t size,
+         pagesize,
+         nextchunk;
+  bool zero;
+  GtMutex *mutex;
+} MALargeTouchInfo;
+
+static void* large_touch_thread(void *data)
+{
+  MALargeTouchInfo *info = data;
+  size_t start, end, offset;
+  for (;;) {
+    gt_mutex_lock(info->mutex);
+    start = info->nextchunk;
+    end = info->size - start < GT_MA_LARGE_CHUNKSIZE
+          ? info->size : start + GT_MA_LARGE_CHUNKSIZE;
+    info->nextchunk = end;
+    gt_mutex_unlock(info->mutex);
+    if (start == end)
+      break;
+    if (info->zero)
+      memset(info->mem + start, 0, end - start);
+    else {
+      /* writing one byte of each page places it on the node of the thread */
+      for (offset = start; offset < end; offset += info->pagesize)
+        info->mem[offset] = 0;
+    }
+  }
+  return NULL;
+}
+
+/* Touches or zeroes all pages of <mem> in chunks, which are spread over
+   <gt_jobs> threads. */
+static void large_first_touch(void *mem, size_t size, bool zero)
+{
+  MALargeTouchInfo info;
+  GtError *err;
+  long pagesize = sysconf(_SC_PAGESIZE);
+  info.mem = mem;
+  info.size = size;
+  info.pagesize = pagesize > 0 ? (size_t) pagesize : (size_t) 4096;
+  info.nextchunk = 0;
+  info.zero = zero;
+  info.mutex = gt_mutex_new();
+  err = gt_error_new();
+  /* if no threads can be started, the pages are touched sequentially */
+  if (gt_jobs == 1U || size <= GT_MA_LARGE_CHUNKSIZE ||
+      gt_multithread(large_touch_thread, &info, err) != 0) {
+    (void) large_touch_thread(&info);
+  }
+  gt_error_delete(err);
+  gt_mutex_delete(info.mutex);
+}
+
+static void large_interleave(void *mem, size_t size)
+{
+#if defined (__linux__) && defined (SYS_mbind) && defined (SYS_get_mempolicy)
+  unsigned long nodemask[GT_MA_MAXNUMANODES / (8 * sizeof (unsigned long))];
+  unsigned long maxnode = GT_MA_MAXNUMANODES, numofnodes = 0, idx;
+  memset(nodemask, 0, sizeof nodemask);
+  if (syscall(SYS_get_mempolicy, NULL, nodemask, maxnode, NULL,
+              GT_MA_MPOL_F_MEMS_ALLOWED) != 0)
+    return;
+  for (idx = 0; idx < (unsigned long) GT_MA_MAXNUMANODES; idx++) {
+    if (nodemask[idx / (8 * sizeof (unsigned long))] &
+        (1UL << (idx % (8 * sizeof (unsigned long)))))
+      numofnodes++;
+  }
+  /* interleaving over a single node does not change the placement */
+  if (numofnodes > 1UL)
+    (void) syscall(SYS_mbind, mem, size, GT_MA_MPOL_INTERLEAVE, nodemask,
+                   maxnode + 1, 0);
+#else
+  (void) mem;
+  (void) size;
+#endif
+}
+
+static void* large_alloc(size_t size, bool zero, unsigned int policy,
+                         GtUword current_size, const char *src_file,
+                         int src_line)
+{
+  void *mem;
+  if (posix_memalign(&mem, GT_MA_LARGE_ALIGNMENT, size) != 0) {
+    fprintf(stderr, "cannot malloc("GT_ZU") memory\n", size);
+    fprintf(stderr, "attempted on line %d in file \"%s\"\n", src_line,
+            src_file);
+    if (current_size)
+      fprintf(stderr, GT_WU " bytes were allocated altogether\n", current_size);
+    exit(EXIT_FAILURE);
+  }
+  /* the policies must be set before the pages are touched the first time */
+#ifdef MADV_HUGEPAGE
+  if (policy & GT_MA_LARGE_HUGEPAGE)
+    (void) madvise(mem, size, MADV_HUGEPAGE);
+#endif
+  if (policy & GT_MA_LARGE_INTERLEAVE)
+    large_interleave(mem, size);
+  if (policy & GT_MA_LARGE_FIRSTTOUCH)
+    large_first_touch(mem, size, zero);
+  else if (zero)
+    memset(mem, 0, size);
+  return mem;
+}
+#endif
+
+static void* large_alloc_mem(size_t size, bool zero, const char *src_file,
+                             int src_line)
+{
+#ifndef _WIN32
+  MAInfo *mainfo;
+  void *mem;
+  /* the table is set up outside of the lock, as the threads touching it
+     allocate memory themselves */
+  mem = large_alloc(size, zero, ma->large_policy, ma->current_size, src_file,
+                    src_line);
+  gt_mutex_lock(bookkeeping_lock);
+  ma->large_tables++;
+  ma->large_bytes += size;
+  if (ma->bookkeeping) {
+    ma->mallocevents++;
+    mainfo = xmalloc(sizeof *mainfo, ma->current_size, src_file, src_line);
+    mainfo->size = size;
+    mainfo->src_file = src_file;
+    mainfo->src_line = src_line;
+    gt_hashmap_add(ma->allocated_pointer, mem, mainfo);
+    add_size(ma, size);
+  }
+  gt_mutex_unlock(bookkeeping_lock);
+  return mem;
+#else
+  return zero ? gt_calloc_mem(1, size, src_file, src_line)
+              : gt_malloc_mem(size, src_file, src_line);
+#endif
+}
+
+void* gt_malloc_large_mem(size_t size, const char *src_file, int src_line)
+{
+  gt_assert(ma);
+  if (ma->large_policy == GT_MA_LARGE_DEFAULT || size < GT_MA_LARGE_ALIGNMENT)
+    return gt_malloc_mem(size, src_file, src_line);
+  return large_alloc_mem(size, false, src_file, src_line);
+}
+
+void* gt_calloc_large_mem(size_t nmemb, size_t size, const char *src_file,
+                          int src_line)
+{
+  gt_assert(ma);
+  if (ma->large_policy == GT_MA_LARGE_DEFAULT ||
+      nmemb * size < GT_MA_LARGE_ALIGNMENT)
+    return gt_calloc_mem(nmemb, size, src_file, src_line);
+  return large_alloc_mem(nmemb * size, true, src_file, src_line);
+}
+
 void gt_free_func(void *ptr)
 {
   if (!ptr) return;
@@ -408,5 +623,34 @@ int gt_ma_unit_test(GtError *err)
     had_err = gt_multithread(test_calloc, NULL, err);
   if (!had_err)
     had_err = gt_multithread(test_realloc, NULL, err);
+  if (!had_err) {
+    unsigned int policy = ma->large_policy;
+    size_t idx, numofentries = 2 * GT_MA_LARGE_ALIGNMENT / sizeof (GtUword);
+    GtUword *tab;
+    ma->large_policy = GT_MA_LARGE_DEFAULT;
+    had_err = gt_ma_add_large_policy("hugepage", err);
+    if (!had_err)
+      had_err = gt_ma_add_large_policy("interleave", err);
+    if (!had_err)
+      had_err = gt_ma_add_large_policy("firsttouch", err);
+    gt_ensure(ma->large_policy == (GT_MA_LARGE_HUGEPAGE |
+                                   GT_MA_LARGE_INTERLEAVE |
+                                   GT_MA_LARGE_FIRSTTOUCH));
+    if (!had_err) {
+      tab = gt_calloc_large(numofentries, sizeof *tab);
+      for (idx = 0; !had_err && idx < numofentries; idx++)
+        gt_ensure(tab[idx] == 0);
+      tab = gt_realloc(tab, sizeof *tab * numofentries / 2);
+      gt_free(tab);
+      tab = gt_malloc_large(sizeof *tab * numofentries);
+      tab[numofentries - 1] = 1;
+      gt_free(tab);
+    }
+    if (!had_err) {
+      gt_ensure(gt_ma_add_large_policy("huge", err) == -1);
+      gt_error_unset(err);
+    }
+    ma->large_policy = policy;
+  }
   return had_err;
 }
@@ -38,4 +38,40 @@ int     gt_ma_check_space_leak(void);
 void    gt_ma_clean(void);
 int     gt_ma_unit_test(GtError*);
 
+/* Policies for the allocation of large tables, which can be combined. */
+#define GT_MA_LARGE_DEFAULT     0U
+/* back large tables by transparent huge pages */
+#define GT_MA_LARGE_HUGEPAGE    1U
+/* interleave the pages of large tables over all allowed NUMA nodes */
+#define GT_MA_LARGE_INTERLEAVE  2U
+/* initialise large tables in parallel, such that each chunk is placed on
+   the NUMA node of the thread touching it first */
+#define GT_MA_LARGE_FIRSTTOUCH  4U
+
+/* Adds the policy named <name> (one of "default", "hugepage", "interleave"
+   and "firsttouch") to the policies used by <gt_malloc_large()> and
+   <gt_calloc_large()>. "default" resets the policies. Returns 0 on success
+   and -1 if <name> is unknown, <err> is set accordingly. */
+int          gt_ma_add_large_policy(const char *name, GtError *err);
+/* Returns the policies for large tables as a combination of the
+   <GT_MA_LARGE_*> flags. */
+unsigned int gt_ma_get_large_policy(void);
+/* Stores the number of tables allocated with a policy for large tables in
+   <numoftables> and their total size in <numofbytes>. */
+void         gt_ma_get_large_stats(GtUword *numoftables, GtUword *numofbytes);
+
+/* Analog to <gt_malloc()>, but for large tables: if a policy for large
+   tables is set and <size> is at least the size of a huge page, the space
+   is aligned to huge pages and placed according to the policy. The space
+   is freed with <gt_free()>. */
+#define gt_malloc_large(size)\
+        gt_malloc_large_mem(size, __FILE__, __LINE__)
+void*   gt_malloc_large_mem(size_t size, const char *src_file, int src_line);
+/* Analog to <gt_calloc()>, but for large tables, see <gt_malloc_large()>.
+   With policy <GT_MA_LARGE_FIRSTTOUCH>, the space is zeroed in parallel. */
+#define gt_calloc_large(nmemb, size)\
+        gt_calloc_large_mem(nmemb, size, __FILE__, __LINE__)
+void*   gt_calloc_large_mem(size_t nmemb, size_t size, const char *src_file,
+                            int src_line);
+
 #endif
@@ -18,10 +18,16 @@
 #include <ctype.h>
 #include <string.h>
 #include "md5.h"
+#include "core/assert_api.h"
 #include "core/ma.h"
 #include "core/md5_encoder_api.h"
-#include "core/md5_fingerprint_api.h"
+#include "core/md5_fingerprint.h"
 #include "core/safearith.h"
+#include "core/ensure.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#include <stdint.h>
+#endif
 
 char* gt_md5_fingerprint(const char *sequence, GtUword seqlen)
 {
@@ -46,3 +52,247 @@ char* gt_md5_fingerprint(const char *sequence, GtUword seqlen)
   gt_md5_encoder_delete(enc);
   return fingerprint;
 }
+
+#ifdef __SSE2__
+
+/* Multi-buffer MD5: the message blocks of GT_MD5_LANES sequences are
+   processed in the lanes of SSE2 registers. Each lane is refilled with the
+   next sequence as soon as its current sequence is finished, so sequences
+   of different lengths do not stall each other. */
+
+#define GT_MD5_LANES 4
+
+static const uint32_t md5_T[64] = {
+  0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee,
+  0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+  0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be,
+  0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+  0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa,
+  0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+  0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed,
+  0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+  0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c,
+  0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+  0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05,
+  0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+  0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039,
+  0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+  0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1,
+  0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+};
+
+static const int md5_shift[16] = { 7, 12, 17, 22, 5, 9, 14, 20,
+                                   4, 11, 16, 23, 6, 10, 15, 21 };
+
+typedef struct {
+  const char *seq;
+  GtUword seqlen,
+          seqnum,
+          block,
+          numofblocks;
+} GtMD5Lane;
+
+static void md5_lane_block(unsigned char *block, const GtMD5Lane *lane)
+{
+  GtUword offset = lane->block * 64, i = 0;
+
+  if (offset < lane->seqlen) {
+    GtUword end = lane->seqlen - offset < 64 ? lane->seqlen - offset : 64;
+    for (; i < end; i++)
+      block[i] = (unsigned char) toupper(lane->seq[offset + i]);
+  }
+  if (i < 64) {
+    if (offset + i == lane->seqlen)
+      block[i++] = 0x80;
+    memset(block + i, 0, 64 - i);
+    if (lane->block + 1 == lane->numofblocks) {
+      /* message length in bits, truncated like in the MD5 encoder module */
+      uint32_t lo = (uint32_t) (lane->seqlen << 3),
+               hi = (uint32_t) ((lane->seqlen >> 29) & 0x7);
+      for (i = 0; i < 4; i++) {
+        block[56 + i] = (unsigned char) (lo >> (8 * i));
+        block[60 + i] = (unsigned char) (hi >> (8 * i));
+      }
+    }
+  }
+}
+
+static void md5_lane_start(GtMD5Lane *lane, uint32_t state[4][GT_MD5_LANES],
+                           unsigned int l, const char **seqs,
+                           const GtUword *seqlens, GtUword seqnum)
+{
+  lane->seq = seqs[seqnum];
+  lane->seqlen = seqlens[seqnum];
+  lane->seqnum = seqnum;
+  lane->block = 0;
+  lane->numofblocks = (lane->seqlen + 8) / 64 + 1;
+  state[0][l] = 0x67452301;
+  state[1][l] = 0xefcdab89;
+  state[2][l] = 0x98badcfe;
+  state[3][l] = 0x10325476;
+}
+
+static void md5_lane_finish(char *fingerprint,
+                            uint32_t state[4][GT_MD5_LANES], unsigned int l)
+{
+  static const char hex[] = "0123456789abcdef";
+  unsigned int i, j;
+
+  for (i = 0; i < 4; i++) {
+    uint32_t v = state[i][l];
+    for (j = 0; j < 4; j++) {
+      *fingerprint++ = hex[(v >> 4) & 0xf];
+      *fingerprint++ = hex[v & 0xf];
+      v >>= 8;
+    }
+  }
+  *fingerprint = '\0';
+}
+
+#define MD5_LE32(P)\
+        ((int) ((uint32_t) (P)[0] | ((uint32_t) (P)[1] << 8) |\
+                ((uint32_t) (P)[2] << 16) | ((uint32_t) (P)[3] << 24)))
+
+static void md5_digest_lanes(uint32_t state[4][GT_MD5_LANES],
+                             const unsigned char *blocks)
+{
+  __m128i m[16], a, b, c, d, a0, b0, c0, d0, f, tmp,
+          ones = _mm_set1_epi32(-1);
+  unsigned int i, j;
+
+  for (j = 0; j < 16; j++) {
+    m[j] = _mm_set_epi32(MD5_LE32(blocks + 192 + 4 * j),
+                         MD5_LE32(blocks + 128 + 4 * j),
+                         MD5_LE32(blocks + 64 + 4 * j),
+                         MD5_LE32(blocks + 4 * j));
+  }
+  a = a0 = _mm_loadu_si128((const __m128i *) state[0]);
+  b = b0 = _mm_loadu_si128((const __m128i *) state[1]);
+  c = c0 = _mm_loadu_si128((const __m128i *) state[2]);
+  d = d0 = _mm_loadu_si128((const __m128i *) state[3]);
+  for (i = 0; i < 64; i++) {
+    int s;
+    if (i < 16) {
+      f = _mm_or_si128(_mm_and_si128(b, c), _mm_andnot_si128(b, d));
+      j = i;
+    } else if (i < 32) {
+      f = _mm_or_si128(_mm_and_si128(b, d), _mm_andnot_si128(d, c));
+      j = (5 * i + 1) & 0xf;
+    } else if (i < 48) {
+      f = _mm_xor_si128(_mm_xor_si128(b, c), d);
+      j = (3 * i + 5) & 0xf;
+    } else {
+      f = _mm_xor_si128(c, _mm_or_si128(b, _mm_xor_si128(d, ones)));
+      j = (7 * i) & 0xf;
+    }
+    s = md5_shift[((i >> 4) << 2) + (i & 3)];
+    f = _mm_add_epi32(_mm_add_epi32(f, a),
+                      _mm_add_epi32(m[j], _mm_set1_epi32((int) md5_T[i])));
+    tmp = d;
+    d = c;
+    c = b;
+    b = _mm_add_epi32(b, _mm_or_si128(_mm_sll_epi32(f, _mm_cvtsi32_si128(s)),
+                                      _mm_srl_epi32(f,
+                                                  _mm_cvtsi32_si128(32 - s))));
+    a = tmp;
+  }
+  _mm_storeu_si128((__m128i *) state[0], _mm_add_epi32(a, a0));
+  _mm_storeu_si128((__m128i *) state[1], _mm_add_epi32(b, b0));
+  _mm_storeu_si128((__m128i *) state[2], _mm_add_epi32(c, c0));
+  _mm_storeu_si128((__m128i *) state[3], _mm_add_epi32(d, d0));
+}
+
+void gt_md5_fingerprint_multi(char *fingerprints, const char **seqs,
+                              const GtUword *seqlens, GtUword num_of_seqs)
+{
+  GtMD5Lane lanes[GT_MD5_LANES];
+  bool active[GT_MD5_LANES];
+  uint32_t state[4][GT_MD5_LANES];
+  unsigned char blocks[GT_MD5_LANES * 64];
+  unsigned int l, numofactive = 0;
+  GtUword nextseq = 0;
+
+  gt_assert(num_of_seqs == 0 || (fingerprints && seqs && seqlens));
+  memset(state, 0, sizeof state);
+  for (l = 0; l < GT_MD5_LANES; l++) {
+    active[l] = nextseq < num_of_seqs;
+    if (active[l]) {
+      md5_lane_start(lanes + l, state, l, seqs, seqlens, nextseq++);
+      numofactive++;
+    } else
+      memset(blocks + l * 64, 0, (size_t) 64);
+  }
+  while (numofactive > 0) {
+    for (l = 0; l < GT_MD5_LANES; l++) {
+      if (active[l])
+        md5_lane_block(blocks + l * 64, lanes + l);
+    }
+    md5_digest_lanes(state, blocks);
+    for (l = 0; l < GT_MD5_LANES; l++) {
+      if (active[l] && ++lanes[l].block == lanes[l].numofblocks) {
+        md5_lane_finish(fingerprints +
+                        lanes[l].seqnum * GT_MD5_FINGERPRINT_SIZE, state, l);
+        if (nextseq < num_of_seqs)
+          md5_lane_start(lanes + l, state, l, seqs, seqlens, nextseq++);
+        else {
+          active[l] = false;
+          numofactive--;
+        }
+      }
+    }
+  }
+}
+
+#else
+
+void gt_md5_fingerprint_multi(char *fingerprints, const char **seqs,
+                              const GtUword *seqlens, GtUword num_of_seqs)
+{
+  GtUword i;
+  gt_assert(num_of_seqs == 0 || (fingerprints && seqs && seqlens));
+  for (i = 0; i < num_of_seqs; i++) {
+    char *fingerprint = gt_md5_fingerprint(seqs[i], seqlens[i]);
+    memcpy(fingerprints + i * GT_MD5_FINGERPRINT_SIZE, fingerprint,
+           GT_MD5_FINGERPRINT_SIZE);
+    gt_free(fingerprint);
+  }
+}
+
+#endif
+
+int gt_md5_fingerprint_unit_test(GtError *err)
+{
+  const GtUword num_of_seqs = 200;
+  const char *seqs[200];
+  GtUword seqlens[200], i, j;
+  char *buf, *fingerprints;
+  int had_err = 0;
+  gt_error_check(err);
+
+  /* lengths around the block boundaries and a few long sequences, in an
+     order which makes the lanes finish at different times */
+  buf = gt_malloc(sizeof (char) * num_of_seqs * 300);
+  for (i = 0; i < num_of_seqs; i++) {
+    seqs[i] = buf + i * 300;
+    seqlens[i] = (i % 3 == 0) ? (i * 7) % 300 : (i * 13) % 130;
+    for (j = 0; j < seqlens[i]; j++)
+      buf[i * 300 + j] = "acgtnACGTN*x"[(i + j * j) % 12];
+  }
+  fingerprints = gt_malloc(sizeof (char) * num_of_seqs *
+                           GT_MD5_FINGERPRINT_SIZE);
+  gt_md5_fingerprint_multi(fingerprints, seqs, seqlens, num_of_seqs);
+  for (i = 0; !had_err && i < num_of_seqs; i++) {
+    char *fingerprint = gt_md5_fingerprint(seqs[i], seqlens[i]);
+    gt_ensure(strcmp(fingerprint,
+                     fingerprints + i * GT_MD5_FINGERPRINT_SIZE) == 0);
+    gt_free(fingerprint);
+  }
+  if (!had_err) {
+    /* empty sequence */
+    gt_md5_fingerprint_multi(fingerprints, seqs, seqlens, 1);
+    gt_ensure(strcmp(fingerprints, "d41d8cd98f00b204e9800998ecf8427e") == 0);
+  }
+  gt_free(fingerprints);
+  gt_free(buf);
+  return had_err;
+}
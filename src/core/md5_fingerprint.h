@@ -0,0 +1,38 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef MD5_FINGERPRINT_H
+#define MD5_FINGERPRINT_H
+
+#include "core/error_api.h"
+#include "core/types_api.h"
+#include "core/md5_fingerprint_api.h"
+
+/* Length of a '\0'-terminated MD5 fingerprint as stored by
+   <gt_md5_fingerprint_multi()>. */
+#define GT_MD5_FINGERPRINT_SIZE  33
+
+/* Computes the MD5 fingerprints (as <gt_md5_fingerprint()> does) of the
+   <num_of_seqs> sequences <seqs> with lengths <seqlens> and stores them as
+   '\0'-terminated strings of <GT_MD5_FINGERPRINT_SIZE> bytes each, one after
+   another, in <fingerprints>. If SSE2 is available, four sequences are hashed
+   at once, which pays off for many short sequences. */
+void gt_md5_fingerprint_multi(char *fingerprints, const char **seqs,
+                              const GtUword *seqlens, GtUword num_of_seqs);
+
+int  gt_md5_fingerprint_unit_test(GtError *err);
+
+#endif
@@ -15,19 +15,27 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include "core/error_api.h"
 #include "core/fa.h"
 #include "core/fileutils_api.h"
 #include "core/hashmap_api.h"
 #include "core/ma.h"
-#include "core/md5_fingerprint_api.h"
+#include "core/md5_fingerprint.h"
 #include "core/md5_tab.h"
+#include "core/multithread_api.h"
+#include "core/thread_api.h"
 #include "core/undef_api.h"
 #include "core/xansi_api.h"
 
+/* number of sequences hashed before their fingerprints are appended to the
+   cache file */
+#define GT_MD5_TAB_BATCHSIZE  16384
+/* number of sequences a thread claims at once */
+#define GT_MD5_TAB_CHUNKSIZE  256
+
 struct GtMD5Tab{
   FILE *fingerprints_file; /* used to lock the memory mapped fingerprints */
-  char *fingerprints; /* holds memory mapped fingerprints */
-  char **md5_fingerprints;
+  char *fingerprints; /* holds memory mapped or computed fingerprints */
   GtUword num_of_md5s,
                 reference_count;
   bool owns_md5s;
@@ -48,7 +56,7 @@ static bool read_fingerprints(GtMD5Tab *md5_tab,
     gt_fa_lock_shared(md5_tab->fingerprints_file);
   }
   md5_tab->fingerprints = gt_fa_xmmap_read(fingerprints_filename, &len);
-  if (len != md5_tab->num_of_md5s * 33) {
+  if (len != md5_tab->num_of_md5s * GT_MD5_FINGERPRINT_SIZE) {
     gt_fa_xmunmap(md5_tab->fingerprints);
     md5_tab->fingerprints = NULL;
     gt_fa_unlock(md5_tab->fingerprints_file);
@@ -59,43 +67,109 @@ static bool read_fingerprints(GtMD5Tab *md5_tab,
   return reading_succeeded;
 }
 
-static void add_fingerprints(char **md5_fingerprints, void *seqs,
-                             GtGetSeqFunc get_seq, GtGetSeqLenFunc get_seq_len,
-                             GtUword num_of_seqs)
+/* Copy the complete fingerprints at the start of <fingerprints_filename> to
+   <fingerprints>. Returns the number of fingerprints copied, which is 0 if
+   the file holds more than <num_of_md5s> of them. A cache file can hold
+   fewer fingerprints than expected if writing it was interrupted. */
+static GtUword read_fingerprints_prefix(char *fingerprints,
+                                        GtUword num_of_md5s,
+                                        const char *fingerprints_filename,
+                                        bool use_file_locking)
 {
-  GtUword i;
-  gt_assert(md5_fingerprints && seqs && get_seq && get_seq_len);
-  for (i = 0; i < num_of_seqs; i++) {
-    md5_fingerprints[i] = gt_md5_fingerprint(get_seq(seqs, i),
-                                             get_seq_len(seqs, i));
+  FILE *fingerprints_file;
+  GtUword i, num_read;
+  gt_assert(fingerprints && fingerprints_filename);
+  fingerprints_file = gt_fa_xfopen(fingerprints_filename, "r");
+  if (use_file_locking)
+    gt_fa_lock_shared(fingerprints_file);
+  num_read = (GtUword) fread(fingerprints, GT_MD5_FINGERPRINT_SIZE,
+                             (size_t) num_of_md5s, fingerprints_file);
+  if (num_read == num_of_md5s && fgetc(fingerprints_file) != EOF)
+    num_read = 0;
+  if (use_file_locking)
+    gt_fa_unlock(fingerprints_file);
+  gt_fa_xfclose(fingerprints_file);
+  for (i = 0; i < num_read; i++) {
+    if (fingerprints[(i + 1) * GT_MD5_FINGERPRINT_SIZE - 1] != '\0')
+      break;
   }
+  return i;
 }
 
-static void dump_md5_fingerprints(char **md5_fingerprints,
-                                  GtUword num_of_md5s, FILE *outfp)
+typedef struct {
+  const char **seqs;
+  GtUword *seqlens,
+          nextseq,
+          num_of_seqs;
+  char *fingerprints;
+  GtMutex *mutex;
+} GtMD5TabThreadInfo;
+
+static void* md5_tab_thread(void *data)
 {
-  GtUword i;
-  gt_assert(md5_fingerprints && num_of_md5s && outfp);
-  for (i = 0; i < num_of_md5s; i++) {
-    gt_xfputs(md5_fingerprints[i], outfp);
-    gt_xfputc('\0', outfp);
+  GtMD5TabThreadInfo *info = data;
+  GtUword start, end;
+  gt_assert(info);
+  for (;;) {
+    gt_mutex_lock(info->mutex);
+    start = info->nextseq;
+    end = start + GT_MD5_TAB_CHUNKSIZE < info->num_of_seqs
+          ? start + GT_MD5_TAB_CHUNKSIZE : info->num_of_seqs;
+    info->nextseq = end;
+    gt_mutex_unlock(info->mutex);
+    if (start == end)
+      break;
+    gt_md5_fingerprint_multi(info->fingerprints
+                             + start * GT_MD5_FINGERPRINT_SIZE,
+                             info->seqs + start, info->seqlens + start,
+                             end - start);
   }
+  return NULL;
 }
 
-static void write_fingerprints(char **md5_fingerprints,
-                               GtUword num_of_md5s,
-                               GtStr *fingerprints_filename,
-                               bool use_file_locking)
+/* Compute the fingerprints of the sequences from <first_seq> on, in batches
+   which are spread over <gt_jobs> threads. Each batch is appended to
+   <outfp>, if given, as soon as it is complete. */
+static void add_fingerprints(char *fingerprints, void *seqs,
+                             GtGetSeqFunc get_seq, GtGetSeqLenFunc get_seq_len,
+                             GtUword first_seq, GtUword num_of_seqs,
+                             FILE *outfp)
 {
-  FILE *fingerprints_file;
-  gt_assert(md5_fingerprints && num_of_md5s && fingerprints_filename);
-  fingerprints_file = gt_fa_xfopen(gt_str_get(fingerprints_filename), "w");
-  if (use_file_locking)
-    gt_fa_lock_exclusive(fingerprints_file);
-  dump_md5_fingerprints(md5_fingerprints, num_of_md5s, fingerprints_file);
-  if (use_file_locking)
-    gt_fa_unlock(fingerprints_file);
-  gt_fa_xfclose(fingerprints_file);
+  GtMD5TabThreadInfo info;
+  GtUword i, start;
+  GtError *err;
+  gt_assert(fingerprints && seqs && get_seq && get_seq_len);
+  info.seqs = gt_malloc(sizeof (*info.seqs) * GT_MD5_TAB_BATCHSIZE);
+  info.seqlens = gt_malloc(sizeof (*info.seqlens) * GT_MD5_TAB_BATCHSIZE);
+  info.mutex = gt_mutex_new();
+  err = gt_error_new();
+  for (start = first_seq; start < num_of_seqs;
+       start += GT_MD5_TAB_BATCHSIZE) {
+    info.num_of_seqs = num_of_seqs - start < GT_MD5_TAB_BATCHSIZE
+                       ? num_of_seqs - start : GT_MD5_TAB_BATCHSIZE;
+    /* the sequences are fetched in the main thread, because <get_seq> may
+       load them on demand */
+    for (i = 0; i < info.num_of_seqs; i++) {
+      info.seqs[i] = get_seq(seqs, start + i);
+      info.seqlens[i] = get_seq_len(seqs, start + i);
+    }
+    info.fingerprints = fingerprints + start * GT_MD5_FINGERPRINT_SIZE;
+    info.nextseq = 0;
+    /* if no threads can be started, the batch is hashed sequentially */
+    if (gt_jobs == 1U || info.num_of_seqs <= GT_MD5_TAB_CHUNKSIZE ||
+        gt_multithread(md5_tab_thread, &info, err) != 0) {
+      (void) md5_tab_thread(&info);
+    }
+    if (outfp) {
+      gt_xfwrite(info.fingerprints, GT_MD5_FINGERPRINT_SIZE,
+                 (size_t) info.num_of_seqs, outfp);
+      gt_xfflush(outfp);
+    }
+  }
+  gt_error_delete(err);
+  gt_mutex_delete(info.mutex);
+  gt_free(info.seqlens);
+  gt_free(info.seqs);
 }
 
 GtMD5Tab* gt_md5_tab_new(const char *sequence_file, void *seqs,
@@ -104,7 +178,7 @@ GtMD5Tab* gt_md5_tab_new(const char *sequence_file, void *seqs,
                          bool use_file_locking)
 {
   GtMD5Tab *md5_tab;
-  bool reading_succeeded = false;
+  bool reading_succeeded = false, cache_is_current = false;
   GtStr *fingerprints_filename;
   gt_assert(sequence_file && seqs && get_seq && get_seq_len);
   md5_tab = gt_calloc(1, sizeof *md5_tab);
@@ -115,18 +189,37 @@ GtMD5Tab* gt_md5_tab_new(const char *sequence_file, void *seqs,
       !gt_file_is_newer(sequence_file, gt_str_get(fingerprints_filename))) {
     /* only try to read the fingerprint file if the sequence file was not
        modified in the meantime */
+    cache_is_current = true;
     reading_succeeded = read_fingerprints(md5_tab,
                                           gt_str_get(fingerprints_filename),
                                           use_file_locking);
   }
   if (!reading_succeeded) {
-    md5_tab->md5_fingerprints = gt_calloc(num_of_seqs, sizeof (char*));
-    add_fingerprints(md5_tab->md5_fingerprints, seqs, get_seq, get_seq_len,
-                     num_of_seqs);
+    GtUword num_cached = 0;
+    FILE *fingerprints_file = NULL;
+    md5_tab->fingerprints = gt_malloc(sizeof (char) * GT_MD5_FINGERPRINT_SIZE
+                                      * (num_of_seqs ? num_of_seqs : 1));
     md5_tab->owns_md5s = true;
+    if (cache_is_current) {
+      /* keep the fingerprints of an incompletely written cache file */
+      num_cached = read_fingerprints_prefix(md5_tab->fingerprints,
+                                            num_of_seqs,
+                                            gt_str_get(fingerprints_filename),
+                                            use_file_locking);
+    }
     if (use_cache_file) {
-      write_fingerprints(md5_tab->md5_fingerprints, md5_tab->num_of_md5s,
-                         fingerprints_filename, use_file_locking);
+      fingerprints_file = gt_fa_xfopen(gt_str_get(fingerprints_filename), "w");
+      if (use_file_locking)
+        gt_fa_lock_exclusive(fingerprints_file);
+      gt_xfwrite(md5_tab->fingerprints, GT_MD5_FINGERPRINT_SIZE,
+                 (size_t) num_cached, fingerprints_file);
+    }
+    add_fingerprints(md5_tab->fingerprints, seqs, get_seq, get_seq_len,
+                     num_cached, num_of_seqs, fingerprints_file);
+    if (use_cache_file) {
+      if (use_file_locking)
+        gt_fa_unlock(fingerprints_file);
+      gt_fa_xfclose(fingerprints_file);
     }
   }
   gt_str_delete(fingerprints_filename);
@@ -169,30 +262,25 @@ GtMD5Tab* gt_md5_tab_ref(GtMD5Tab *md5_tab)
 
 void gt_md5_tab_delete(GtMD5Tab *md5_tab)
 {
-  GtUword i;
   if (!md5_tab) return;
   if (md5_tab->reference_count) {
     md5_tab->reference_count--;
     return;
   }
-  gt_fa_xmunmap(md5_tab->fingerprints);
+  if (md5_tab->owns_md5s)
+    gt_free(md5_tab->fingerprints);
+  else
+    gt_fa_xmunmap(md5_tab->fingerprints);
   gt_fa_unlock(md5_tab->fingerprints_file);
   gt_fa_xfclose(md5_tab->fingerprints_file);
   gt_hashmap_delete(md5_tab->md5map);
-  if (md5_tab->owns_md5s) {
-    for (i = 0; i < md5_tab->num_of_md5s; i++)
-      gt_free(md5_tab->md5_fingerprints[i]);
-    gt_free(md5_tab->md5_fingerprints);
-  }
   gt_free(md5_tab);
 }
 
 const char* gt_md5_tab_get(const GtMD5Tab *md5_tab, GtUword idx)
 {
   gt_assert(md5_tab && idx < md5_tab->num_of_md5s);
-  if (md5_tab->owns_md5s)
-    return md5_tab->md5_fingerprints[idx];
- return md5_tab->fingerprints + idx * 33;
+  return md5_tab->fingerprints + idx * GT_MD5_FINGERPRINT_SIZE;
 }
 
 static void build_md5map(GtMD5Tab *md5_tab)
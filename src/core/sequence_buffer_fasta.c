@@ -17,6 +17,7 @@
 */
 
 #include <ctype.h>
+#include <string.h>
 #include "core/cstr_api.h"
 #include "core/sequence_buffer_fasta.h"
 #include "core/sequence_buffer_rep.h"
@@ -38,10 +39,34 @@ struct GtSequenceBufferFasta {
 #define gt_sequence_buffer_fasta_cast(SB)\
         gt_sequence_buffer_cast(gt_sequence_buffer_fasta_class(), SB)
 
+/* Returns the number of characters from the current position of the input
+   buffer which can be processed without the state machine of
+   <gt_sequence_buffer_fasta_advance()>: in a description, all characters
+   up to the next line break, in a sequence, all characters up to the next
+   white space or separator, but no more than fit into the output buffer. */
+static inline GtUword fasta_scan_block(GtSequenceBuffer *sb,
+                                       GtUword currentoutpos)
+{
+  GtSequenceBufferMembers *pvt = sb->pvt;
+  const unsigned char *buf = pvt->inbuf + pvt->currentinpos;
+  GtUword length = pvt->currentfillpos - pvt->currentinpos;
+  const unsigned char *newline;
+
+  if (((GtSequenceBufferFasta*) sb)->indesc)
+  {
+    newline = memchr(buf, NEWLINESYMBOL, (size_t) length);
+    return newline != NULL ? (GtUword) (newline - buf) : length;
+  }
+  if (length > (GtUword) OUTBUFSIZE - currentoutpos)
+    length = (GtUword) OUTBUFSIZE - currentoutpos;
+  return inlinebuf_seqrun(buf, length, (unsigned char) FASTASEPARATOR);
+}
+
 static int gt_sequence_buffer_fasta_advance(GtSequenceBuffer *sb, GtError *err)
 {
   int currentchar, ret = 0;
-  GtUword currentoutpos = 0, currentfileadd = 0, currentfileread = 0;
+  GtUword currentoutpos = 0, currentfileadd = 0, currentfileread = 0,
+          runlength;
   GtSequenceBufferMembers *pvt;
   GtSequenceBufferFasta *sbf;
 
@@ -80,6 +105,29 @@ static int gt_sequence_buffer_fasta_advance(GtSequenceBuffer *sb, GtError *err)
                                        "rb");
       pvt->currentinpos = 0;
       pvt->currentfillpos = 0;
+    } else if (!pvt->use_ungetchar && pvt->currentinpos < pvt->currentfillpos
+               && (runlength = fasta_scan_block(sb, currentoutpos)) > 0)
+    {
+      /* a run of sequence or description characters without line breaks
+         from the input buffer */
+      const unsigned char *run = pvt->inbuf + pvt->currentinpos;
+      if (!sbf->indesc)
+      {
+        if ((ret = process_run(sb, currentoutpos, run, runlength, err)))
+          return ret;
+        currentoutpos += runlength;
+        currentfileadd += runlength;
+      } else if (pvt->descptr != NULL)
+      {
+        GtUword idx;
+        for (idx = 0; idx < runlength; idx++)
+        {
+          if (run[idx] != CRSYMBOL)
+            gt_desc_buffer_append_char(pvt->descptr, (char) run[idx]);
+        }
+      }
+      pvt->currentinpos += runlength;
+      currentfileread += runlength;
     } else
     {
       currentchar = inlinebuf_getchar(sb, pvt->inputstream);
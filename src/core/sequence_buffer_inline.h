@@ -19,6 +19,10 @@
 #ifndef SEQUENCE_BUFFER_INLINE_H
 #define SEQUENCE_BUFFER_INLINE_H
 
+#include <string.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 #include "core/compat.h"
 #include "core/file.h"
 #include "core/sequence_buffer_rep.h"
@@ -57,6 +61,72 @@
   return 0;
 }
 
+/* Like <process_char()> for the <runlength> characters at <run>, which must
+   not contain line breaks. */
+/*@unused@*/ static inline int process_run(GtSequenceBuffer *sb,
+                                           GtUword currentoutpos,
+                                           const unsigned char *run,
+                                           GtUword runlength,
+                                           GtError *err)
+{
+  GtSequenceBufferMembers *pvt;
+  unsigned char charcode, *outptr;
+  GtUword idx;
+  pvt = sb->pvt;
+  memcpy(pvt->outbuforig + currentoutpos, run, (size_t) runlength);
+  outptr = pvt->outbuf + currentoutpos;
+  if (pvt->symbolmap != NULL) {
+    for (idx = 0; idx < runlength; idx++) {
+      charcode = pvt->symbolmap[run[idx]];
+      if (charcode == UNDEFCHAR) {
+        pvt->counter += idx;
+        return process_char(sb, currentoutpos + idx, run[idx], err);
+      }
+      if (ISSPECIAL((GtUchar) charcode)) {
+        pvt->lastspeciallength++;
+      } else {
+        pvt->lastspeciallength = 0;
+        if (pvt->chardisttab != NULL)
+          pvt->chardisttab[(int) charcode]++;
+      }
+      outptr[idx] = charcode;
+    }
+  } else
+    memcpy(outptr, run, (size_t) runlength);
+  pvt->counter += runlength;
+  return 0;
+}
+
+/* Returns the length of the prefix of the <length> characters at <buf> which
+   consists of characters greater than the blank, except for <stopchar>. All
+   white space characters and all line breaks end such a prefix. With SSE2,
+   16 characters are compared at once. */
+/*@unused@*/ static inline GtUword inlinebuf_seqrun(const unsigned char *buf,
+                                                   GtUword length,
+                                                   unsigned char stopchar)
+{
+  GtUword idx = 0;
+#ifdef __SSE2__
+  const __m128i blank = _mm_set1_epi8(' '),
+                stop = _mm_set1_epi8((char) stopchar);
+  __m128i block, special;
+  int mask;
+
+  for (/* Nothing */; idx + 16 <= length; idx += 16) {
+    block = _mm_loadu_si128((const __m128i *) (buf + idx));
+    /* the unsigned minimum equals the character iff it is <= ' ' */
+    special = _mm_or_si128(_mm_cmpeq_epi8(_mm_min_epu8(block, blank), block),
+                           _mm_cmpeq_epi8(block, stop));
+    if ((mask = _mm_movemask_epi8(special)) != 0)
+      return idx + (GtUword) __builtin_ctz((unsigned int) mask);
+  }
+#endif
+  while (idx < length && buf[idx] > (unsigned char) ' ' &&
+         buf[idx] != stopchar)
+    idx++;
+  return idx;
+}
+
 /*@unused@*/ static inline int inlinebuf_getchar(GtSequenceBuffer *sb,
                                                  GtFile *f)
 {
@@ -15,6 +15,9 @@
   h
 */
 
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
 #include "core/alphabet_api.h"
 #include "core/arraydef.h"
 #include "core/bittab_api.h"
@@ -22,17 +25,24 @@
 #include "core/encseq_api.h"
 #include "core/ensure.h"
 #include "core/error_api.h"
+#include "core/fa.h"
+#include "core/fileutils_api.h"
 #include "core/intbits.h"
 #include "core/log_api.h"
 #include "core/logger.h"
 #include "core/ma.h"
 #include "core/ma_api.h"
+#include "core/mapspec.h"
 #include "core/mathsupport.h"
+#include "core/md5_encoder_api.h"
+#include "core/minmax.h"
 #include "core/radix_sort.h"
 #include "core/range_api.h"
+#include "core/str_api.h"
 #include "core/types_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
+#include "core/xansi_api.h"
 #include "extended/kmer_database.h"
 #include "match/sfx-mappedstr.h"
 
@@ -58,6 +68,7 @@ struct GtKmerDatabase {
                 *positions;
  GtBittab       *deleted_positions;
  GtUword        nu_kmer_codes,
+                covered_length,
                 initial_size,
                 current_size,
                 seen_kmers,
@@ -67,9 +78,11 @@ struct GtKmerDatabase {
                 min_nu_occ,
                 min_code,
                 prune_interval;
+ unsigned int   alphabet_size;
  bool           cutoff_is_set,
                 mean_cutoff,
                 prune_is_set;
+ void           *mapped;
  GtSortedBuffer sb;
 };
 
@@ -81,7 +94,10 @@ GtKmerDatabase* gt_kmer_database_new(unsigned int alpabet_size,
   GtKmerDatabase *kdb = gt_malloc(sizeof (*kdb));
   gt_assert(encseq != NULL);
   gt_assert((GtUword) kmer_size < gt_encseq_total_length(encseq));
+  kdb->alphabet_size = alpabet_size;
   kdb->nu_kmer_codes = gt_power_for_small_exponents(alpabet_size, kmer_size);
+  kdb->covered_length = 0;
+  kdb->mapped = NULL;
   kdb->offset = gt_calloc((size_t) (kdb->nu_kmer_codes + 1),
                          sizeof (*kdb->offset));
   kdb->seen_kmer_counts = gt_calloc((size_t) (kdb->nu_kmer_codes + 1),
@@ -124,9 +140,13 @@ GtKmerDatabase* gt_kmer_database_new(unsigned int alpabet_size,
 void gt_kmer_database_delete(GtKmerDatabase *kdb)
 {
   if (kdb != NULL) {
-    gt_free(kdb->offset);
-    gt_free(kdb->seen_kmer_counts);
-    gt_free(kdb->positions);
+    if (kdb->mapped != NULL)
+      gt_fa_xmunmap(kdb->mapped);
+    else {
+      gt_free(kdb->offset);
+      gt_free(kdb->seen_kmer_counts);
+      gt_free(kdb->positions);
+    }
     gt_free(kdb->sb.kmers);
     gt_bittab_delete(kdb->deleted_positions);
     GT_FREEARRAY(kdb->sb.intervals, GtRange);
@@ -143,6 +163,39 @@ static void gt_kmer_database_intervals_reset(GtKmerDatabase *kdb)
   kdb->sb.intervals_kmer_count = 0;
 }
 
+/* A database read from file points into the mapped file. Before it is
+   changed, its tables are copied to the heap. */
+static void gt_kmer_database_unmap(GtKmerDatabase *kdb)
+{
+  GtUword *offset,
+          *seen_kmer_counts,
+          *positions,
+          kmer_count;
+
+  gt_assert(kdb != NULL);
+
+  if (kdb->mapped == NULL)
+    return;
+  kmer_count = kdb->offset[kdb->nu_kmer_codes];
+  offset = gt_malloc((size_t) (kdb->nu_kmer_codes + 1) * sizeof (*offset));
+  memcpy(offset, kdb->offset,
+         (size_t) (kdb->nu_kmer_codes + 1) * sizeof (*offset));
+  seen_kmer_counts = gt_malloc((size_t) (kdb->nu_kmer_codes + 1) *
+                               sizeof (*seen_kmer_counts));
+  memcpy(seen_kmer_counts, kdb->seen_kmer_counts,
+         (size_t) (kdb->nu_kmer_codes + 1) * sizeof (*seen_kmer_counts));
+  kdb->current_size = kmer_count + kdb->initial_size;
+  positions = gt_malloc((size_t) kdb->current_size * sizeof (*positions));
+  if (kmer_count > 0)
+    memcpy(positions, kdb->positions,
+           (size_t) kmer_count * sizeof (*positions));
+  gt_fa_xmunmap(kdb->mapped);
+  kdb->mapped = NULL;
+  kdb->offset = offset;
+  kdb->seen_kmer_counts = seen_kmer_counts;
+  kdb->positions = positions;
+}
+
 static void gt_kmer_database_increase_size(GtKmerDatabase *kdb)
 {
   gt_assert(kdb != NULL);
@@ -226,6 +279,8 @@ static void gt_kmer_database_prune(GtKmerDatabase *kdb)
 
   gt_assert(kdb != NULL);
 
+  gt_kmer_database_unmap(kdb);
+
   for (code = 0; code < kdb->nu_kmer_codes; code++) {
     current_left = kdb->offset[code];
     right = kdb->offset[code + 1];
@@ -272,6 +327,8 @@ static void gt_kmer_database_merge(GtKmerDatabase *kdb)
 
   gt_assert(kdb != NULL);
 
+  gt_kmer_database_unmap(kdb);
+
   size_sb = kdb->sb.kmer_count;
   gt_kmer_database_preprocess_buffer(kdb);
   preprocessed_size = kdb->sb.preprocessed_kmer_count;
@@ -406,6 +463,7 @@ void gt_kmer_database_add_interval(GtKmerDatabase *kdb,
 
   gt_assert(kdb != NULL);
   gt_assert(start < end + 1 - (kdb->sb.kmer_size - 1));
+  gt_assert(start >= kdb->covered_length);
 
   if (kdb->sb.intervals_kmer_count > 0) {
     GT_UNUSED GtUword prev = kdb->sb.intervals->nextfreeGtRange - 1;
@@ -438,6 +496,8 @@ void gt_kmer_database_add_interval(GtKmerDatabase *kdb,
   new.end = original_end;
   GT_STOREINARRAY(kdb->sb.intervals, GtRange, 10, new);
   kdb->sb.intervals_kmer_count += interval_size;
+  kdb->covered_length = MIN(original_end + 1,
+                            gt_encseq_total_length(kdb->sb.es));
 }
 
 void gt_kmer_database_add_kmer(GtKmerDatabase *kdb,
@@ -452,6 +512,7 @@ void gt_kmer_database_add_kmer(GtKmerDatabase *kdb,
   gt_assert(kdb != NULL);
   gt_assert(kmercode < kdb->nu_kmer_codes);
 
+  gt_kmer_database_unmap(kdb);
   kdb->current_size++;
   if (kdb->positions == NULL) {
     kdb->positions = gt_malloc((size_t) (GtUword) 100 *
@@ -664,6 +725,311 @@ GtUword gt_kmer_database_get_used_size(GtKmerDatabase *kdb)
     ((GtUword) sizeof (GtUword) * (kdb->nu_kmer_codes + 1)) - 1;
 }
 
+GtUword gt_kmer_database_get_covered_length(GtKmerDatabase *kdb)
+{
+  gt_assert(kdb != NULL);
+
+  return kdb->covered_length;
+}
+
+/* Layout of a database file: a header of GT_KMER_DATABASE_HEADERSIZE words,
+   starting with a magic number and the version of the format, followed by
+   the offset table and the table of seen kmer counts (each with
+   nu_kmer_codes + 1 entries) and the positions without any free space.
+   The header ends with the MD5 digest of the encoded characters of the
+   covered prefix, stored as four 32-bit values, so that a database is only
+   mapped for an encoded sequence with the same prefix. */
+#define GT_KMER_DATABASE_MAGIC   ((GtUword) 0x3042444bUL) /* "KDB0" */
+#define GT_KMER_DATABASE_VERSION ((GtUword) 2)
+#define GT_KMER_DATABASE_FINGERPRINT_WORDS 4
+#define GT_KMER_DATABASE_TMP_SUFFIX ".tmp"
+
+enum {
+  GT_KMER_DATABASE_HEADER_MAGIC = 0,
+  GT_KMER_DATABASE_HEADER_VERSION,
+  GT_KMER_DATABASE_HEADER_ALPHABETSIZE,
+  GT_KMER_DATABASE_HEADER_KMERSIZE,
+  GT_KMER_DATABASE_HEADER_KMERCOUNT,
+  GT_KMER_DATABASE_HEADER_SEENKMERS,
+  GT_KMER_DATABASE_HEADER_MINNUOCC,
+  GT_KMER_DATABASE_HEADER_MINCODE,
+  GT_KMER_DATABASE_HEADER_COVEREDLENGTH,
+  GT_KMER_DATABASE_HEADER_FINGERPRINT,
+  GT_KMER_DATABASE_HEADERSIZE =
+    GT_KMER_DATABASE_HEADER_FINGERPRINT + GT_KMER_DATABASE_FINGERPRINT_WORDS
+};
+
+typedef struct {
+  GtUword *header,
+          *offset,
+          *seen_kmer_counts,
+          *positions,
+          nu_kmer_codes,
+          kmer_count;
+} GtKmerDatabaseMapinfo;
+
+static void gt_kmer_database_header_setup_mapspec(GtMapspec *mapspec,
+                                                  void *data,
+                                                  GT_UNUSED bool write)
+{
+  GtKmerDatabaseMapinfo *mapinfo = data;
+
+  gt_mapspec_add_ulong(mapspec, mapinfo->header,
+                       (GtUword) GT_KMER_DATABASE_HEADERSIZE);
+}
+
+static void gt_kmer_database_data_setup_mapspec(GtMapspec *mapspec,
+                                                void *data,
+                                                bool write)
+{
+  GtKmerDatabaseMapinfo *mapinfo = data;
+
+  gt_kmer_database_header_setup_mapspec(mapspec, data, write);
+  gt_mapspec_add_ulong(mapspec, mapinfo->offset, mapinfo->nu_kmer_codes + 1);
+  gt_mapspec_add_ulong(mapspec, mapinfo->seen_kmer_counts,
+                       mapinfo->nu_kmer_codes + 1);
+  gt_mapspec_add_ulong(mapspec, mapinfo->positions, mapinfo->kmer_count);
+}
+
+static GtUword gt_kmer_database_file_size(GtUword nu_kmer_codes,
+                                          GtUword kmer_count)
+{
+  return (GtUword) sizeof (GtUword) *
+         (GT_KMER_DATABASE_HEADERSIZE + 2 * (nu_kmer_codes + 1) + kmer_count);
+}
+
+static void gt_kmer_database_fingerprint(const GtEncseq *encseq,
+                                         GtUword length, GtUword *fingerprint)
+{
+  GtMD5Encoder *enc = gt_md5_encoder_new();
+  GtEncseqReader *esr;
+  unsigned char digest[16];
+  char buf[64];
+  GtUword pos, idx = 0;
+  unsigned int i;
+
+  esr = gt_encseq_create_reader_with_readmode(encseq, GT_READMODE_FORWARD, 0);
+  for (pos = 0; pos < length; pos++) {
+    buf[idx++] = (char) gt_encseq_reader_next_encoded_char(esr);
+    if (idx == (GtUword) sizeof (buf)) {
+      gt_md5_encoder_add_block(enc, buf, idx);
+      idx = 0;
+    }
+  }
+  gt_md5_encoder_add_block(enc, buf, idx);
+  gt_md5_encoder_finish(enc, digest, NULL);
+  for (i = 0; i < (unsigned int) GT_KMER_DATABASE_FINGERPRINT_WORDS; i++) {
+    fingerprint[i] = ((GtUword) digest[4 * i] << 24) |
+                     ((GtUword) digest[4 * i + 1] << 16) |
+                     ((GtUword) digest[4 * i + 2] << 8) |
+                     (GtUword) digest[4 * i + 3];
+  }
+  gt_encseq_reader_delete(esr);
+  gt_md5_encoder_delete(enc);
+}
+
+int gt_kmer_database_write(GtKmerDatabase *kdb, const char *indexname,
+                           GtError *err)
+{
+  int had_err = 0;
+  GtUword header[GT_KMER_DATABASE_HEADERSIZE];
+  GtKmerDatabaseMapinfo mapinfo;
+  GtStr *filename, *tmpfilename;
+  FILE *fp;
+
+  gt_error_check(err);
+  gt_assert(kdb != NULL && indexname != NULL);
+
+  gt_kmer_database_flush(kdb);
+  if (kdb->cutoff_is_set)
+    gt_kmer_database_prune(kdb);
+  header[GT_KMER_DATABASE_HEADER_MAGIC] = GT_KMER_DATABASE_MAGIC;
+  header[GT_KMER_DATABASE_HEADER_VERSION] = GT_KMER_DATABASE_VERSION;
+  header[GT_KMER_DATABASE_HEADER_ALPHABETSIZE] = (GtUword) kdb->alphabet_size;
+  header[GT_KMER_DATABASE_HEADER_KMERSIZE] = (GtUword) kdb->sb.kmer_size;
+  header[GT_KMER_DATABASE_HEADER_KMERCOUNT] = kdb->offset[kdb->nu_kmer_codes];
+  header[GT_KMER_DATABASE_HEADER_SEENKMERS] = kdb->seen_kmers;
+  header[GT_KMER_DATABASE_HEADER_MINNUOCC] = kdb->min_nu_occ;
+  header[GT_KMER_DATABASE_HEADER_MINCODE] = kdb->min_code;
+  header[GT_KMER_DATABASE_HEADER_COVEREDLENGTH] = kdb->covered_length;
+  gt_kmer_database_fingerprint(kdb->sb.es, kdb->covered_length,
+                               header + GT_KMER_DATABASE_HEADER_FINGERPRINT);
+  mapinfo.header = header;
+  mapinfo.offset = kdb->offset;
+  mapinfo.seen_kmer_counts = kdb->seen_kmer_counts;
+  mapinfo.positions = kdb->positions;
+  mapinfo.nu_kmer_codes = kdb->nu_kmer_codes;
+  mapinfo.kmer_count = header[GT_KMER_DATABASE_HEADER_KMERCOUNT];
+
+  /* <kdb> may be mapped from the file to be written, so write to a temporary
+     file first and replace the file afterwards */
+  filename = gt_str_new_cstr(indexname);
+  gt_str_append_cstr(filename, GT_KMER_DATABASE_FILE_SUFFIX);
+  tmpfilename = gt_str_clone(filename);
+  gt_str_append_cstr(tmpfilename, GT_KMER_DATABASE_TMP_SUFFIX);
+  fp = gt_fa_fopen(gt_str_get(tmpfilename), "wb", err);
+  if (fp == NULL)
+    had_err = -1;
+  if (!had_err) {
+    had_err = gt_mapspec_write(gt_kmer_database_data_setup_mapspec, fp,
+                               &mapinfo,
+                               gt_kmer_database_file_size(mapinfo.nu_kmer_codes,
+                                                          mapinfo.kmer_count),
+                               err);
+    gt_fa_fclose(fp);
+    if (!had_err &&
+        rename(gt_str_get(tmpfilename), gt_str_get(filename)) != 0) {
+      gt_error_set(err, "cannot rename %s to %s: %s", gt_str_get(tmpfilename),
+                   gt_str_get(filename), strerror(errno));
+      had_err = -1;
+    }
+    if (had_err)
+      (void) remove(gt_str_get(tmpfilename));
+  }
+  gt_str_delete(tmpfilename);
+  gt_str_delete(filename);
+  return had_err;
+}
+
+GtKmerDatabase* gt_kmer_database_new_from_file(const char *indexname,
+                                               unsigned int kmer_size,
+                                               GtUword sb_max_nu_kmers,
+                                               GtEncseq *encseq,
+                                               GtError *err)
+{
+  int had_err = 0;
+  GtKmerDatabase *kdb = NULL;
+  GtKmerDatabaseMapinfo mapinfo;
+  GtUword header[GT_KMER_DATABASE_HEADERSIZE],
+          fingerprint[GT_KMER_DATABASE_FINGERPRINT_WORDS],
+          code;
+  void *mapped = NULL;
+  GtStr *filename = gt_str_new_cstr(indexname);
+
+  gt_error_check(err);
+  gt_assert(encseq != NULL);
+
+  gt_str_append_cstr(filename, GT_KMER_DATABASE_FILE_SUFFIX);
+  if (!gt_file_exists(gt_str_get(filename))) {
+    gt_error_set(err, "file %s does not exist", gt_str_get(filename));
+    had_err = -1;
+  }
+  if (!had_err && gt_file_size(gt_str_get(filename)) <
+      (off_t) (sizeof (GtUword) * GT_KMER_DATABASE_HEADERSIZE)) {
+    gt_error_set(err, "file %s is not a kmer database: file too short",
+                 gt_str_get(filename));
+    had_err = -1;
+  }
+  if (!had_err) {
+    had_err = gt_mapspec_read_header(gt_kmer_database_header_setup_mapspec,
+                                     &mapinfo, gt_str_get(filename),
+                                     (GtUword) sizeof (GtUword) *
+                                     GT_KMER_DATABASE_HEADERSIZE,
+                                     &mapped, err);
+    if (!had_err)
+      memcpy(header, mapinfo.header, sizeof (header));
+    gt_fa_xmunmap(mapped);
+    mapped = NULL;
+  }
+  if (!had_err && header[GT_KMER_DATABASE_HEADER_MAGIC] !=
+      GT_KMER_DATABASE_MAGIC) {
+    gt_error_set(err, "file %s is not a kmer database: wrong magic number",
+                 gt_str_get(filename));
+    had_err = -1;
+  }
+  if (!had_err && header[GT_KMER_DATABASE_HEADER_VERSION] !=
+      GT_KMER_DATABASE_VERSION) {
+    gt_error_set(err, "kmer database %s has format version " GT_WU
+                 ", expected version " GT_WU, gt_str_get(filename),
+                 header[GT_KMER_DATABASE_HEADER_VERSION],
+                 GT_KMER_DATABASE_VERSION);
+    had_err = -1;
+  }
+  if (!had_err && header[GT_KMER_DATABASE_HEADER_ALPHABETSIZE] !=
+      (GtUword) gt_alphabet_num_of_chars(gt_encseq_alphabet(encseq))) {
+    gt_error_set(err, "kmer database %s uses alphabet size " GT_WU ", but "
+                 "the alphabet of the given encoded sequence has size %u",
+                 gt_str_get(filename),
+                 header[GT_KMER_DATABASE_HEADER_ALPHABETSIZE],
+                 gt_alphabet_num_of_chars(gt_encseq_alphabet(encseq)));
+    had_err = -1;
+  }
+  if (!had_err && header[GT_KMER_DATABASE_HEADER_KMERSIZE] !=
+      (GtUword) kmer_size) {
+    gt_error_set(err, "kmer database %s uses kmersize " GT_WU ", but kmersize "
+                 "%u was requested", gt_str_get(filename),
+                 header[GT_KMER_DATABASE_HEADER_KMERSIZE], kmer_size);
+    had_err = -1;
+  }
+  if (!had_err && header[GT_KMER_DATABASE_HEADER_COVEREDLENGTH] >
+      gt_encseq_total_length(encseq)) {
+    gt_error_set(err, "kmer database %s was not built for a prefix of the "
+                 "given encoded sequence", gt_str_get(filename));
+    had_err = -1;
+  }
+  if (!had_err && (GtUword) header[GT_KMER_DATABASE_HEADER_KMERSIZE] >=
+      gt_encseq_total_length(encseq)) {
+    gt_error_set(err, "kmer database %s uses kmersize " GT_WU " which is too "
+                 "large for the given encoded sequence", gt_str_get(filename),
+                 header[GT_KMER_DATABASE_HEADER_KMERSIZE]);
+    had_err = -1;
+  }
+  if (!had_err) {
+    gt_kmer_database_fingerprint(encseq,
+                                 header[GT_KMER_DATABASE_HEADER_COVEREDLENGTH],
+                                 fingerprint);
+    if (memcmp(fingerprint, header + GT_KMER_DATABASE_HEADER_FINGERPRINT,
+               sizeof (fingerprint)) != 0) {
+      gt_error_set(err, "kmer database %s was not built for a prefix of the "
+                   "given encoded sequence: fingerprint of the first " GT_WU
+                   " characters differs", gt_str_get(filename),
+                   header[GT_KMER_DATABASE_HEADER_COVEREDLENGTH]);
+      had_err = -1;
+    }
+  }
+  if (!had_err) {
+    kdb = gt_kmer_database_new((unsigned int)
+                                 header[GT_KMER_DATABASE_HEADER_ALPHABETSIZE],
+                               (unsigned int)
+                                 header[GT_KMER_DATABASE_HEADER_KMERSIZE],
+                               sb_max_nu_kmers, encseq);
+    mapinfo.nu_kmer_codes = kdb->nu_kmer_codes;
+    mapinfo.kmer_count = header[GT_KMER_DATABASE_HEADER_KMERCOUNT];
+    had_err = gt_mapspec_read(gt_kmer_database_data_setup_mapspec, &mapinfo,
+                              gt_str_get(filename),
+                              gt_kmer_database_file_size(mapinfo.nu_kmer_codes,
+                                                         mapinfo.kmer_count),
+                              &mapped, err);
+  }
+  if (!had_err) {
+    gt_free(kdb->offset);
+    gt_free(kdb->seen_kmer_counts);
+    kdb->mapped = mapped;
+    kdb->offset = mapinfo.offset;
+    kdb->seen_kmer_counts = mapinfo.seen_kmer_counts;
+    kdb->positions = mapinfo.positions;
+    kdb->current_size = header[GT_KMER_DATABASE_HEADER_KMERCOUNT];
+    kdb->seen_kmers = header[GT_KMER_DATABASE_HEADER_SEENKMERS];
+    kdb->min_nu_occ = header[GT_KMER_DATABASE_HEADER_MINNUOCC];
+    kdb->min_code = header[GT_KMER_DATABASE_HEADER_MINCODE];
+    kdb->covered_length = header[GT_KMER_DATABASE_HEADER_COVEREDLENGTH];
+    /* kmers which were seen but have no positions were removed by a cutoff */
+    for (code = 0; code < kdb->nu_kmer_codes; code++) {
+      if (kdb->seen_kmer_counts[code] > 0 &&
+          kdb->offset[code] == kdb->offset[code + 1])
+        gt_bittab_set_bit(kdb->deleted_positions, code);
+    }
+  }
+  else {
+    if (mapped != NULL)
+      gt_fa_xmunmap(mapped);
+    gt_kmer_database_delete(kdb);
+    kdb = NULL;
+  }
+  gt_str_delete(filename);
+  return kdb;
+}
+
 void gt_kmer_database_print(GtKmerDatabase *kdb, GtLogger *logger, bool verbose)
 {
   GtUword i,
@@ -767,7 +1133,9 @@ int gt_kmer_database_unit_test(GtError *err)
                                      (GtUword) 3,(GtUword) 0};
   GtAlphabet *al = gt_alphabet_new_dna();
   GtEncseqBuilder *eb = gt_encseq_builder_new(al);
-  GtEncseq *es;
+  GtEncseq *es,
+           *prefix_es,
+           *other_es;
   GtKmerDatabase *sb_test,
                  *kdb,
                  *compare_kdb,
@@ -778,6 +1146,10 @@ int gt_kmer_database_unit_test(GtError *err)
 
   gt_encseq_builder_add_cstr(eb, "ACCTAGGTCT", (GtUword) 10, NULL);
   es = gt_encseq_builder_build(eb, err);
+  gt_encseq_builder_add_cstr(eb, "ACCTA", (GtUword) 5, NULL);
+  prefix_es = gt_encseq_builder_build(eb, err);
+  gt_encseq_builder_add_cstr(eb, "ACCTTGGTCT", (GtUword) 10, NULL);
+  other_es = gt_encseq_builder_build(eb, err);
   gt_encseq_builder_delete(eb);
 
   sb_test = gt_kmer_database_new(GT_KMERDB_AS, GT_KMERDB_K,
@@ -892,6 +1264,60 @@ int gt_kmer_database_unit_test(GtError *err)
     k += j;
   }
 
+  /*test if a database can be written, mapped and extended*/
+  if (!had_err) {
+    GtKmerDatabase *prefix_kdb,
+                   *loaded_kdb = NULL;
+    GtStr *tmpfilename = gt_str_new();
+    FILE *tmpfp = gt_xtmpfp(tmpfilename);
+    GtUword prefix_length = gt_encseq_total_length(prefix_es);
+
+    gt_fa_xfclose(tmpfp);
+    prefix_kdb = gt_kmer_database_new(GT_KMERDB_AS, GT_KMERDB_K,
+                                      max_nu_kmers, prefix_es);
+    gt_kmer_database_add_interval(prefix_kdb, 0, prefix_length - 1);
+    had_err = gt_kmer_database_write(prefix_kdb, gt_str_get(tmpfilename), err);
+    if (!had_err) {
+      loaded_kdb = gt_kmer_database_new_from_file(gt_str_get(tmpfilename),
+                                                  GT_KMERDB_K, max_nu_kmers,
+                                                  intervals_too_big->sb.es,
+                                                  err);
+      if (loaded_kdb == NULL)
+        had_err = -1;
+    }
+    if (!had_err) {
+      gt_ensure(gt_kmer_database_get_covered_length(loaded_kdb) ==
+                prefix_length);
+      had_err = gt_kmer_database_compare(loaded_kdb, prefix_kdb, err);
+    }
+    /* a sequence of sufficient length with a different prefix is rejected */
+    if (!had_err) {
+      GtKmerDatabase *other_kdb;
+      other_kdb = gt_kmer_database_new_from_file(gt_str_get(tmpfilename),
+                                                 GT_KMERDB_K, max_nu_kmers,
+                                                 other_es, err);
+      gt_ensure(other_kdb == NULL && gt_error_is_set(err));
+      gt_error_unset(err);
+    }
+    if (!had_err) {
+      gt_kmer_database_add_interval(loaded_kdb, prefix_length,
+                                    seq_length - 1);
+      gt_kmer_database_flush(loaded_kdb);
+      had_err = gt_kmer_database_check_consistency(loaded_kdb, err);
+    }
+    if (!had_err)
+      had_err = gt_kmer_database_compare(loaded_kdb, intervals_too_big, err);
+    gt_kmer_database_delete(prefix_kdb);
+    gt_kmer_database_delete(loaded_kdb);
+    gt_xremove(gt_str_get(tmpfilename));
+    gt_str_append_cstr(tmpfilename, GT_KMER_DATABASE_FILE_SUFFIX);
+    if (gt_file_exists(gt_str_get(tmpfilename)))
+      gt_xremove(gt_str_get(tmpfilename));
+    gt_str_delete(tmpfilename);
+  }
+
+  gt_encseq_delete(prefix_es);
+  gt_encseq_delete(other_es);
   gt_kmer_database_delete(sb_test);
   gt_kmer_database_delete(kdb);
   gt_kmer_database_delete(compare_kdb);
@@ -19,9 +19,12 @@
 
 #include "core/arraydef.h"
 #include "core/codetype.h"
+#include "core/encseq_api.h"
 #include "core/error_api.h"
 #include "core/logger_api.h"
 
+#define GT_KMER_DATABASE_FILE_SUFFIX ".kdb"
+
 /* The <GtKmerDatabase> class stores all kmers occuring in a set of given
    files. Size of k and of the alphabet need to be known beforehand */
 typedef struct GtKmerDatabase GtKmerDatabase;
@@ -42,6 +45,31 @@ GtKmerDatabase* gt_kmer_database_new(unsigned int alpabet_size,
                                      GtUword sb_max_nu_kmers,
                                      GtEncseq *encseq);
 
+/* Returns new <GtKmerDatabase> object read from the file <indexname> with
+   suffix <GT_KMER_DATABASE_FILE_SUFFIX>, which was written by
+   <gt_kmer_database_write()>. The tables are mapped into memory and only
+   copied when kmers are added. <encseq> must be the encoded sequence the
+   database was built for or an extension of it, kmers can only be added from
+   intervals starting at or after <gt_kmer_database_get_covered_length()>.
+   <kmer_size> must equal the kmersize the database was built with.
+   <sb_max_nu_kmers> is the size of the internal buffer as in
+   <gt_kmer_database_new()>. Returns NULL on error, <err> is set accordingly. */
+GtKmerDatabase* gt_kmer_database_new_from_file(const char *indexname,
+                                               unsigned int kmer_size,
+                                               GtUword sb_max_nu_kmers,
+                                               GtEncseq *encseq,
+                                               GtError *err);
+
+/* Flushes the internal buffer of <kdb> and writes its content to the file
+   <indexname> with suffix <GT_KMER_DATABASE_FILE_SUFFIX>. If a cutoff is set,
+   all kmers exceeding it are pruned before writing. The file is replaced only
+   after the database was written completely, so <kdb> may be mapped from
+   it. Returns 0 on success, -1
+   otherwise and <err> is set accordingly. */
+int               gt_kmer_database_write(GtKmerDatabase *kdb,
+                                         const char *indexname,
+                                         GtError *err);
+
 /* Frees space for <GtKmerDatabase>. */
 void              gt_kmer_database_delete(GtKmerDatabase *kdb);
 
@@ -86,6 +114,11 @@ void              gt_kmer_database_set_prune(GtKmerDatabase *kdb);
 /* Returns the number of kmers inserted in the <GtKmerDatabase>. */
 GtUword           gt_kmer_database_get_kmer_count(GtKmerDatabase *kdb);
 
+/* Returns the length of the prefix of the encoded sequence covered by <kdb>,
+   that is 0 for a new database or the length of the encoded sequence a
+   database read from file was written for. */
+GtUword           gt_kmer_database_get_covered_length(GtKmerDatabase *kdb);
+
 /* Returns the arithmetic mean for all kmers inserted in the <GtKmerDatabase>,
    based on the number of different kmers already inserted. If a cutoff is set
    this returns the mean for all kmers which would have been inserted without
@@ -0,0 +1,584 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "core/alphabet.h"
+#include "core/array.h"
+#include "core/chardef.h"
+#include "core/class_alloc_lock.h"
+#include "core/encseq.h"
+#include "core/ensure.h"
+#include "core/intbits.h"
+#include "core/ma.h"
+#include "core/minmax.h"
+#include "core/multithread_api.h"
+#include "core/readmode.h"
+#include "core/thread_api.h"
+#include "core/unused_api.h"
+#include "extended/match_sw.h"
+#include "extended/match_iterator_rep.h"
+#include "extended/match_iterator_seedext.h"
+#include "match/seed-extend.h"
+#include "match/seqabstract.h"
+#include "match/xdrop.h"
+
+/* sensitivity used to derive the xdrop cutoff score from the error rate */
+#define SEEDEXT_SENSITIVITY  93
+
+const GtMatchIteratorClass* gt_match_iterator_seedext_class(void);
+
+#define gt_match_iterator_seedext_cast(M)\
+        gt_match_iterator_cast(gt_match_iterator_seedext_class(), M)
+
+/* a k-mer of the first sequence set */
+typedef struct {
+  GtUword code, seqnum, relpos;
+} GtSeedExtKmer;
+
+/* a seed, <pos1> is relative to sequence <seqnum1> of the first set,
+   <pos2> to the (possibly reverse complemented) query sequence */
+typedef struct {
+  GtUword seqnum1, pos1, pos2;
+} GtSeedExtSeed;
+
+/* a match or an extended region, all positions are inclusive */
+typedef struct {
+  GtUword seqnum1, start1, end1, start2, end2, length, edist;
+  GtMatchDirection dir;
+} GtSeedExtMatch;
+
+typedef struct {
+  GtEncseq *es1, *es2;
+  bool selfcompare;
+  GtUword seedlength,
+          minlength,
+          errorpercentage,
+          num_of_kmers,
+          next_query,
+          seqno2,
+          matchnum;
+  GtXdropscore xdropbelowscore;
+  GtXdropArbitraryscores scores;
+  GtUchar *seqs1;
+  GtSeedExtKmer *kmers;
+  GtArray **matches; /* the matches of each sequence of <es2> */
+  GtMutex *mutex;
+} GtMatchIteratorSeedExtMembers;
+
+struct GtMatchIteratorSeedExt {
+  const GtMatchIterator parent_instance;
+  GtMatchIteratorSeedExtMembers *pvt;
+};
+
+/* the resources of a single thread */
+typedef struct {
+  GtXdropresources *res;
+  GtSeqabstract *useq, *vseq;
+  GtUchar *query;
+  GtUword query_alloc;
+  GtArray *seeds,
+          *regions;
+} GtSeedExtThreadInfo;
+
+static int seedext_kmer_cmp(const void *a, const void *b)
+{
+  const GtSeedExtKmer *ka = a, *kb = b;
+  if (ka->code != kb->code)
+    return ka->code < kb->code ? -1 : 1;
+  if (ka->seqnum != kb->seqnum)
+    return ka->seqnum < kb->seqnum ? -1 : 1;
+  if (ka->relpos != kb->relpos)
+    return ka->relpos < kb->relpos ? -1 : 1;
+  return 0;
+}
+
+static int seedext_seed_cmp(const void *a, const void *b)
+{
+  const GtSeedExtSeed *sa = a, *sb = b;
+  if (sa->seqnum1 != sb->seqnum1)
+    return sa->seqnum1 < sb->seqnum1 ? -1 : 1;
+  if (sa->pos2 != sb->pos2)
+    return sa->pos2 < sb->pos2 ? -1 : 1;
+  if (sa->pos1 != sb->pos1)
+    return sa->pos1 < sb->pos1 ? -1 : 1;
+  return 0;
+}
+
+static int seedext_match_cmp(const void *a, const void *b)
+{
+  const GtSeedExtMatch *ma = a, *mb = b;
+  if (ma->seqnum1 != mb->seqnum1)
+    return ma->seqnum1 < mb->seqnum1 ? -1 : 1;
+  if (ma->dir != mb->dir)
+    return ma->dir == GT_MATCH_DIRECT ? -1 : 1;
+  if (ma->start1 != mb->start1)
+    return ma->start1 < mb->start1 ? -1 : 1;
+  if (ma->start2 != mb->start2)
+    return ma->start2 < mb->start2 ? -1 : 1;
+  if (ma->end1 != mb->end1)
+    return ma->end1 < mb->end1 ? -1 : 1;
+  if (ma->end2 != mb->end2)
+    return ma->end2 < mb->end2 ? -1 : 1;
+  return 0;
+}
+
+static GtUword seedext_code_mask(GtUword seedlength)
+{
+  return seedlength == (GtUword) GT_UNITSIN2BITENC
+         ? ~(GtUword) 0
+         : (((GtUword) 1) << GT_MULT2(seedlength)) - 1;
+}
+
+/* index all k-mers without special characters of the first sequence set */
+static void seedext_build_index(GtMatchIteratorSeedExtMembers *pvt)
+{
+  GtUword seqnum, i, totallength, num_of_sequences, mask, code, valid;
+  GtUword allocated = 0;
+
+  totallength = gt_encseq_total_length(pvt->es1);
+  num_of_sequences = gt_encseq_num_of_sequences(pvt->es1);
+  pvt->seqs1 = gt_malloc(sizeof (GtUchar) * (totallength + 1));
+  if (totallength > 0)
+    gt_encseq_extract_encoded(pvt->es1, pvt->seqs1, 0, totallength - 1);
+  mask = seedext_code_mask(pvt->seedlength);
+  pvt->kmers = NULL;
+  pvt->num_of_kmers = 0;
+  for (seqnum = 0; seqnum < num_of_sequences; seqnum++) {
+    const GtUchar *seq = pvt->seqs1 + gt_encseq_seqstartpos(pvt->es1, seqnum);
+    GtUword seqlength = gt_encseq_seqlength(pvt->es1, seqnum);
+    code = valid = 0;
+    for (i = 0; i < seqlength; i++) {
+      if (ISSPECIAL(seq[i])) {
+        valid = 0;
+        continue;
+      }
+      code = ((code << 2) | seq[i]) & mask;
+      if (++valid >= pvt->seedlength) {
+        if (pvt->num_of_kmers == allocated) {
+          allocated = allocated * 1.2 + 1024;
+          pvt->kmers = gt_realloc(pvt->kmers,
+                                  sizeof (GtSeedExtKmer) * allocated);
+        }
+        pvt->kmers[pvt->num_of_kmers].code = code;
+        pvt->kmers[pvt->num_of_kmers].seqnum = seqnum;
+        pvt->kmers[pvt->num_of_kmers].relpos = i + 1 - pvt->seedlength;
+        pvt->num_of_kmers++;
+      }
+    }
+  }
+  if (pvt->num_of_kmers > 0) {
+    qsort(pvt->kmers, (size_t) pvt->num_of_kmers, sizeof (GtSeedExtKmer),
+          seedext_kmer_cmp);
+  }
+}
+
+/* returns the index of the first k-mer with a code not smaller than <code> */
+static GtUword seedext_lower_bound(const GtMatchIteratorSeedExtMembers *pvt,
+                                   GtUword code)
+{
+  GtUword left = 0, right = pvt->num_of_kmers, mid;
+  while (left < right) {
+    mid = left + GT_DIV2(right - left);
+    if (pvt->kmers[mid].code < code)
+      left = mid + 1;
+    else
+      right = mid;
+  }
+  return left;
+}
+
+static void seedext_collect_seeds(const GtMatchIteratorSeedExtMembers *pvt,
+                                  GtSeedExtThreadInfo *ti, GtUword seqno2,
+                                  GtUword len2)
+{
+  GtUword i, idx, code = 0, valid = 0,
+          mask = seedext_code_mask(pvt->seedlength);
+  GtSeedExtSeed seed;
+
+  gt_array_reset(ti->seeds);
+  for (i = 0; i < len2; i++) {
+    if (ISSPECIAL(ti->query[i])) {
+      valid = 0;
+      continue;
+    }
+    code = ((code << 2) | ti->query[i]) & mask;
+    if (++valid < pvt->seedlength)
+      continue;
+    for (idx = seedext_lower_bound(pvt, code);
+         idx < pvt->num_of_kmers && pvt->kmers[idx].code == code; idx++) {
+      /* in a self comparison, each pair of sequences is compared once */
+      if (pvt->selfcompare && pvt->kmers[idx].seqnum >= seqno2)
+        break;
+      seed.seqnum1 = pvt->kmers[idx].seqnum;
+      seed.pos1 = pvt->kmers[idx].relpos;
+      seed.pos2 = i + 1 - pvt->seedlength;
+      gt_array_add(ti->seeds, seed);
+    }
+  }
+  if (gt_array_size(ti->seeds) > 0) {
+    qsort(gt_array_get_space(ti->seeds), gt_array_size(ti->seeds),
+          sizeof (GtSeedExtSeed), seedext_seed_cmp);
+  }
+}
+
+/* extends <seed> to both sides, stores the extended region in <region> and
+   returns true if it is a match */
+static bool seedext_extend(const GtMatchIteratorSeedExtMembers *pvt,
+                           GtSeedExtThreadInfo *ti,
+                           const GtSeedExtSeed *seed, GtUword len2,
+                           GtSeedExtMatch *region)
+{
+  GtXdropbest left = { 0, 0, 0, 0, 0 }, right = { 0, 0, 0, 0, 0 };
+  const GtUchar *seq1 = pvt->seqs1 + gt_encseq_seqstartpos(pvt->es1,
+                                                           seed->seqnum1);
+  GtUword len1 = gt_encseq_seqlength(pvt->es1, seed->seqnum1),
+          k = pvt->seedlength, alignedlen1, alignedlen2, distance;
+  GtXdropscore score;
+
+  /* the sequences are always given with offset 0, the extension only reads
+     the given ranges */
+  if (seed->pos1 > 0 && seed->pos2 > 0) {
+    gt_seqabstract_reinit_gtuchar(ti->useq, seq1, seed->pos1, 0);
+    gt_seqabstract_reinit_gtuchar(ti->vseq, ti->query, seed->pos2, 0);
+    gt_evalxdroparbitscoresextend(false, &left, ti->res, ti->useq, ti->vseq,
+                                  pvt->xdropbelowscore);
+  }
+  if (seed->pos1 + k < len1 && seed->pos2 + k < len2) {
+    gt_seqabstract_reinit_gtuchar(ti->useq, seq1 + seed->pos1 + k,
+                                  len1 - seed->pos1 - k, 0);
+    gt_seqabstract_reinit_gtuchar(ti->vseq, ti->query + seed->pos2 + k,
+                                  len2 - seed->pos2 - k, 0);
+    gt_evalxdroparbitscoresextend(true, &right, ti->res, ti->useq, ti->vseq,
+                                  pvt->xdropbelowscore);
+  }
+  alignedlen1 = left.ivalue + k + right.ivalue;
+  alignedlen2 = left.jvalue + k + right.jvalue;
+  score = (GtXdropscore) k * pvt->scores.mat + left.score + right.score;
+  gt_assert(score >= 0 && (GtUword) score <= alignedlen1 + alignedlen2);
+  distance = (alignedlen1 + alignedlen2 - (GtUword) score) / 3;
+
+  region->seqnum1 = seed->seqnum1;
+  region->start1 = seed->pos1 - left.ivalue;
+  region->end1 = region->start1 + alignedlen1 - 1;
+  region->start2 = seed->pos2 - left.jvalue;
+  region->end2 = region->start2 + alignedlen2 - 1;
+  region->length = MAX(alignedlen1, alignedlen2);
+  region->edist = distance;
+  return 200 * distance <= pvt->errorpercentage * (alignedlen1 + alignedlen2)
+         && alignedlen1 + alignedlen2 >= GT_MULT2(pvt->minlength);
+}
+
+static bool seedext_seed_is_covered(const GtSeedExtThreadInfo *ti,
+                                    const GtSeedExtSeed *seed, GtUword k)
+{
+  GtUword i;
+  for (i = 0; i < gt_array_size(ti->regions); i++) {
+    const GtSeedExtMatch *region = gt_array_get(ti->regions, i);
+    if (region->seqnum1 == seed->seqnum1 &&
+        region->start1 <= seed->pos1 && seed->pos1 + k - 1 <= region->end1 &&
+        region->start2 <= seed->pos2 && seed->pos2 + k - 1 <= region->end2) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static void seedext_process_query(GtMatchIteratorSeedExtMembers *pvt,
+                                  GtSeedExtThreadInfo *ti, GtUword seqno2)
+{
+  GtUword i, len2, startpos2;
+  GtSeedExtMatch region;
+  GtMatchDirection dir;
+  unsigned int strand;
+
+  pvt->matches[seqno2] = gt_array_new(sizeof (GtSeedExtMatch));
+  len2 = gt_encseq_seqlength(pvt->es2, seqno2);
+  if (len2 < pvt->seedlength)
+    return;
+  if (len2 > ti->query_alloc) {
+    ti->query_alloc = len2;
+    ti->query = gt_realloc(ti->query, sizeof (GtUchar) * ti->query_alloc);
+  }
+  startpos2 = gt_encseq_seqstartpos(pvt->es2, seqno2);
+  gt_encseq_extract_encoded(pvt->es2, ti->query, startpos2,
+                            startpos2 + len2 - 1);
+
+  for (strand = 0; strand < 2U; strand++) {
+    dir = strand == 0 ? GT_MATCH_DIRECT : GT_MATCH_REVERSE;
+    if (dir == GT_MATCH_REVERSE) {
+      /* reverse complement the query in place */
+      for (i = 0; i < GT_DIV2(len2 + 1); i++) {
+        GtUchar a = ti->query[i], b = ti->query[len2 - 1 - i];
+        ti->query[i] = ISSPECIAL(b) ? b : GT_COMPLEMENTBASE(b);
+        ti->query[len2 - 1 - i] = ISSPECIAL(a) ? a : GT_COMPLEMENTBASE(a);
+      }
+    }
+    seedext_collect_seeds(pvt, ti, seqno2, len2);
+    gt_array_reset(ti->regions);
+    for (i = 0; i < gt_array_size(ti->seeds); i++) {
+      const GtSeedExtSeed *seed = gt_array_get(ti->seeds, i);
+      /* seeds are sorted by the sequence number in the first set, regions
+         found for previous sequences cannot cover the seed */
+      if (i > 0 && seed->seqnum1 !=
+                   ((GtSeedExtSeed*) gt_array_get(ti->seeds, i-1))->seqnum1) {
+        gt_array_reset(ti->regions);
+      }
+      if (seedext_seed_is_covered(ti, seed, pvt->seedlength))
+        continue;
+      if (seedext_extend(pvt, ti, seed, len2, &region)) {
+        GtSeedExtMatch match = region;
+        match.dir = dir;
+        if (dir == GT_MATCH_REVERSE) {
+          match.start2 = len2 - 1 - region.end2;
+          match.end2 = len2 - 1 - region.start2;
+        }
+        gt_array_add(pvt->matches[seqno2], match);
+      }
+      gt_array_add(ti->regions, region);
+    }
+  }
+  if (gt_array_size(pvt->matches[seqno2]) > 0) {
+    qsort(gt_array_get_space(pvt->matches[seqno2]),
+          gt_array_size(pvt->matches[seqno2]), sizeof (GtSeedExtMatch),
+          seedext_match_cmp);
+  }
+}
+
+static void* seedext_thread_func(void *data)
+{
+  GtMatchIteratorSeedExtMembers *pvt = data;
+  GtSeedExtThreadInfo ti;
+  GtUword seqno2;
+
+  ti.res = gt_xdrop_resources_new(&pvt->scores);
+  ti.useq = gt_seqabstract_new_empty();
+  ti.vseq = gt_seqabstract_new_empty();
+  ti.query = NULL;
+  ti.query_alloc = 0;
+  ti.seeds = gt_array_new(sizeof (GtSeedExtSeed));
+  ti.regions = gt_array_new(sizeof (GtSeedExtMatch));
+  for (;;) {
+    gt_mutex_lock(pvt->mutex);
+    seqno2 = pvt->next_query++;
+    gt_mutex_unlock(pvt->mutex);
+    if (seqno2 >= gt_encseq_num_of_sequences(pvt->es2))
+      break;
+    seedext_process_query(pvt, &ti, seqno2);
+  }
+  gt_array_delete(ti.regions);
+  gt_array_delete(ti.seeds);
+  gt_free(ti.query);
+  gt_seqabstract_delete(ti.vseq);
+  gt_seqabstract_delete(ti.useq);
+  gt_xdrop_resources_delete(ti.res);
+  return NULL;
+}
+
+static GtMatchIteratorStatus gt_match_iterator_seedext_next(GtMatchIterator *mi,
+                                                            GtMatch **match,
+                                                            GT_UNUSED
+                                                            GtError *err)
+{
+  GtMatchIteratorSeedExt *mis;
+  GtMatchIteratorSeedExtMembers *pvt;
+  const GtSeedExtMatch *m;
+  const char *desc1, *desc2;
+  GtUword desclen1, desclen2;
+  gt_assert(mi && match);
+
+  mis = gt_match_iterator_seedext_cast(mi);
+  pvt = mis->pvt;
+  while (pvt->seqno2 < gt_encseq_num_of_sequences(pvt->es2) &&
+         pvt->matchnum == gt_array_size(pvt->matches[pvt->seqno2])) {
+    pvt->seqno2++;
+    pvt->matchnum = 0;
+  }
+  if (pvt->seqno2 == gt_encseq_num_of_sequences(pvt->es2))
+    return GT_MATCHER_STATUS_END;
+  m = gt_array_get(pvt->matches[pvt->seqno2], pvt->matchnum++);
+  desc1 = gt_encseq_description(pvt->es1, &desclen1, m->seqnum1);
+  desc2 = gt_encseq_description(pvt->es2, &desclen2, pvt->seqno2);
+  *match = gt_match_sw_new("", "", m->seqnum1, pvt->seqno2, m->length,
+                           m->edist, m->start1, m->start2, m->end1, m->end2,
+                           m->dir);
+  gt_match_set_seqid1_nt(*match, desc1, desclen1);
+  gt_match_set_seqid2_nt(*match, desc2, desclen2);
+  return GT_MATCHER_STATUS_OK;
+}
+
+GtMatchIterator* gt_match_iterator_seedext_new(GtEncseq *es1, GtEncseq *es2,
+                                               GtUword seedlength,
+                                               GtUword minlength,
+                                               GtUword errorpercentage,
+                                               GtWord xdropbelowscore,
+                                               GtError *err)
+{
+  GtMatchIterator *mi;
+  GtMatchIteratorSeedExt *mis;
+  GtMatchIteratorSeedExtMembers *pvt;
+  gt_assert(es1 && es2);
+  gt_error_check(err);
+
+  if (!gt_alphabet_is_dna(gt_encseq_alphabet(es1)) ||
+      !gt_alphabet_is_dna(gt_encseq_alphabet(es2))) {
+    gt_error_set(err, "seed extension matching requires DNA sequences");
+    return NULL;
+  }
+  if (seedlength == 0 || seedlength > (GtUword) GT_UNITSIN2BITENC) {
+    gt_error_set(err, "seed length must be in the range from 1 to %u",
+                 (unsigned int) GT_UNITSIN2BITENC);
+    return NULL;
+  }
+  if (errorpercentage > 100 - GT_EXTEND_MIN_IDENTITY_PERCENTAGE) {
+    gt_error_set(err, "error percentage must not exceed %d",
+                 100 - GT_EXTEND_MIN_IDENTITY_PERCENTAGE);
+    return NULL;
+  }
+
+  mi = gt_match_iterator_create(gt_match_iterator_seedext_class());
+  mis = (GtMatchIteratorSeedExt*) mi;
+  mis->pvt = pvt = gt_calloc(1, sizeof (GtMatchIteratorSeedExtMembers));
+  pvt->es1 = gt_encseq_ref(es1);
+  pvt->es2 = gt_encseq_ref(es2);
+  pvt->selfcompare = (es1 == es2);
+  pvt->seedlength = seedlength;
+  pvt->minlength = minlength;
+  pvt->errorpercentage = errorpercentage;
+  /* scores compatible with the greedy extension, as in the self comparison
+     of the seed-extend module */
+  pvt->scores.mat = 2;
+  pvt->scores.mis = -1;
+  pvt->scores.ins = -2;
+  pvt->scores.del = -2;
+  pvt->xdropbelowscore = xdropbelowscore != 0
+                         ? xdropbelowscore
+                         : gt_optimalxdropbelowscore(errorpercentage,
+                                                     SEEDEXT_SENSITIVITY);
+  pvt->matches = gt_calloc((size_t) gt_encseq_num_of_sequences(es2),
+                           sizeof (GtArray*));
+  pvt->mutex = gt_mutex_new();
+  seedext_build_index(pvt);
+  pvt->next_query = 0;
+  if (gt_multithread(seedext_thread_func, pvt, err) != 0) {
+    gt_match_iterator_delete(mi);
+    return NULL;
+  }
+  /* the index is not needed any more */
+  gt_free(pvt->kmers);
+  pvt->kmers = NULL;
+  pvt->seqno2 = pvt->matchnum = 0;
+  return mi;
+}
+
+static void gt_match_iterator_seedext_free(GtMatchIterator *mi)
+{
+  GtMatchIteratorSeedExt *mis;
+  GtUword i;
+  if (!mi) return;
+  mis = gt_match_iterator_seedext_cast(mi);
+  for (i = 0; i < gt_encseq_num_of_sequences(mis->pvt->es2); i++)
+    gt_array_delete(mis->pvt->matches[i]);
+  gt_free(mis->pvt->matches);
+  gt_free(mis->pvt->kmers);
+  gt_free(mis->pvt->seqs1);
+  gt_mutex_delete(mis->pvt->mutex);
+  gt_encseq_delete(mis->pvt->es1);
+  gt_encseq_delete(mis->pvt->es2);
+  gt_free(mis->pvt);
+}
+
+const GtMatchIteratorClass* gt_match_iterator_seedext_class(void)
+{
+  static const GtMatchIteratorClass *mic;
+  gt_class_alloc_lock_enter();
+  if (!mic) {
+    mic = gt_match_iterator_class_new(sizeof (GtMatchIteratorSeedExt),
+                                      gt_match_iterator_seedext_next,
+                                      gt_match_iterator_seedext_free);
+  }
+  gt_class_alloc_lock_leave();
+  return mic;
+}
+
+int gt_match_iterator_seedext_unit_test(GtError *err)
+{
+  /* sequence 1 is a copy of sequence 0 and sequence 2 is its reverse
+     complement, so each pair of these sequences has one match covering the
+     whole sequences; sequence 3 has no match */
+  static const char *seqs[] = {
+    "ACGTTGCAAGGCTAGCTTACCGATCGGATTACAGCTAAGC",
+    "ACGTTGCAAGGCTAGCTTACCGATCGGATTACAGCTAAGC",
+    "GCTTAGCTGTAATCCGATCGGTAAGCTAGCCTTGCAACGT",
+    "TTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTTT"
+  };
+  static const GtUword expected[][2] = {{0, 1}, {0, 2}, {1, 2}};
+  static const GtMatchDirection expected_dir[] = {
+    GT_MATCH_DIRECT, GT_MATCH_REVERSE, GT_MATCH_REVERSE
+  };
+  GtAlphabet *alpha;
+  GtEncseqBuilder *eb;
+  GtEncseq *es;
+  GtMatchIterator *mi = NULL;
+  GtMatch *match;
+  GtMatchIteratorStatus status;
+  GtUword i, nofmatches = 0;
+  int had_err = 0;
+  gt_error_check(err);
+
+  alpha = gt_alphabet_new_dna();
+  eb = gt_encseq_builder_new(alpha);
+  gt_encseq_builder_enable_description_support(eb);
+  gt_encseq_builder_enable_multiseq_support(eb);
+  for (i = 0; i < sizeof (seqs) / sizeof (seqs[0]); i++)
+    gt_encseq_builder_add_cstr(eb, seqs[i], (GtUword) strlen(seqs[i]), "");
+  es = gt_encseq_builder_build(eb, err);
+  if (es == NULL)
+    had_err = -1;
+  if (!had_err) {
+    mi = gt_match_iterator_seedext_new(es, es, 12UL, 20UL, 10UL, 0, err);
+    if (mi == NULL)
+      had_err = -1;
+  }
+  while (!had_err &&
+         (status = gt_match_iterator_next(mi, &match, err)) !=
+         GT_MATCHER_STATUS_END) {
+    GtRange rng1, rng2;
+    GtMatchSW *msw;
+
+    gt_ensure(status == GT_MATCHER_STATUS_OK);
+    gt_ensure(nofmatches < sizeof (expected) / sizeof (expected[0]));
+    if (!had_err) {
+      msw = gt_match_sw_cast(match);
+      gt_match_get_range_seq1(match, &rng1);
+      gt_match_get_range_seq2(match, &rng2);
+      gt_ensure(gt_match_sw_get_seqno1(msw) == expected[nofmatches][0]);
+      gt_ensure(gt_match_sw_get_seqno2(msw) == expected[nofmatches][1]);
+      gt_ensure(gt_match_get_direction(match) == expected_dir[nofmatches]);
+      gt_ensure(rng1.start == 0 && rng1.end == 39UL);
+      gt_ensure(rng2.start == 0 && rng2.end == 39UL);
+      gt_ensure(gt_match_sw_get_edist(msw) == 0);
+    }
+    gt_match_delete(match);
+    nofmatches++;
+  }
+  gt_ensure(nofmatches == sizeof (expected) / sizeof (expected[0]));
+  gt_match_iterator_delete(mi);
+  gt_encseq_delete(es);
+  gt_encseq_builder_delete(eb);
+  gt_alphabet_delete(alpha);
+  return had_err;
+}
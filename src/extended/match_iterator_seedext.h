@@ -0,0 +1,51 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef MATCH_ITERATOR_SEEDEXT_H
+#define MATCH_ITERATOR_SEEDEXT_H
+
+#include "core/encseq_api.h"
+#include "extended/match_iterator_api.h"
+
+/* The <GtMatchIteratorSeedExt> class implements the <GtMatchIterator>
+   interface. It computes local matches between the DNA sequences of two
+   <GtEncseq> objects in-process: exact k-mer seeds are extended to both sides
+   with the xdrop algorithm of the seed-extend module. The matches are
+   computed with <gt_jobs> threads and delivered as <GtMatchSW> objects, sorted
+   by the sequence number in the second and in the first set, the direction
+   and the start positions, so that the order does not depend on the number of
+   threads. */
+typedef struct GtMatchIteratorSeedExt GtMatchIteratorSeedExt;
+
+/* Returns a new iterator over the matches between <es1> and <es2>. If <es1>
+   and <es2> are the same object, only matches between different sequences are
+   reported, each pair of sequences only once. Seeds are exact matches of
+   length <seedlength>, a match must have length at least <minlength> (on
+   average in both sequences) and at most <errorpercentage> percent errors.
+   <xdropbelowscore> is the xdrop cutoff score of the extension, 0 means that
+   it is derived from <errorpercentage>. Reverse complemented matches are
+   reported with direction <GT_MATCH_REVERSE> and forward strand coordinates.
+   Returns NULL and sets <err> on error. */
+GtMatchIterator* gt_match_iterator_seedext_new(GtEncseq *es1, GtEncseq *es2,
+                                               GtUword seedlength,
+                                               GtUword minlength,
+                                               GtUword errorpercentage,
+                                               GtWord xdropbelowscore,
+                                               GtError *err);
+
+int              gt_match_iterator_seedext_unit_test(GtError *err);
+
+#endif
@@ -16,7 +16,11 @@
 */
 
 #include <math.h>
+#include <string.h>
 #include "core/divmodmul.h"
+#include "core/ensure.h"
+#include "core/ma_api.h"
+#include "core/minmax.h"
 #include "core/safearith.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
@@ -46,16 +50,122 @@ static const char* dna_showretracenames(DnaRetrace retrace)
   return dna_retracenames[retrace];
 }
 
+/* the precomputed values used to evaluate the rows of the DP tables */
+typedef struct {
+  const unsigned char *gen_seq_tran,
+                      *ref_seq_tran;
+  GtAlphabet *gen_alphabet;
+  GthDPParam *dp_param;
+  GthDPOptionsEST *dp_options_est;
+  GthDPOptionsCore *dp_options_core;
+  GthDbl **outputweights,
+         *dashweights,
+         log_probies,          /* initial exon state probability */
+         log_1minusprobies;    /* initial intron state probability */
+  GthFlt log_probdelgen,       /* deletion in genomic sequence */
+         log_1minusprobdelgen,
+         *e_maxvalue;
+  GthPath *e_retrace;
+  unsigned char *decreasedoutput;
+} GthDNADPContext;
+
+/* In the checkpointing mode the rows 0, ..., <gen_dp_length> are divided into
+   strips of <interval> rows. Only the backtrace table of the current strip is
+   stored. For strip i > 0 the scores, intron starts, and exon starts of its
+   predecessor row i * <interval> - 1 are stored as checkpoint i - 1, which
+   allows to recompute the strip during the backtracing. */
+struct GthDNACheckpoints {
+  GthDNADPContext context;
+  GtUword interval,
+          numofcheckpoints,
+          current_strip,
+          width;
+  GthFlt *score[DNA_NUMOFSTATES];
+  GtUword *intronstart,
+          *exonstart;
+};
+
+/* the following function returns the strip height which minimizes the space
+   for the checkpoint rows plus the space for the backtrace table of one strip,
+   i.e., roughly the square root of the space for the complete table */
+static GtUword dp_matrix_checkpoint_interval(GtUword gen_dp_length)
+{
+  GtUword interval,
+          checkpointrowsize = DNA_NUMOFSTATES * sizeof (GthFlt) +
+                              2 * sizeof (GtUword);
+  interval = (GtUword) sqrt(2.0 * checkpointrowsize * (gen_dp_length + 1) /
+                            sizeof (GthPath));
+  /* strips have to start at even rows, because two rows share a row of the
+     backtrace table */
+  interval += GT_MOD2(interval);
+  return MAX(interval, 2UL);
+}
+
+static GthDNACheckpoints* dp_matrix_checkpoints_new(GtUword gen_dp_length,
+                                                    GtUword ref_dp_length,
+                                                    GtUword interval)
+{
+  GthDNACheckpoints *cp = gt_calloc(1, sizeof *cp);
+  GtUword t;
+  cp->interval = interval;
+  cp->numofcheckpoints = gen_dp_length / interval;
+  cp->current_strip = 0;
+  cp->width = ref_dp_length + 1;
+  for (t = DNA_E_STATE; t < DNA_NUMOFSTATES; t++) {
+    cp->score[t] = gt_malloc(sizeof *cp->score[t] * cp->numofcheckpoints *
+                             cp->width);
+  }
+  cp->intronstart = gt_malloc(sizeof *cp->intronstart * cp->numofcheckpoints *
+                              cp->width);
+  cp->exonstart = gt_malloc(sizeof *cp->exonstart * cp->numofcheckpoints *
+                            cp->width);
+  return cp;
+}
+
+static GtUword dp_matrix_checkpoints_size(const GthDNACheckpoints *cp)
+{
+  return cp->numofcheckpoints * cp->width *
+         (DNA_NUMOFSTATES * sizeof (GthFlt) + 2 * sizeof (GtUword));
+}
+
+/* the following function initializes row 0 of the backtrace table */
+static void dp_matrix_init_path_row_zero(GthDPMatrix *dpm)
+{
+  GtUword m;
+  dpm->path[0][0]  = DNA_E_NM;
+  dpm->path[0][0] |= I_STATE_E_N;
+  for (m = 1; m <= dpm->ref_dp_length; m++) {
+    dpm->path[0][m]  = DNA_E_M;
+    dpm->path[0][m] |= I_STATE_I_N;
+  }
+}
+
+/* the following function initializes score table <n> with row 0 */
+static void dp_matrix_init_score_row_zero(GthDPMatrix *dpm, GtUword n)
+{
+  GtUword m;
+  dpm->score[DNA_E_STATE][n][0] = 0.0;
+  dpm->score[DNA_I_STATE][n][0] = 0.0;
+
+  for (m = 1; m <= dpm->ref_dp_length; m++) {
+    dpm->score[DNA_E_STATE][n][m] = (GthFlt) 0.0;
+    /* disallow intron status for 5' non-matching cDNA letters: */
+    dpm->score[DNA_I_STATE][n][m] = (GthFlt) GTH_MINUSINFINITY;
+  }
+}
+
 /* the following function allocates space for the DP tables for cDNAs/ESTs */
 static int dp_matrix_init(GthDPMatrix *dpm,
                           GtUword gen_dp_length,
                           GtUword ref_dp_length,
                           GtUword autoicmaxmatrixsize,
                           bool introncutout,
+                          GtUword checkpointmatrixsize,
                           GthJumpTable *jump_table,
                           GthStat *stat)
 {
-  GtUword t, n, m, matrixsize, sizeofpathtype =  sizeof (GthPath);
+  GtUword t, n, matrixsize, pathrows, checkpointinterval = 0,
+          sizeofpathtype =  sizeof (GthPath);
 
   /* XXX: adjust this check for QUARTER_MATRIX case */
   if (DNA_NUMOFSTATES * sizeofpathtype * (gen_dp_length + 1) >=
@@ -65,9 +175,21 @@ static int dp_matrix_init(GthDPMatrix *dpm,
     return GTH_ERROR_MATRIX_ALLOCATION_FAILED;
   }
 
-  matrixsize = gt_safe_mult_ulong((GT_DIV2(gen_dp_length + 1) +
-                                   GT_MOD2(gen_dp_length + 1)),
-                                   ref_dp_length + 1);
+  pathrows = GT_DIV2(gen_dp_length + 1) + GT_MOD2(gen_dp_length + 1);
+  matrixsize = gt_safe_mult_ulong(pathrows, ref_dp_length + 1);
+
+  if (!jump_table && checkpointmatrixsize > 0 &&
+      sizeofpathtype * matrixsize > checkpointmatrixsize << 20) {
+    /* the complete backtrace table would be larger than the specified maximal
+       size -> only store the backtrace table for a strip of rows */
+    checkpointinterval = dp_matrix_checkpoint_interval(gen_dp_length);
+    if (checkpointinterval <= gen_dp_length) {
+      pathrows = GT_DIV2(checkpointinterval);
+      matrixsize = gt_safe_mult_ulong(pathrows, ref_dp_length + 1);
+    }
+    else
+      checkpointinterval = 0;
+  }
 
   if (!introncutout && autoicmaxmatrixsize > 0) {
     /* in this case the automatic intron cutout technique is enabled
@@ -81,14 +203,10 @@ static int dp_matrix_init(GthDPMatrix *dpm,
 
   /* allocate space for dpm->path */
   if (jump_table) {
-    gth_array2dim_plain_calloc(dpm->path,
-                               GT_DIV2(gen_dp_length + 1) +
-                               GT_MOD2(gen_dp_length + 1), ref_dp_length + 1);
+    gth_array2dim_plain_calloc(dpm->path, pathrows, ref_dp_length + 1);
   }
   else {
-    gth_array2dim_plain_malloc(dpm->path,
-                               GT_DIV2(gen_dp_length + 1) +
-                               GT_MOD2(gen_dp_length + 1), ref_dp_length + 1);
+    gth_array2dim_plain_malloc(dpm->path, pathrows, ref_dp_length + 1);
   }
   dpm->path_jt = NULL;
   if (!dpm->path)
@@ -108,35 +226,43 @@ static int dp_matrix_init(GthDPMatrix *dpm,
     dpm->exonstart[n] = gt_calloc(ref_dp_length + 1, sizeof *dpm->exonstart);
   }
 
-  /* initialize the DP matrices */
-  dpm->path[0][0]  = DNA_E_NM;
-  dpm->path[0][0] |= I_STATE_E_N;
-  for (m = 1; m <= ref_dp_length; m++) {
-    dpm->path[0][m]  = DNA_E_M;
-    dpm->path[0][m] |= I_STATE_I_N;
-  }
-
-  for (n = 0; n < DNA_NUMOFSCORETABLES; n++) {
-    dpm->score[DNA_E_STATE][n][0] = 0.0;
-    dpm->score[DNA_I_STATE][n][0] = 0.0;
-
-    for (m = 1; m <= ref_dp_length; m++) {
-      dpm->score[DNA_E_STATE][n][m] = (GthFlt) 0.0;
-      /* disallow intron status for 5' non-matching cDNA letters: */
-      dpm->score[DNA_I_STATE][n][m] = (GthFlt) GTH_MINUSINFINITY;
-    }
-  }
   dpm->gen_dp_length = gen_dp_length;
   dpm->ref_dp_length = ref_dp_length;
+  dpm->checkpoints = NULL;
+  if (checkpointinterval) {
+    dpm->checkpoints = dp_matrix_checkpoints_new(gen_dp_length, ref_dp_length,
+                                                 checkpointinterval);
+  }
+
+  /* initialize the DP matrices */
+  dp_matrix_init_path_row_zero(dpm);
+  for (n = 0; n < DNA_NUMOFSCORETABLES; n++)
+    dp_matrix_init_score_row_zero(dpm, n);
 
   /* statistics */
   gth_stat_increment_numofbacktracematrixallocations(stat);
   gth_stat_increase_totalsizeofbacktracematricesinMB(stat,
-                                           (sizeofpathtype * matrixsize) >> 20);
+                                           (sizeofpathtype * matrixsize +
+                                            (dpm->checkpoints
+                                             ? dp_matrix_checkpoints_size(
+                                                              dpm->checkpoints)
+                                             : 0)) >> 20);
 
   return 0;
 }
 
+/* the following function returns the stored row of the backtrace table which
+   contains row <n> */
+static GthPath* dp_matrix_path_row(const GthDPMatrix *dpm, GtUword n)
+{
+  if (dpm->checkpoints) {
+    const GthDNACheckpoints *cp = dpm->checkpoints;
+    gt_assert(n / cp->interval == cp->current_strip);
+    return dpm->path[GT_DIV2(n - cp->current_strip * cp->interval)];
+  }
+  return dpm->path[GT_DIV2(n)];
+}
+
 #if 0
 static GtUword dp_matrix_get_reference_length(DPMatrix *dpm)
 {
@@ -275,223 +401,390 @@ static void I_1m(GthDPMatrix *dpm, GtUword m, GthDbl log_1minusprobies)
   }
 }
 
-/* the following function evaluate the dynamic programming tables */
-static void dna_complete_path_matrix(GthDPMatrix *dpm,
-                                     const unsigned char *gen_seq_tran,
-                                     const unsigned char *ref_seq_tran,
-                                     GtUword genomic_offset,
-                                     GtAlphabet *gen_alphabet,
-                                     GthDPParam *dp_param,
-                                     GthDPOptionsEST *dp_options_est,
-                                     GthDPOptionsCore *dp_options_core)
+static void dna_dp_context_init(GthDNADPContext *context,
+                                const unsigned char *gen_seq_tran,
+                                const unsigned char *ref_seq_tran,
+                                GtUword ref_dp_length,
+                                GtAlphabet *gen_alphabet,
+                                GthDPParam *dp_param,
+                                GthDPOptionsEST *dp_options_est,
+                                GthDPOptionsCore *dp_options_core)
 {
-  GthFlt value, maxvalue;
-  GthPath retrace;
-  GtUword n, m, modn, modnminus1;
-  GthDbl rval, outputweight, **outputweights,
-         log_probies,          /* initial exon state probability */
-         log_1minusprobies;    /* initial intron state probability */
-  GthFlt log_probdelgen,       /* deletion in genomic sequence */
-         log_1minusprobdelgen;
-  unsigned char genomicchar, referencechar;
+  GtUword n, m;
   unsigned int gen_alphabet_mapsize = gt_alphabet_size(gen_alphabet);
 
-  gt_assert(dpm->gen_dp_length > 1);
+  context->gen_seq_tran = gen_seq_tran;
+  context->ref_seq_tran = ref_seq_tran;
+  context->gen_alphabet = gen_alphabet;
+  context->dp_param = dp_param;
+  context->dp_options_est = dp_options_est;
+  context->dp_options_core = dp_options_core;
 
-  log_probies = (GthDbl) log((double) dp_options_est->probies);
-  log_1minusprobies = (GthDbl) log(1.0 - dp_options_est->probies);
-  log_probdelgen = (GthFlt) log((double) dp_options_est->probdelgen);
-  log_1minusprobdelgen = (GthFlt) log(1.0 - dp_options_est->probdelgen);
+  context->log_probies = (GthDbl) log((double) dp_options_est->probies);
+  context->log_1minusprobies = (GthDbl) log(1.0 - dp_options_est->probies);
+  context->log_probdelgen = (GthFlt) log((double) dp_options_est->probdelgen);
+  context->log_1minusprobdelgen = (GthFlt) log(1.0 -
+                                               dp_options_est->probdelgen);
 
   /* precompute outputweights
      XXX: move this to somewhere else, maybe make it smaller */
-  gt_array2dim_calloc(outputweights, UCHAR_MAX+1, UCHAR_MAX+1);
+  gt_array2dim_calloc(context->outputweights, UCHAR_MAX+1, UCHAR_MAX+1);
   for (n = 0; n <= UCHAR_MAX; n++) {
     for (m = 0; m <= UCHAR_MAX; m++) {
-      ADDOUTPUTWEIGHT(outputweights[n][m], n, m);
+      ADDOUTPUTWEIGHT(context->outputweights[n][m], n, m);
     }
   }
 
-  if (!genomic_offset) {
+  /* precompute the summands which only depend on the reference position */
+  context->dashweights = gt_malloc(sizeof *context->dashweights *
+                                   (ref_dp_length + 1));
+  context->decreasedoutput = gt_malloc(sizeof *context->decreasedoutput *
+                                       (ref_dp_length + 1));
+  for (m = 1; m <= ref_dp_length; m++) {
+    context->dashweights[m] = context->outputweights[DASH][ref_seq_tran[m-1]];
+    context->decreasedoutput[m] = (unsigned char)
+                                  (m < dp_options_est->wdecreasedoutput ||
+                                   m > ref_dp_length
+                                       - dp_options_est->wdecreasedoutput);
+  }
+  context->e_maxvalue = gt_malloc(sizeof *context->e_maxvalue *
+                                  (ref_dp_length + 1));
+  context->e_retrace = gt_malloc(sizeof *context->e_retrace *
+                                 (ref_dp_length + 1));
+}
+
+static void dna_dp_context_free(GthDNADPContext *context)
+{
+  gt_free(context->e_retrace);
+  gt_free(context->e_maxvalue);
+  gt_free(context->decreasedoutput);
+  gt_free(context->dashweights);
+  gt_array2dim_delete(context->outputweights);
+}
+
+/* the following function evaluates the rows <from> to <to> of the dynamic
+   programming tables, row <from> - 1 has to be available in the score tables.
+   Every row <n> is computed in two passes: The first pass evaluates the
+   I-state and the candidates of the E-state which only depend on row <n>-1,
+   i.e., it has no dependencies between neighboring cells of the row. The
+   second pass evaluates the remaining E-state candidates which depend on cell
+   <m>-1 of the current row. The candidates are considered in the same order as
+   before and the summands which only depend on <n> or on <m> are computed once
+   per row or column, using the same operations. Hence the scores and the
+   backtrace table are identical to the cell by cell evaluation. */
+static void dna_compute_rows(GthDPMatrix *dpm, GthDNADPContext *context,
+                             GtUword from, GtUword to)
+{
+  GthFlt value, maxvalue, *e_maxvalue = context->e_maxvalue;
+  GthPath retrace, *e_retrace = context->e_retrace, *pathrow;
+  GtUword n, m, modn, modnminus1, ref_dp_length = dpm->ref_dp_length,
+          *exonstart, *prev_exonstart, *intronstart, *prev_intronstart;
+  GthDbl rval, outputweight, *genweights,
+         *dashweights = context->dashweights,
+         diag_e_weight, diag_i_weight, vert_e_weight, vert_i_weight,
+         vert_e_weight_last, vert_i_weight_last, horz_e_weight,
+         horz_i_weight;
+  GthFlt log_probdelgen = context->log_probdelgen,
+         log_1minusprobdelgen = context->log_1minusprobdelgen,
+         *score_e, *score_i, *prev_score_e, *prev_score_i,
+         donor_weight, i_i_weight;
+  const unsigned char *gen_seq_tran = context->gen_seq_tran,
+                      *ref_seq_tran = context->ref_seq_tran,
+                      *decreasedoutput = context->decreasedoutput;
+  unsigned char genomicchar, referencechar;
+  GthDPParam *dp_param = context->dp_param;
+  GthDPOptionsEST *dp_options_est = context->dp_options_est;
+  GthDPOptionsCore *dp_options_core = context->dp_options_core;
+  bool lastrow;
+
+  gt_assert(from > 0 && to <= dpm->gen_dp_length);
+
+  if (from == 1) {
     /* handle case for n equals 1 */
     dpm->path[0][0] |= UPPER_E_N;
     dpm->path[0][0] |= UPPER_I_STATE_I_N;
 
     /* stepping along the cDNA/EST sequence */
-    for (m = 1; m <= dpm->ref_dp_length; m++) {
-      E_1m(dpm, gen_seq_tran[0], ref_seq_tran, m, gen_alphabet, log_probies,
-           dp_options_est, dp_options_core);
-      I_1m(dpm, m, log_1minusprobies);
+    for (m = 1; m <= ref_dp_length; m++) {
+      E_1m(dpm, gen_seq_tran[0], ref_seq_tran, m, context->gen_alphabet,
+           context->log_probies, dp_options_est, dp_options_core);
+      I_1m(dpm, m, context->log_1minusprobies);
     }
+    from = 2;
   }
 
   /* handle all other n's
      stepping along the genomic sequence */
-  if (genomic_offset)
-    n = genomic_offset + 1;
-  else
-    n = 2;
-
-  for (; n <= dpm->gen_dp_length; n++) {
+  for (n = from; n <= to; n++) {
     modn = GT_MOD2(n);
     modnminus1 = GT_MOD2(n-1);
     genomicchar = gen_seq_tran[n-1];
+    genweights = context->outputweights[genomicchar];
+    lastrow = n == dpm->gen_dp_length ? true : false;
+    pathrow = dp_matrix_path_row(dpm, n);
+    score_e = dpm->score[DNA_E_STATE][modn];
+    score_i = dpm->score[DNA_I_STATE][modn];
+    prev_score_e = dpm->score[DNA_E_STATE][modnminus1];
+    prev_score_i = dpm->score[DNA_I_STATE][modnminus1];
+    exonstart = dpm->exonstart[modn];
+    prev_exonstart = dpm->exonstart[modnminus1];
+    intronstart = dpm->intronstart[modn];
+    prev_intronstart = dpm->intronstart[modnminus1];
+
+    /* the summands which only depend on the genomic position */
+    diag_e_weight = (GthDbl) (log_1minusprobdelgen +
+                              dp_param->log_1minusPdonor[n-1]);
+    diag_i_weight = (GthDbl) (dp_param->log_Pacceptor[n-2] +
+                              log_1minusprobdelgen);
+    vert_e_weight = diag_e_weight + genweights[DASH];
+    vert_e_weight_last = n < dp_options_est->wzerotransition
+                         ? diag_e_weight : 0.0;
+    vert_i_weight = diag_i_weight + genweights[DASH];
+    vert_i_weight_last = diag_i_weight;
+    horz_e_weight = (GthDbl) log_probdelgen;
+    horz_i_weight = lastrow ? 0.0
+                            : (GthDbl) (dp_param->log_Pacceptor[n-1] +
+                                        log_probdelgen);
+    donor_weight = log_1minusprobdelgen + dp_param->log_Pdonor[n-1];
+    i_i_weight = dp_param->log_1minusPacceptor[n-2];
 
     if (modn) {
-      dpm->path[GT_DIV2(n)][0] |= UPPER_E_N;
-      dpm->path[GT_DIV2(n)][0] |= UPPER_I_STATE_I_N;
+      pathrow[0] |= UPPER_E_N;
+      pathrow[0] |= UPPER_I_STATE_I_N;
     }
     else {
-      dpm->path[GT_DIV2(n)][0]  = DNA_E_N;
-      dpm->path[GT_DIV2(n)][0] |= I_STATE_I_N;
+      pathrow[0]  = DNA_E_N;
+      pathrow[0] |= I_STATE_I_N;
     }
 
-    /* stepping along the cDNA/EST sequence */
-    for (m = 1; m <= dpm->ref_dp_length; m++) {
+    /* first pass: stepping along the cDNA/EST sequence */
+    for (m = 1; m <= ref_dp_length; m++) {
       referencechar = ref_seq_tran[m-1];
 
-      /* evaluate E_nm */
+      /* evaluate E_nm, candidates 0. to 3. */
 
       /* 0. */
       outputweight = 0.0;
-      rval = (GthDbl) (log_1minusprobdelgen + dp_param->log_1minusPdonor[n-1]);
-      rval += outputweights[genomicchar][referencechar];
-      if ((m < dp_options_est->wdecreasedoutput ||
-           m > dpm->ref_dp_length - dp_options_est->wdecreasedoutput) &&
-           genomicchar == referencechar) {
-        outputweight += outputweights[genomicchar][referencechar];
+      rval = diag_e_weight;
+      rval += genweights[referencechar];
+      if (decreasedoutput[m] && genomicchar == referencechar) {
+        outputweight += genweights[referencechar];
         rval -= (outputweight / 2.0);
       }
-      maxvalue = (GthFlt) (dpm->score[DNA_E_STATE][modnminus1][m-1] + rval);
+      maxvalue = (GthFlt) (prev_score_e[m-1] + rval);
       retrace  = DNA_E_NM;
 
       /* 1. */
       outputweight = 0.0;
-      rval = (GthDbl) (dp_param->log_Pacceptor[n-2] + log_1minusprobdelgen);
-      rval += outputweights[genomicchar][referencechar];
-      if ((m < dp_options_est->wdecreasedoutput ||
-           m > dpm->ref_dp_length - dp_options_est->wdecreasedoutput) &&
-           genomicchar == referencechar) {
-        outputweight += outputweights[genomicchar][referencechar];
+      rval = diag_i_weight;
+      rval += genweights[referencechar];
+      if (decreasedoutput[m] && genomicchar == referencechar) {
+        outputweight += genweights[referencechar];
         rval -= (outputweight / 2.0);
       }
-      value = (GthFlt) (dpm->score[DNA_I_STATE][modnminus1][m-1] + rval);
+      value = (GthFlt) (prev_score_i[m-1] + rval);
       /* intron from intronstart to n-1 => n-1 - intronstart + 1 */
-      if (n - dpm->intronstart[modnminus1][m - 1] <
-          dp_options_core->dpminintronlength) {
+      if (n - prev_intronstart[m - 1] < dp_options_core->dpminintronlength)
         value -= dp_options_core->shortintronpenalty;
-      }
       UPDATEMAX(DNA_I_NM);
 
       /* 2. */
-      rval = 0.0;
-      if (m < dpm->ref_dp_length || n < dp_options_est->wzerotransition)
-        rval += (log_1minusprobdelgen + dp_param->log_1minusPdonor[n-1]);
-      if (m < dpm->ref_dp_length)
-        rval += outputweights[genomicchar][DASH];
-      value = (GthFlt) (dpm->score[DNA_E_STATE][modnminus1][m] + rval);
+      value = (GthFlt) (prev_score_e[m] + (m < ref_dp_length
+                                           ? vert_e_weight
+                                           : vert_e_weight_last));
       UPDATEMAX(DNA_E_N);
 
       /* 3. */
-      rval = (GthDbl) (dp_param->log_Pacceptor[n-2] + log_1minusprobdelgen);
-      if (m < dpm->ref_dp_length)
-        rval += outputweights[genomicchar][DASH];
-      value = (GthFlt) (dpm->score[DNA_I_STATE][modnminus1][m] + rval);
+      value = (GthFlt) (prev_score_i[m] + (m < ref_dp_length
+                                           ? vert_i_weight
+                                           : vert_i_weight_last));
       /* intron from intronstart to n-1 => n-1 - intronstart + 1 */
-      if (n - dpm->intronstart[modnminus1][m] <
-          dp_options_core->dpminintronlength) {
+      if (n - prev_intronstart[m] < dp_options_core->dpminintronlength)
         value -= dp_options_core->shortintronpenalty;
-      }
       UPDATEMAX(DNA_I_N);
 
+      e_maxvalue[m] = maxvalue;
+      e_retrace[m] = retrace;
+
+      /* evaluate I_nm */
+
+      /* 0. */
+      maxvalue = prev_score_e[m] + donor_weight;
+      if (n - prev_exonstart[m] < dp_options_core->dpminexonlength)
+         maxvalue -= dp_options_core->shortexonpenalty;
+      retrace  = I_STATE_E_N;
+
+      /* 1. */
+      value = prev_score_i[m];
+      if (!dp_options_core->freeintrontrans && m < ref_dp_length)
+        value += i_i_weight;
+      UPDATEMAX(I_STATE_I_N);
+
+      /* save maximum values */
+      score_i[m] = maxvalue;
+      if (modn)
+        pathrow[m] |= (retrace << 4);
+      else
+        pathrow[m]  = retrace;
+
+      switch (retrace) {
+       case I_STATE_E_N:
+          /* begin of a new intron */
+          intronstart[m] = n;
+          break;
+        case I_STATE_I_N:
+          /* continue existing intron */
+          intronstart[m] = prev_intronstart[m];
+          break;
+        default: gt_assert(0);
+      }
+    }
+
+    /* second pass: evaluate E_nm, candidates 4. and 5. */
+    for (m = 1; m <= ref_dp_length; m++) {
+      maxvalue = e_maxvalue[m];
+      retrace = e_retrace[m];
+
       /* 4. */
-      rval = 0.0;
-      if (n < dpm->gen_dp_length || m < dp_options_est->wzerotransition)
-        rval = (GthDbl) log_probdelgen;
-      if (n < dpm->gen_dp_length)
-        rval += outputweights[DASH][referencechar];
-      value = (GthFlt) (dpm->score[DNA_E_STATE][modn][m-1] + rval);
+      if (!lastrow)
+        rval = horz_e_weight + dashweights[m];
+      else if (m < dp_options_est->wzerotransition)
+        rval = horz_e_weight;
+      else
+        rval = 0.0;
+      value = (GthFlt) (score_e[m-1] + rval);
       UPDATEMAX(DNA_E_M);
 
       /* 5. */
       rval = 0.0;
-      if (n < dpm->gen_dp_length)
-       rval += (dp_param->log_Pacceptor[n-1] + log_probdelgen);
-      if (n < dpm->gen_dp_length)
-        rval += outputweights[DASH][referencechar];
-      value = (GthFlt) (dpm->score[DNA_I_STATE][modn][m-1] + rval);
+      if (!lastrow) {
+        rval += horz_i_weight;
+        rval += dashweights[m];
+      }
+      value = (GthFlt) (score_i[m-1] + rval);
       /* intron from intronstart to n => n - intronstart + 1 */
-      if (n - dpm->intronstart[modn][m - 1] + 1 <
-          dp_options_core->dpminintronlength) {
+      if (n - intronstart[m - 1] + 1 < dp_options_core->dpminintronlength)
         value -= dp_options_core->shortintronpenalty;
-      }
       UPDATEMAX(DNA_I_M);
 
       /* save maximum values */
-      dpm->score[DNA_E_STATE][modn][m] = maxvalue;
+      score_e[m] = maxvalue;
       if (modn)
-        dpm->path[GT_DIV2(n)][m] |= (retrace << 4);
+        pathrow[m] |= (retrace << 4);
       else
-        dpm->path[GT_DIV2(n)][m]  = retrace;
+        pathrow[m] |= retrace;
 
       switch (retrace) {
         case DNA_I_NM:
         case DNA_I_N:
         case DNA_I_M:
-          dpm->exonstart[modn][m] = n;
+          exonstart[m] = n;
           break;
         case DNA_E_NM:
-          dpm->exonstart[modn][m] = dpm->exonstart[modnminus1][m - 1];
+          exonstart[m] = prev_exonstart[m - 1];
           break;
         case DNA_E_N:
-          dpm->exonstart[modn][m] = dpm->exonstart[modnminus1][m];
+          exonstart[m] = prev_exonstart[m];
           break;
         case DNA_E_M:
-          dpm->exonstart[modn][m] = dpm->exonstart[modn][m - 1];
+          exonstart[m] = exonstart[m - 1];
           break;
         default: gt_assert(0);
       }
+    }
+  }
 
-      /* evaluate I_nm */
+}
 
-      /* 0. */
-      maxvalue = dpm->score[DNA_E_STATE][modnminus1][m] +
-                 (log_1minusprobdelgen + dp_param->log_Pdonor[n-1]);
-      if (n - dpm->exonstart[modnminus1][m]
-          < dp_options_core->dpminexonlength) {
-         maxvalue -= dp_options_core->shortexonpenalty;
-      }
-      retrace  = I_STATE_E_N;
+/* the following function evaluate the dynamic programming tables */
+static void dna_complete_path_matrix(GthDPMatrix *dpm,
+                                     const unsigned char *gen_seq_tran,
+                                     const unsigned char *ref_seq_tran,
+                                     GtUword genomic_offset,
+                                     GtAlphabet *gen_alphabet,
+                                     GthDPParam *dp_param,
+                                     GthDPOptionsEST *dp_options_est,
+                                     GthDPOptionsCore *dp_options_core)
+{
+  GthDNACheckpoints *cp = dpm->checkpoints;
+  GthDNADPContext context;
+  GtUword strip, t;
 
-      /* 1. */
-      value = dpm->score[DNA_I_STATE][modnminus1][m];
-      if (!dp_options_core->freeintrontrans && m < dpm->ref_dp_length)
-        value += dp_param->log_1minusPacceptor[n-2];
-      UPDATEMAX(I_STATE_I_N);
+  gt_assert(dpm->gen_dp_length > 1);
 
-      /* save maximum values */
-      dpm->score[DNA_I_STATE][modn][m] = maxvalue;
-      if (modn)
-        dpm->path[GT_DIV2(n)][m] |= (retrace << 4);
-      else
-        dpm->path[GT_DIV2(n)][m] |= retrace;
+  if (!cp) {
+    dna_dp_context_init(&context, gen_seq_tran, ref_seq_tran,
+                        dpm->ref_dp_length, gen_alphabet, dp_param,
+                        dp_options_est, dp_options_core);
+    dna_compute_rows(dpm, &context, genomic_offset + 1, dpm->gen_dp_length);
+    dna_dp_context_free(&context);
+    return;
+  }
 
-      switch (retrace) {
-       case I_STATE_E_N:
-          /* begin of a new intron */
-          dpm->intronstart[modn][m] = n;
-          break;
-        case I_STATE_I_N:
-          /* continue existing intron */
-          dpm->intronstart[modn][m] = dpm->intronstart[modnminus1][m];
-          break;
-        default: gt_assert(0);
+  /* checkpointing mode, the context is kept to recompute the strips */
+  gt_assert(!genomic_offset);
+  dna_dp_context_init(&cp->context, gen_seq_tran, ref_seq_tran,
+                      dpm->ref_dp_length, gen_alphabet, dp_param,
+                      dp_options_est, dp_options_core);
+  for (strip = 0; strip <= cp->numofcheckpoints; strip++) {
+    cp->current_strip = strip;
+    dna_compute_rows(dpm, &cp->context, strip ? strip * cp->interval : 1,
+                     MIN((strip + 1) * cp->interval - 1, dpm->gen_dp_length));
+    if (strip < cp->numofcheckpoints) {
+      /* save the last row of the strip, it is always odd */
+      for (t = DNA_E_STATE; t < DNA_NUMOFSTATES; t++) {
+        memcpy(cp->score[t] + strip * cp->width, dpm->score[t][1],
+               sizeof *cp->score[t] * cp->width);
       }
+      memcpy(cp->intronstart + strip * cp->width, dpm->intronstart[1],
+             sizeof *cp->intronstart * cp->width);
+      memcpy(cp->exonstart + strip * cp->width, dpm->exonstart[1],
+             sizeof *cp->exonstart * cp->width);
+    }
+  }
+}
+
+/* the following function recomputes the backtrace table of <strip> from its
+   checkpoint */
+static void dp_matrix_recompute_strip(GthDPMatrix *dpm, GtUword strip)
+{
+  GthDNACheckpoints *cp = dpm->checkpoints;
+  GtUword t;
+
+  gt_assert(cp && strip <= cp->numofcheckpoints);
+  cp->current_strip = strip;
+  if (!strip) {
+    dp_matrix_init_path_row_zero(dpm);
+    dp_matrix_init_score_row_zero(dpm, 0);
+    memset(dpm->intronstart[0], 0, sizeof *dpm->intronstart[0] * cp->width);
+    memset(dpm->exonstart[0], 0, sizeof *dpm->exonstart[0] * cp->width);
+    dna_compute_rows(dpm, &cp->context, 1,
+                     MIN(cp->interval - 1, dpm->gen_dp_length));
+  }
+  else {
+    for (t = DNA_E_STATE; t < DNA_NUMOFSTATES; t++) {
+      memcpy(dpm->score[t][1], cp->score[t] + (strip - 1) * cp->width,
+             sizeof *cp->score[t] * cp->width);
     }
+    memcpy(dpm->intronstart[1], cp->intronstart + (strip - 1) * cp->width,
+           sizeof *cp->intronstart * cp->width);
+    memcpy(dpm->exonstart[1], cp->exonstart + (strip - 1) * cp->width,
+           sizeof *cp->exonstart * cp->width);
+    dna_compute_rows(dpm, &cp->context, strip * cp->interval,
+                     MIN((strip + 1) * cp->interval - 1, dpm->gen_dp_length));
   }
+}
 
-  /* free space  */
-  gt_array2dim_delete(outputweights);
+/* the following function returns the backtrace table entry for <n> and <m>,
+   in the checkpointing mode the strip containing row <n> is recomputed if
+   necessary */
+static GthPath dp_matrix_get_path(GthDPMatrix *dpm, GtUword n, GtUword m)
+{
+  if (dpm->checkpoints && n / dpm->checkpoints->interval !=
+                          dpm->checkpoints->current_strip) {
+    dp_matrix_recompute_strip(dpm, n / dpm->checkpoints->interval);
+  }
+  return dp_matrix_path_row(dpm, n)[m];
 }
 
 static void dna_include_exon(GthBacktracePath *backtrace_path,
@@ -542,7 +835,7 @@ static int dna_evaltracepath(GthBacktracePath *backtrace_path, GthDPMatrix *dpm,
     /* here we map the quarter matrix bitvector stuff back on the simple Retrace
        types.  Thereby, no further changes on the backtracing procedure are
        necessary. */
-    pathtype = dpm->path[GT_DIV2(genptr)][refptr];
+    pathtype = dp_matrix_get_path(dpm, genptr, refptr);
     if (dpm->path_jt)
       pathtype_jt = dpm->path_jt[GT_DIV2(genptr)][refptr];
     lower = (bool) !GT_MOD2(genptr);
@@ -760,6 +1053,16 @@ static void dp_matrix_free(GthDPMatrix *dpm)
       gt_free(dpm->score[t][n]);
   }
 
+  /* freeing space for the checkpoints */
+  if (dpm->checkpoints) {
+    for (t = DNA_E_STATE; t < DNA_NUMOFSTATES; t++)
+      gt_free(dpm->checkpoints->score[t]);
+    gt_free(dpm->checkpoints->intronstart);
+    gt_free(dpm->checkpoints->exonstart);
+    dna_dp_context_free(&dpm->checkpoints->context);
+    gt_free(dpm->checkpoints);
+  }
+
   /* freeing space for dpm->path */
   gth_array2dim_plain_delete(dpm->path);
   if (dpm->path_jt)
@@ -997,7 +1300,7 @@ static void detect_small_terminal_exons(GthSA *sa,
   }
 
   if (dp_matrix_init(&dpm_terminal, gen_dp_length_terminal,
-                     ref_dp_length_terminal, 0, false, NULL, stat)) {
+                     ref_dp_length_terminal, 0, false, 0, NULL, stat)) {
     /* out of memory */
     return;
   }
@@ -1135,7 +1438,7 @@ static void detect_small_initial_exons(GthSA *sa,
             gen_seq_bounds->end);
 
   if (dp_matrix_init(&dpm_initial, gen_dp_length_initial,
-                     ref_dp_length_initial, 0, false, NULL, stat)) {
+                     ref_dp_length_initial, 0, false, 0, NULL, stat)) {
     /* out of memory */
     return;
   }
@@ -1273,6 +1576,9 @@ int gth_align_dna(GthSA *sa,
                              introncutout ? spliced_seq->splicedseqlen
                                           : gen_dp_length,
                              ref_dp_length, autoicmaxmatrixsize, introncutout,
+                             jump_table || dp_options_core->btmatrixgenrange
+                                           .start != GT_UNDEF_UWORD
+                             ? 0 : dp_options_core->checkpointmatrixsize,
                              jump_table, stat))) {
     gth_dp_param_delete(dp_param);
     gth_spliced_seq_delete(spliced_seq);
@@ -1454,3 +1760,350 @@ GthSA* gth_align_dna_simple(GthInput *input,
   gth_dp_options_core_delete(dp_options_core);
   return sa;
 }
+
+/* the following function evaluates the rows <from> to <to> of the dynamic
+   programming tables cell by cell, i.e., all candidates of the E-state and the
+   I-state are evaluated before the next cell of the row. It is the reference
+   for dna_compute_rows() in the unit test below. */
+static void dna_compute_rows_cell_by_cell(GthDPMatrix *dpm,
+                                          GthDNADPContext *context,
+                                          GtUword from, GtUword to)
+{
+  GthFlt value, maxvalue;
+  GthPath retrace, *pathrow;
+  GtUword n, m, modn, modnminus1;
+  GthDbl rval, outputweight, **outputweights = context->outputweights;
+  GthFlt log_probdelgen = context->log_probdelgen,
+         log_1minusprobdelgen = context->log_1minusprobdelgen;
+  const unsigned char *gen_seq_tran = context->gen_seq_tran,
+                      *ref_seq_tran = context->ref_seq_tran;
+  unsigned char genomicchar, referencechar;
+  GthDPParam *dp_param = context->dp_param;
+  GthDPOptionsEST *dp_options_est = context->dp_options_est;
+  GthDPOptionsCore *dp_options_core = context->dp_options_core;
+
+  gt_assert(from > 0 && to <= dpm->gen_dp_length);
+
+  if (from == 1) {
+    /* handle case for n equals 1 */
+    dpm->path[0][0] |= UPPER_E_N;
+    dpm->path[0][0] |= UPPER_I_STATE_I_N;
+
+    /* stepping along the cDNA/EST sequence */
+    for (m = 1; m <= dpm->ref_dp_length; m++) {
+      E_1m(dpm, gen_seq_tran[0], ref_seq_tran, m, context->gen_alphabet,
+           context->log_probies, dp_options_est, dp_options_core);
+      I_1m(dpm, m, context->log_1minusprobies);
+    }
+    from = 2;
+  }
+
+  /* handle all other n's
+     stepping along the genomic sequence */
+  for (n = from; n <= to; n++) {
+    modn = GT_MOD2(n);
+    modnminus1 = GT_MOD2(n-1);
+    genomicchar = gen_seq_tran[n-1];
+    pathrow = dp_matrix_path_row(dpm, n);
+
+    if (modn) {
+      pathrow[0] |= UPPER_E_N;
+      pathrow[0] |= UPPER_I_STATE_I_N;
+    }
+    else {
+      pathrow[0]  = DNA_E_N;
+      pathrow[0] |= I_STATE_I_N;
+    }
+
+    /* stepping along the cDNA/EST sequence */
+    for (m = 1; m <= dpm->ref_dp_length; m++) {
+      referencechar = ref_seq_tran[m-1];
+
+      /* evaluate E_nm */
+
+      /* 0. */
+      outputweight = 0.0;
+      rval = (GthDbl) (log_1minusprobdelgen + dp_param->log_1minusPdonor[n-1]);
+      rval += outputweights[genomicchar][referencechar];
+      if ((m < dp_options_est->wdecreasedoutput ||
+           m > dpm->ref_dp_length - dp_options_est->wdecreasedoutput) &&
+           genomicchar == referencechar) {
+        outputweight += outputweights[genomicchar][referencechar];
+        rval -= (outputweight / 2.0);
+      }
+      maxvalue = (GthFlt) (dpm->score[DNA_E_STATE][modnminus1][m-1] + rval);
+      retrace  = DNA_E_NM;
+
+      /* 1. */
+      outputweight = 0.0;
+      rval = (GthDbl) (dp_param->log_Pacceptor[n-2] + log_1minusprobdelgen);
+      rval += outputweights[genomicchar][referencechar];
+      if ((m < dp_options_est->wdecreasedoutput ||
+           m > dpm->ref_dp_length - dp_options_est->wdecreasedoutput) &&
+           genomicchar == referencechar) {
+        outputweight += outputweights[genomicchar][referencechar];
+        rval -= (outputweight / 2.0);
+      }
+      value = (GthFlt) (dpm->score[DNA_I_STATE][modnminus1][m-1] + rval);
+      /* intron from intronstart to n-1 => n-1 - intronstart + 1 */
+      if (n - dpm->intronstart[modnminus1][m - 1] <
+          dp_options_core->dpminintronlength) {
+        value -= dp_options_core->shortintronpenalty;
+      }
+      UPDATEMAX(DNA_I_NM);
+
+      /* 2. */
+      rval = 0.0;
+      if (m < dpm->ref_dp_length || n < dp_options_est->wzerotransition)
+        rval += (log_1minusprobdelgen + dp_param->log_1minusPdonor[n-1]);
+      if (m < dpm->ref_dp_length)
+        rval += outputweights[genomicchar][DASH];
+      value = (GthFlt) (dpm->score[DNA_E_STATE][modnminus1][m] + rval);
+      UPDATEMAX(DNA_E_N);
+
+      /* 3. */
+      rval = (GthDbl) (dp_param->log_Pacceptor[n-2] + log_1minusprobdelgen);
+      if (m < dpm->ref_dp_length)
+        rval += outputweights[genomicchar][DASH];
+      value = (GthFlt) (dpm->score[DNA_I_STATE][modnminus1][m] + rval);
+      /* intron from intronstart to n-1 => n-1 - intronstart + 1 */
+      if (n - dpm->intronstart[modnminus1][m] <
+          dp_options_core->dpminintronlength) {
+        value -= dp_options_core->shortintronpenalty;
+      }
+      UPDATEMAX(DNA_I_N);
+
+      /* 4. */
+      rval = 0.0;
+      if (n < dpm->gen_dp_length || m < dp_options_est->wzerotransition)
+        rval = (GthDbl) log_probdelgen;
+      if (n < dpm->gen_dp_length)
+        rval += outputweights[DASH][referencechar];
+      value = (GthFlt) (dpm->score[DNA_E_STATE][modn][m-1] + rval);
+      UPDATEMAX(DNA_E_M);
+
+      /* 5. */
+      rval = 0.0;
+      if (n < dpm->gen_dp_length)
+       rval += (dp_param->log_Pacceptor[n-1] + log_probdelgen);
+      if (n < dpm->gen_dp_length)
+        rval += outputweights[DASH][referencechar];
+      value = (GthFlt) (dpm->score[DNA_I_STATE][modn][m-1] + rval);
+      /* intron from intronstart to n => n - intronstart + 1 */
+      if (n - dpm->intronstart[modn][m - 1] + 1 <
+          dp_options_core->dpminintronlength) {
+        value -= dp_options_core->shortintronpenalty;
+      }
+      UPDATEMAX(DNA_I_M);
+
+      /* save maximum values */
+      dpm->score[DNA_E_STATE][modn][m] = maxvalue;
+      if (modn)
+        pathrow[m] |= (retrace << 4);
+      else
+        pathrow[m]  = retrace;
+
+      switch (retrace) {
+        case DNA_I_NM:
+        case DNA_I_N:
+        case DNA_I_M:
+          dpm->exonstart[modn][m] = n;
+          break;
+        case DNA_E_NM:
+          dpm->exonstart[modn][m] = dpm->exonstart[modnminus1][m - 1];
+          break;
+        case DNA_E_N:
+          dpm->exonstart[modn][m] = dpm->exonstart[modnminus1][m];
+          break;
+        case DNA_E_M:
+          dpm->exonstart[modn][m] = dpm->exonstart[modn][m - 1];
+          break;
+        default: gt_assert(0);
+      }
+
+      /* evaluate I_nm */
+
+      /* 0. */
+      maxvalue = dpm->score[DNA_E_STATE][modnminus1][m] +
+                 (log_1minusprobdelgen + dp_param->log_Pdonor[n-1]);
+      if (n - dpm->exonstart[modnminus1][m]
+          < dp_options_core->dpminexonlength) {
+         maxvalue -= dp_options_core->shortexonpenalty;
+      }
+      retrace  = I_STATE_E_N;
+
+      /* 1. */
+      value = dpm->score[DNA_I_STATE][modnminus1][m];
+      if (!dp_options_core->freeintrontrans && m < dpm->ref_dp_length)
+        value += dp_param->log_1minusPacceptor[n-2];
+      UPDATEMAX(I_STATE_I_N);
+
+      /* save maximum values */
+      dpm->score[DNA_I_STATE][modn][m] = maxvalue;
+      if (modn)
+        pathrow[m] |= (retrace << 4);
+      else
+        pathrow[m] |= retrace;
+
+      switch (retrace) {
+       case I_STATE_E_N:
+          /* begin of a new intron */
+          dpm->intronstart[modn][m] = n;
+          break;
+        case I_STATE_I_N:
+          /* continue existing intron */
+          dpm->intronstart[modn][m] = dpm->intronstart[modnminus1][m];
+          break;
+        default: gt_assert(0);
+      }
+    }
+  }
+}
+
+#define GTH_UNIT_TEST_GEN_LENGTH  600
+#define GTH_UNIT_TEST_REF_LENGTH  300
+
+/* the following function creates a genomic sequence with a gene of three exons
+   and a reference sequence, which is either derived from the exons (with a few
+   mismatches and deletions) or random */
+static GtUword unit_test_sequences(unsigned char *gen_seq_tran,
+                                   unsigned char *ref_seq_tran, bool related,
+                                   GtAlphabet *alphabet)
+{
+  static const GtRange exons[] = { { 60, 129 }, { 210, 299 }, { 430, 509 } };
+  GtUword i, j, seed = 42, ref_dp_length = 0;
+  for (i = 0; i < GTH_UNIT_TEST_GEN_LENGTH; i++) {
+    seed = seed * 1103515245 + 12345;
+    gen_seq_tran[i] = gt_alphabet_encode(alphabet, "ACGT"[(seed >> 16) % 4]);
+  }
+  /* the introns start with GT and end with AG */
+  for (i = 0; i < 2; i++) {
+    gen_seq_tran[exons[i].end + 1] = gt_alphabet_encode(alphabet, 'G');
+    gen_seq_tran[exons[i].end + 2] = gt_alphabet_encode(alphabet, 'T');
+    gen_seq_tran[exons[i+1].start - 2] = gt_alphabet_encode(alphabet, 'A');
+    gen_seq_tran[exons[i+1].start - 1] = gt_alphabet_encode(alphabet, 'G');
+  }
+  if (related) {
+    for (i = 0; i < sizeof exons / sizeof exons[0]; i++) {
+      for (j = exons[i].start; j <= exons[i].end; j++) {
+        if (j % 37 == 0)
+          continue;
+        ref_seq_tran[ref_dp_length++] = j % 17 ? gen_seq_tran[j]
+                                               : (gen_seq_tran[j] + 1) % 4;
+      }
+    }
+  }
+  else {
+    for (i = 0; i < GTH_UNIT_TEST_REF_LENGTH / 2; i++) {
+      seed = seed * 1103515245 + 12345;
+      ref_seq_tran[ref_dp_length++] = gt_alphabet_encode(alphabet,
+                                                  "ACGT"[(seed >> 16) % 4]);
+    }
+  }
+  gt_assert(ref_dp_length <= GTH_UNIT_TEST_REF_LENGTH);
+  return ref_dp_length;
+}
+
+/* the following function evaluates the dynamic programming tables with
+   dna_compute_rows() and with dna_compute_rows_cell_by_cell() and checks that
+   the scores, the intron and exon starts, and the backtrace tables are
+   identical */
+static int unit_test_compare_rows(const unsigned char *gen_seq_tran,
+                                  const unsigned char *ref_seq_tran,
+                                  GtUword ref_dp_length,
+                                  GtAlphabet *alphabet, GthDPParam *dp_param,
+                                  GthDPOptionsEST *dp_options_est,
+                                  GthDPOptionsCore *dp_options_core,
+                                  GthStat *stat, GtError *err)
+{
+  GthDPMatrix dpm, dpm_ref;
+  GthDNADPContext context;
+  GtUword n, t, modn, gen_dp_length = GTH_UNIT_TEST_GEN_LENGTH;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_ensure(!dp_matrix_init(&dpm, gen_dp_length, ref_dp_length, 0, false, 0,
+                            NULL, stat));
+  gt_ensure(!dp_matrix_init(&dpm_ref, gen_dp_length, ref_dp_length, 0, false,
+                            0, NULL, stat));
+  if (had_err)
+    return had_err;
+  dna_dp_context_init(&context, gen_seq_tran, ref_seq_tran, ref_dp_length,
+                      alphabet, dp_param, dp_options_est, dp_options_core);
+
+  for (n = 1; !had_err && n <= gen_dp_length; n++) {
+    dna_compute_rows(&dpm, &context, n, n);
+    dna_compute_rows_cell_by_cell(&dpm_ref, &context, n, n);
+    modn = GT_MOD2(n);
+    for (t = DNA_E_STATE; t < DNA_NUMOFSTATES; t++) {
+      gt_ensure(!memcmp(dpm.score[t][modn], dpm_ref.score[t][modn],
+                        sizeof (GthFlt) * (ref_dp_length + 1)));
+    }
+    gt_ensure(!memcmp(dpm.intronstart[modn], dpm_ref.intronstart[modn],
+                      sizeof (GtUword) * (ref_dp_length + 1)));
+    gt_ensure(!memcmp(dpm.exonstart[modn], dpm_ref.exonstart[modn],
+                      sizeof (GtUword) * (ref_dp_length + 1)));
+  }
+  for (n = 0; !had_err && n <= gen_dp_length; n += 2) {
+    gt_ensure(!memcmp(dpm.path[GT_DIV2(n)], dpm_ref.path[GT_DIV2(n)],
+                      sizeof (GthPath) * (ref_dp_length + 1)));
+  }
+
+  dna_dp_context_free(&context);
+  dp_matrix_free(&dpm_ref);
+  dp_matrix_free(&dpm);
+  return had_err;
+}
+
+int gth_align_dna_unit_test(GtError *err)
+{
+  unsigned char gen_seq_tran[GTH_UNIT_TEST_GEN_LENGTH],
+                ref_seq_tran[GTH_UNIT_TEST_REF_LENGTH];
+  GtRange gen_seq_bounds = { 0, GTH_UNIT_TEST_GEN_LENGTH - 1 };
+  GthSpliceSiteModel *splice_site_model;
+  GthDPOptionsCore *dp_options_core;
+  GthDPOptionsEST *dp_options_est;
+  GthDPParam *dp_param;
+  GtAlphabet *alphabet;
+  GthStat *stat;
+  GtUword ref_dp_length, i;
+  int had_err = 0;
+
+  gt_error_check(err);
+  alphabet = gt_alphabet_new_dna();
+  splice_site_model = gth_splice_site_model_new();
+  dp_options_core = gth_dp_options_core_new();
+  dp_options_est = gth_dp_options_est_new();
+  stat = gth_stat_new();
+
+  /* the reference is related or random, with the default options and with
+     free intron transitions and the windows for zero transition weights and
+     decreased output weights covering the whole reference */
+  for (i = 0; !had_err && i < 4; i++) {
+    ref_dp_length = unit_test_sequences(gen_seq_tran, ref_seq_tran, i % 2,
+                                        alphabet);
+    if (i == 2) {
+      dp_options_core->freeintrontrans = true;
+      dp_options_est->wzerotransition = GTH_UNIT_TEST_GEN_LENGTH;
+      dp_options_est->wdecreasedoutput = GTH_UNIT_TEST_REF_LENGTH;
+    }
+    dp_param = gth_dp_param_new_with_range(0, GTH_UNIT_TEST_GEN_LENGTH - 1,
+                                           gen_seq_tran, &gen_seq_bounds,
+                                           splice_site_model, alphabet);
+    gt_ensure(dp_param != NULL);
+    if (!had_err) {
+      had_err = unit_test_compare_rows(gen_seq_tran, ref_seq_tran,
+                                       ref_dp_length, alphabet, dp_param,
+                                       dp_options_est, dp_options_core, stat,
+                                       err);
+    }
+    gth_dp_param_delete(dp_param);
+  }
+
+  gth_stat_delete(stat);
+  gth_dp_options_est_delete(dp_options_est);
+  gth_dp_options_core_delete(dp_options_core);
+  gth_splice_site_model_delete(splice_site_model);
+  gt_alphabet_delete(alphabet);
+  return had_err;
+}
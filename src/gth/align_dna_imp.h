@@ -70,6 +70,9 @@ typedef enum {
   DNA_NUMOFRETRACE
 } DnaRetrace;
 
+/* checkpoint rows of a DP whose backtrace table is stored in strips */
+typedef struct GthDNACheckpoints GthDNACheckpoints;
+
 /* the following structure bundles all tables involved in the dynamic
    programming for cDNAs/ESTs */
 struct GthDPMatrix {
@@ -82,6 +85,8 @@ struct GthDPMatrix {
                 *exonstart[DNA_NUMOFSCORETABLES],
                 gen_dp_length,
                 ref_dp_length;
+  GthDNACheckpoints *checkpoints;   /* if not NULL, <path> only contains the
+                                       rows of the current strip */
 };
 
 #endif
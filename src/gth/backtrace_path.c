@@ -882,6 +882,18 @@ void gth_backtrace_path_show_complete(const GthBacktracePath *bp, bool xmlout,
                      outfp);
 }
 
+const Editoperation* gth_backtrace_path_get_complete(const GthBacktracePath *bp)
+{
+  gt_assert(bp);
+  return gt_array_get_space(bp->editoperations);
+}
+
+GtUword gth_backtrace_path_length_complete(const GthBacktracePath *bp)
+{
+  gt_assert(bp);
+  return gt_array_size(bp->editoperations);
+}
+
 void gth_backtrace_path_cutoff_start(GthBacktracePath *bp)
 {
   gt_assert(bp);
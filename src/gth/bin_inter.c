@@ -0,0 +1,284 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <string.h>
+#include "core/assert_api.h"
+#include "core/ensure.h"
+#include "core/fa.h"
+#include "core/str.h"
+#include "core/xansi_api.h"
+#include "core/xposix.h"
+#include "gth/bin_inter.h"
+
+/* at most 10 bytes of 7 bits are needed for a 64 bit value */
+#define MAX_VARINT_LENGTH  10
+
+void gth_bin_inter_write_header(GtFile *outfp)
+{
+  gt_file_xwrite(outfp, GTH_BIN_INTER_MAGIC, GTH_BIN_INTER_MAGIC_LENGTH);
+  gt_file_xfputc(GTH_BIN_INTER_VERSION, outfp);
+}
+
+void gth_bin_inter_write_record(GtFile *outfp, char type, const GtStr *payload)
+{
+  GtStr *lenbuf;
+  gt_assert(payload);
+  lenbuf = gt_str_new();
+  gt_str_append_char(lenbuf, type);
+  gth_bin_inter_put_uword(lenbuf, gt_str_length(payload));
+  gt_file_xwrite(outfp, gt_str_get_mem(lenbuf), gt_str_length(lenbuf));
+  if (gt_str_length(payload))
+    gt_file_xwrite(outfp, gt_str_get_mem(payload), gt_str_length(payload));
+  gt_str_delete(lenbuf);
+}
+
+void gth_bin_inter_put_uword(GtStr *buf, GtUword value)
+{
+  gt_assert(buf);
+  while (value >= 0x80) {
+    gt_str_append_char(buf, (char) ((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  gt_str_append_char(buf, (char) value);
+}
+
+void gth_bin_inter_put_word(GtStr *buf, GtWord value)
+{
+  /* zigzag encoding, small negative values get short encodings as well */
+  gth_bin_inter_put_uword(buf, value < 0 ? (((GtUword) ~value) << 1) | 1
+                                         : ((GtUword) value) << 1);
+}
+
+static void put_bits(GtStr *buf, uint64_t bits, unsigned int numofbytes)
+{
+  unsigned int i;
+  for (i = 0; i < numofbytes; i++) {
+    gt_str_append_char(buf, (char) (bits & 0xff));
+    bits >>= 8;
+  }
+}
+
+void gth_bin_inter_put_flt(GtStr *buf, GthFlt value)
+{
+  float fvalue = value;
+  uint32_t bits;
+  gt_assert(buf);
+  memcpy(&bits, &fvalue, sizeof bits);
+  put_bits(buf, bits, sizeof bits);
+}
+
+void gth_bin_inter_put_dbl(GtStr *buf, GthDbl value)
+{
+  double dvalue = value;
+  uint64_t bits;
+  gt_assert(buf);
+  memcpy(&bits, &dvalue, sizeof bits);
+  put_bits(buf, bits, sizeof bits);
+}
+
+bool gth_bin_inter_get_uword(GtUword *value, const unsigned char **ptr,
+                             const unsigned char *end)
+{
+  const unsigned char *p;
+  unsigned int shift = 0;
+  GtUword v = 0;
+  gt_assert(value && ptr && *ptr);
+  for (p = *ptr; p < end && shift < 7 * MAX_VARINT_LENGTH; p++, shift += 7) {
+    v |= ((GtUword) (*p & 0x7f)) << shift;
+    if (!(*p & 0x80)) {
+      *value = v;
+      *ptr = p + 1;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool gth_bin_inter_get_word(GtWord *value, const unsigned char **ptr,
+                            const unsigned char *end)
+{
+  GtUword v;
+  gt_assert(value);
+  if (!gth_bin_inter_get_uword(&v, ptr, end))
+    return false;
+  *value = (v & 1) ? (GtWord) ~(v >> 1) : (GtWord) (v >> 1);
+  return true;
+}
+
+static bool get_bits(uint64_t *bits, unsigned int numofbytes,
+                     const unsigned char **ptr, const unsigned char *end)
+{
+  unsigned int i;
+  gt_assert(bits && ptr && *ptr);
+  if (end - *ptr < (ptrdiff_t) numofbytes)
+    return false;
+  *bits = 0;
+  for (i = 0; i < numofbytes; i++)
+    *bits |= ((uint64_t) (*ptr)[i]) << (8 * i);
+  *ptr += numofbytes;
+  return true;
+}
+
+bool gth_bin_inter_get_flt(GthFlt *value, const unsigned char **ptr,
+                           const unsigned char *end)
+{
+  uint64_t bits;
+  uint32_t fbits;
+  float fvalue;
+  gt_assert(value);
+  if (!get_bits(&bits, sizeof fbits, ptr, end))
+    return false;
+  fbits = (uint32_t) bits;
+  memcpy(&fvalue, &fbits, sizeof fvalue);
+  *value = fvalue;
+  return true;
+}
+
+bool gth_bin_inter_get_dbl(GthDbl *value, const unsigned char **ptr,
+                           const unsigned char *end)
+{
+  uint64_t bits;
+  double dvalue;
+  gt_assert(value);
+  if (!get_bits(&bits, sizeof bits, ptr, end))
+    return false;
+  memcpy(&dvalue, &bits, sizeof dvalue);
+  *value = dvalue;
+  return true;
+}
+
+int gth_bin_inter_read_byte(GtFile *fp)
+{
+  unsigned char c;
+  /* gt_file_xfgetc() cannot be used, for compressed files it returns signed
+     characters */
+  return gt_file_xread(fp, &c, 1) == 1 ? c : EOF;
+}
+
+int gth_bin_inter_read_uword(GtUword *value, GtFile *fp)
+{
+  unsigned int shift;
+  GtUword v = 0;
+  int cc;
+  gt_assert(value);
+  for (shift = 0; shift < 7 * MAX_VARINT_LENGTH; shift += 7) {
+    if ((cc = gth_bin_inter_read_byte(fp)) == EOF)
+      return shift ? -1 : 0;
+    v |= ((GtUword) (cc & 0x7f)) << shift;
+    if (!(cc & 0x80)) {
+      *value = v;
+      return (int) (shift / 7 + 1);
+    }
+  }
+  return -1;
+}
+
+int gth_bin_inter_unit_test(GtError *err)
+{
+  static const GtUword uwords[] = { 0, 1, 127, 128, 300, 16383, 16384,
+                                    (GtUword) 1 << 31, GT_UWORD_MAX };
+  static const GtWord words[] = { 0, -1, 1, -64, 63, 64, -65, GT_WORD_MAX,
+                                  GT_WORD_MIN };
+  const unsigned char *ptr, *end;
+  GtUword i, uvalue;
+  GtWord value;
+  GthFlt fltvalue;
+  GthDbl dblvalue;
+  GtStr *buf, *path;
+  GtFile *file;
+  FILE *fp;
+  int had_err = 0;
+
+  gt_error_check(err);
+  buf = gt_str_new();
+
+  /* LEB128: seven bits per byte, least significant group first */
+  gth_bin_inter_put_uword(buf, 300);
+  gt_ensure(gt_str_length(buf) == 2);
+  gt_ensure((unsigned char) gt_str_get(buf)[0] == 0xac);
+  gt_ensure((unsigned char) gt_str_get(buf)[1] == 0x02);
+  for (i = 0; !had_err && i < sizeof uwords / sizeof uwords[0]; i++) {
+    gt_str_reset(buf);
+    gth_bin_inter_put_uword(buf, uwords[i]);
+    gt_ensure(gt_str_length(buf) <= MAX_VARINT_LENGTH);
+    gt_ensure(gt_str_length(buf) == 1 || uwords[i] >= 128);
+    ptr = (const unsigned char*) gt_str_get_mem(buf);
+    end = ptr + gt_str_length(buf);
+    gt_ensure(gth_bin_inter_get_uword(&uvalue, &ptr, end));
+    gt_ensure(uvalue == uwords[i] && ptr == end);
+    /* a truncated value is not decoded */
+    ptr = (const unsigned char*) gt_str_get_mem(buf);
+    gt_ensure(!gth_bin_inter_get_uword(&uvalue, &ptr, end - 1));
+  }
+
+  /* zigzag: 0, -1, 1, -2, ... are mapped to 0, 1, 2, 3, ... */
+  for (i = 0; !had_err && i < 4; i++) {
+    gt_str_reset(buf);
+    gth_bin_inter_put_word(buf, (i & 1) ? -(GtWord) (i + 1) / 2
+                                        : (GtWord) i / 2);
+    gt_ensure(gt_str_length(buf) == 1 &&
+              (GtUword) (unsigned char) gt_str_get(buf)[0] == i);
+  }
+  for (i = 0; !had_err && i < sizeof words / sizeof words[0]; i++) {
+    gt_str_reset(buf);
+    gth_bin_inter_put_word(buf, words[i]);
+    gt_ensure(words[i] < -64 || words[i] >= 64 || gt_str_length(buf) == 1);
+    ptr = (const unsigned char*) gt_str_get_mem(buf);
+    end = ptr + gt_str_length(buf);
+    gt_ensure(gth_bin_inter_get_word(&value, &ptr, end));
+    gt_ensure(value == words[i] && ptr == end);
+  }
+
+  /* floating point numbers are stored with a fixed length */
+  gt_str_reset(buf);
+  gth_bin_inter_put_flt(buf, (GthFlt) 0.25);
+  gth_bin_inter_put_dbl(buf, (GthDbl) -1234.5678);
+  gt_ensure(gt_str_length(buf) == sizeof (float) + sizeof (double));
+  ptr = (const unsigned char*) gt_str_get_mem(buf);
+  end = ptr + gt_str_length(buf);
+  gt_ensure(gth_bin_inter_get_flt(&fltvalue, &ptr, end));
+  gt_ensure(fltvalue == (GthFlt) 0.25);
+  gt_ensure(!gth_bin_inter_get_dbl(&dblvalue, &ptr, end - 1));
+  gt_ensure(gth_bin_inter_get_dbl(&dblvalue, &ptr, end));
+  gt_ensure(dblvalue == (GthDbl) -1234.5678 && ptr == end);
+
+  /* varints read from a file report their length, 0 at the end of the file
+     and -1 for a truncated value */
+  if (!had_err) {
+    path = gt_str_new();
+    fp = gt_xtmpfp(path);
+    gt_str_reset(buf);
+    gth_bin_inter_put_uword(buf, 5);
+    gth_bin_inter_put_uword(buf, GT_UWORD_MAX);
+    gt_xfwrite(gt_str_get_mem(buf), 1, gt_str_length(buf), fp);
+    gt_xfputc(0x80, fp);
+    gt_fa_xfclose(fp);
+    file = gt_file_xopen(gt_str_get(path), "r");
+    gt_ensure(gth_bin_inter_read_uword(&uvalue, file) == 1 && uvalue == 5);
+    gt_ensure(gth_bin_inter_read_uword(&uvalue, file) ==
+              (int) gt_str_length(buf) - 1 && uvalue == GT_UWORD_MAX);
+    gt_ensure(gth_bin_inter_read_uword(&uvalue, file) == -1);
+    gt_ensure(gth_bin_inter_read_uword(&uvalue, file) == 0);
+    gt_file_delete(file);
+    gt_xunlink(gt_str_get(path));
+    gt_str_delete(path);
+  }
+
+  gt_str_delete(buf);
+  return had_err;
+}
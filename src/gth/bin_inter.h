@@ -0,0 +1,86 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef BIN_INTER_H
+#define BIN_INTER_H
+
+#include <stdbool.h>
+#include "core/error_api.h"
+#include "core/file.h"
+#include "core/str_api.h"
+#include "gth/bssm_param.h"
+
+/*
+  The binary intermediate format is an alternative to the XML intermediate
+  output. A file consists of one or more sections, each starting with the
+  header
+
+    GTH_BIN_INTER_MAGIC (7 bytes), version (1 byte)
+
+  followed by records of the form
+
+    type (1 byte), payload length (varint), payload.
+
+  Unsigned integers are stored as LEB128 varints, floating point numbers as
+  little endian IEEE 754 values. Records of type GTH_BIN_INTER_STRING append
+  their payload to the string table of the section, other records refer to
+  the strings (sequence ids and file names) by their index in this table.
+  Records of type GTH_BIN_INTER_SA contain one spliced alignment each. The
+  payload starts with the genomic id, the start and the length of the forward
+  range of the alignment. Readers skip records of unknown type. Because every
+  section is self-contained, concatenated files are valid files.
+*/
+
+#define GTH_BIN_INTER_MAGIC         "\211GTHBSA"
+#define GTH_BIN_INTER_MAGIC_LENGTH  7
+#define GTH_BIN_INTER_VERSION       1
+
+#define GTH_BIN_INTER_STRING        'S'
+#define GTH_BIN_INTER_SA            'A'
+
+/* Write the section header to <outfp>. */
+void gth_bin_inter_write_header(GtFile *outfp);
+/* Write a record of the given <type> with the content of <payload> to
+   <outfp>. */
+void gth_bin_inter_write_record(GtFile *outfp, char type, const GtStr *payload);
+
+/* Append an encoding of <value> to <buf>. */
+void gth_bin_inter_put_uword(GtStr *buf, GtUword value);
+void gth_bin_inter_put_word(GtStr *buf, GtWord value);
+void gth_bin_inter_put_flt(GtStr *buf, GthFlt value);
+void gth_bin_inter_put_dbl(GtStr *buf, GthDbl value);
+
+/* Decode a value from the memory at <*ptr> and advance <*ptr>. Returns false
+   if the encoding exceeds <end>. */
+bool gth_bin_inter_get_uword(GtUword *value, const unsigned char **ptr,
+                             const unsigned char *end);
+bool gth_bin_inter_get_word(GtWord *value, const unsigned char **ptr,
+                            const unsigned char *end);
+bool gth_bin_inter_get_flt(GthFlt *value, const unsigned char **ptr,
+                           const unsigned char *end);
+bool gth_bin_inter_get_dbl(GthDbl *value, const unsigned char **ptr,
+                           const unsigned char *end);
+
+/* Returns the next byte of <fp> as an unsigned char or EOF. */
+int  gth_bin_inter_read_byte(GtFile *fp);
+/* Read a varint from <fp> (byte by byte) and store it in <value>. Returns the
+   number of bytes read on success, 0 if <fp> is exhausted before the first
+   byte, and -1 on a truncated value. */
+int  gth_bin_inter_read_uword(GtUword *value, GtFile *fp);
+
+int  gth_bin_inter_unit_test(GtError*);
+
+#endif
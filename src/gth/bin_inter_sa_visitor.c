@@ -0,0 +1,222 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/cstr_api.h"
+#include "core/hashmap_api.h"
+#include "core/ma_api.h"
+#include "gth/bin_inter.h"
+#include "gth/sa_visitor_rep.h"
+#include "gth/bin_inter_sa_visitor.h"
+
+struct GthBinInterSAVisitor {
+  const GthSAVisitor parent_instance;
+  GthInput *input;
+  GtFile *outfp;
+  GtHashmap *string_table; /* maps strings to their index */
+  GtUword num_of_strings;
+  GtStr *record;
+};
+
+#define bin_inter_sa_visitor_cast(GV)\
+        gth_sa_visitor_cast(gth_bin_inter_sa_visitor_class(), GV)
+
+/* Returns the index of <cstr> in the string table of the current section,
+   writes a string record first if <cstr> has not been seen before. */
+static GtUword string_index(GthBinInterSAVisitor *visitor, const char *cstr)
+{
+  GtUword *idx;
+  gt_assert(visitor && cstr);
+  if (!(idx = gt_hashmap_get(visitor->string_table, cstr))) {
+    GtStr *payload = gt_str_new_cstr(cstr);
+    gth_bin_inter_write_record(visitor->outfp, GTH_BIN_INTER_STRING, payload);
+    gt_str_delete(payload);
+    idx = gt_malloc(sizeof *idx);
+    *idx = visitor->num_of_strings++;
+    gt_hashmap_add(visitor->string_table, gt_cstr_dup(cstr), idx);
+  }
+  return *idx;
+}
+
+static void put_eops(GtStr *record, GthSA *sa)
+{
+  GthBacktracePath *bp = gth_sa_backtrace_path(sa);
+  const Editoperation *eops = gth_backtrace_path_get_complete(bp);
+  GtUword i, num_of_eops = gth_backtrace_path_length_complete(bp),
+          num_of_runs = 0, runlength = 0;
+  bool proteineop = gth_sa_alphatype(sa) == PROTEIN_ALPHA;
+  Eoptype eoptype;
+
+  /* like in the XML output, the edit operations are stored from the last to
+     the first one and consecutive operations of the same type are joined */
+  for (i = 0; i < num_of_eops; i++) {
+    if (!i || gt_editoperation_type(eops[i], proteineop) !=
+              gt_editoperation_type(eops[i-1], proteineop)) {
+      num_of_runs++;
+    }
+  }
+  gth_bin_inter_put_uword(record, num_of_runs);
+  for (i = num_of_eops; i > 0; i--) {
+    eoptype = gt_editoperation_type(eops[i-1], proteineop);
+    runlength += gt_editoperation_length(eops[i-1], proteineop);
+    if (i == 1 || gt_editoperation_type(eops[i-2], proteineop) != eoptype) {
+      gt_assert(NUM_OF_EOP_TYPES <= 16);
+      gth_bin_inter_put_uword(record, (runlength << 4) | eoptype);
+      runlength = 0;
+    }
+  }
+}
+
+static void put_exons_and_introns(GtStr *record, GthSA *sa)
+{
+  GtUword i, prevgen, prevref = 0;
+  bool dnaalpha = gth_sa_alphatype(sa) == DNA_ALPHA;
+  Exoninfo *exon;
+  Introninfo *intron;
+
+  /* exon borders are stored as differences to the previous border */
+  prevgen = gth_sa_gen_dp_start(sa);
+  gth_bin_inter_put_uword(record, gth_sa_num_of_exons(sa));
+  for (i = 0; i < gth_sa_num_of_exons(sa); i++) {
+    exon = gth_sa_get_exon(sa, i);
+    gth_bin_inter_put_word(record,
+                           (GtWord) (exon->leftgenomicexonborder - prevgen));
+    gth_bin_inter_put_word(record, (GtWord) (exon->rightgenomicexonborder -
+                                             exon->leftgenomicexonborder));
+    gth_bin_inter_put_word(record,
+                           (GtWord) (exon->leftreferenceexonborder - prevref));
+    gth_bin_inter_put_word(record, (GtWord) (exon->rightreferenceexonborder -
+                                             exon->leftreferenceexonborder));
+    gth_bin_inter_put_dbl(record, exon->exonscore);
+    prevgen = exon->rightgenomicexonborder;
+    prevref = exon->rightreferenceexonborder;
+  }
+
+  gth_bin_inter_put_uword(record, gth_sa_num_of_introns(sa));
+  for (i = 0; i < gth_sa_num_of_introns(sa); i++) {
+    intron = gth_sa_get_intron(sa, i);
+    gth_bin_inter_put_flt(record, intron->donorsiteprobability);
+    gth_bin_inter_put_flt(record, intron->acceptorsiteprobability);
+    gth_bin_inter_put_dbl(record, dnaalpha ? intron->donorsitescore
+                                           : UNDEFINED_SPLICE_SITE_SCORE);
+    gth_bin_inter_put_dbl(record, dnaalpha ? intron->acceptorsitescore
+                                           : UNDEFINED_SPLICE_SITE_SCORE);
+  }
+}
+
+static void bin_inter_show_spliced_alignment(GthBinInterSAVisitor *visitor,
+                                             GthSA *sa)
+{
+  GtStr *record = visitor->record;
+  GtUword gen_id, gen_file, ref_file, ref_id, flags = 0;
+  GtRange range = { 0, 0 };
+
+  gt_assert(gth_sa_alphatype(sa) == DNA_ALPHA ||
+            gth_sa_alphatype(sa) == PROTEIN_ALPHA);
+
+  /* the strings have to be written before the record which refers to them */
+  gen_id = string_index(visitor, gth_sa_gen_id(sa));
+  gen_file = string_index(visitor,
+                          gth_input_get_genomic_filename(visitor->input,
+                                                     gth_sa_gen_file_num(sa)));
+  ref_file = string_index(visitor,
+                          gth_input_get_reference_filename(visitor->input,
+                                                     gth_sa_ref_file_num(sa)));
+  ref_id = string_index(visitor, gth_sa_ref_id(sa));
+
+  /* key of the record */
+  if (gth_sa_num_of_exons(sa))
+    range = gth_sa_range_forward(sa);
+  gt_str_reset(record);
+  gth_bin_inter_put_uword(record, gen_id);
+  gth_bin_inter_put_uword(record, range.start);
+  gth_bin_inter_put_uword(record, range.end - range.start);
+
+  /* body of the record */
+  if (gth_sa_alphatype(sa) == PROTEIN_ALPHA)
+    flags |= 1;
+  if (gth_sa_gen_strand_forward(sa))
+    flags |= 2;
+  if (gth_sa_ref_strand_forward(sa))
+    flags |= 4;
+  if (gth_sa_genomic_cov_is_highest(sa))
+    flags |= 8;
+  gth_bin_inter_put_uword(record, flags);
+  gth_bin_inter_put_uword(record, gen_file);
+  gth_bin_inter_put_uword(record, ref_file);
+  gth_bin_inter_put_uword(record, ref_id);
+  gth_bin_inter_put_uword(record, gth_sa_gen_seq_num(sa));
+  gth_bin_inter_put_uword(record, gth_sa_ref_seq_num(sa));
+  gth_bin_inter_put_uword(record, gth_sa_gen_dp_start(sa));
+  gth_bin_inter_put_uword(record, gth_sa_gen_dp_length(sa));
+  gth_bin_inter_put_uword(record, gth_sa_gen_total_length(sa));
+  gth_bin_inter_put_uword(record, gth_sa_gen_offset(sa));
+  gth_bin_inter_put_uword(record, gth_sa_ref_total_length(sa));
+  gth_bin_inter_put_uword(record, gth_sa_genomiccutoff_start(sa));
+  gth_bin_inter_put_uword(record, gth_sa_referencecutoff_start(sa));
+  gth_bin_inter_put_uword(record, gth_sa_eopcutoff_start(sa));
+  gth_bin_inter_put_uword(record, gth_sa_genomiccutoff_end(sa));
+  gth_bin_inter_put_uword(record, gth_sa_referencecutoff_end(sa));
+  gth_bin_inter_put_uword(record, gth_sa_eopcutoff_end(sa));
+  put_eops(record, sa);
+  put_exons_and_introns(record, sa);
+  gth_bin_inter_put_uword(record, gth_sa_polyAtail_start(sa));
+  gth_bin_inter_put_uword(record, gth_sa_polyAtail_stop(sa));
+  gth_bin_inter_put_flt(record, gth_sa_score(sa));
+  gth_bin_inter_put_flt(record, gth_sa_coverage(sa));
+  gth_bin_inter_put_uword(record, gth_sa_cumlen_scored_exons(sa));
+
+  gth_bin_inter_write_record(visitor->outfp, GTH_BIN_INTER_SA, record);
+}
+
+static void bin_inter_sa_visitor_free(GthSAVisitor *sa_visitor)
+{
+  GthBinInterSAVisitor *visitor = bin_inter_sa_visitor_cast(sa_visitor);
+  gt_hashmap_delete(visitor->string_table);
+  gt_str_delete(visitor->record);
+}
+
+static void bin_inter_sa_visitor_visit_sa(GthSAVisitor *sa_visitor,
+                                          GthSA *sa)
+{
+  GthBinInterSAVisitor *visitor = bin_inter_sa_visitor_cast(sa_visitor);
+  gt_assert(sa);
+  bin_inter_show_spliced_alignment(visitor, sa);
+}
+
+const GthSAVisitorClass* gth_bin_inter_sa_visitor_class()
+{
+  static const GthSAVisitorClass savc = { sizeof (GthBinInterSAVisitor),
+                                          bin_inter_sa_visitor_free,
+                                          NULL,
+                                          bin_inter_sa_visitor_visit_sa,
+                                          NULL };
+  return &savc;
+}
+
+GthSAVisitor* gth_bin_inter_sa_visitor_new(GthInput *input, GtFile *outfp)
+{
+  GthSAVisitor *sa_visitor =
+    gth_sa_visitor_create(gth_bin_inter_sa_visitor_class());
+  GthBinInterSAVisitor *visitor = bin_inter_sa_visitor_cast(sa_visitor);
+  visitor->input = input;
+  visitor->outfp = outfp;
+  visitor->string_table = gt_hashmap_new(GT_HASH_STRING, gt_free_func,
+                                         gt_free_func);
+  visitor->num_of_strings = 0;
+  visitor->record = gt_str_new();
+  gth_bin_inter_write_header(outfp);
+  return sa_visitor;
+}
@@ -0,0 +1,32 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef BIN_INTER_SA_VISITOR_H
+#define BIN_INTER_SA_VISITOR_H
+
+#include "gth/sa_visitor.h"
+
+/* implements the ``spliced alignment visitor'' interface, writes the
+   alignments in the binary intermediate format (see gth/bin_inter.h) */
+typedef struct GthBinInterSAVisitor GthBinInterSAVisitor;
+
+const GthSAVisitorClass* gth_bin_inter_sa_visitor_class(void);
+/* Creates a visitor which writes to <outfp>, the section header is written
+   immediately. */
+GthSAVisitor*            gth_bin_inter_sa_visitor_new(GthInput*,
+                                                      GtFile *outfp);
+
+#endif
@@ -53,10 +53,14 @@ typedef struct {
          minaveragessp;              /* minimum average splice site probability
                                       */
   bool intermediate,                 /* stop after SA computation */
+       bininter,                     /* write intermediate output in binary
+                                        format */
        proteinexonpenal,             /* add short exon penalty in protein DP */
        disableclustersas,            /* disable the clustering of SAs in
                                         consensus phase */
-       cdnaforward;                  /* align only forward strand of cDNAs */
+       cdnaforward,                  /* align only forward strand of cDNAs */
+       splicesitetrack;              /* store the BSSM probabilities in
+                                        splice site track files */
   GthSAFilter *sa_filter;            /* the spliced alignment filter */
   GthDuplicateCheck duplicate_check; /* the modus use for duplicate checks */
   GthSpliceSiteModel *splice_site_model; /* the splice site model */
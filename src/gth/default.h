@@ -85,6 +85,8 @@
 
 #define GTH_DEFAULT_MAXIMAL_SPLICESITEPROB          ((GthFlt) 0.999999)
 
+#define GTH_DEFAULT_SPLICESITETRACK                 false
+
 #define GTH_DEFAULT_JUMPTABLE            false
 
 /* default values for intron cutouts */
@@ -106,6 +108,8 @@
 #define GTH_DEFAULT_JTOVERLAP            5
 #define GTH_DEFAULT_JTDEBUG              false
 
+#define GTH_DEFAULT_CHECKPOINTMATRIXSIZE 0
+
 #define GTH_DEFAULT_PROBIES              0.5
 #define GTH_DEFAULT_PROBDELGEN           0.03
 #define GTH_DEFAULT_IDENTITYWEIGHT       2.0
@@ -131,6 +135,8 @@
 
 #define GTH_DEFAULT_INTERMEDIATE         false    /* stop after SA
                                                      calculation */
+#define GTH_DEFAULT_BININTER             false    /* binary intermediate
+                                                     output */
 
 /* defaults for sorting of AGSs */
 #define GTH_DEFAULT_SORTAGS              false
@@ -35,6 +35,7 @@ GthDPOptionsCore* gth_dp_options_core_new(void)
   dp_options_core->btmatrixrefrange.end = GT_UNDEF_UWORD;
   dp_options_core->jtoverlap = GTH_DEFAULT_JTOVERLAP;
   dp_options_core->jtdebug = GTH_DEFAULT_JTDEBUG;
+  dp_options_core->checkpointmatrixsize = GTH_DEFAULT_CHECKPOINTMATRIXSIZE;
   return dp_options_core;
 }
 
@@ -34,6 +34,11 @@ typedef struct {
           btmatrixrefrange;
   GtUword jtoverlap;
   bool jtdebug;
+  unsigned int checkpointmatrixsize; /* maximal size (in megabytes) of the
+                                        backtrace table of the cDNA DP, larger
+                                        tables are recomputed from checkpoint
+                                        rows during the backtracing (0 disables
+                                        the checkpointing) */
 } GthDPOptionsCore;
 
 GthDPOptionsCore* gth_dp_options_core_new(void);
@@ -16,22 +16,13 @@
 */
 
 #include <math.h>
-#include "core/chardef.h"
 #include "core/ma_api.h"
 #include "core/range.h"
-#include "core/safearith.h"
 #include "core/unused_api.h"
 #include "gth/bssm_param_rep.h"
-#include "gth/default.h"
 #include "gth/dp_param.h"
 #include "gth/splice_site_model_rep.h"
-
-/* XXX: why A? */
-#define SUBSTITUTEWILDCARDWITHA(C)\
-        if (C ==  WILDCARD)\
-        {\
-          C = gen_alphabet_symbolmap['A'];\
-        }
+#include "gth/splice_site_track.h"
 
 #define CHECK_DP_PARAMETER_ALLOCATION(PTR)\
         if ((PTR) == NULL)\
@@ -40,135 +31,6 @@
           return NULL;\
         }
 
-static void evalsplicesiteprobformodel(GthFlt *prob, bool donorsite,
-                                       const unsigned char *gen_seq_tran,
-                                       const GtRange *gen_seq_bounds,
-                                       GtUword genpos,
-                                       const GtUchar *gen_alphabet_symbolmap,
-                                       GthBSSMModel *bssmmodel)
-{
-  GtUword pc, /* previous char */
-                cc, /* current char */
-                d, i, j;
-  GtWord startpos, endpos;
-  GthDbl pval = 0.5, Tv[3] = { 0.0 }, Fv[4] = { 0.0 };
-  gt_assert(bssmmodel);
-
-  /* set start and endpos */
-  if (donorsite) {
-    startpos = genpos - bssmmodel->window_size_left,
-    endpos   = gt_safe_cast2long(genpos + bssmmodel->window_size_right + 1);
-  }
-  else { /* acceptorsite */
-    startpos =  genpos - bssmmodel->window_size_left - 1,
-    endpos   =  genpos + bssmmodel->window_size_right;
-  }
-
-  if ((startpos >= gt_safe_cast2long(gen_seq_bounds->start)) &&
-      (gt_safe_cast2ulong(endpos) <= gen_seq_bounds->end)) {
-    pc = gen_seq_tran[startpos];
-    SUBSTITUTEWILDCARDWITHA(pc);
-    if (bssmmodel->hypothesis_num == HYPOTHESIS2) {
-      gt_assert(bssmmodel->hypotables.hypo2table);
-      Tv[0] = (double) bssmmodel->hypotables.hypo2table[0][0][pc][0];
-      Fv[0] = (double) bssmmodel->hypotables.hypo2table[1][0][pc][0];
-    }
-    else {
-      gt_assert(bssmmodel->hypotables.hypo7table);
-      Tv[0] = (double) bssmmodel->hypotables.hypo7table[0][0][pc][0];
-      Tv[1] = (double) bssmmodel->hypotables.hypo7table[1][0][pc][0];
-      Tv[2] = (double) bssmmodel->hypotables.hypo7table[2][0][pc][0];
-      Fv[0] = (double) bssmmodel->hypotables.hypo7table[3][0][pc][0];
-      Fv[1] = (double) bssmmodel->hypotables.hypo7table[4][0][pc][0];
-      Fv[2] = (double) bssmmodel->hypotables.hypo7table[5][0][pc][0];
-      Fv[3] = (double) bssmmodel->hypotables.hypo7table[6][0][pc][0];
-    }
-    d = 50 - bssmmodel->window_size_left;
-    for (i = startpos + 1; i <= gt_safe_cast2ulong(endpos); i++) {
-      j = d + (i - startpos);
-      cc = gen_seq_tran[i];
-      SUBSTITUTEWILDCARDWITHA(cc);
-      if (bssmmodel->hypothesis_num == HYPOTHESIS2) {
-        Tv[0] = Tv[0] * bssmmodel->hypotables.hypo2table[0][j][pc][cc];
-        Fv[0] = Fv[0] * bssmmodel->hypotables.hypo2table[1][j][pc][cc];
-      }
-      else {
-        Tv[0] = Tv[0] * bssmmodel->hypotables.hypo7table[0][j][pc][cc];
-        Tv[1] = Tv[1] * bssmmodel->hypotables.hypo7table[1][j][pc][cc];
-        Tv[2] = Tv[2] * bssmmodel->hypotables.hypo7table[2][j][pc][cc];
-        Fv[0] = Fv[0] * bssmmodel->hypotables.hypo7table[3][j][pc][cc];
-        Fv[1] = Fv[1] * bssmmodel->hypotables.hypo7table[4][j][pc][cc];
-        Fv[2] = Fv[2] * bssmmodel->hypotables.hypo7table[5][j][pc][cc];
-        Fv[3] = Fv[3] * bssmmodel->hypotables.hypo7table[6][j][pc][cc];
-      }
-      pc = cc;
-    }
-    if (bssmmodel->hypothesis_num == HYPOTHESIS2)
-      pval = Tv[0] / (Tv[0] + Fv[0]);
-    else {
-      pval = Tv[0] + Tv[1] + Tv[2];
-      pval = pval / (pval + Fv[0] + Fv[1] + Fv[2] + Fv[3]);
-    }
-    /* XXX: prevents problem with fission_yeast.bssm file */
-    if (isnan(pval))
-      pval = 0.0;
-    /* pval is a valid probability */
-    gt_assert(pval >= 0.0 && pval <= 1.0);
-    pval = 2.0 * (pval - 0.5); /* XXX: ? */
-  }
-  else
-    pval = 0.0;
-
-  /* return probability */
-  *prob = (GthFlt) pval;
-}
-
-static void evaldonorprob(GthFlt *prob, const unsigned char *gen_seq_tran,
-                          const GtRange *gen_seq_bounds, GtUword genpos,
-                          const GtUchar *gen_alphabet_symbolmap,
-                          GthBSSMParam *bssm_param)
-{
-  *prob = (GthFlt) 0.0;
-  gt_assert(bssm_param);
-
-  if (genpos < gen_seq_bounds->end) {
-    if (bssm_param->gt_donor_model_set &&
-        gen_seq_tran[genpos]     == gen_alphabet_symbolmap['G'] &&
-        gen_seq_tran[genpos + 1] == gen_alphabet_symbolmap['T']) {
-      evalsplicesiteprobformodel(prob, true, gen_seq_tran, gen_seq_bounds,
-                                 genpos, gen_alphabet_symbolmap,
-                                 &bssm_param->gt_donor_model);
-    }
-    else if (bssm_param->gc_donor_model_set &&
-             gen_seq_tran[genpos]     == gen_alphabet_symbolmap['G'] &&
-             gen_seq_tran[genpos + 1] == gen_alphabet_symbolmap['C']) {
-      evalsplicesiteprobformodel(prob, true, gen_seq_tran, gen_seq_bounds,
-                                 genpos, gen_alphabet_symbolmap,
-                                 &bssm_param->gc_donor_model);
-    }
-  }
-}
-
-static void evalacceptorprob(GthFlt *prob, const unsigned char *gen_seq_tran,
-                             const GtRange *gen_seq_bounds,
-                             GtUword genpos,
-                             const GtUchar *gen_alphabet_symbolmap,
-                             GthBSSMParam *bssm_param)
-{
-  *prob = (GthFlt) 0.0;
-  gt_assert(bssm_param);
-
-  if (genpos > 0 &&
-      gen_seq_tran[genpos - 1] == gen_alphabet_symbolmap['A'] &&
-      gen_seq_tran[genpos]     == gen_alphabet_symbolmap['G']) {
-    if (bssm_param->ag_acceptor_model_set) {
-      evalsplicesiteprobformodel(prob, false, gen_seq_tran, gen_seq_bounds,
-                                 genpos, gen_alphabet_symbolmap,
-                                 &bssm_param->ag_acceptor_model);
-    }
-  }
-}
-
 /*
   The following function evaluates the U12-type intron model.
   That is, if a consensus sequence /[AG]TATCCTT  (where / denotes the exon end
@@ -460,10 +322,9 @@ static void filllogvaluesforonestrand(GtArray *ranges,
   GtUword rangeindex,
        startpos,
        endpos,
-       genomicindex,
        probindex   = 0,
        totallength = gt_ranges_total_length(ranges);
-  GthFlt donorprob, acceptorprob;
+  GthFlt *donorprobs, *acceptorprobs;
   double log_donorprob, log_acceptorprob;
 
   if (!splice_site_model->bssm_param) {
@@ -484,41 +345,51 @@ static void filllogvaluesforonestrand(GtArray *ranges,
                            splice_site_model->bssm_param
                            ->ag_acceptor_model_set);
 
+    /* get the BSSM probabilities from the splice site track, if available */
+    donorprobs = gt_malloc(sizeof *donorprobs * totallength);
+    acceptorprobs = gt_malloc(sizeof *acceptorprobs * totallength);
     for (rangeindex = 0; rangeindex < gt_array_size(ranges); rangeindex++) {
       startpos = ((GtRange*) gt_array_get(ranges, rangeindex))->start;
       endpos   = ((GtRange*) gt_array_get(ranges, rangeindex))->end;
+      if (splice_site_model->splice_site_track) {
+        gth_splice_site_track_get(splice_site_model->splice_site_track,
+                                  donorprobs + probindex,
+                                  acceptorprobs + probindex, gen_seq_tran,
+                                  gen_seq_bounds, startpos, endpos);
+      }
+      else {
+        gth_splice_site_track_compute(donorprobs + probindex,
+                                      acceptorprobs + probindex, gen_seq_tran,
+                                      gen_seq_bounds, startpos, endpos,
+                                      gen_alphabet_symbolmap,
+                                      splice_site_model->bssm_param);
+      }
+      probindex += endpos - startpos + 1;
+    }
+    gt_assert(probindex == totallength);
 
-      for (genomicindex = startpos; genomicindex <= endpos; genomicindex++) {
-        evaldonorprob(&donorprob, gen_seq_tran, gen_seq_bounds, genomicindex,
-                       gen_alphabet_symbolmap, splice_site_model->bssm_param);
-        if (donorprob > GTH_DEFAULT_MAXIMAL_SPLICESITEPROB)
-          donorprob = GTH_DEFAULT_MAXIMAL_SPLICESITEPROB;
-        if (donorprob > 0.0) {
-          log_donorprob = log((double) donorprob);
-          if (log_donorprob > (double) log_Pdonor[probindex]) {
-            log_Pdonor[probindex]       = (GthFlt) log_donorprob;
-            log_1minusPdonor[probindex] = (GthFlt)
-                                          log(1.0 - (double) donorprob);
-          }
+    for (probindex = 0; probindex < totallength; probindex++) {
+      if (donorprobs[probindex] > 0.0) {
+        log_donorprob = log((double) donorprobs[probindex]);
+        if (log_donorprob > (double) log_Pdonor[probindex]) {
+          log_Pdonor[probindex]       = (GthFlt) log_donorprob;
+          log_1minusPdonor[probindex] = (GthFlt)
+                                        log(1.0 - (double)
+                                            donorprobs[probindex]);
         }
-        evalacceptorprob(&acceptorprob, gen_seq_tran, gen_seq_bounds,
-                         genomicindex, gen_alphabet_symbolmap,
-                         splice_site_model->bssm_param);
-        if (acceptorprob > GTH_DEFAULT_MAXIMAL_SPLICESITEPROB)
-          acceptorprob = GTH_DEFAULT_MAXIMAL_SPLICESITEPROB;
-        if (acceptorprob > 0.0) {
-          log_acceptorprob = log((double) acceptorprob);
-          if (log_acceptorprob > (double) log_Pacceptor[probindex]) {
-            log_Pacceptor[probindex]       = (GthFlt) log_acceptorprob;
-            log_1minusPacceptor[probindex] = (GthFlt)
-                                             log(1.0 - (double) acceptorprob);
-          }
+      }
+      if (acceptorprobs[probindex] > 0.0) {
+        log_acceptorprob = log((double) acceptorprobs[probindex]);
+        if (log_acceptorprob > (double) log_Pacceptor[probindex]) {
+          log_Pacceptor[probindex]       = (GthFlt) log_acceptorprob;
+          log_1minusPacceptor[probindex] = (GthFlt)
+                                           log(1.0 - (double)
+                                               acceptorprobs[probindex]);
         }
-        probindex++;
       }
     }
-
-    gt_assert(probindex == totallength);
+    gt_free(donorprobs);
+    gt_free(acceptorprobs);
   }
 }
 
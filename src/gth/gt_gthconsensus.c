@@ -127,7 +127,7 @@ int gt_gthconsensus(int argc, const char **argv, const GthPlugins *plugins,
   }
 
   /* output statistics */
-  if (!had_err && !call_info->out->gff3out)
+  if (!had_err && !call_info->out->gff3out && !call_info->bininter)
     gth_stat_show(stat, false, call_info->out->xmlout, call_info->out->outfp);
 
   /* free space */
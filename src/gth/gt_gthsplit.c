@@ -16,9 +16,12 @@
 */
 
 #include <math.h>
+#include <string.h>
 #include "core/cstr_api.h"
 #include "core/output_file_api.h"
 #include "core/unused_api.h"
+#include "core/versionfunc.h"
+#include "gth/bin_inter_sa_visitor.h"
 #include "gth/gthxml.h"
 #include "gth/gthverbosefunc.h"
 #include "gth/intermediate.h"
@@ -40,7 +43,8 @@ typedef struct {
   unsigned int range;
   GtFileMode file_mode;
   GtStrArray *consensusfiles;
-  bool force;
+  bool force,
+       bininter;
   GthSAFilter *sa_filter; /* owned */
   GthShowVerbose showverbose;
 } Gthsplitinfo;
@@ -53,7 +57,9 @@ typedef struct {
   GtUword *subset_file_sa_counter,
                 num_of_subset_files;
   GthSAFilter *sa_filter; /* reference only */
-  GthSAVisitor *sa_visitor;
+  GthSAVisitor *sa_visitor,
+               **subset_visitors; /* one per split file for -bininter */
+  GthInput *input;
 } Store_in_subset_file_data;
 
 static void close_output_files(Store_in_subset_file_data
@@ -76,8 +82,14 @@ static void close_output_files(Store_in_subset_file_data
         store_in_subset_file_data->gthsplitinfo->showverbose(gt_str_get(buf));
       }
       gt_assert(store_in_subset_file_data->subset_filenames[i]);
-      /* put XML trailer in file before closing it */
-      gth_xml_show_trailer(true, store_in_subset_file_data->subset_files[i]);
+      if (store_in_subset_file_data->gthsplitinfo->bininter) {
+        gth_sa_visitor_delete(store_in_subset_file_data->subset_visitors[i]);
+        store_in_subset_file_data->subset_visitors[i] = NULL;
+      }
+      else {
+        /* put XML trailer in file before closing it */
+        gth_xml_show_trailer(true, store_in_subset_file_data->subset_files[i]);
+      }
       gt_file_delete(store_in_subset_file_data->subset_files[i]);
       gt_str_delete(store_in_subset_file_data->subset_filenames[i]);
       store_in_subset_file_data->subset_files[i]           = NULL;
@@ -188,14 +200,27 @@ static int store_in_subset_file(void *data, GthSA *sa,
                                   ->file_mode,
                                   gt_str_get(store_in_subset_file_data
                                              ->subset_filenames[filenum]), "w");
-      /* store XML header in file */
-      gth_xml_show_leader(true,
-                          store_in_subset_file_data->subset_files[filenum]);
+      if (store_in_subset_file_data->gthsplitinfo->bininter) {
+        /* every binary split file gets its own string table */
+        store_in_subset_file_data->subset_visitors[filenum] =
+          gth_bin_inter_sa_visitor_new(store_in_subset_file_data->input,
+                                       store_in_subset_file_data
+                                       ->subset_files[filenum]);
+      }
+      else {
+        /* store XML header in file */
+        gth_xml_show_leader(true,
+                            store_in_subset_file_data->subset_files[filenum]);
+      }
     }
   }
 
   /* put it there */
-  if (!had_err) {
+  if (!had_err && store_in_subset_file_data->gthsplitinfo->bininter) {
+    gth_sa_visitor_visit_sa(store_in_subset_file_data
+                            ->subset_visitors[filenum], sa);
+  }
+  else if (!had_err) {
     gth_xml_inter_sa_visitor_set_outfp(store_in_subset_file_data->sa_visitor,
                                        store_in_subset_file_data
                                        ->subset_files[filenum]);
@@ -219,6 +244,7 @@ static void initGthsplitinfo(Gthsplitinfo *gthsplitinfo)
   gthsplitinfo->file_mode      = GT_FILE_MODE_UNCOMPRESSED;
   gthsplitinfo->showverbose    = NULL;
   gthsplitinfo->force          = false;
+  gthsplitinfo->bininter       = false;
   gthsplitinfo->sa_filter      = gth_sa_filter_new();
   gthsplitinfo->consensusfiles = gt_str_array_new();
 }
@@ -237,7 +263,7 @@ static GtOPrval gthsplit_parse_options(int *parsed_args,
 {
   GtOptionParser *op;
   GtOption *optalignmentscore, *optcoverage, *optrange, *optverbose, *optgzip,
-           *optbzip2, *optforce;
+           *optbzip2, *optforce, *optbininter;
   bool alignmentscore, coverage, verbose, gzip, bzip2;
   GtOPrval oprval;
 
@@ -281,6 +307,11 @@ static GtOPrval gthsplit_parse_options(int *parsed_args,
                                 "files", &gthsplitinfo->force, false);
   gt_option_parser_add_option(op, optforce);
 
+  optbininter = gt_option_new_bool("bininter", "write split files in the "
+                                   "binary intermediate format instead of "
+                                   "XML", &gthsplitinfo->bininter, false);
+  gt_option_parser_add_option(op, optbininter);
+
   gt_option_exclude(optalignmentscore, optcoverage);
   gt_option_exclude(optgzip, optbzip2);
   gt_option_is_mandatory_either(optalignmentscore, optcoverage);
@@ -351,11 +382,16 @@ static int gthsplit_process_files(Gthsplitinfo *gthsplitinfo,
   store_in_subset_file_data.subset_file_sa_counter =
     gt_malloc(sizeof (GtUword) *
               store_in_subset_file_data.num_of_subset_files);
+  store_in_subset_file_data.subset_visitors =
+    gt_malloc(sizeof (GthSAVisitor*) *
+              store_in_subset_file_data.num_of_subset_files);
   for (i = 0; i < store_in_subset_file_data.num_of_subset_files; i++) {
     store_in_subset_file_data.subset_files[i]           = NULL;
     store_in_subset_file_data.subset_filenames[i]       = NULL;
     store_in_subset_file_data.subset_file_sa_counter[i] = 0;
+    store_in_subset_file_data.subset_visitors[i]        = NULL;
   }
+  store_in_subset_file_data.input = inputinfo;
   store_in_subset_file_data.sa_visitor = gth_xml_inter_sa_visitor_new(inputinfo,
                                                                       0, NULL);
 
@@ -379,6 +415,7 @@ static int gthsplit_process_files(Gthsplitinfo *gthsplitinfo,
   gt_free(store_in_subset_file_data.subset_files);
   gt_free(store_in_subset_file_data.subset_filenames);
   gt_free(store_in_subset_file_data.subset_file_sa_counter);
+  gt_free(store_in_subset_file_data.subset_visitors);
 
   return had_err;
 }
@@ -413,3 +450,22 @@ int gt_gthsplit(int argc, const char **argv, const GthPlugins *plugins,
 
   return had_err;
 }
+
+static GthSeqCon* gthsplit_seq_con_new(GT_UNUSED const char *indexname,
+                                       GT_UNUSED bool assign_rc,
+                                       GT_UNUSED bool orig_seq,
+                                       GT_UNUSED bool tran_seq)
+{
+  /* splitting never accesses the sequences */
+  gt_assert(0);
+  return NULL;
+}
+
+int gt_gthsplit_without_plugins(int argc, const char **argv, GtError *err)
+{
+  GthPlugins plugins;
+  memset(&plugins, 0, sizeof plugins);
+  plugins.seq_con_new = gthsplit_seq_con_new;
+  plugins.gth_version_func = gt_versionfunc;
+  return gt_gthsplit(argc, argv, &plugins, err);
+}
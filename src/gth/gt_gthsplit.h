@@ -25,4 +25,8 @@
 int gt_gthsplit(int argc, const char **argv, const GthPlugins *plugins,
                 GtError*);
 
+/* the gthsplit tool without the GenomeThreader plugins, which are not needed
+   to split intermediate files */
+int gt_gthsplit_without_plugins(int argc, const char **argv, GtError*);
+
 #endif
@@ -15,11 +15,21 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <sys/stat.h>
 #include <expat.h>
 #include "core/compat.h"
+#include "core/ensure.h"
 #include "core/fa.h"
+#include "core/ma_api.h"
+#include "core/minmax.h"
+#include "core/undef_api.h"
 #include "core/unused_api.h"
+#include "core/xposix.h"
+#include "gth/bin_inter.h"
+#include "gth/bin_inter_sa_visitor.h"
+#include "gth/gthxml.h"
 #include "gth/intermediate.h"
+#include "gth/xml_inter_sa_visitor.h"
 
 #define SPLICEDALIGNMENT_TAG            "spliced_alignment"
 #define REFERENCEALPHATYPE_TAG          "referencealphatype"
@@ -69,6 +79,9 @@
 #define CUMULATIVELENGTHOFSCOREDEXONS_TAG\
                                         "cumulativelengthofscoredexons"
 
+/* records of binary intermediate files are read in chunks of this size */
+#define BIN_RECORD_CHUNK_SIZE           (1UL << 20)
+
 #define ILLEGAL_DATA\
         fprintf(stderr, "illegal data in line "GT_WU" of file \"%s\"\n",\
                 parseinfo->linenumber , parseinfo->outputfilename);\
@@ -110,6 +123,13 @@ typedef struct {
   GthStat *stat;
 } SACollectionData;
 
+typedef struct {
+  const char *gen_id;
+  GtRange range;
+  GthSAProcessFunc saprocessfunc;
+  void *data;
+} RegionFilter;
+
 static int store_in_sa_collection(void *data, GthSA *sa,
                                   GT_UNUSED const char *outputfilename,
                                   GT_UNUSED GtError *err)
@@ -468,10 +488,11 @@ static void character_data_handler(void *data, const XML_Char *string, int len)
   gt_str_append_cstr_nt(parseinfo->databuf, string, len);
 }
 
-int gt_parse_intermediate_output(GthInput *input,
-                                 GthSAProcessFunc saprocessfunc, void *data,
-                                 const char *outputfilename,
-                                 GtFile *intermediate_fp, GtError *err)
+static int parse_xml_intermediate_output(GthInput *input,
+                                         GthSAProcessFunc saprocessfunc,
+                                         void *data,
+                                         const char *outputfilename,
+                                         GtFile *intermediate_fp, GtError *err)
 {
   GtStr *line;
   XML_Parser parser;
@@ -546,6 +567,379 @@ int gt_parse_intermediate_output(GthInput *input,
   return had_err;
 }
 
+static bool sa_is_in_region(const RegionFilter *region, const char *gen_id,
+                            const GtRange *range)
+{
+  gt_assert(region && gen_id && range);
+  return !strcmp(region->gen_id, gen_id) &&
+         gt_range_overlap(&region->range, range);
+}
+
+/* process function used to filter the alignments of XML files by region */
+static int process_in_region(void *data, GthSA *sa,
+                             const char *outputfilename, GtError *err)
+{
+  RegionFilter *region = (RegionFilter*) data;
+  GtRange range;
+  gt_error_check(err);
+  range = gth_sa_range_forward(sa);
+  if (sa_is_in_region(region, gth_sa_gen_id(sa), &range)) {
+    return region->saprocessfunc(region->data, sa, outputfilename, err);
+  }
+  gth_sa_delete(sa);
+  return 0;
+}
+
+#define BIN_GET(FUNC, VALUE)\
+        do {\
+          if (!had_err && !FUNC(&(VALUE), &ptr, end))\
+            had_err = -1;\
+        } while (0)
+
+#define BIN_GET_STRING(IDX, CSTR)\
+        do {\
+          BIN_GET(gth_bin_inter_get_uword, IDX);\
+          if (!had_err && IDX >= gt_str_array_size(strings))\
+            had_err = -1;\
+          if (!had_err)\
+            CSTR = gt_str_array_get(strings, IDX);\
+        } while (0)
+
+/* Decodes the body of a binary spliced alignment record in the same order the
+   XML parser sets the corresponding fields. */
+static int decode_bin_sa(GthSA *sa, const unsigned char *ptr,
+                         const unsigned char *end, GtStrArray *strings,
+                         GthInput *input)
+{
+  GtUword i, flags = 0, idx, value = 0, num_of_values = 0;
+  const char *cstr = NULL;
+  Cutoffs cutoffs;
+  Exoninfo exoninfo;
+  Introninfo introninfo;
+  GtWord delta = 0;
+  GthFlt flt = 0.0;
+  GtUword prevgen, prevref = 0;
+  int had_err = 0;
+
+  BIN_GET(gth_bin_inter_get_uword, flags);
+  if (!had_err)
+    gth_sa_set_alphatype(sa, (flags & 1) ? PROTEIN_ALPHA : DNA_ALPHA);
+  if (!had_err) {
+    gth_sa_set_gen_strand(sa, (flags & 2) != 0);
+    gth_sa_set_ref_strand(sa, (flags & 4) != 0);
+    gth_sa_set_highest_cov(sa, (flags & 8) != 0);
+  }
+  BIN_GET_STRING(idx, cstr);
+  if (!had_err) {
+    gth_sa_set_gen_file_num(sa, process_file(input, (char*) cstr,
+                                             GTH_UNDEFINED_HASH, false,
+                                             UNDEF_ALPHA));
+  }
+  BIN_GET_STRING(idx, cstr);
+  if (!had_err) {
+    gth_sa_set_ref_file_num(sa, process_file(input, (char*) cstr,
+                                             GTH_UNDEFINED_HASH, true,
+                                             gth_sa_alphatype(sa)));
+  }
+  BIN_GET_STRING(idx, cstr);
+  if (!had_err)
+    gth_sa_set_ref_id(sa, cstr);
+  BIN_GET(gth_bin_inter_get_uword, value);
+  if (!had_err)
+    gth_sa_set_gen_seq_num(sa, value);
+  BIN_GET(gth_bin_inter_get_uword, value);
+  if (!had_err)
+    gth_sa_set_ref_seq_num(sa, value);
+  BIN_GET(gth_bin_inter_get_uword, prevgen);
+  BIN_GET(gth_bin_inter_get_uword, value);
+  if (!had_err) {
+    gth_sa_set_gen_dp_length(sa, value);
+    gth_sa_set_gen_dp_start(sa, prevgen);
+  }
+  BIN_GET(gth_bin_inter_get_uword, value);
+  if (!had_err)
+    gth_sa_set_gen_total_length(sa, value);
+  BIN_GET(gth_bin_inter_get_uword, value);
+  if (!had_err)
+    gth_sa_set_gen_offset(sa, value);
+  BIN_GET(gth_bin_inter_get_uword, value);
+  if (!had_err)
+    gth_sa_set_ref_total_length(sa, value);
+  BIN_GET(gth_bin_inter_get_uword, cutoffs.genomiccutoff);
+  BIN_GET(gth_bin_inter_get_uword, cutoffs.referencecutoff);
+  BIN_GET(gth_bin_inter_get_uword, cutoffs.eopcutoff);
+  if (!had_err)
+    gth_sa_set_cutoffs_start(sa, &cutoffs);
+  BIN_GET(gth_bin_inter_get_uword, cutoffs.genomiccutoff);
+  BIN_GET(gth_bin_inter_get_uword, cutoffs.referencecutoff);
+  BIN_GET(gth_bin_inter_get_uword, cutoffs.eopcutoff);
+  if (!had_err)
+    gth_sa_set_cutoffs_end(sa, &cutoffs);
+
+  /* edit operations, stored as (length << 4) | type */
+  BIN_GET(gth_bin_inter_get_uword, num_of_values);
+  for (i = 0; !had_err && i < num_of_values; i++) {
+    BIN_GET(gth_bin_inter_get_uword, value);
+    if (!had_err && (value & 0xf) >= NUM_OF_EOP_TYPES)
+      had_err = -1;
+    if (!had_err) {
+      gth_backtrace_path_add_eop(gth_sa_backtrace_path(sa),
+                                 (Eoptype) (value & 0xf), value >> 4);
+    }
+  }
+
+  /* exons, the borders are stored as differences */
+  BIN_GET(gth_bin_inter_get_uword, num_of_values);
+  for (i = 0; !had_err && i < num_of_values; i++) {
+    BIN_GET(gth_bin_inter_get_word, delta);
+    exoninfo.leftgenomicexonborder = prevgen + delta;
+    BIN_GET(gth_bin_inter_get_word, delta);
+    exoninfo.rightgenomicexonborder = exoninfo.leftgenomicexonborder + delta;
+    BIN_GET(gth_bin_inter_get_word, delta);
+    exoninfo.leftreferenceexonborder = prevref + delta;
+    BIN_GET(gth_bin_inter_get_word, delta);
+    exoninfo.rightreferenceexonborder = exoninfo.leftreferenceexonborder
+                                        + delta;
+    BIN_GET(gth_bin_inter_get_dbl, exoninfo.exonscore);
+    if (!had_err) {
+      gth_sa_add_exon(sa, &exoninfo);
+      prevgen = exoninfo.rightgenomicexonborder;
+      prevref = exoninfo.rightreferenceexonborder;
+    }
+  }
+
+  /* introns */
+  BIN_GET(gth_bin_inter_get_uword, num_of_values);
+  for (i = 0; !had_err && i < num_of_values; i++) {
+    BIN_GET(gth_bin_inter_get_flt, introninfo.donorsiteprobability);
+    BIN_GET(gth_bin_inter_get_flt, introninfo.acceptorsiteprobability);
+    BIN_GET(gth_bin_inter_get_dbl, introninfo.donorsitescore);
+    BIN_GET(gth_bin_inter_get_dbl, introninfo.acceptorsitescore);
+    if (!had_err)
+      gth_sa_add_intron(sa, &introninfo);
+  }
+
+  BIN_GET(gth_bin_inter_get_uword, value);
+  if (!had_err)
+    gth_sa_set_polyAtail_start(sa, value);
+  BIN_GET(gth_bin_inter_get_uword, value);
+  if (!had_err)
+    gth_sa_set_polyAtail_stop(sa, value);
+  BIN_GET(gth_bin_inter_get_flt, flt);
+  if (!had_err)
+    gth_sa_set_score(sa, flt);
+  BIN_GET(gth_bin_inter_get_flt, flt);
+  if (!had_err)
+    gth_sa_set_coverage(sa, flt);
+  BIN_GET(gth_bin_inter_get_uword, value);
+  if (!had_err)
+    gth_sa_set_cumlen_scored_exons(sa, value);
+
+  return had_err;
+}
+
+/* Decodes the key of a binary spliced alignment record and, if it lies in
+   <region> (or no <region> is given), the complete alignment, which is passed
+   to <saprocessfunc> afterwards. */
+static int process_bin_sa(GthInput *input, GthSAProcessFunc saprocessfunc,
+                          void *data, const char *outputfilename,
+                          const unsigned char *ptr, const unsigned char *end,
+                          GtStrArray *strings, const RegionFilter *region,
+                          GtUword record_num, GtError *err)
+{
+  GtUword gen_id = 0;
+  GtRange range = { 0, 0 };
+  GthSA *sa;
+  int had_err = 0;
+
+  gt_error_check(err);
+
+  BIN_GET(gth_bin_inter_get_uword, gen_id);
+  BIN_GET(gth_bin_inter_get_uword, range.start);
+  BIN_GET(gth_bin_inter_get_uword, range.end);
+  if (!had_err && gen_id >= gt_str_array_size(strings))
+    had_err = -1;
+  if (had_err) {
+    gt_error_set(err, "record "GT_WU" of file \"%s\" is corrupt", record_num,
+                 outputfilename);
+    return had_err;
+  }
+  range.end += range.start;
+  if (region && !sa_is_in_region(region, gt_str_array_get(strings, gen_id),
+                                 &range)) {
+    return 0;
+  }
+
+  sa = gth_sa_new();
+  gth_sa_set_gen_id(sa, gt_str_array_get(strings, gen_id));
+  if (decode_bin_sa(sa, ptr, end, strings, input)) {
+    gt_error_set(err, "record "GT_WU" of file \"%s\" is corrupt", record_num,
+                 outputfilename);
+    gth_sa_delete(sa);
+    return -1;
+  }
+
+  /* same post processing as for the XML intermediate output */
+  gth_backtrace_path_reverse(gth_sa_backtrace_path(sa));
+  gth_backtrace_path_ensure_length_1_before_introns(gth_sa_backtrace_path(sa));
+
+  return saprocessfunc(data, sa, outputfilename, err);
+}
+
+/* Parses a binary intermediate file, the first byte of the magic has already
+   been read from <intermediate_fp>. If <region> is given, spliced alignment
+   records outside of it are skipped after decoding their key. If the size
+   <filesize> of the file is known (that is, not <GT_UNDEF_UWORD>), records
+   exceeding it are rejected. Otherwise records are read in chunks, so that a
+   corrupt record length does not lead to a huge allocation. */
+static int parse_bin_intermediate_output(GthInput *input,
+                                         GthSAProcessFunc saprocessfunc,
+                                         void *data,
+                                         const char *outputfilename,
+                                         GtFile *intermediate_fp,
+                                         const RegionFilter *region,
+                                         GtUword filesize, GtError *err)
+{
+  GtStrArray *strings;
+  unsigned char *record = NULL;
+  GtUword i, record_length, allocated = 0, record_num = 0,
+          offset = 1, /* the first byte of the magic */
+          chunk, got;
+  bool in_header = true;
+  int cc = 0, rval, had_err = 0;
+
+  gt_error_check(err);
+  strings = gt_str_array_new();
+
+  while (!had_err) {
+    if (in_header) {
+      /* the first byte of the magic has already been read */
+      for (i = 1; !had_err && i < GTH_BIN_INTER_MAGIC_LENGTH; i++) {
+        if (gth_bin_inter_read_byte(intermediate_fp) !=
+            (unsigned char) GTH_BIN_INTER_MAGIC[i]) {
+          had_err = -1;
+        }
+      }
+      if (had_err) {
+        gt_error_set(err, "file \"%s\" is not a binary intermediate file",
+                     outputfilename);
+      }
+      else if ((cc = gth_bin_inter_read_byte(intermediate_fp)) !=
+               GTH_BIN_INTER_VERSION) {
+        gt_error_set(err, "binary intermediate file \"%s\" has version %d, "
+                     "expected version %d", outputfilename, cc,
+                     GTH_BIN_INTER_VERSION);
+        had_err = -1;
+      }
+      /* every section has its own string table */
+      gt_str_array_reset(strings);
+      in_header = false;
+      offset += GTH_BIN_INTER_MAGIC_LENGTH;
+      continue;
+    }
+    if ((cc = gth_bin_inter_read_byte(intermediate_fp)) == EOF)
+      break;
+    offset++;
+    if (cc == (unsigned char) GTH_BIN_INTER_MAGIC[0]) {
+      in_header = true;
+      continue;
+    }
+    record_num++;
+    if ((rval = gth_bin_inter_read_uword(&record_length,
+                                         intermediate_fp)) <= 0) {
+      gt_error_set(err, "record "GT_WU" of file \"%s\" is truncated",
+                   record_num, outputfilename);
+      had_err = -1;
+      break;
+    }
+    offset += rval;
+    if (filesize != GT_UNDEF_UWORD &&
+        (offset > filesize || record_length > filesize - offset)) {
+      gt_error_set(err, "record "GT_WU" of file \"%s\" has length "GT_WU
+                   ", which exceeds the remaining file size", record_num,
+                   outputfilename, record_length);
+      had_err = -1;
+      break;
+    }
+    for (got = 0; got < record_length; got += chunk) {
+      chunk = MIN(record_length - got, BIN_RECORD_CHUNK_SIZE);
+      if (got + chunk > allocated) {
+        allocated = got + chunk;
+        record = gt_realloc(record, allocated);
+      }
+      if (gt_file_xread(intermediate_fp, record + got, chunk) != (int) chunk) {
+        gt_error_set(err, "record "GT_WU" of file \"%s\" is truncated",
+                     record_num, outputfilename);
+        had_err = -1;
+        break;
+      }
+    }
+    if (had_err)
+      break;
+    offset += record_length;
+    switch (cc) {
+      case GTH_BIN_INTER_STRING:
+        gt_str_array_add_cstr_nt(strings, (const char*) record, record_length);
+        break;
+      case GTH_BIN_INTER_SA:
+        had_err = process_bin_sa(input, saprocessfunc, data, outputfilename,
+                                 record, record + record_length, strings,
+                                 region, record_num, err);
+        break;
+      default:
+        /* skip records of unknown type */
+        break;
+    }
+  }
+
+  gt_free(record);
+  gt_str_array_delete(strings);
+  return had_err;
+}
+
+/* Determines the format of <intermediate_fp> by its first byte and parses it
+   accordingly. <filesize> is the size of the file, if it is known, and
+   <GT_UNDEF_UWORD> otherwise. */
+static int parse_intermediate_output(GthInput *input,
+                                     GthSAProcessFunc saprocessfunc,
+                                     void *data, const char *outputfilename,
+                                     GtFile *intermediate_fp,
+                                     RegionFilter *region, GtUword filesize,
+                                     GtError *err)
+{
+  int cc;
+  gt_error_check(err);
+  cc = gt_file_xfgetc(intermediate_fp);
+  if (cc != EOF &&
+      (unsigned char) cc == (unsigned char) GTH_BIN_INTER_MAGIC[0]) {
+    return parse_bin_intermediate_output(input, saprocessfunc, data,
+                                         outputfilename, intermediate_fp,
+                                         region, filesize, err);
+  }
+  if (cc != EOF)
+    gt_file_unget_char(intermediate_fp, cc);
+  if (region) {
+    region->saprocessfunc = saprocessfunc;
+    region->data = data;
+    return parse_xml_intermediate_output(input, process_in_region, region,
+                                         outputfilename, intermediate_fp, err);
+  }
+  return parse_xml_intermediate_output(input, saprocessfunc, data,
+                                       outputfilename, intermediate_fp, err);
+}
+
+/* Returns the size of the intermediate file <filename> opened as <fp>, if it
+   is a regular uncompressed file, and <GT_UNDEF_UWORD> otherwise. */
+static GtUword intermediate_file_size(GtFile *fp, const char *filename)
+{
+  struct stat sb;
+  if (gt_file_mode(fp) != GT_FILE_MODE_UNCOMPRESSED ||
+      stat(filename, &sb) || !S_ISREG(sb.st_mode)) {
+    return GT_UNDEF_UWORD;
+  }
+  return (GtUword) sb.st_size;
+}
+
 bool gth_intermediate_output_is_correct(char *outputfilename,
                                         GthSACollection *orig_sa_collection,
                                         GthInput *input,
@@ -584,9 +978,11 @@ bool gth_intermediate_output_is_correct(char *outputfilename,
   gt_assert(*outfp);
 
   /* read in the intermediate output */
-  if (gt_parse_intermediate_output(input, store_in_sa_collection,
-                                   &sa_collection_data, outputfilename, *outfp,
-                                   err)) {
+  if (parse_intermediate_output(input, store_in_sa_collection,
+                                &sa_collection_data, outputfilename, *outfp,
+                                NULL,
+                                intermediate_file_size(*outfp, outputfilename),
+                                err)) {
     fprintf(stderr, "error: %s\n", gt_error_get(err));
     exit(EXIT_FAILURE);
   }
@@ -624,9 +1020,11 @@ static void show_parse_file_status(GthShowVerbose showverbose,
 /* The following function processes a set of consensus files. If no consensus
    file is given, stdin is used as input. */
 
-int gth_process_intermediate_files(GthInput *input, GtStrArray *consensusfiles,
-                                   GthSAProcessFunc saprocessfunc, void *data,
-                                   GthShowVerbose showverbose, GtError *err)
+static int process_intermediate_files(GthInput *input,
+                                      GtStrArray *consensusfiles,
+                                      GthSAProcessFunc saprocessfunc,
+                                      void *data, RegionFilter *region,
+                                      GthShowVerbose showverbose, GtError *err)
 {
   GtUword i;
   GtFile *fp, *genfile;
@@ -646,9 +1044,11 @@ int gth_process_intermediate_files(GthInput *input, GtStrArray *consensusfiles,
                                gt_str_array_get(consensusfiles, i));
       }
 
-      had_err = gt_parse_intermediate_output(input, saprocessfunc, data,
+      had_err = parse_intermediate_output(input, saprocessfunc, data,
                                           gt_str_array_get(consensusfiles, i),
-                                          fp, err);
+                                          fp, region, intermediate_file_size(fp,
+                                          gt_str_array_get(consensusfiles, i)),
+                                          err);
 
       /* close file */
       gt_file_delete(fp);
@@ -656,14 +1056,41 @@ int gth_process_intermediate_files(GthInput *input, GtStrArray *consensusfiles,
   }
   else {
     genfile = gt_file_new_from_fileptr(stdin);
-    had_err = gt_parse_intermediate_output(input, saprocessfunc, data, "stdin",
-                                           genfile, err);
+    had_err = parse_intermediate_output(input, saprocessfunc, data, "stdin",
+                                        genfile, region, GT_UNDEF_UWORD, err);
     gt_file_delete_without_handle(genfile);
   }
 
   return had_err;
 }
 
+int gth_process_intermediate_files(GthInput *input, GtStrArray *consensusfiles,
+                                   GthSAProcessFunc saprocessfunc, void *data,
+                                   GthShowVerbose showverbose, GtError *err)
+{
+  return process_intermediate_files(input, consensusfiles, saprocessfunc, data,
+                                    NULL, showverbose, err);
+}
+
+int gth_process_intermediate_files_in_region(GthInput *input,
+                                             GtStrArray *consensusfiles,
+                                             const char *gen_id,
+                                             const GtRange *range,
+                                             GthSAProcessFunc saprocessfunc,
+                                             void *data,
+                                             GthShowVerbose showverbose,
+                                             GtError *err)
+{
+  RegionFilter region;
+  gt_assert(gen_id && range);
+  region.gen_id = gen_id;
+  region.range = *range;
+  region.saprocessfunc = NULL;
+  region.data = NULL;
+  return process_intermediate_files(input, consensusfiles, saprocessfunc, data,
+                                    &region, showverbose, err);
+}
+
 int gth_build_sa_collection(GthSACollection *sa_collection, GthInput *input,
                             GtStrArray *consensusfiles, GthSAFilter *sa_filter,
                             GthStat *stat, GthShowVerbose showverbose,
@@ -679,3 +1106,246 @@ int gth_build_sa_collection(GthSACollection *sa_collection, GthInput *input,
                                         store_in_sa_collection,
                                         &sa_collection_data, showverbose, err);
 }
+
+static GthSeqCon* unit_test_seq_con_new(GT_UNUSED const char *indexname,
+                                        GT_UNUSED bool assign_rc,
+                                        GT_UNUSED bool orig_seq,
+                                        GT_UNUSED bool tran_seq)
+{
+  /* the intermediate files are processed without the sequences */
+  gt_assert(0);
+  return NULL;
+}
+
+/* Returns a DNA spliced alignment on the forward strand of <gen_id> with two
+   exons, which starts at <gen_start>. */
+static GthSA* unit_test_sa_new(const char *gen_id, GtUword gen_start,
+                               GthFlt score)
+{
+  Cutoffs cutoffs = { 0, 0, 0 };
+  Exoninfo exoninfo;
+  Introninfo introninfo;
+  GthSA *sa = gth_sa_new();
+  gth_sa_set_alphatype(sa, DNA_ALPHA);
+  gth_sa_set_gen_strand(sa, true);
+  gth_sa_set_ref_strand(sa, true);
+  gth_sa_set_gen_id(sa, gen_id);
+  gth_sa_set_ref_id(sa, "est1");
+  gth_sa_set_gen_file_num(sa, 0);
+  gth_sa_set_gen_seq_num(sa, gen_id[3] == '1' ? 0 : 1);
+  gth_sa_set_ref_file_num(sa, 0);
+  gth_sa_set_ref_seq_num(sa, 0);
+  gth_sa_set_gen_dp_start(sa, gen_start);
+  gth_sa_set_gen_dp_length(sa, 120);
+  gth_sa_set_gen_total_length(sa, 10000);
+  gth_sa_set_gen_offset(sa, 0);
+  gth_sa_set_ref_total_length(sa, 40);
+  gth_sa_set_cutoffs_start(sa, &cutoffs);
+  gth_sa_set_cutoffs_end(sa, &cutoffs);
+  gth_backtrace_path_add_eop(gth_sa_backtrace_path(sa), EOP_TYPE_MATCH, 20);
+  gth_backtrace_path_add_eop(gth_sa_backtrace_path(sa), EOP_TYPE_INTRON, 80);
+  gth_backtrace_path_add_eop(gth_sa_backtrace_path(sa), EOP_TYPE_MISMATCH, 1);
+  gth_backtrace_path_add_eop(gth_sa_backtrace_path(sa), EOP_TYPE_MATCH, 19);
+  exoninfo.leftgenomicexonborder = gen_start;
+  exoninfo.rightgenomicexonborder = gen_start + 19;
+  exoninfo.leftreferenceexonborder = 0;
+  exoninfo.rightreferenceexonborder = 19;
+  exoninfo.exonscore = 1.0;
+  gth_sa_add_exon(sa, &exoninfo);
+  exoninfo.leftgenomicexonborder = gen_start + 100;
+  exoninfo.rightgenomicexonborder = gen_start + 119;
+  exoninfo.leftreferenceexonborder = 20;
+  exoninfo.rightreferenceexonborder = 39;
+  exoninfo.exonscore = 0.95;
+  gth_sa_add_exon(sa, &exoninfo);
+  introninfo.donorsiteprobability = 0.5;
+  introninfo.acceptorsiteprobability = 0.25;
+  introninfo.donorsitescore = 0.75;
+  introninfo.acceptorsitescore = 0.125;
+  gth_sa_add_intron(sa, &introninfo);
+  gth_sa_set_polyAtail_start(sa, 0);
+  gth_sa_set_polyAtail_stop(sa, 0);
+  gth_sa_set_score(sa, score);
+  gth_sa_set_coverage(sa, 1.0);
+  gth_sa_set_highest_cov(sa, false);
+  gth_sa_set_cumlen_scored_exons(sa, 40);
+  return sa;
+}
+
+static int unit_test_count_sa(void *data, GthSA *sa,
+                              GT_UNUSED const char *outputfilename,
+                              GT_UNUSED GtError *err)
+{
+  (*(GtUword*) data)++;
+  gth_sa_delete(sa);
+  return 0;
+}
+
+static int unit_test_visit_sa(void *data, GthSA *sa,
+                              GT_UNUSED const char *outputfilename,
+                              GT_UNUSED GtError *err)
+{
+  gth_sa_visitor_visit_sa((GthSAVisitor*) data, sa);
+  gth_sa_delete(sa);
+  return 0;
+}
+
+/* Writes the spliced alignments of <filename> to a new temporary file, whose
+   name is stored in <outfilename>, in the binary or XML intermediate
+   format. */
+static int unit_test_convert(GthInput *input, const char *filename,
+                             GtStr *outfilename, bool bininter, GtError *err)
+{
+  GtStrArray *files = gt_str_array_new();
+  GthSAVisitor *visitor;
+  GtFile *outfp;
+  int had_err;
+  gt_fa_xfclose(gt_xtmpfp(outfilename));
+  outfp = gt_file_xopen(gt_str_get(outfilename), "w");
+  if (bininter)
+    visitor = gth_bin_inter_sa_visitor_new(input, outfp);
+  else {
+    gth_xml_show_leader(true, outfp);
+    visitor = gth_xml_inter_sa_visitor_new(input, 1, outfp);
+  }
+  gt_str_array_add_cstr(files, filename);
+  had_err = gth_process_intermediate_files(input, files, unit_test_visit_sa,
+                                           visitor, NULL, err);
+  gth_sa_visitor_delete(visitor);
+  if (!bininter)
+    gth_xml_show_trailer(true, outfp);
+  gt_file_delete(outfp);
+  gt_str_array_delete(files);
+  return had_err;
+}
+
+static bool unit_test_files_are_equal(const char *filename_a,
+                                      const char *filename_b)
+{
+  GtStr *a = gt_str_new(), *b = gt_str_new();
+  bool equal;
+  FILE *fp;
+  int cc;
+  fp = gt_fa_xfopen(filename_a, "r");
+  while ((cc = fgetc(fp)) != EOF)
+    gt_str_append_char(a, cc);
+  gt_fa_xfclose(fp);
+  fp = gt_fa_xfopen(filename_b, "r");
+  while ((cc = fgetc(fp)) != EOF)
+    gt_str_append_char(b, cc);
+  gt_fa_xfclose(fp);
+  equal = !gt_str_cmp(a, b);
+  gt_str_delete(a);
+  gt_str_delete(b);
+  return equal;
+}
+
+int gth_intermediate_unit_test(GtError *err)
+{
+  static const char *gen_ids[] = { "seq1", "seq1", "seq2" };
+  static const GtUword gen_starts[] = { 100, 5000, 100 };
+  GtStr *xmlfile = gt_str_new(), *binfile = gt_str_new(),
+        *xmlfile2 = gt_str_new();
+  GtStrArray *files = gt_str_array_new();
+  GthSAVisitor *visitor;
+  GthInput *input;
+  GtRange range;
+  GtUword i, count;
+  GtFile *outfp;
+  int had_err = 0;
+
+  gt_error_check(err);
+  input = gth_input_new(NULL, unit_test_seq_con_new);
+  gth_input_add_genomic_file(input, "genomic.fas");
+  gth_input_add_reference_file(input, "ests.fas", DNA_ALPHA);
+
+  /* write the spliced alignments as XML intermediate output */
+  gt_fa_xfclose(gt_xtmpfp(xmlfile));
+  outfp = gt_file_xopen(gt_str_get(xmlfile), "w");
+  gth_xml_show_leader(true, outfp);
+  visitor = gth_xml_inter_sa_visitor_new(input, 1, outfp);
+  for (i = 0; i < sizeof gen_ids / sizeof gen_ids[0]; i++) {
+    GthSA *sa = unit_test_sa_new(gen_ids[i], gen_starts[i], 0.5 + 0.1 * i);
+    gth_sa_visitor_visit_sa(visitor, sa);
+    gth_sa_delete(sa);
+  }
+  gth_sa_visitor_delete(visitor);
+  gth_xml_show_trailer(true, outfp);
+  gt_file_delete(outfp);
+
+  /* XML -> binary -> XML reproduces the XML file */
+  had_err = unit_test_convert(input, gt_str_get(xmlfile), binfile, true, err);
+  if (!had_err) {
+    had_err = unit_test_convert(input, gt_str_get(binfile), xmlfile2, false,
+                                err);
+  }
+  gt_ensure(unit_test_files_are_equal(gt_str_get(xmlfile),
+                                      gt_str_get(xmlfile2)));
+  /* the files of the alignments are not added again */
+  gt_ensure(gth_input_num_of_gen_files(input) == 1);
+  gt_ensure(gth_input_num_of_ref_files(input) == 1);
+
+  /* region queries give the same alignments for both formats */
+  for (i = 0; !had_err && i < 2; i++) {
+    gt_str_array_reset(files);
+    gt_str_array_add(files, i ? binfile : xmlfile);
+    count = 0;
+    range.start = 0;
+    range.end = 9999;
+    had_err = gth_process_intermediate_files_in_region(input, files, "seq1",
+                                                       &range,
+                                                       unit_test_count_sa,
+                                                       &count, NULL, err);
+    gt_ensure(count == 2);
+    count = 0;
+    range.start = 219;
+    range.end = 5000;
+    if (!had_err) {
+      had_err = gth_process_intermediate_files_in_region(input, files, "seq1",
+                                                         &range,
+                                                         unit_test_count_sa,
+                                                         &count, NULL, err);
+    }
+    gt_ensure(count == 2);
+    count = 0;
+    range.start = 220;
+    range.end = 4999;
+    if (!had_err) {
+      had_err = gth_process_intermediate_files_in_region(input, files, "seq1",
+                                                         &range,
+                                                         unit_test_count_sa,
+                                                         &count, NULL, err);
+    }
+    gt_ensure(count == 0);
+    count = 0;
+    range.start = 0;
+    range.end = 150;
+    if (!had_err) {
+      had_err = gth_process_intermediate_files_in_region(input, files, "seq2",
+                                                         &range,
+                                                         unit_test_count_sa,
+                                                         &count, NULL, err);
+    }
+    gt_ensure(count == 1);
+    count = 0;
+    if (!had_err) {
+      had_err = gth_process_intermediate_files_in_region(input, files, "seq3",
+                                                         &range,
+                                                         unit_test_count_sa,
+                                                         &count, NULL, err);
+    }
+    gt_ensure(count == 0);
+  }
+
+  gt_xunlink(gt_str_get(xmlfile));
+  if (gt_str_length(binfile))
+    gt_xunlink(gt_str_get(binfile));
+  if (gt_str_length(xmlfile2))
+    gt_xunlink(gt_str_get(xmlfile2));
+  gth_input_delete_complete(input);
+  gt_str_array_delete(files);
+  gt_str_delete(xmlfile);
+  gt_str_delete(binfile);
+  gt_str_delete(xmlfile2);
+  return had_err;
+}
@@ -33,6 +33,16 @@ bool gth_intermediate_output_is_correct(char *outputfilename,
 int  gth_process_intermediate_files(GthInput*, GtStrArray *consensusfiles,
                                     GthSAProcessFunc, void *data,
                                     GthShowVerbose, GtError*);
+/* Like gth_process_intermediate_files(), but only the spliced alignments on
+   the genomic sequence <gen_id> whose forward range overlaps <range> are passed
+   to the <GthSAProcessFunc>. In binary intermediate files only the key of the
+   other alignments is decoded. */
+int  gth_process_intermediate_files_in_region(GthInput*,
+                                              GtStrArray *consensusfiles,
+                                              const char *gen_id,
+                                              const GtRange *range,
+                                              GthSAProcessFunc, void *data,
+                                              GthShowVerbose, GtError*);
 
 /* The following function builds a tree of alignments from a set of consensus
   files. If no consensus file is given, stdin is used as input. */
@@ -40,4 +50,6 @@ int  gth_build_sa_collection(GthSACollection*, GthInput*,
                              GtStrArray *consensusfiles, GthSAFilter*, GthStat*,
                              GthShowVerbose, GtError*);
 
+int  gth_intermediate_unit_test(GtError*);
+
 #endif
@@ -21,6 +21,7 @@
 #include "gth/gthdef.h"
 #include "gth/gthspeciestab.h"
 #include "gth/parse_options.h"
+#include "gth/splice_site_track.h"
 
 #define SHOWINTRONMAXLEN_OPT_CSTR   "showintronmaxlen"
 #define TOPOS_OPT_CSTR              "topos"
@@ -111,6 +112,7 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
          *optprotein = NULL,              /* mandatory input */
          *optspecies = NULL,              /* BSSM parameter */
          *optbssm = NULL,                 /* BSSM parameter */
+         *optsplicesitetrack = NULL,      /* BSSM splice site track */
          *optscorematrix = NULL,          /* score matrix */
          *opttranslationtable = NULL,     /* translationtable */
          *optforward = NULL,              /* strand direction */
@@ -168,6 +170,7 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
          *optintroncutout = NULL,         /* sim. filter, after gl. chaining */
          *optfastdp = NULL,               /* sim. filter, after gl. chaining */
          *optautointroncutout = NULL,     /* sim. filter, after gl. chaining */
+         *optcheckpointdp = NULL,
          *opticinitialdelta = NULL,       /* sim. filter, after gl. chaining */
          *opticiterations = NULL,         /* sim. filter, after gl. chaining */
          *opticdeltaincrease = NULL,      /* sim. filter, after gl. chaining */
@@ -208,6 +211,7 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
          *optminaveragessp = NULL,        /* advanced similarity filter */
          *optduplicatecheck= NULL,        /* advanced similarity filter */
          *optintermediate = NULL,         /* stop after SA computation */
+         *optbininter = NULL,             /* binary intermediate output */
          *optsortags = NULL,              /* postproc. of PGLs, sorting of
                                              AGSs */
          *optsortagswf = NULL,            /* postproc. of PGLs, sorting of
@@ -306,6 +310,22 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
     gt_option_parser_add_option(op, optbssm);
   }
 
+  /* -splicesitetrack */
+  if (!gthconsensus_parsing) {
+    optsplicesitetrack = gt_option_new_bool("splicesitetrack", "store the "
+                                            "BSSM splice site probabilities "
+                                            "of every genomic file in a track "
+                                            "file (suffix "
+                                            GTH_SPLICE_SITE_TRACK_FILE_SUFFIX
+                                            ", 16 bytes per position) and use "
+                                            "it in later runs with the same "
+                                            "BSSM parameters",
+                                            &call_info->splicesitetrack,
+                                            GTH_DEFAULT_SPLICESITETRACK);
+    gt_option_is_extended_option(optsplicesitetrack);
+    gt_option_parser_add_option(op, optsplicesitetrack);
+  }
+
   /* -scorematrix */
   optscorematrix = gt_option_new_string("scorematrix", "read amino acid "
                                      "substitution scoring matrix from file in "
@@ -790,6 +810,22 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
     gt_option_parser_add_option(op, optautointroncutout);
   }
 
+  /* -checkpointdp */
+  if (!gthconsensus_parsing) {
+    optcheckpointdp = gt_option_new_uint("checkpointdp", "set the maximal "
+                                         "backtrace matrix size in megabytes "
+                                         "for cDNA/EST alignments, larger "
+                                         "matrices are only stored at "
+                                         "checkpoint rows and recomputed "
+                                         "during the backtracing (0 disables "
+                                         "checkpointing)",
+                                         &call_info->dp_options_core
+                                         ->checkpointmatrixsize,
+                                         GTH_DEFAULT_CHECKPOINTMATRIXSIZE);
+    gt_option_is_extended_option(optcheckpointdp);
+    gt_option_parser_add_option(op, optcheckpointdp);
+  }
+
   /* -icinitialdelta */
   if (!gthconsensus_parsing) {
     opticinitialdelta = gt_option_new_uint(ICINITIALDELTA_OPT_CSTR, "set the "
@@ -1180,6 +1216,16 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
                                        GTH_DEFAULT_INTERMEDIATE);
   gt_option_parser_add_option(op, optintermediate);
 
+  /* -bininter */
+  optbininter = gt_option_new_bool("bininter", "write the intermediate "
+                                   "results in a compact binary format "
+                                   "instead of XML (requires -intermediate). "
+                                   "The files can be processed with "
+                                   "gthconsensus and gthsplit",
+                                   &call_info->bininter,
+                                   GTH_DEFAULT_BININTER);
+  gt_option_parser_add_option(op, optbininter);
+
   /* -sortags */
   optsortags = gt_option_new_bool("sortags", "sort alternative gene structures "
                                   "according to the weighted mean of the "
@@ -1316,6 +1362,10 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
     gt_option_exclude(optskipalignmentout, optintermediate);
   if (optxmlout && optgff3out)
     gt_option_exclude(optxmlout, optgff3out);
+  if (optbininter && optxmlout)
+    gt_option_exclude(optbininter, optxmlout);
+  if (optbininter && optgff3out)
+    gt_option_exclude(optbininter, optgff3out);
 
   /* option implications (single) */
   if (opttopos && optfrompos)
@@ -1328,6 +1378,8 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
     gt_option_imply(optsortagswf, optsortags);
   gt_option_imply(optgff3descranges, optgff3out);
   gt_option_imply(optmd5ids, optgff3out);
+  if (optbininter && optintermediate)
+    gt_option_imply(optbininter, optintermediate);
   if (optbtmatrixgenrange && optbtmatrixrefrange) {
     gt_option_imply(optbtmatrixgenrange, optbtmatrixrefrange);
     gt_option_imply(optbtmatrixrefrange, optbtmatrixrefrange);
@@ -1336,6 +1388,8 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
   /* option implications (either 2) */
   if (optgff3out && optskipalignmentout && optintermediate)
     gt_option_imply_either_2(optgff3out, optskipalignmentout, optintermediate);
+  if (optsplicesitetrack && optspecies && optbssm)
+    gt_option_imply_either_2(optsplicesitetrack, optspecies, optbssm);
   if (opticinitialdelta && optintroncutout && optautointroncutout) {
     gt_option_imply_either_2(opticinitialdelta, optintroncutout,
                           optautointroncutout);
@@ -1352,8 +1406,9 @@ GtOPrval gth_parse_options(GthCallInfo *call_info, GthInput *input,
     gt_option_imply_either_2(opticminremlength, optintroncutout,
                           optautointroncutout);
   }
-  if (optintermediate && optxmlout && optgff3out) {
-    gt_option_imply_either_2(optintermediate, optxmlout, optgff3out);
+  if (optintermediate && optxmlout && optgff3out && optbininter) {
+    gt_option_imply_either_3(optintermediate, optxmlout, optgff3out,
+                             optbininter);
   }
 
   /* set mail addresse */
@@ -17,6 +17,7 @@
 
 #include "core/undef_api.h"
 #include "gth/proc_sa_collection.h"
+#include "gth/bin_inter_sa_visitor.h"
 #include "gth/gthsadistri.h"
 #include "gth/pgl_collection.h"
 #include "gth/gff3_pgl_visitor.h"
@@ -53,7 +54,11 @@ void gth_proc_sa_collection(GthSACollection *sa_collection,
   /* output alignments */
   if (!call_info->out->skipalignmentout) {
     GthSAVisitor *sa_visitor;
-    if (call_info->out->xmlout) {
+    if (call_info->bininter) {
+      gt_assert(call_info->intermediate);
+      sa_visitor = gth_bin_inter_sa_visitor_new(input, call_info->out->outfp);
+    }
+    else if (call_info->out->xmlout) {
       if (call_info->intermediate) {
         sa_visitor = gth_xml_inter_sa_visitor_new(input, indentlevel + 1,
                                                   call_info->out->outfp);
@@ -175,7 +175,7 @@ void gth_run_header_show(GthCallInfo *call_info, GthInput *input,
     show_xml_run_header(call_info, input, timestring, gth_version, indentlevel,
                         args);
   }
-  else if (!call_info->out->gff3out) {
+  else if (!call_info->out->gff3out && !call_info->bininter) {
     gt_file_xprintf(outfp, "%c GenomeThreader %s\n", COMMENTCHAR,
                     gth_version);
     gt_file_xprintf(outfp, "%c Date run: %s\n", COMMENTCHAR, timestring);
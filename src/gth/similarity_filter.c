@@ -15,16 +15,30 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
+#include "core/chardef.h"
+#include "core/class_alloc_lock.h"
+#include "core/ensure.h"
+#include "core/fa.h"
+#include "core/ma_api.h"
+#include "core/minmax.h"
+#include "core/multithread_api.h"
+#include "core/thread_api.h"
 #include "core/trans_table.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "core/warning_api.h"
+#include "core/xposix.h"
 #include "gth/chaining.h"
+#include "gth/default.h"
 #include "gth/gtherror.h"
 #include "gth/gthxml.h"
 #include "gth/intermediate.h"
 #include "gth/proc_sa_collection.h"
+#include "gth/seq_con_rep.h"
 #include "gth/similarity_filter.h"
+#include "gth/splice_site_track.h"
+#include "gth/xml_inter_sa_visitor.h"
 
 #define UNSUCCESSFULALIGNMENTSCORE      0.0
 
@@ -33,6 +47,10 @@
 
 #define SHOW_COMPUTE_MATCHES_STATUS_BUF_SIZE    160
 
+/* number of chains per thread which are aligned in one block, if the spliced
+   alignments are computed in parallel */
+#define GTH_DP_JOBS_PER_THREAD                  16
+
 typedef struct {
   GtUword call_number;
   bool significant_match_found,
@@ -355,42 +373,67 @@ static bool isunsuccessfulalignment(GthSA *sa,
   return false;
 }
 
-static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
-                       GthInput *input, GthStat *stat,
-                       GthSACollection *sa_collection, GthSA *saA,
-                       GtUword gen_file_num,
-                       GtUword ref_file_num,
-                       GtUword gen_total_length,
-                       GtUword gen_offset,
-                       const GtRange *gen_seq_bounds,
-                       const GtRange *gen_seq_bounds_rc,
-                       GtUword ref_total_length, GtUword ref_offset,
-                       GtUword chainctr,
-                       GtUword num_of_chains, GthMatchInfo *match_info,
-                       const unsigned char *ref_seq_tran,
-                       const unsigned char *ref_seq_orig,
-                       const unsigned char *ref_seq_tran_rc,
-                       const unsigned char *ref_seq_orig_rc,
-                       GthChain *chain,
-                       GthDNACompletePathMatrixJT dna_complete_path_matrix_jt,
-                       GthProteinCompletePathMatrixJT
-                       protein_complete_path_matrix_jt)
+/* the outcome of the DP for a single chain, it determines how the computed
+   spliced alignments are processed further (see process_dp_job()) */
+typedef enum {
+  GTH_DP_NONE,
+  GTH_DP_SAVE_A,             /* save saA, discard saB */
+  GTH_DP_SAVE_B,             /* save saB, discard saA */
+  GTH_DP_DISCARD,            /* discard saA, decrease the call number */
+  GTH_DP_DISCARD_SIGNIFICANT /* discard saA, mark significant match as found */
+} GthDPOutcome;
+
+/* all information necessary to compute the spliced alignment(s) for a single
+   chain. The DP part (compute_dna_dp_job() and compute_protein_dp_job())
+   only writes into the job itself and its <stat>, which makes it possible to
+   compute the jobs of consecutive chains in parallel. */
+typedef struct {
+  GthChain *chain;
+  GtUword chainctr,
+          gen_total_length,
+          gen_offset,
+          ref_total_length,
+          ref_offset;
+  GtRange gen_seq_bounds,
+          gen_seq_bounds_rc;
+  const unsigned char *ref_seq_tran,
+                      *ref_seq_orig,
+                      *ref_seq_tran_rc,
+                      *ref_seq_orig_rc;
+  GthSA *saA,
+        *saB; /* space for the second alignment, allocated on demand if not
+                 preallocated */
+  GthStat *stat;
+  GthDPOutcome outcome;
+  int rval;
+} GthDPJob;
+
+static int compute_dna_dp_job(GthDPJob *job, bool directmatches,
+                              GthCallInfo *call_info, GthInput *input,
+                              GtUword gen_file_num, GtUword ref_file_num,
+                              GtUword num_of_chains,
+                              GthDNACompletePathMatrixJT
+                              dna_complete_path_matrix_jt,
+                              GthProteinCompletePathMatrixJT
+                              protein_complete_path_matrix_jt)
 {
   int rval;
   bool bothstrandsanalyzed, firstdp = true,
        GT_UNUSED gs2outdirectmatches = directmatches;
-  GthSA *saB = NULL;
   GtFile *outfp = call_info->out->outfp;
 
+  job->outcome = GTH_DP_NONE;
+
   if (directmatches ? gth_input_forward(input)
                     : gth_input_reverse(input)) {
     /* calculate alignment */
-    rval = callsahmt(true, saA, directmatches, gen_file_num, ref_file_num,
-                     chain, gen_total_length, gen_offset, gen_seq_bounds,
-                     gen_seq_bounds_rc,
-                     ref_seq_tran, ref_seq_orig, ref_total_length, ref_offset,
-                     input, &call_info->simfilterparam.introncutoutinfo, stat,
-                     chainctr, num_of_chains, call_info->translationtable,
+    rval = callsahmt(true, job->saA, directmatches, gen_file_num, ref_file_num,
+                     job->chain, job->gen_total_length, job->gen_offset,
+                     &job->gen_seq_bounds, &job->gen_seq_bounds_rc,
+                     job->ref_seq_tran, job->ref_seq_orig,
+                     job->ref_total_length, job->ref_offset, input,
+                     &call_info->simfilterparam.introncutoutinfo, job->stat,
+                     job->chainctr, num_of_chains, call_info->translationtable,
                      directmatches, call_info->proteinexonpenal,
                      call_info->splice_site_model, call_info->dp_options_core,
                      call_info->dp_options_est, call_info->dp_options_postpro,
@@ -405,11 +448,10 @@ static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
     bothstrandsanalyzed = gth_input_both(input);
 
     if (rval == GTH_ERROR_SA_COULD_NOT_BE_DETERMINED ||
-        isunsuccessfulalignment(saA, call_info->out->comments, outfp)) {
-      match_info->call_number--;
+        isunsuccessfulalignment(job->saA, call_info->out->comments, outfp)) {
       /* if the spliced alignment was unsuccessful, it is deleted and the
          next hit is considered. */
-      gth_sa_delete(saA);
+      job->outcome = GTH_DP_DISCARD;
       return 0; /* continue */
     }
 
@@ -417,40 +459,45 @@ static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
        Otherwise we have to calculate the alignment to the other strand
        first and then save the better one. */
     if (!bothstrandsanalyzed)
-      save_sa(sa_collection, saA, call_info->sa_filter, match_info, stat);
+      job->outcome = GTH_DP_SAVE_A;
   }
 
   if (directmatches ? gth_input_reverse(input)
                     : gth_input_forward(input)) {
-    if ((firstdp || gth_sa_is_poor(saA, call_info->minaveragessp)) &&
+    if ((firstdp || gth_sa_is_poor(job->saA, call_info->minaveragessp)) &&
         !call_info->cdnaforward) {
       if (firstdp) {
         /* space for first alignment is already allocated, but we have to
            change the direction of the genomic and the reference strand */
-        gth_sa_set_gen_strand(saA, !directmatches);
-        gth_sa_set_ref_strand(saA, false);
+        gth_sa_set_gen_strand(job->saA, !directmatches);
+        gth_sa_set_ref_strand(job->saA, false);
       }
-      else {
+      else if (!job->saB) {
         /* allocating space for second alignment */
-        saB = gth_sa_new_and_set(!directmatches, false, input,
-                                 chain->gen_file_num, chain->gen_seq_num,
-                                 chain->ref_file_num, chain->ref_seq_num,
-                                 match_info->call_number, gen_total_length,
-                                 gen_offset, ref_total_length);
+        job->saB = gth_sa_new_and_set(!directmatches, false, input,
+                                      job->chain->gen_file_num,
+                                      job->chain->gen_seq_num,
+                                      job->chain->ref_file_num,
+                                      job->chain->ref_seq_num,
+                                      gth_sa_call_number(job->saA),
+                                      job->gen_total_length, job->gen_offset,
+                                      job->ref_total_length);
       }
 
       /* setting gs2outdirectmatches (for compatibility) */
       gs2outdirectmatches = (bool) !directmatches;
 
       /* calculate alignment */
-      rval = callsahmt(true, firstdp ? saA : saB, !directmatches,
-                       gen_file_num, ref_file_num, chain, gen_total_length,
-                       gen_offset, gen_seq_bounds, gen_seq_bounds_rc,
-                       ref_seq_tran_rc, ref_seq_orig_rc, ref_total_length,
-                       ref_offset, input,
-                       &call_info->simfilterparam.introncutoutinfo, stat,
-                       chainctr, num_of_chains, call_info->translationtable,
-                       directmatches, call_info->proteinexonpenal,
+      rval = callsahmt(true, firstdp ? job->saA : job->saB, !directmatches,
+                       gen_file_num, ref_file_num, job->chain,
+                       job->gen_total_length, job->gen_offset,
+                       &job->gen_seq_bounds, &job->gen_seq_bounds_rc,
+                       job->ref_seq_tran_rc, job->ref_seq_orig_rc,
+                       job->ref_total_length, job->ref_offset, input,
+                       &call_info->simfilterparam.introncutoutinfo, job->stat,
+                       job->chainctr, num_of_chains,
+                       call_info->translationtable, directmatches,
+                       call_info->proteinexonpenal,
                        call_info->splice_site_model, call_info->dp_options_core,
                        call_info->dp_options_est, call_info->dp_options_postpro,
                        dna_complete_path_matrix_jt,
@@ -462,68 +509,48 @@ static int call_dna_DP(bool directmatches, GthCallInfo *call_info,
 
       if (firstdp) {
         if (rval == GTH_ERROR_SA_COULD_NOT_BE_DETERMINED ||
-            isunsuccessfulalignment(saA, call_info->out->comments, outfp)) {
+            isunsuccessfulalignment(job->saA, call_info->out->comments,
+                                    outfp)) {
           /* for compatibility with GS2 */
           /* XXX: makes no sense. Possibly only if -gs2out is used. */
-          match_info->significant_match_found= true;
-
           /* if the spliced alignment was unsuccessful, it is deleted and
              the next hit is considered. */
-          gth_sa_delete(saA);
+          job->outcome = GTH_DP_DISCARD_SIGNIFICANT;
           return 0; /* continue */
         }
 
-        save_sa(sa_collection, saA, call_info->sa_filter, match_info, stat);
+        job->outcome = GTH_DP_SAVE_A;
       }
       else /* !firstdp */
       {
         if (rval == GTH_ERROR_SA_COULD_NOT_BE_DETERMINED ||
-            isunsuccessfulalignment(saB, call_info->out->comments, outfp) ||
-            !gth_sa_B_is_better_than_A(saA, saB)) {
-          /* insert first SA */
-          save_sa(sa_collection, saA, call_info->sa_filter, match_info, stat);
-          /* discard second SA */
-          gth_sa_delete(saB);
+            isunsuccessfulalignment(job->saB, call_info->out->comments,
+                                    outfp) ||
+            !gth_sa_B_is_better_than_A(job->saA, job->saB)) {
+          /* insert first SA, discard second SA */
+          job->outcome = GTH_DP_SAVE_A;
         }
         else {
-          /* insert second SA */
-          save_sa(sa_collection, saB, call_info->sa_filter, match_info, stat);
-          /* free first SA */
-          gth_sa_delete(saA);
+          /* insert second SA, free first SA */
+          job->outcome = GTH_DP_SAVE_B;
         }
       }
     }
     else
-      save_sa(sa_collection, saA, call_info->sa_filter, match_info, stat);
+      job->outcome = GTH_DP_SAVE_A;
   }
 
   return 0;
 }
 
-static int call_protein_DP(bool directmatches,
-                           GthCallInfo *call_info,
-                           GthInput *input,
-                           GthStat *stat,
-                           GthSACollection *sa_collection,
-                           GthSA *saA,
-                           GtUword gen_file_num,
-                           GtUword ref_file_num,
-                           GtUword gen_total_length,
-                           GtUword gen_offset,
-                           const GtRange *gen_seq_bounds,
-                           const GtRange *gen_seq_bounds_rc,
-                           GtUword ref_total_length,
-                           GtUword ref_offset,
-                           GtUword chainctr,
-                           GtUword num_of_chains,
-                           GthMatchInfo *match_info,
-                           const unsigned char *ref_seq_tran,
-                           const unsigned char *ref_seq_orig,
-                           GthChain *chain,
-                           GthDNACompletePathMatrixJT
-                           dna_complete_path_matrix_jt,
-                           GthProteinCompletePathMatrixJT
-                           protein_complete_path_matrix_jt)
+static int compute_protein_dp_job(GthDPJob *job, bool directmatches,
+                                  GthCallInfo *call_info, GthInput *input,
+                                  GtUword gen_file_num, GtUword ref_file_num,
+                                  GtUword num_of_chains,
+                                  GthDNACompletePathMatrixJT
+                                  dna_complete_path_matrix_jt,
+                                  GthProteinCompletePathMatrixJT
+                                  protein_complete_path_matrix_jt)
 {
   GtFile *outfp = call_info->out->outfp;
   int rval;
@@ -537,15 +564,17 @@ static int call_protein_DP(bool directmatches,
 #endif
 
   /* calculate alignment */
-  rval = callsahmt(false, saA, directmatches, gen_file_num, ref_file_num,
-                   chain, gen_total_length, gen_offset, gen_seq_bounds,
-                   gen_seq_bounds_rc, ref_seq_tran, ref_seq_orig,
-                   ref_total_length, ref_offset, input,
-                   &call_info->simfilterparam.introncutoutinfo, stat, chainctr,
-                   num_of_chains, call_info->translationtable, directmatches,
-                   call_info->proteinexonpenal, call_info->splice_site_model,
-                   call_info->dp_options_core, call_info->dp_options_est,
-                   call_info->dp_options_postpro, dna_complete_path_matrix_jt,
+  rval = callsahmt(false, job->saA, directmatches, gen_file_num, ref_file_num,
+                   job->chain, job->gen_total_length, job->gen_offset,
+                   &job->gen_seq_bounds, &job->gen_seq_bounds_rc,
+                   job->ref_seq_tran, job->ref_seq_orig, job->ref_total_length,
+                   job->ref_offset, input,
+                   &call_info->simfilterparam.introncutoutinfo, job->stat,
+                   job->chainctr, num_of_chains, call_info->translationtable,
+                   directmatches, call_info->proteinexonpenal,
+                   call_info->splice_site_model, call_info->dp_options_core,
+                   call_info->dp_options_est, call_info->dp_options_postpro,
+                   dna_complete_path_matrix_jt,
                    protein_complete_path_matrix_jt, call_info->out);
   if (rval && rval != GTH_ERROR_SA_COULD_NOT_BE_DETERMINED) {
                    /* ^ this error is treated below */
@@ -553,17 +582,15 @@ static int call_protein_DP(bool directmatches,
   }
 
   if (rval == GTH_ERROR_SA_COULD_NOT_BE_DETERMINED ||
-      isunsuccessfulalignment(saA, call_info->out->comments, outfp)) {
-    match_info->call_number--;
+      isunsuccessfulalignment(job->saA, call_info->out->comments, outfp)) {
     /* if the spliced alignment was unsuccessful, it is deleted and the
        next hit is considered. */
-    gth_sa_delete(saA);
-    /* continue */
+    job->outcome = GTH_DP_DISCARD;
     return 0;
   }
 
   /* we can save the alignment now */
-  save_sa(sa_collection, saA, call_info->sa_filter, match_info, stat);
+  job->outcome = GTH_DP_SAVE_A;
 
   return 0;
 }
@@ -615,7 +642,8 @@ static GthChainCollection* match_and_chain(GthCallInfo *call_info,
 
   if (!gth_chain_collection_size(chain_collection)) {
     /* no matches found -> return */
-    if (!call_info->out->xmlout && !call_info->out->gff3out && !directmatches &&
+    if (!call_info->out->xmlout && !call_info->out->gff3out &&
+        !call_info->bininter && !directmatches &&
         !match_info->significant_match_found) {
       show_no_match_line(gth_input_get_alphatype(input, ref_file_num), outfp);
     }
@@ -626,6 +654,359 @@ static GthChainCollection* match_and_chain(GthCallInfo *call_info,
   return chain_collection;
 }
 
+/* the following function increases the call number and returns true, if the
+   maximal number of matches to display has been reached */
+static bool check_max_call_number(GthCallInfo *call_info,
+                                  GthMatchInfo *match_info, bool refseqisdna)
+{
+  GtFile *outfp = call_info->out->outfp;
+  if (++match_info->call_number > call_info->firstalshown &&
+      call_info->firstalshown > 0) {
+    if (!(call_info->out->xmlout || call_info->out->gff3out ||
+          call_info->bininter)) {
+      gt_file_xfputc('\n', outfp);
+    }
+    else if (call_info->out->xmlout)
+      gt_file_xprintf(outfp, "<!--\n");
+
+    if (!call_info->out->gff3out && !call_info->bininter) {
+      gt_file_xprintf(outfp, "Maximal matching %s count (%u) reached.\n",
+                      refseqisdna ? "EST" : "protein",
+                      call_info->firstalshown);
+      gt_file_xprintf(outfp, "Only the first %u matches will be "
+                         "displayed.\n", call_info->firstalshown);
+    }
+
+    if (!(call_info->out->xmlout || call_info->out->gff3out ||
+          call_info->bininter)) {
+      gt_file_xfputc('\n', outfp);
+    }
+    else if (call_info->out->xmlout)
+      gt_file_xprintf(outfp, "-->\n");
+
+    match_info->max_call_number_reached = true;
+    return true;
+  }
+  return false;
+}
+
+/* check if protein sequences have a stop amino acid */
+static void check_stop_amino_acid(const GthDPJob *job, GthInput *input,
+                                  GthMatchInfo *match_info)
+{
+  if (!match_info->stop_amino_acid_warning &&
+     job->ref_seq_orig[job->ref_total_length - 1] != GT_STOP_AMINO) {
+    GtStr *ref_id = gt_str_new();
+    gth_input_save_ref_id(input, ref_id, job->chain->ref_file_num,
+                          job->chain->ref_seq_num);
+    gt_warning("protein sequence '%s' (#" GT_WU " in file %s) does not end "
+               "with a stop amino acid ('%c'). If it is not a protein "
+               "fragment you should add a stop amino acid to improve the "
+               "prediction. For example with `gt seqtransform "
+               "-addstopaminos` (see http://genometools.org for details).",
+               gt_str_get(ref_id), job->chain->ref_seq_num,
+               gth_input_get_reference_filename(input,
+                                                job->chain->ref_file_num),
+               GT_STOP_AMINO);
+    match_info->stop_amino_acid_warning = true;
+    gt_str_delete(ref_id);
+  }
+}
+
+/* the following function prepares the DP job for <chain> */
+static void init_dp_job(GthDPJob *job, GthChain *chain, GtUword chainctr,
+                        GthInput *input, bool directmatches, bool refseqisdna,
+                        GtUword call_number, bool allocate_saB,
+                        GthStat *stat)
+{
+  GtRange range;
+
+  job->chain = chain;
+  job->chainctr = chainctr;
+  job->ref_seq_tran_rc = NULL;
+  job->ref_seq_orig_rc = NULL;
+  job->saB = NULL;
+  job->stat = stat;
+  job->outcome = GTH_DP_NONE;
+  job->rval = 0;
+
+  /* compute considered genomic regions if not set by -frompos */
+  if (!gth_input_use_substring_spec(input)) {
+    job->gen_seq_bounds = gth_input_get_genomic_range(input,
+                                                      chain->gen_file_num,
+                                                      chain->gen_seq_num);
+    job->gen_total_length  = gt_range_length(&job->gen_seq_bounds);
+    job->gen_offset        = job->gen_seq_bounds.start;
+    job->gen_seq_bounds_rc = job->gen_seq_bounds;
+  }
+  else {
+    /* genomic multiseq contains exactly one sequence */
+    gt_assert(gth_input_num_of_gen_seqs(input, chain->gen_file_num) == 1);
+    job->gen_total_length = gth_input_genomic_file_total_length(input,
+                                                                chain
+                                                                ->gen_file_num);
+    job->gen_seq_bounds.start    = gth_input_genomic_substring_from(input);
+    job->gen_seq_bounds.end      = gth_input_genomic_substring_to(input);
+    job->gen_offset              = 0;
+    job->gen_seq_bounds_rc.start = job->gen_total_length - 1
+                                   - job->gen_seq_bounds.end;
+    job->gen_seq_bounds_rc.end   = job->gen_total_length - 1
+                                   - job->gen_seq_bounds.start;
+  }
+
+  /* "retrieving" the reference sequence */
+  range = gth_input_get_reference_range(input, chain->ref_file_num,
+                                        chain->ref_seq_num);
+  job->ref_seq_tran = gth_input_current_ref_seq_tran(input) + range.start;
+  job->ref_seq_orig = gth_input_current_ref_seq_orig(input) + range.start;
+  if (refseqisdna) {
+    job->ref_seq_tran_rc = gth_input_current_ref_seq_tran_rc(input)
+                           + range.start;
+    job->ref_seq_orig_rc = gth_input_current_ref_seq_orig_rc(input)
+                           + range.start;
+  }
+  job->ref_total_length = range.end - range.start + 1;
+  job->ref_offset = range.start;
+
+  /* allocating space for alignment */
+  job->saA = gth_sa_new_and_set(directmatches, true, input,
+                                chain->gen_file_num, chain->gen_seq_num,
+                                chain->ref_file_num, chain->ref_seq_num,
+                                call_number, job->gen_total_length,
+                                job->gen_offset, job->ref_total_length);
+  if (allocate_saB) {
+    job->saB = gth_sa_new_and_set(!directmatches, false, input,
+                                  chain->gen_file_num, chain->gen_seq_num,
+                                  chain->ref_file_num, chain->ref_seq_num,
+                                  call_number, job->gen_total_length,
+                                  job->gen_offset, job->ref_total_length);
+  }
+
+  /* extend the DP borders to the left and to the right */
+  gth_chain_extend_borders(chain, &job->gen_seq_bounds,
+                           &job->gen_seq_bounds_rc, job->gen_total_length,
+                           job->gen_offset);
+
+  /* From here on the dp positions always refer to the forward strand of the
+     genomic DNA. */
+}
+
+static int compute_dp_job(GthDPJob *job, bool directmatches, bool refseqisdna,
+                          GthCallInfo *call_info, GthInput *input,
+                          GtUword gen_file_num, GtUword ref_file_num,
+                          GtUword num_of_chains,
+                          GthDNACompletePathMatrixJT
+                          dna_complete_path_matrix_jt,
+                          GthProteinCompletePathMatrixJT
+                          protein_complete_path_matrix_jt)
+{
+  /* call the Dynamic Programming */
+  if (refseqisdna) {
+    return compute_dna_dp_job(job, directmatches, call_info, input,
+                              gen_file_num, ref_file_num, num_of_chains,
+                              dna_complete_path_matrix_jt,
+                              protein_complete_path_matrix_jt);
+  }
+  return compute_protein_dp_job(job, directmatches, call_info, input,
+                                gen_file_num, ref_file_num, num_of_chains,
+                                dna_complete_path_matrix_jt,
+                                protein_complete_path_matrix_jt);
+}
+
+/* the following function processes the result of a computed DP job: It saves
+   or discards the spliced alignments and does the bookkeeping which depends on
+   the order of the chains. */
+static int process_dp_job(GthDPJob *job, GthSACollection *sa_collection,
+                          GthCallInfo *call_info, GthMatchInfo *match_info,
+                          GthStat *stat)
+{
+  /* check return value */
+  if (job->rval == GTH_ERROR_DP_PARAMETER_ALLOCATION_FAILED) {
+    /* statistics bookkeeping */
+    gth_stat_increment_numoffailedDPparameterallocations(stat);
+    gth_stat_increment_numofundeterminedSAs(stat);
+    /* free space */
+    gth_sa_delete(job->saA);
+    gth_sa_delete(job->saB);
+    match_info->call_number--;
+    return 0; /* continue with the next DP range */
+  }
+  else if (job->rval) {
+    gth_sa_delete(job->saA);
+    gth_sa_delete(job->saB);
+    return -1;
+  }
+
+  switch (job->outcome) {
+    case GTH_DP_SAVE_A:
+      save_sa(sa_collection, job->saA, call_info->sa_filter, match_info, stat);
+      gth_sa_delete(job->saB);
+      break;
+    case GTH_DP_SAVE_B:
+      save_sa(sa_collection, job->saB, call_info->sa_filter, match_info, stat);
+      gth_sa_delete(job->saA);
+      break;
+    case GTH_DP_DISCARD:
+      match_info->call_number--;
+      gth_sa_delete(job->saA);
+      gth_sa_delete(job->saB);
+      break;
+    case GTH_DP_DISCARD_SIGNIFICANT:
+      match_info->significant_match_found = true;
+      gth_sa_delete(job->saA);
+      gth_sa_delete(job->saB);
+      break;
+    case GTH_DP_NONE:
+      gth_sa_delete(job->saA);
+      gth_sa_delete(job->saB);
+      break;
+    default: gt_assert(0);
+  }
+  return 0;
+}
+
+typedef struct {
+  GthDPJob *jobs;
+  GtUword numofjobs,
+          nextjob,
+          num_of_chains,
+          gen_file_num,
+          ref_file_num;
+  bool directmatches,
+       refseqisdna;
+  GthCallInfo *call_info;
+  GthInput *input;
+  GthDNACompletePathMatrixJT dna_complete_path_matrix_jt;
+  GthProteinCompletePathMatrixJT protein_complete_path_matrix_jt;
+  GtMutex *mutex;
+} GthDPThreadInfo;
+
+static void* compute_dp_jobs_thread(void *data)
+{
+  GthDPThreadInfo *ti = data;
+  GthDPJob *job;
+  gt_assert(ti);
+  for (;;) {
+    gt_mutex_lock(ti->mutex);
+    job = ti->nextjob < ti->numofjobs ? ti->jobs + ti->nextjob++ : NULL;
+    gt_mutex_unlock(ti->mutex);
+    if (!job)
+      break;
+    job->rval = compute_dp_job(job, ti->directmatches, ti->refseqisdna,
+                               ti->call_info, ti->input, ti->gen_file_num,
+                               ti->ref_file_num, ti->num_of_chains,
+                               ti->dna_complete_path_matrix_jt,
+                               ti->protein_complete_path_matrix_jt);
+  }
+  return NULL;
+}
+
+/* the following function computes the spliced alignments for blocks of
+   consecutive chains in parallel. Only the DP is computed in parallel, every
+   DP job has its own statistics. Setting up the jobs and processing the
+   results (including the call numbers and the statistics) is done in the order
+   of the chains, which makes the result identical to the sequential one.
+   gth_align_dna() and gth_align_protein() use no static or global data, they
+   only read the shared sequences, options, and splice site model. The
+   splice site track computes its blocks on demand and caches them under its
+   own mutex. */
+static int calc_spliced_alignments_threaded(GthSACollection *sa_collection,
+                                            GthChainCollection
+                                            *chain_collection,
+                                            GthCallInfo *call_info,
+                                            GthInput *input,
+                                            GthStat *stat,
+                                            GtUword gen_file_num,
+                                            GtUword ref_file_num,
+                                            bool directmatches,
+                                            bool refseqisdna,
+                                            GthMatchInfo *match_info,
+                                            GthDNACompletePathMatrixJT
+                                            dna_complete_path_matrix_jt,
+                                            GthProteinCompletePathMatrixJT
+                                            protein_complete_path_matrix_jt,
+                                            GtError *err)
+{
+  GtUword blockstart, blocksize, num_of_chains, j;
+  GthDPThreadInfo ti;
+  bool allocate_saB;
+  int had_err = 0;
+
+  num_of_chains = gth_chain_collection_size(chain_collection);
+  blocksize = (GtUword) gt_jobs * GTH_DP_JOBS_PER_THREAD;
+  /* the space for the alignment to the other strand is needed, if both strands
+     are analyzed */
+  allocate_saB = refseqisdna && gth_input_both(input) &&
+                 !call_info->cdnaforward;
+
+  ti.jobs = gt_malloc(sizeof *ti.jobs * blocksize);
+  ti.num_of_chains = num_of_chains;
+  ti.gen_file_num = gen_file_num;
+  ti.ref_file_num = ref_file_num;
+  ti.directmatches = directmatches;
+  ti.refseqisdna = refseqisdna;
+  ti.call_info = call_info;
+  ti.input = input;
+  ti.dna_complete_path_matrix_jt = dna_complete_path_matrix_jt;
+  ti.protein_complete_path_matrix_jt = protein_complete_path_matrix_jt;
+  ti.mutex = gt_mutex_new();
+
+  for (blockstart = 0;
+       !had_err && !match_info->max_call_number_reached &&
+       blockstart < num_of_chains;
+       blockstart += ti.numofjobs) {
+    ti.numofjobs = MIN(blocksize, num_of_chains - blockstart);
+    /* as in the sequential case, no DP is computed for chains after the
+       first <firstalshown> alignments */
+    if (call_info->firstalshown > 0) {
+      if (match_info->call_number >= (GtUword) call_info->firstalshown) {
+        GT_UNUSED bool max_call_number_reached =
+          check_max_call_number(call_info, match_info, refseqisdna);
+        gt_assert(max_call_number_reached);
+        break;
+      }
+      ti.numofjobs = MIN(ti.numofjobs, (GtUword) call_info->firstalshown -
+                                       match_info->call_number);
+    }
+    ti.nextjob = 0;
+    for (j = 0; j < ti.numofjobs; j++) {
+      init_dp_job(ti.jobs + j,
+                  gth_chain_collection_get(chain_collection, blockstart + j),
+                  blockstart + j, input, directmatches, refseqisdna,
+                  GT_UNDEF_UWORD, allocate_saB, gth_stat_new());
+    }
+
+    if (gt_multithread(compute_dp_jobs_thread, &ti, err))
+      had_err = -1;
+
+    /* process the results in the order of the chains */
+    for (j = 0; j < ti.numofjobs; j++) {
+      GthDPJob *job = ti.jobs + j;
+      if (!had_err && !match_info->max_call_number_reached &&
+          !check_max_call_number(call_info, match_info, refseqisdna)) {
+        if (!refseqisdna)
+          check_stop_amino_acid(job, input, match_info);
+        gth_sa_set_call_number(job->saA, match_info->call_number);
+        if (job->saB)
+          gth_sa_set_call_number(job->saB, match_info->call_number);
+        gth_stat_add_counters(stat, job->stat);
+        if (process_dp_job(job, sa_collection, call_info, match_info, stat))
+          had_err = -1;
+      }
+      else {
+        /* the job is not used */
+        gth_sa_delete(job->saA);
+        gth_sa_delete(job->saB);
+      }
+      gth_stat_delete(job->stat);
+    }
+  }
+
+  gt_mutex_delete(ti.mutex);
+  gt_free(ti.jobs);
+  return had_err;
+}
+
 static int calc_spliced_alignments(GthSACollection *sa_collection,
                                    GthChainCollection *chain_collection,
                                    GthCallInfo *call_info,
@@ -638,153 +1019,54 @@ static int calc_spliced_alignments(GthSACollection *sa_collection,
                                    GthDNACompletePathMatrixJT
                                    dna_complete_path_matrix_jt,
                                    GthProteinCompletePathMatrixJT
-                                   protein_complete_path_matrix_jt)
+                                   protein_complete_path_matrix_jt,
+                                   GtError *err)
 {
-  const unsigned char *ref_seq_tran, *ref_seq_orig, *ref_seq_tran_rc = NULL,
-                      *ref_seq_orig_rc = NULL;
-  GtUword chainctr, gen_offset = GT_UNDEF_UWORD, gen_total_length,
-                ref_total_length;
+  GtUword chainctr, num_of_chains;
   GtFile *outfp = call_info->out->outfp;
-  GtRange gen_seq_bounds, gen_seq_bounds_rc;
   bool refseqisdna;
-  GthChain *chain;
-  GtRange range;
-  GthSA *saA;
-  int rval;
+  GthDPJob job;
 
   gt_assert(sa_collection && chain_collection);
 
   refseqisdna = gth_input_ref_file_is_dna(input, ref_file_num);
-
-  for (chainctr = 0;
-       chainctr < gth_chain_collection_size(chain_collection);
-       chainctr++) {
-       chain = gth_chain_collection_get(chain_collection, chainctr);
-    if (++match_info->call_number > call_info->firstalshown &&
-        call_info->firstalshown > 0) {
-      if (!(call_info->out->xmlout || call_info->out->gff3out))
-        gt_file_xfputc('\n', outfp);
-      else if (call_info->out->xmlout)
-        gt_file_xprintf(outfp, "<!--\n");
-
-      if (!call_info->out->gff3out) {
-        gt_file_xprintf(outfp, "Maximal matching %s count (%u) reached.\n",
-                        refseqisdna ? "EST" : "protein",
-                        call_info->firstalshown);
-        gt_file_xprintf(outfp, "Only the first %u matches will be "
-                           "displayed.\n", call_info->firstalshown);
-      }
-
-      if (!(call_info->out->xmlout || call_info->out->gff3out))
-        gt_file_xfputc('\n', outfp);
-      else if (call_info->out->xmlout)
-        gt_file_xprintf(outfp, "-->\n");
-
-      match_info->max_call_number_reached = true;
-      break; /* break out of loop */
-    }
-
-    /* compute considered genomic regions if not set by -frompos */
-    if (!gth_input_use_substring_spec(input)) {
-      gen_seq_bounds = gth_input_get_genomic_range(input, chain->gen_file_num,
-                                                   chain->gen_seq_num);
-      gen_total_length      = gt_range_length(&gen_seq_bounds);
-      gen_offset            = gen_seq_bounds.start;
-      gen_seq_bounds_rc     = gen_seq_bounds;
-    }
-    else {
-      /* genomic multiseq contains exactly one sequence */
-      gt_assert(gth_input_num_of_gen_seqs(input, chain->gen_file_num) == 1);
-      gen_total_length = gth_input_genomic_file_total_length(input,
-                                                             chain
-                                                             ->gen_file_num);
-      gen_seq_bounds.start    = gth_input_genomic_substring_from(input);
-      gen_seq_bounds.end      = gth_input_genomic_substring_to(input);
-      gen_offset              = 0;
-      gen_seq_bounds_rc.start = gen_total_length - 1 - gen_seq_bounds.end;
-      gen_seq_bounds_rc.end   = gen_total_length - 1 - gen_seq_bounds.start;
-    }
-
-    /* "retrieving" the reference sequence */
-    range = gth_input_get_reference_range(input, chain->ref_file_num,
-                                          chain->ref_seq_num);
-    ref_seq_tran = gth_input_current_ref_seq_tran(input) + range.start;
-    ref_seq_orig = gth_input_current_ref_seq_orig(input) + range.start;
-    if (refseqisdna) {
-      ref_seq_tran_rc = gth_input_current_ref_seq_tran_rc(input) + range.start;
-      ref_seq_orig_rc = gth_input_current_ref_seq_orig_rc(input) + range.start;
-    }
-    ref_total_length = range.end - range.start + 1;
-
-    /* check if protein sequences have a stop amino acid */
-    if (!refseqisdna && !match_info->stop_amino_acid_warning &&
-       ref_seq_orig[ref_total_length - 1] != GT_STOP_AMINO) {
-      GtStr *ref_id = gt_str_new();
-      gth_input_save_ref_id(input, ref_id, chain->ref_file_num,
-                            chain->ref_seq_num);
-      gt_warning("protein sequence '%s' (#" GT_WU " in file %s) does not end "
-                 "with a stop amino acid ('%c'). If it is not a protein "
-                 "fragment you should add a stop amino acid to improve the "
-                 "prediction. For example with `gt seqtransform "
-                 "-addstopaminos` (see http://genometools.org for details).",
-                 gt_str_get(ref_id), chain->ref_seq_num,
-                 gth_input_get_reference_filename(input, chain->ref_file_num),
-                 GT_STOP_AMINO);
-      match_info->stop_amino_acid_warning = true;
-      gt_str_delete(ref_id);
-    }
-
-    /* allocating space for alignment */
-    saA = gth_sa_new_and_set(directmatches, true, input, chain->gen_file_num,
-                             chain->gen_seq_num, chain->ref_file_num,
-                             chain->ref_seq_num, match_info->call_number,
-                             gen_total_length, gen_offset, ref_total_length);
-
-    /* extend the DP borders to the left and to the right */
-    gth_chain_extend_borders(chain, &gen_seq_bounds, &gen_seq_bounds_rc,
-                             gen_total_length, gen_offset);
-
-    /* From here on the dp positions always refer to the forward strand of the
-       genomic DNA. */
-
-    /* call the Dynamic Programming */
-    if (refseqisdna) {
-      rval = call_dna_DP(directmatches, call_info, input, stat,
-                         sa_collection, saA, gen_file_num, ref_file_num,
-                         gen_total_length, gen_offset, &gen_seq_bounds,
-                         &gen_seq_bounds_rc, ref_total_length, range.start,
-                         chainctr, gth_chain_collection_size(chain_collection),
-                         match_info, ref_seq_tran, ref_seq_orig,
-                         ref_seq_tran_rc, ref_seq_orig_rc, chain,
-                         dna_complete_path_matrix_jt,
-                         protein_complete_path_matrix_jt);
-    }
-    else {
-      rval = call_protein_DP(directmatches, call_info, input,
-                             stat, sa_collection, saA, gen_file_num,
-                             ref_file_num, gen_total_length, gen_offset,
-                             &gen_seq_bounds, &gen_seq_bounds_rc,
-                             ref_total_length, range.start, chainctr,
-                             gth_chain_collection_size(chain_collection),
-                             match_info, ref_seq_tran, ref_seq_orig, chain,
-                             dna_complete_path_matrix_jt,
-                             protein_complete_path_matrix_jt);
+  num_of_chains = gth_chain_collection_size(chain_collection);
+
+  /* comments, verbose output, and edit operations are written during the DP,
+     they are only shown in the correct order if the chains are processed
+     sequentially */
+  if (gt_jobs > 1U && num_of_chains > 1UL && !call_info->out->comments &&
+      !call_info->out->showverbose && !call_info->out->showeops) {
+    if (calc_spliced_alignments_threaded(sa_collection, chain_collection,
+                                         call_info, input, stat, gen_file_num,
+                                         ref_file_num, directmatches,
+                                         refseqisdna, match_info,
+                                         dna_complete_path_matrix_jt,
+                                         protein_complete_path_matrix_jt,
+                                         err)) {
+      return -1;
     }
-    /* check return value */
-    if (rval == GTH_ERROR_DP_PARAMETER_ALLOCATION_FAILED) {
-      /* statistics bookkeeping */
-      gth_stat_increment_numoffailedDPparameterallocations(stat);
-      gth_stat_increment_numofundeterminedSAs(stat);
-      /* free space */
-      gth_sa_delete(saA);
-      match_info->call_number--;
-      continue; /* continue with the next DP range */
+  }
+  else {
+    for (chainctr = 0; chainctr < num_of_chains; chainctr++) {
+      if (check_max_call_number(call_info, match_info, refseqisdna))
+        break; /* break out of loop */
+      init_dp_job(&job, gth_chain_collection_get(chain_collection, chainctr),
+                  chainctr, input, directmatches, refseqisdna,
+                  match_info->call_number, false, stat);
+      if (!refseqisdna)
+        check_stop_amino_acid(&job, input, match_info);
+      job.rval = compute_dp_job(&job, directmatches, refseqisdna, call_info,
+                                input, gen_file_num, ref_file_num,
+                                num_of_chains, dna_complete_path_matrix_jt,
+                                protein_complete_path_matrix_jt);
+      if (process_dp_job(&job, sa_collection, call_info, match_info, stat))
+        return -1;
     }
-    else if (rval)
-      return -1;
   }
 
-  if (!call_info->out->xmlout && !call_info->out->gff3out && !directmatches &&
+  if (!call_info->out->xmlout && !call_info->out->gff3out &&
+      !call_info->bininter && !directmatches &&
       !match_info->significant_match_found &&
       match_info->call_number <= call_info->firstalshown) {
     show_no_match_line(gth_input_get_alphatype(input, ref_file_num), outfp);
@@ -829,13 +1111,59 @@ static void show_compute_matches_status(bool direct, GthShowVerbose showverbose,
   }
 }
 
+/* the following function creates the splice site track for the genomic file
+   <gen_file_num> (which has to be loaded) and sets it in the splice site
+   model, if BSSM parameters are used and no track exists yet */
+static int setup_splice_site_track(GthSpliceSiteTrack **splice_site_track,
+                                   GthCallInfo *call_info, GthInput *input,
+                                   GtUword gen_file_num, GtError *err)
+{
+  const GthBSSMParam *bssm_param;
+  const unsigned char *gen_seq_tran_rc;
+  gt_error_check(err);
+  bssm_param =
+    gth_splice_site_model_bssm_param(call_info->splice_site_model);
+  if (*splice_site_track || !bssm_param)
+    return 0;
+  gen_seq_tran_rc = gth_input_reverse(input)
+                    ? gth_input_current_gen_seq_tran_rc(input) : NULL;
+  if (call_info->splicesitetrack) {
+    *splice_site_track =
+      gth_splice_site_track_new_persistent(bssm_param,
+                                  gth_input_current_gen_seq_tran(input),
+                                  gen_seq_tran_rc,
+                                  gth_input_genomic_file_total_length(input,
+                                                                gen_file_num),
+                                  gth_input_current_gen_alphabet(input),
+                                  gth_input_get_genomic_filename(input,
+                                                                 gen_file_num),
+                                  err);
+    if (!*splice_site_track)
+      return -1;
+  }
+  else {
+    *splice_site_track =
+      gth_splice_site_track_new(bssm_param,
+                                gth_input_current_gen_seq_tran(input),
+                                gen_seq_tran_rc,
+                                gth_input_genomic_file_total_length(input,
+                                                                gen_file_num),
+                                gth_input_current_gen_alphabet(input));
+  }
+  gth_splice_site_model_set_track(call_info->splice_site_model,
+                                  *splice_site_track);
+  return 0;
+}
+
 static int compute_sa_collection(GthSACollection *sa_collection,
                                  GthCallInfo *call_info,
                                  GthInput *input,
                                  GthStat *stat,
-                                 const GthPlugins *plugins)
+                                 const GthPlugins *plugins,
+                                 GtError *err)
 {
   GthChainCollection *chain_collection;
+  GthSpliceSiteTrack *splice_site_track;
   GthMatchInfo match_info;
   GtUword g, r;
   int rval = 0;
@@ -846,6 +1174,8 @@ static int compute_sa_collection(GthSACollection *sa_collection,
   match_info.stop_amino_acid_warning = false;
 
   for (g = 0; g < gth_input_num_of_gen_files(input); g++) {
+    /* the BSSM probabilities of the genomic file are shared by all chains */
+    splice_site_track = NULL;
     for (r = 0; r < gth_input_num_of_ref_files(input); r++) {
       if (gth_input_get_alphatype(input, r) == DNA_ALPHA ||
           gth_input_forward(input)) {
@@ -858,12 +1188,18 @@ static int compute_sa_collection(GthSACollection *sa_collection,
         chain_collection = match_and_chain(call_info, input, stat, g, r, true,
                                            &match_info, plugins);
         if (chain_collection) {
-          rval = calc_spliced_alignments(sa_collection, chain_collection,
-                                         call_info, input, stat, g, r, true,
-                                         &match_info,
-                                         plugins->dna_complete_path_matrix_jt,
-                                         plugins
-                                         ->protein_complete_path_matrix_jt);
+          rval = setup_splice_site_track(&splice_site_track, call_info, input,
+                                         g, err);
+          if (!rval) {
+            rval = calc_spliced_alignments(sa_collection, chain_collection,
+                                           call_info, input, stat, g, r, true,
+                                           &match_info,
+                                           plugins
+                                           ->dna_complete_path_matrix_jt,
+                                           plugins
+                                           ->protein_complete_path_matrix_jt,
+                                           err);
+          }
           gth_chain_collection_delete(chain_collection);
           if (rval)
             break;
@@ -883,12 +1219,18 @@ static int compute_sa_collection(GthSACollection *sa_collection,
         chain_collection = match_and_chain(call_info, input, stat, g, r, false,
                                            &match_info, plugins);
         if (chain_collection) {
-          rval = calc_spliced_alignments(sa_collection, chain_collection,
-                                         call_info, input, stat, g, r, false,
-                                         &match_info,
-                                         plugins->dna_complete_path_matrix_jt,
-                                         plugins
-                                         ->protein_complete_path_matrix_jt);
+          rval = setup_splice_site_track(&splice_site_track, call_info, input,
+                                         g, err);
+          if (!rval) {
+            rval = calc_spliced_alignments(sa_collection, chain_collection,
+                                           call_info, input, stat, g, r, false,
+                                           &match_info,
+                                           plugins
+                                           ->dna_complete_path_matrix_jt,
+                                           plugins
+                                           ->protein_complete_path_matrix_jt,
+                                           err);
+          }
           gth_chain_collection_delete(chain_collection);
           if (rval)
             break;
@@ -897,6 +1239,8 @@ static int compute_sa_collection(GthSACollection *sa_collection,
           break;
       }
     }
+    gth_splice_site_model_set_track(call_info->splice_site_model, NULL);
+    gth_splice_site_track_delete(splice_site_track);
   }
 
   return rval;
@@ -904,7 +1248,7 @@ static int compute_sa_collection(GthSACollection *sa_collection,
 
 int gth_similarity_filter(GthCallInfo *call_info, GthInput *input,
                           GthStat *stat, unsigned int indentlevel,
-                          const GthPlugins *plugins, GT_UNUSED GtError *err)
+                          const GthPlugins *plugins, GtError *err)
 {
   GthSACollection *sa_collection; /* stores the calculated spliced alignments */
 
@@ -914,7 +1258,8 @@ int gth_similarity_filter(GthCallInfo *call_info, GthInput *input,
   sa_collection = gth_sa_collection_new(call_info->duplicate_check);
 
   /* compute the spliced alignments */
-  if (compute_sa_collection(sa_collection, call_info, input, stat, plugins)) {
+  if (compute_sa_collection(sa_collection, call_info, input, stat, plugins,
+                            err)) {
     gth_sa_collection_delete(sa_collection);
     return -1;
   }
@@ -928,7 +1273,7 @@ int gth_similarity_filter(GthCallInfo *call_info, GthInput *input,
   }
 
   /* output statistics */
-  if (!call_info->out->gff3out)
+  if (!call_info->out->gff3out && !call_info->bininter)
     gth_stat_show(stat, true, call_info->out->xmlout, call_info->out->outfp);
 
 #ifndef NDEBUG
@@ -945,3 +1290,476 @@ int gth_similarity_filter(GthCallInfo *call_info, GthInput *input,
 
   return 0;
 }
+
+/* The unit test computes the spliced alignments of synthetic chains once
+   sequentially and once with four threads and compares the results. The
+   genomic sequence contains GTH_UNIT_TEST_NUM_OF_GENES genes with three exons
+   each, the reference file contains their transcripts (with some mismatches,
+   every second one reverse complemented). */
+#define GTH_UNIT_TEST_NUM_OF_GENES   48
+#define GTH_UNIT_TEST_GENE_DISTANCE  400
+
+typedef struct {
+  const GthSeqCon parent_instance;
+  GtUchar *orig_seq,
+          *tran_seq,
+          *orig_seq_rc,
+          *tran_seq_rc;
+  GtArray *ranges;
+  GtStrArray *descriptions;
+  GtAlphabet *alphabet;
+} UnitTestSeqCon;
+
+static const GthSeqConClass* unit_test_seq_con_class(void);
+
+#define unit_test_seq_con_cast(SC)\
+        gth_seq_con_cast(unit_test_seq_con_class(), SC)
+
+static void unit_test_seq_con_demand_orig_seq(GT_UNUSED GthSeqCon *sc)
+{
+  /* the original sequence is always present */
+}
+
+static GtUchar* unit_test_seq_con_get_orig_seq(GthSeqCon *sc, GtUword seq_num)
+{
+  UnitTestSeqCon *utsc = unit_test_seq_con_cast(sc);
+  return utsc->orig_seq +
+         ((GtRange*) gt_array_get(utsc->ranges, seq_num))->start;
+}
+
+static GtUchar* unit_test_seq_con_get_tran_seq(GthSeqCon *sc, GtUword seq_num)
+{
+  UnitTestSeqCon *utsc = unit_test_seq_con_cast(sc);
+  return utsc->tran_seq +
+         ((GtRange*) gt_array_get(utsc->ranges, seq_num))->start;
+}
+
+static GtUchar* unit_test_seq_con_get_orig_seq_rc(GthSeqCon *sc,
+                                                  GtUword seq_num)
+{
+  UnitTestSeqCon *utsc = unit_test_seq_con_cast(sc);
+  return utsc->orig_seq_rc +
+         ((GtRange*) gt_array_get(utsc->ranges, seq_num))->start;
+}
+
+static GtUchar* unit_test_seq_con_get_tran_seq_rc(GthSeqCon *sc,
+                                                  GtUword seq_num)
+{
+  UnitTestSeqCon *utsc = unit_test_seq_con_cast(sc);
+  return utsc->tran_seq_rc +
+         ((GtRange*) gt_array_get(utsc->ranges, seq_num))->start;
+}
+
+static void unit_test_seq_con_get_description(GthSeqCon *sc, GtUword seq_num,
+                                              GtStr *desc)
+{
+  UnitTestSeqCon *utsc = unit_test_seq_con_cast(sc);
+  gt_str_append_cstr(desc, gt_str_array_get(utsc->descriptions, seq_num));
+}
+
+static void unit_test_seq_con_echo_description(GthSeqCon *sc, GtUword seq_num,
+                                               GtFile *outfp)
+{
+  UnitTestSeqCon *utsc = unit_test_seq_con_cast(sc);
+  gt_file_xfputs(gt_str_array_get(utsc->descriptions, seq_num), outfp);
+}
+
+static GtUword unit_test_seq_con_num_of_seqs(GthSeqCon *sc)
+{
+  UnitTestSeqCon *utsc = unit_test_seq_con_cast(sc);
+  return gt_array_size(utsc->ranges);
+}
+
+static GtUword unit_test_seq_con_total_length(GthSeqCon *sc)
+{
+  UnitTestSeqCon *utsc = unit_test_seq_con_cast(sc);
+  return ((GtRange*) gt_array_get_last(utsc->ranges))->end + 1;
+}
+
+static GtRange unit_test_seq_con_get_range(GthSeqCon *sc, GtUword seq_num)
+{
+  UnitTestSeqCon *utsc = unit_test_seq_con_cast(sc);
+  return *(GtRange*) gt_array_get(utsc->ranges, seq_num);
+}
+
+static GtAlphabet* unit_test_seq_con_get_alphabet(GthSeqCon *sc)
+{
+  UnitTestSeqCon *utsc = unit_test_seq_con_cast(sc);
+  return utsc->alphabet;
+}
+
+static void unit_test_seq_con_free(GthSeqCon *sc)
+{
+  UnitTestSeqCon *utsc = unit_test_seq_con_cast(sc);
+  gt_free(utsc->orig_seq);
+  gt_free(utsc->tran_seq);
+  gt_free(utsc->orig_seq_rc);
+  gt_free(utsc->tran_seq_rc);
+  gt_array_delete(utsc->ranges);
+  gt_str_array_delete(utsc->descriptions);
+  gt_alphabet_delete(utsc->alphabet);
+}
+
+static const GthSeqConClass* unit_test_seq_con_class(void)
+{
+  static const GthSeqConClass *scc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!scc) {
+    scc = gth_seq_con_class_new(sizeof (UnitTestSeqCon),
+                                unit_test_seq_con_demand_orig_seq,
+                                unit_test_seq_con_get_orig_seq,
+                                unit_test_seq_con_get_tran_seq,
+                                unit_test_seq_con_get_orig_seq_rc,
+                                unit_test_seq_con_get_tran_seq_rc,
+                                unit_test_seq_con_get_description,
+                                unit_test_seq_con_echo_description,
+                                unit_test_seq_con_num_of_seqs,
+                                unit_test_seq_con_total_length,
+                                unit_test_seq_con_get_range,
+                                unit_test_seq_con_get_alphabet,
+                                unit_test_seq_con_free);
+  }
+  gt_class_alloc_lock_leave();
+  return scc;
+}
+
+/* Stores the exons of gene <gene> in <exons>. */
+static void unit_test_gene_exons(GtRange *exons, GtUword gene)
+{
+  exons[0].start = 100 + gene * GTH_UNIT_TEST_GENE_DISTANCE;
+  exons[0].end   = exons[0].start + 29 + (7 * gene) % 20;
+  exons[1].start = exons[0].end + 41 + (5 * gene) % 20;
+  exons[1].end   = exons[1].start + 39 + (11 * gene) % 20;
+  exons[2].start = exons[1].end + 51 + (3 * gene) % 20;
+  exons[2].end   = exons[2].start + 29 + (13 * gene) % 20;
+}
+
+static GtUword unit_test_genomic_length(void)
+{
+  return 100 + GTH_UNIT_TEST_NUM_OF_GENES * GTH_UNIT_TEST_GENE_DISTANCE;
+}
+
+static void unit_test_genomic_seq(GtStr *seq)
+{
+  GtUword i, gene, seed = 42;
+  GtRange exons[3];
+  char *s;
+  for (i = 0; i < unit_test_genomic_length(); i++) {
+    seed = seed * 1103515245 + 12345;
+    gt_str_append_char(seq, "ACGT"[(seed >> 16) % 4]);
+  }
+  /* the introns start with GT and end with AG */
+  s = gt_str_get(seq);
+  for (gene = 0; gene < GTH_UNIT_TEST_NUM_OF_GENES; gene++) {
+    unit_test_gene_exons(exons, gene);
+    for (i = 0; i < 2; i++) {
+      s[exons[i].end + 1] = 'G';
+      s[exons[i].end + 2] = 'T';
+      s[exons[i+1].start - 2] = 'A';
+      s[exons[i+1].start - 1] = 'G';
+    }
+  }
+}
+
+static char unit_test_complement(char cc)
+{
+  switch (cc) {
+    case 'A': return 'T';
+    case 'C': return 'G';
+    case 'G': return 'C';
+    case 'T': return 'A';
+    default: gt_assert(0);
+  }
+  return cc;
+}
+
+/* Appends the transcript of gene <gene> to <seq>. */
+static void unit_test_append_transcript(GtStr *seq, const char *genomic_seq,
+                                        GtUword gene)
+{
+  GtUword i, j, start, len;
+  GtRange exons[3];
+  char *s;
+  unit_test_gene_exons(exons, gene);
+  start = gt_str_length(seq);
+  for (i = 0; i < 3; i++) {
+    gt_str_append_cstr_nt(seq, genomic_seq + exons[i].start,
+                          gt_range_length(exons + i));
+  }
+  s = gt_str_get(seq) + start;
+  len = gt_str_length(seq) - start;
+  for (i = 0; i < len; i++) {
+    if ((i + gene) % 31 == 0)
+      s[i] = unit_test_complement(s[i]);
+  }
+  if (gene % 2) {
+    for (i = 0, j = len - 1; i < j; i++, j--) {
+      char cc = s[i];
+      s[i] = unit_test_complement(s[j]);
+      s[j] = unit_test_complement(cc);
+    }
+    if (i == j)
+      s[i] = unit_test_complement(s[i]);
+  }
+}
+
+static GthSeqCon* unit_test_seq_con_new(const char *indexname,
+                                        GT_UNUSED bool assign_rc,
+                                        GT_UNUSED bool orig_seq,
+                                        GT_UNUSED bool tran_seq)
+{
+  GthSeqCon *sc = gth_seq_con_create(unit_test_seq_con_class());
+  UnitTestSeqCon *utsc = unit_test_seq_con_cast(sc);
+  GtStr *genomic_seq = gt_str_new(), *seq = gt_str_new(), *desc;
+  GtUword i, j, seq_num, total_length;
+  GtRange range;
+
+  utsc->ranges = gt_array_new(sizeof (GtRange));
+  utsc->descriptions = gt_str_array_new();
+  utsc->alphabet = gt_alphabet_new_dna();
+  unit_test_genomic_seq(genomic_seq);
+
+  /* the sequences are stored in <seq>, separated by SEPARATOR */
+  if (strstr(indexname, "genomic")) {
+    gt_str_append_str(seq, genomic_seq);
+    range.start = 0;
+    range.end = gt_str_length(seq) - 1;
+    gt_array_add(utsc->ranges, range);
+    gt_str_array_add_cstr(utsc->descriptions, "chr1");
+  }
+  else {
+    desc = gt_str_new();
+    for (seq_num = 0; seq_num < GTH_UNIT_TEST_NUM_OF_GENES; seq_num++) {
+      if (seq_num)
+        gt_str_append_char(seq, (char) SEPARATOR);
+      range.start = gt_str_length(seq);
+      unit_test_append_transcript(seq, gt_str_get(genomic_seq),
+                                  seq_num);
+      range.end = gt_str_length(seq) - 1;
+      gt_array_add(utsc->ranges, range);
+      gt_str_reset(desc);
+      gt_str_append_cstr(desc, "est");
+      gt_str_append_uword(desc, seq_num);
+      gt_str_array_add(utsc->descriptions, desc);
+    }
+    gt_str_delete(desc);
+  }
+
+  /* the reverse complements are stored at the positions of the sequences */
+  total_length = gt_str_length(seq);
+  utsc->orig_seq = gt_malloc(sizeof (GtUchar) * (total_length + 1));
+  utsc->tran_seq = gt_malloc(sizeof (GtUchar) * (total_length + 1));
+  utsc->orig_seq_rc = gt_malloc(sizeof (GtUchar) * (total_length + 1));
+  utsc->tran_seq_rc = gt_malloc(sizeof (GtUchar) * (total_length + 1));
+  memcpy(utsc->orig_seq, gt_str_get(seq), total_length);
+  for (i = 0; i < total_length; i++)
+    utsc->orig_seq_rc[i] = SEPARATOR;
+  for (seq_num = 0; seq_num < gt_array_size(utsc->ranges); seq_num++) {
+    range = *(GtRange*) gt_array_get(utsc->ranges, seq_num);
+    for (i = range.start, j = range.end; i <= range.end; i++, j--) {
+      utsc->orig_seq_rc[i] = unit_test_complement(utsc->orig_seq[j]);
+    }
+  }
+  for (i = 0; i < total_length; i++) {
+    utsc->tran_seq[i] = utsc->orig_seq[i] == SEPARATOR
+                        ? SEPARATOR
+                        : gt_alphabet_encode(utsc->alphabet,
+                                             utsc->orig_seq[i]);
+    utsc->tran_seq_rc[i] = utsc->orig_seq_rc[i] == SEPARATOR
+                           ? SEPARATOR
+                           : gt_alphabet_encode(utsc->alphabet,
+                                                utsc->orig_seq_rc[i]);
+  }
+  utsc->orig_seq[total_length] = utsc->tran_seq[total_length] =
+  utsc->orig_seq_rc[total_length] = utsc->tran_seq_rc[total_length] =
+    SEPARATOR;
+
+  gt_str_delete(seq);
+  gt_str_delete(genomic_seq);
+  return sc;
+}
+
+static void unit_test_add_chain(GthChainCollection *chain_collection,
+                                GtUword ref_seq_num, GtUword gene)
+{
+  GthChain *chain = gth_chain_new();
+  GtRange exons[3];
+  GtUword i;
+  chain->gen_file_num = 0;
+  chain->gen_seq_num = 0;
+  chain->ref_file_num = 0;
+  chain->ref_seq_num = ref_seq_num;
+  unit_test_gene_exons(exons, gene);
+  for (i = 0; i < 3; i++)
+    gt_array_add(chain->forwardranges, exons[i]);
+  gt_ranges_copy_to_opposite_strand(chain->reverseranges, chain->forwardranges,
+                                    unit_test_genomic_length(), 0);
+  chain->refseqcoverage = 100.0;
+  gth_chain_collection_add(chain_collection, chain);
+}
+
+/* Returns a chain for every transcript. Some chains occur twice (the second
+   spliced alignment is a duplicate) and some transcripts are additionally
+   chained with the following gene. */
+static GthChainCollection* unit_test_chain_collection_new(void)
+{
+  GthChainCollection *chain_collection = gth_chain_collection_new();
+  GtUword gene;
+  for (gene = 0; gene < GTH_UNIT_TEST_NUM_OF_GENES; gene++) {
+    unit_test_add_chain(chain_collection, gene, gene);
+    if (gene % 4 == 0)
+      unit_test_add_chain(chain_collection, gene, gene);
+    if (gene % 5 == 1 && gene + 1 < GTH_UNIT_TEST_NUM_OF_GENES)
+      unit_test_add_chain(chain_collection, gene, gene + 1);
+  }
+  return chain_collection;
+}
+
+/* Computes the spliced alignments of the chains of the unit test for both
+   directions with <jobs> threads and writes the resulting alignments (with
+   their call numbers), the match information, and the statistics to a new
+   temporary file, whose name is stored in <outfilename>. */
+static int unit_test_calc_spliced_alignments(GtStr *outfilename,
+                                             unsigned int jobs,
+                                             unsigned int firstalshown,
+                                             GtUword *num_of_sas, GtError *err)
+{
+  unsigned int original_jobs = gt_jobs;
+  GthChainCollection *chain_collection;
+  GthSACollectionIterator *iterator;
+  GthSACollection *sa_collection;
+  GthMatchInfo match_info;
+  GthCallInfo *call_info;
+  GthSAVisitor *visitor;
+  GthInput *input;
+  GthStat *stat;
+  GthSA *sa;
+  GtUword i;
+  int had_err = 0;
+
+  gt_error_check(err);
+  input = gth_input_new(NULL, unit_test_seq_con_new);
+  gth_input_add_genomic_file(input, "genomic.fas");
+  gth_input_add_cdna_file(input, "ests.fas");
+  gth_input_load_genomic_file(input, 0, true);
+  gth_input_load_reference_file(input, 0, true);
+
+  call_info = gth_call_info_new("gt");
+  call_info->firstalshown = firstalshown;
+  call_info->minaveragessp = GTH_DEFAULT_MINAVERAGESSP;
+  call_info->duplicate_check = GTH_DC_ID;
+  call_info->simfilterparam.introncutoutinfo.introncutout =
+    GTH_DEFAULT_INTRONCUTOUT;
+  call_info->simfilterparam.introncutoutinfo.autoicmaxmatrixsize =
+    GTH_DEFAULT_AUTOICMAXMATRIXSIZE;
+  call_info->simfilterparam.introncutoutinfo.icinitialdelta =
+    GTH_DEFAULT_ICINITIALDELTA;
+  call_info->simfilterparam.introncutoutinfo.iciterations =
+    GTH_DEFAULT_ICITERATIONS;
+  call_info->simfilterparam.introncutoutinfo.icdeltaincrease =
+    GTH_DEFAULT_ICDELTAINCREASE;
+  call_info->out->xmlout = true;
+  gt_fa_xfclose(gt_xtmpfp(outfilename));
+  call_info->out->outfp = gt_file_xopen(gt_str_get(outfilename), "w");
+
+  stat = gth_stat_new();
+  sa_collection = gth_sa_collection_new(call_info->duplicate_check);
+  match_info.call_number = 0;
+  match_info.significant_match_found = false;
+  match_info.max_call_number_reached = false;
+  match_info.stop_amino_acid_warning = false;
+
+  gt_jobs = jobs;
+  for (i = 0; !had_err && !match_info.max_call_number_reached && i < 2; i++) {
+    chain_collection = unit_test_chain_collection_new();
+    had_err = calc_spliced_alignments(sa_collection, chain_collection,
+                                      call_info, input, stat, 0, 0, !i,
+                                      &match_info, NULL, NULL, err);
+    gth_chain_collection_delete(chain_collection);
+  }
+  gt_jobs = original_jobs;
+
+  *num_of_sas = 0;
+  visitor = gth_xml_inter_sa_visitor_new(input, 0, call_info->out->outfp);
+  iterator = gth_sa_collection_iterator_new(sa_collection);
+  while ((sa = gth_sa_collection_iterator_next(iterator))) {
+    gth_sa_visitor_visit_sa(visitor, sa);
+    gt_file_xprintf(call_info->out->outfp, "call_number=" GT_WU "\n",
+                    gth_sa_call_number(sa));
+    (*num_of_sas)++;
+  }
+  gth_sa_collection_iterator_delete(iterator);
+  gth_sa_visitor_delete(visitor);
+  gt_file_xprintf(call_info->out->outfp, "call_number=" GT_WU
+                  ", significant_match_found=%d, max_call_number_reached=%d\n",
+                  match_info.call_number, match_info.significant_match_found,
+                  match_info.max_call_number_reached);
+  gth_stat_show(stat, true, true, call_info->out->outfp);
+
+  gth_sa_collection_delete(sa_collection);
+  gth_stat_delete(stat);
+  gth_call_info_delete(call_info);
+  gth_input_delete_complete(input);
+  return had_err;
+}
+
+/* Appends the content of <filename> to <content>, without the line showing
+   the date. */
+static void unit_test_read_file(GtStr *content, const char *filename)
+{
+  GtStr *line = gt_str_new();
+  FILE *fp;
+  int cc;
+  fp = gt_fa_xfopen(filename, "r");
+  while ((cc = fgetc(fp)) != EOF) {
+    gt_str_append_char(line, cc);
+    if (cc == '\n') {
+      if (!strstr(gt_str_get(line), "date finished"))
+        gt_str_append_str(content, line);
+      gt_str_reset(line);
+    }
+  }
+  gt_str_append_str(content, line);
+  gt_fa_xfclose(fp);
+  gt_str_delete(line);
+}
+
+int gth_similarity_filter_unit_test(GtError *err)
+{
+  static const unsigned int firstalshown[] = { 0, 7, 50 };
+  GtStr *seqfile = gt_str_new(), *parfile = gt_str_new(),
+        *seqcontent = gt_str_new(), *parcontent = gt_str_new();
+  GtUword i, num_of_sas_seq, num_of_sas_par;
+  int had_err = 0;
+
+  gt_error_check(err);
+  for (i = 0; !had_err && i < sizeof firstalshown / sizeof firstalshown[0];
+       i++) {
+    gt_str_reset(seqfile);
+    gt_str_reset(parfile);
+    had_err = unit_test_calc_spliced_alignments(seqfile, 1, firstalshown[i],
+                                                &num_of_sas_seq, err);
+    if (!had_err) {
+      had_err = unit_test_calc_spliced_alignments(parfile, 4, firstalshown[i],
+                                                  &num_of_sas_par, err);
+    }
+    if (!had_err) {
+      gt_str_reset(seqcontent);
+      gt_str_reset(parcontent);
+      unit_test_read_file(seqcontent, gt_str_get(seqfile));
+      unit_test_read_file(parcontent, gt_str_get(parfile));
+      gt_ensure(num_of_sas_seq > 0);
+      gt_ensure(!firstalshown[i] || num_of_sas_seq <= firstalshown[i]);
+      gt_ensure(num_of_sas_seq == num_of_sas_par);
+      gt_ensure(!gt_str_cmp(seqcontent, parcontent));
+      gt_xunlink(gt_str_get(seqfile));
+      gt_xunlink(gt_str_get(parfile));
+    }
+  }
+
+  gt_str_delete(seqfile);
+  gt_str_delete(parfile);
+  gt_str_delete(seqcontent);
+  gt_str_delete(parcontent);
+  return had_err;
+}
@@ -25,4 +25,6 @@ int gth_similarity_filter(GthCallInfo*, GthInput*, GthStat*,
                           unsigned int indentlevel, const GthPlugins *plugins,
                           GtError*);
 
+int gth_similarity_filter_unit_test(GtError*);
+
 #endif
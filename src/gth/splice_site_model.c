@@ -54,6 +54,7 @@ GthSpliceSiteModel* gth_splice_site_model_new(void)
                                       GTH_DEFAULT_U12_TYPEDONORPROBONEMISMATCH);
 
   ssm->bssm_param = NULL;
+  ssm->splice_site_track = NULL;
 
   return ssm;
 }
@@ -104,3 +105,17 @@ void gth_splice_site_model_set_U12typedonorprob_one_mismatch(GthSpliceSiteModel
 {
   SET_PROB_VALUE(U12typedonorprobonemismatch, prob);
 }
+
+const GthBSSMParam* gth_splice_site_model_bssm_param(const GthSpliceSiteModel
+                                                     *ssm)
+{
+  gt_assert(ssm);
+  return ssm->bssm_param;
+}
+
+void gth_splice_site_model_set_track(GthSpliceSiteModel *ssm,
+                                     GthSpliceSiteTrack *splice_site_track)
+{
+  gt_assert(ssm);
+  ssm->splice_site_track = splice_site_track;
+}
@@ -19,6 +19,8 @@
 #define SPLICE_SITE_MODEL_H
 
 #include "core/error.h"
+#include "gth/bssm_param.h"
+#include "gth/splice_site_track.h"
 
 /* generic splice site model */
 typedef struct GthSpliceSiteModel GthSpliceSiteModel;
@@ -37,5 +39,13 @@ void                gth_splice_site_model_set_U12typedonorprob(
 void                gth_splice_site_model_set_U12typedonorprob_one_mismatch(
                                                         GthSpliceSiteModel*,
                                                         GthFlt prob);
+/* Returns the BSSM parameters of the splice site model or NULL, if the
+   generic model is used. */
+const GthBSSMParam* gth_splice_site_model_bssm_param(const GthSpliceSiteModel*);
+/* Use <splice_site_track> (which is not owned by the splice site model) to
+   get the BSSM probabilities. Set to NULL to compute them again. */
+void                gth_splice_site_model_set_track(GthSpliceSiteModel*,
+                                                    GthSpliceSiteTrack
+                                                    *splice_site_track);
 
 #endif
@@ -71,6 +71,9 @@ struct GthSpliceSiteModel {
 
   GthBSSMParam *bssm_param; /* contains bssm parameters or is NULL,
                               if generic parameters are used. */
+  GthSpliceSiteTrack *splice_site_track; /* caches the BSSM probabilities of
+                                            the current genomic file, or is
+                                            NULL */
 };
 
 #endif
@@ -0,0 +1,766 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/chardef.h"
+#include "core/fa.h"
+#include "core/fileutils_api.h"
+#include "core/ma_api.h"
+#include "core/md5_fingerprint_api.h"
+#include "core/minmax.h"
+#include "core/multithread_api.h"
+#include "core/safearith.h"
+#include "core/str_api.h"
+#include "core/thread_api.h"
+#include "core/xansi_api.h"
+#include "gth/bssm_param_rep.h"
+#include "gth/default.h"
+#include "gth/gthdef.h"
+#include "gth/splice_site_track.h"
+
+#define SPLICE_SITE_TRACK_VERSION       1
+#define SPLICE_SITE_TRACK_HEADERSIZE    4 /* words */
+#define SPLICE_SITE_TRACK_MD5SIZE       40
+/* the probabilities are computed and cached in blocks of this many
+   positions */
+#define SPLICE_SITE_TRACK_BLOCKSIZE     16384
+/* the maximal number of blocks kept in memory (512 MB) */
+#define SPLICE_SITE_TRACK_MAXBLOCKS     4096
+/* the number of blocks computed in parallel before they are written to the
+   track file of a persistent track */
+#define SPLICE_SITE_TRACK_WRITEBATCH    64
+
+/* XXX: why A? */
+#define SUBSTITUTEWILDCARDWITHA(C)\
+        if (C ==  WILDCARD)\
+        {\
+          C = gen_alphabet_symbolmap['A'];\
+        }
+
+struct GthSpliceSiteTrack {
+  const GthBSSMParam *bssm_param;
+  const unsigned char *gen_seq_tran[2]; /* forward and reverse strand */
+  GtUword gen_total_length,
+          margin,                  /* positions closer than this to the
+                                      sequence bounds are computed directly */
+          num_of_blocks;
+  const GtUchar *gen_alphabet_symbolmap;
+  /* the complete track (persistent tracks only) */
+  GthFlt *donorprobs[2],
+         *acceptorprobs[2];
+  void *trackdata;                 /* the mapped header and probabilities */
+  /* the block cache (other tracks) */
+  GthFlt **blocks[2];              /* donor probabilities followed by the
+                                      acceptor probabilities of the block */
+  GtUword *cached,                 /* ring buffer of the cached blocks */
+          num_of_cached,
+          next_to_evict;
+  GtMutex *mutex;
+};
+
+static void evalsplicesiteprobformodel(GthFlt *prob, bool donorsite,
+                                       const unsigned char *gen_seq_tran,
+                                       const GtRange *gen_seq_bounds,
+                                       GtUword genpos,
+                                       const GtUchar *gen_alphabet_symbolmap,
+                                       const GthBSSMModel *bssmmodel)
+{
+  GtUword pc, /* previous char */
+                cc, /* current char */
+                d, i, j;
+  GtWord startpos, endpos;
+  GthDbl pval = 0.5, Tv[3] = { 0.0 }, Fv[4] = { 0.0 };
+  gt_assert(bssmmodel);
+
+  /* set start and endpos */
+  if (donorsite) {
+    startpos = genpos - bssmmodel->window_size_left,
+    endpos   = gt_safe_cast2long(genpos + bssmmodel->window_size_right + 1);
+  }
+  else { /* acceptorsite */
+    startpos =  genpos - bssmmodel->window_size_left - 1,
+    endpos   =  genpos + bssmmodel->window_size_right;
+  }
+
+  if ((startpos >= gt_safe_cast2long(gen_seq_bounds->start)) &&
+      (gt_safe_cast2ulong(endpos) <= gen_seq_bounds->end)) {
+    pc = gen_seq_tran[startpos];
+    SUBSTITUTEWILDCARDWITHA(pc);
+    if (bssmmodel->hypothesis_num == HYPOTHESIS2) {
+      Tv[0] = (double) bssmmodel->hypotables.hypo2table[0][0][pc][0];
+      Fv[0] = (double) bssmmodel->hypotables.hypo2table[1][0][pc][0];
+    }
+    else {
+      Tv[0] = (double) bssmmodel->hypotables.hypo7table[0][0][pc][0];
+      Tv[1] = (double) bssmmodel->hypotables.hypo7table[1][0][pc][0];
+      Tv[2] = (double) bssmmodel->hypotables.hypo7table[2][0][pc][0];
+      Fv[0] = (double) bssmmodel->hypotables.hypo7table[3][0][pc][0];
+      Fv[1] = (double) bssmmodel->hypotables.hypo7table[4][0][pc][0];
+      Fv[2] = (double) bssmmodel->hypotables.hypo7table[5][0][pc][0];
+      Fv[3] = (double) bssmmodel->hypotables.hypo7table[6][0][pc][0];
+    }
+    d = 50 - bssmmodel->window_size_left;
+    for (i = startpos + 1; i <= gt_safe_cast2ulong(endpos); i++) {
+      j = d + (i - startpos);
+      cc = gen_seq_tran[i];
+      SUBSTITUTEWILDCARDWITHA(cc);
+      if (bssmmodel->hypothesis_num == HYPOTHESIS2) {
+        Tv[0] = Tv[0] * bssmmodel->hypotables.hypo2table[0][j][pc][cc];
+        Fv[0] = Fv[0] * bssmmodel->hypotables.hypo2table[1][j][pc][cc];
+      }
+      else {
+        Tv[0] = Tv[0] * bssmmodel->hypotables.hypo7table[0][j][pc][cc];
+        Tv[1] = Tv[1] * bssmmodel->hypotables.hypo7table[1][j][pc][cc];
+        Tv[2] = Tv[2] * bssmmodel->hypotables.hypo7table[2][j][pc][cc];
+        Fv[0] = Fv[0] * bssmmodel->hypotables.hypo7table[3][j][pc][cc];
+        Fv[1] = Fv[1] * bssmmodel->hypotables.hypo7table[4][j][pc][cc];
+        Fv[2] = Fv[2] * bssmmodel->hypotables.hypo7table[5][j][pc][cc];
+        Fv[3] = Fv[3] * bssmmodel->hypotables.hypo7table[6][j][pc][cc];
+      }
+      pc = cc;
+    }
+    if (bssmmodel->hypothesis_num == HYPOTHESIS2)
+      pval = Tv[0] / (Tv[0] + Fv[0]);
+    else {
+      pval = Tv[0] + Tv[1] + Tv[2];
+      pval = pval / (pval + Fv[0] + Fv[1] + Fv[2] + Fv[3]);
+    }
+    /* XXX: prevents problem with fission_yeast.bssm file */
+    if (isnan(pval))
+      pval = 0.0;
+    /* pval is a valid probability */
+    gt_assert(pval >= 0.0 && pval <= 1.0);
+    pval = 2.0 * (pval - 0.5); /* XXX: ? */
+  }
+  else
+    pval = 0.0;
+
+  /* return probability */
+  *prob = (GthFlt) pval;
+}
+
+static void evaldonorprob(GthFlt *prob, const unsigned char *gen_seq_tran,
+                          const GtRange *gen_seq_bounds, GtUword genpos,
+                          const GtUchar *gen_alphabet_symbolmap,
+                          const GthBSSMParam *bssm_param)
+{
+  *prob = (GthFlt) 0.0;
+  gt_assert(bssm_param);
+
+  if (genpos < gen_seq_bounds->end) {
+    if (bssm_param->gt_donor_model_set &&
+        gen_seq_tran[genpos]     == gen_alphabet_symbolmap['G'] &&
+        gen_seq_tran[genpos + 1] == gen_alphabet_symbolmap['T']) {
+      evalsplicesiteprobformodel(prob, true, gen_seq_tran, gen_seq_bounds,
+                                 genpos, gen_alphabet_symbolmap,
+                                 &bssm_param->gt_donor_model);
+    }
+    else if (bssm_param->gc_donor_model_set &&
+             gen_seq_tran[genpos]     == gen_alphabet_symbolmap['G'] &&
+             gen_seq_tran[genpos + 1] == gen_alphabet_symbolmap['C']) {
+      evalsplicesiteprobformodel(prob, true, gen_seq_tran, gen_seq_bounds,
+                                 genpos, gen_alphabet_symbolmap,
+                                 &bssm_param->gc_donor_model);
+    }
+  }
+}
+
+static void evalacceptorprob(GthFlt *prob, const unsigned char *gen_seq_tran,
+                             const GtRange *gen_seq_bounds,
+                             GtUword genpos,
+                             const GtUchar *gen_alphabet_symbolmap,
+                             const GthBSSMParam *bssm_param)
+{
+  *prob = (GthFlt) 0.0;
+  gt_assert(bssm_param);
+
+  if (genpos > 0 &&
+      gen_seq_tran[genpos - 1] == gen_alphabet_symbolmap['A'] &&
+      gen_seq_tran[genpos]     == gen_alphabet_symbolmap['G']) {
+    if (bssm_param->ag_acceptor_model_set) {
+      evalsplicesiteprobformodel(prob, false, gen_seq_tran, gen_seq_bounds,
+                                 genpos, gen_alphabet_symbolmap,
+                                 &bssm_param->ag_acceptor_model);
+    }
+  }
+}
+
+void gth_splice_site_track_compute(GthFlt *donorprobs, GthFlt *acceptorprobs,
+                                   const unsigned char *gen_seq_tran,
+                                   const GtRange *gen_seq_bounds,
+                                   GtUword start, GtUword end,
+                                   const GtUchar *gen_alphabet_symbolmap,
+                                   const GthBSSMParam *bssm_param)
+{
+  GtUword genomicindex;
+  GthFlt donorprob, acceptorprob;
+  gt_assert(donorprobs && acceptorprobs && gen_seq_tran && gen_seq_bounds);
+  gt_assert(start <= end + 1);
+  for (genomicindex = start; genomicindex <= end; genomicindex++) {
+    evaldonorprob(&donorprob, gen_seq_tran, gen_seq_bounds, genomicindex,
+                  gen_alphabet_symbolmap, bssm_param);
+    if (donorprob > GTH_DEFAULT_MAXIMAL_SPLICESITEPROB)
+      donorprob = GTH_DEFAULT_MAXIMAL_SPLICESITEPROB;
+    *donorprobs++ = donorprob;
+    evalacceptorprob(&acceptorprob, gen_seq_tran, gen_seq_bounds, genomicindex,
+                     gen_alphabet_symbolmap, bssm_param);
+    if (acceptorprob > GTH_DEFAULT_MAXIMAL_SPLICESITEPROB)
+      acceptorprob = GTH_DEFAULT_MAXIMAL_SPLICESITEPROB;
+    *acceptorprobs++ = acceptorprob;
+  }
+}
+
+/* Characters which can not occur within a genomic sequence (like separators)
+   end a segment. Wildcards are treated as A by the BSSM evaluation. */
+#define SEGMENT_BREAK(C)  ((C) >= 4 && (C) != WILDCARD)
+
+/* Computes the probabilities of block <blocknum> of <strand>. The positions
+   are evaluated with respect to the segments free of separators around the
+   block, which gives the same probabilities as the sequence bounds for all
+   positions at least <track->margin> away from them. */
+static void compute_block(const GthSpliceSiteTrack *track, unsigned int strand,
+                          GtUword blocknum, GthFlt *donorprobs,
+                          GthFlt *acceptorprobs)
+{
+  const unsigned char *gen_seq_tran = track->gen_seq_tran[strand];
+  GtUword blockstart, blockend, pos, last;
+  GtRange segment;
+
+  blockstart = blocknum * SPLICE_SITE_TRACK_BLOCKSIZE;
+  blockend = MIN(blockstart + SPLICE_SITE_TRACK_BLOCKSIZE,
+                 track->gen_total_length) - 1;
+  memset(donorprobs, 0, sizeof (GthFlt) * (blockend - blockstart + 1));
+  memset(acceptorprobs, 0, sizeof (GthFlt) * (blockend - blockstart + 1));
+
+  pos = blockstart > track->margin ? blockstart - track->margin : 0;
+  last = MIN(blockend + track->margin, track->gen_total_length - 1);
+  while (pos <= last) {
+    if (SEGMENT_BREAK(gen_seq_tran[pos])) {
+      pos++;
+      continue;
+    }
+    segment.start = pos;
+    while (pos < last && !SEGMENT_BREAK(gen_seq_tran[pos + 1]))
+      pos++;
+    segment.end = pos++;
+    if (segment.end >= blockstart && segment.start <= blockend) {
+      GtUword from = MAX(segment.start, blockstart),
+              to = MIN(segment.end, blockend);
+      gth_splice_site_track_compute(donorprobs + from - blockstart,
+                                    acceptorprobs + from - blockstart,
+                                    gen_seq_tran, &segment, from, to,
+                                    track->gen_alphabet_symbolmap,
+                                    track->bssm_param);
+    }
+  }
+}
+
+static GtUword model_margin(const GthBSSMModel *model)
+{
+  return MAX(model->window_size_left, model->window_size_right) + 2;
+}
+
+static GthSpliceSiteTrack* splice_site_track_new(const GthBSSMParam
+                                                 *bssm_param,
+                                                 const unsigned char
+                                                 *gen_seq_tran,
+                                                 const unsigned char
+                                                 *gen_seq_tran_rc,
+                                                 GtUword gen_total_length,
+                                                 GtAlphabet *gen_alphabet)
+{
+  GthSpliceSiteTrack *track;
+  gt_assert(bssm_param && gen_seq_tran && gen_total_length && gen_alphabet);
+  track = gt_calloc(1, sizeof *track);
+  track->bssm_param = bssm_param;
+  track->gen_seq_tran[0] = gen_seq_tran;
+  track->gen_seq_tran[1] = gen_seq_tran_rc;
+  track->gen_total_length = gen_total_length;
+  track->gen_alphabet_symbolmap = gt_alphabet_symbolmap(gen_alphabet);
+  track->num_of_blocks = (gen_total_length + SPLICE_SITE_TRACK_BLOCKSIZE - 1)
+                         / SPLICE_SITE_TRACK_BLOCKSIZE;
+  /* the BSSM window of a position and the dinucleotides around it are
+     contained in the margin */
+  track->margin = 2;
+  if (bssm_param->gt_donor_model_set) {
+    track->margin = MAX(track->margin,
+                        model_margin(&bssm_param->gt_donor_model));
+  }
+  if (bssm_param->gc_donor_model_set) {
+    track->margin = MAX(track->margin,
+                        model_margin(&bssm_param->gc_donor_model));
+  }
+  if (bssm_param->ag_acceptor_model_set) {
+    track->margin = MAX(track->margin,
+                        model_margin(&bssm_param->ag_acceptor_model));
+  }
+  return track;
+}
+
+GthSpliceSiteTrack* gth_splice_site_track_new(const GthBSSMParam *bssm_param,
+                                              const unsigned char
+                                              *gen_seq_tran,
+                                              const unsigned char
+                                              *gen_seq_tran_rc,
+                                              GtUword gen_total_length,
+                                              GtAlphabet *gen_alphabet)
+{
+  GthSpliceSiteTrack *track;
+  unsigned int strand;
+  track = splice_site_track_new(bssm_param, gen_seq_tran, gen_seq_tran_rc,
+                                gen_total_length, gen_alphabet);
+  for (strand = 0; strand < 2; strand++) {
+    if (track->gen_seq_tran[strand]) {
+      track->blocks[strand] = gt_calloc(track->num_of_blocks,
+                                        sizeof *track->blocks[strand]);
+    }
+  }
+  track->cached = gt_malloc(sizeof *track->cached *
+                            SPLICE_SITE_TRACK_MAXBLOCKS);
+  track->mutex = gt_mutex_new();
+  return track;
+}
+
+/* Returns the MD5 fingerprint of the BSSM models used by <bssm_param>. */
+static char* bssm_param_fingerprint(const GthBSSMParam *bssm_param)
+{
+  const GthBSSMModel *models[3];
+  bool models_set[3];
+  GtStr *buf = gt_str_new();
+  char *fingerprint;
+  unsigned int i;
+  models[0] = &bssm_param->gt_donor_model;
+  models[1] = &bssm_param->gc_donor_model;
+  models[2] = &bssm_param->ag_acceptor_model;
+  models_set[0] = bssm_param->gt_donor_model_set;
+  models_set[1] = bssm_param->gc_donor_model_set;
+  models_set[2] = bssm_param->ag_acceptor_model_set;
+  for (i = 0; i < 3; i++) {
+    gt_str_append_char(buf, models_set[i] ? '1' : '0');
+    if (models_set[i]) {
+      gt_str_append_uword(buf, models[i]->hypothesis_num);
+      gt_str_append_char(buf, ',');
+      gt_str_append_uword(buf, models[i]->window_size_left);
+      gt_str_append_char(buf, ',');
+      gt_str_append_uword(buf, models[i]->window_size_right);
+      if (models[i]->hypothesis_num == HYPOTHESIS2) {
+        gt_str_append_cstr_nt(buf, (const char*)
+                              models[i]->hypotables.hypo2table,
+                              sizeof (Hypo2table));
+      }
+      else {
+        gt_str_append_cstr_nt(buf, (const char*)
+                              models[i]->hypotables.hypo7table,
+                              sizeof (Hypo7table));
+      }
+    }
+  }
+  fingerprint = gt_md5_fingerprint(gt_str_get(buf), gt_str_length(buf));
+  gt_str_delete(buf);
+  return fingerprint;
+}
+
+static GtUword track_file_size(GtUword gen_total_length,
+                               GtUword num_of_strands)
+{
+  return sizeof (GtUword) * SPLICE_SITE_TRACK_HEADERSIZE
+         + SPLICE_SITE_TRACK_MD5SIZE
+         + num_of_strands * 2 * gen_total_length * sizeof (GthFlt);
+}
+
+static void set_track_pointers(GthSpliceSiteTrack *track, void *data,
+                               GtUword num_of_strands)
+{
+  GthFlt *probs = (GthFlt*) ((char*) data + sizeof (GtUword) *
+                             SPLICE_SITE_TRACK_HEADERSIZE +
+                             SPLICE_SITE_TRACK_MD5SIZE);
+  unsigned int strand;
+  for (strand = 0; strand < num_of_strands; strand++) {
+    track->donorprobs[strand] = probs;
+    probs += track->gen_total_length;
+    track->acceptorprobs[strand] = probs;
+    probs += track->gen_total_length;
+  }
+}
+
+/* Maps the track file <filename>. Returns false, if it does not match the
+   <track> and the <fingerprint> of the BSSM parameters. */
+static bool read_track_file(GthSpliceSiteTrack *track, const char *filename,
+                            const char *fingerprint)
+{
+  GtUword num_of_strands = track->gen_seq_tran[1] ? 2 : 1, *header;
+  FILE *fp = NULL;
+  size_t len;
+  bool use_file_locking = !getenv(GTHNOFLOCKENVNAME);
+  void *mapped;
+
+  if (use_file_locking) {
+    fp = gt_fa_xfopen(filename, "r");
+    gt_fa_lock_shared(fp);
+  }
+  mapped = gt_fa_mmap_read(filename, &len, NULL);
+  if (use_file_locking) {
+    gt_fa_unlock(fp);
+    gt_fa_xfclose(fp);
+  }
+  if (!mapped)
+    return false;
+  header = mapped;
+  /* a track file with both strands can be used for the forward strand only */
+  if (len < track_file_size(track->gen_total_length, 1) ||
+      header[0] != SPLICE_SITE_TRACK_VERSION ||
+      header[1] != track->gen_total_length ||
+      header[2] < num_of_strands ||
+      len != track_file_size(track->gen_total_length, header[2]) ||
+      strncmp((char*) (header + SPLICE_SITE_TRACK_HEADERSIZE), fingerprint,
+              SPLICE_SITE_TRACK_MD5SIZE)) {
+    gt_fa_xmunmap(mapped);
+    return false;
+  }
+  track->trackdata = mapped;
+  set_track_pointers(track, mapped, num_of_strands);
+  return true;
+}
+
+typedef struct {
+  GthSpliceSiteTrack *track;
+  GthFlt *buffer;                  /* the probabilities of the current batch */
+  GtUword first_block,
+          num_of_blocks,
+          next_block;
+  GtMutex *mutex;
+} ComputeTrackInfo;
+
+static void* compute_track_thread(void *data)
+{
+  ComputeTrackInfo *info = data;
+  GthSpliceSiteTrack *track = info->track;
+  GtUword i, block;
+  GthFlt *probs;
+  for (;;) {
+    gt_mutex_lock(info->mutex);
+    i = info->next_block++;
+    gt_mutex_unlock(info->mutex);
+    if (i >= info->num_of_blocks)
+      break;
+    block = info->first_block + i;
+    probs = info->buffer + i * 2 * SPLICE_SITE_TRACK_BLOCKSIZE;
+    compute_block(track, block / track->num_of_blocks,
+                  block % track->num_of_blocks, probs,
+                  probs + SPLICE_SITE_TRACK_BLOCKSIZE);
+  }
+  return NULL;
+}
+
+/* Writes the donor and acceptor probabilities <probs> of block <block> to
+   their positions in the track file <fp>. */
+static void write_block(FILE *fp, const GthSpliceSiteTrack *track,
+                        GtUword block, const GthFlt *probs)
+{
+  GtUword strand = block / track->num_of_blocks,
+          blockstart = (block % track->num_of_blocks)
+                       * SPLICE_SITE_TRACK_BLOCKSIZE,
+          blocklen = MIN(SPLICE_SITE_TRACK_BLOCKSIZE,
+                         track->gen_total_length - blockstart),
+          offset = sizeof (GtUword) * SPLICE_SITE_TRACK_HEADERSIZE
+                   + SPLICE_SITE_TRACK_MD5SIZE
+                   + (strand * 2 * track->gen_total_length + blockstart)
+                     * sizeof (GthFlt);
+  gt_xfseek(fp, (GtWord) offset, SEEK_SET);
+  gt_xfwrite(probs, sizeof (GthFlt), blocklen, fp);
+  gt_xfseek(fp, (GtWord) (offset + track->gen_total_length * sizeof (GthFlt)),
+            SEEK_SET);
+  gt_xfwrite(probs + SPLICE_SITE_TRACK_BLOCKSIZE, sizeof (GthFlt), blocklen,
+             fp);
+}
+
+/* Computes the complete track and writes it to <filename>. The blocks are
+   computed in batches and each batch is written before the next one is
+   computed, so that the track is never kept in memory as a whole. */
+static int write_track_file(GthSpliceSiteTrack *track, const char *filename,
+                            const char *fingerprint, GtError *err)
+{
+  GtUword num_of_strands = track->gen_seq_tran[1] ? 2 : 1,
+          header[SPLICE_SITE_TRACK_HEADERSIZE],
+          total_blocks, i;
+  char md5[SPLICE_SITE_TRACK_MD5SIZE];
+  ComputeTrackInfo info;
+  bool use_file_locking = !getenv(GTHNOFLOCKENVNAME);
+  FILE *fp;
+  int had_err = 0;
+
+  gt_error_check(err);
+
+  if (!(fp = gt_fa_fopen(filename, "w", err)))
+    return -1;
+  if (use_file_locking)
+    gt_fa_lock_exclusive(fp);
+
+  header[0] = SPLICE_SITE_TRACK_VERSION;
+  header[1] = track->gen_total_length;
+  header[2] = num_of_strands;
+  header[3] = 0;
+  memset(md5, 0, SPLICE_SITE_TRACK_MD5SIZE);
+  strncpy(md5, fingerprint, SPLICE_SITE_TRACK_MD5SIZE - 1);
+  gt_xfwrite(header, sizeof *header, SPLICE_SITE_TRACK_HEADERSIZE, fp);
+  gt_xfwrite(md5, 1, SPLICE_SITE_TRACK_MD5SIZE, fp);
+
+  /* the blocks are independent from each other */
+  info.track = track;
+  info.buffer = gt_malloc(sizeof (GthFlt) * 2 * SPLICE_SITE_TRACK_BLOCKSIZE
+                          * SPLICE_SITE_TRACK_WRITEBATCH);
+  info.mutex = gt_mutex_new();
+  total_blocks = num_of_strands * track->num_of_blocks;
+  for (info.first_block = 0; !had_err && info.first_block < total_blocks;
+       info.first_block += info.num_of_blocks) {
+    info.num_of_blocks = MIN(SPLICE_SITE_TRACK_WRITEBATCH,
+                             total_blocks - info.first_block);
+    info.next_block = 0;
+    had_err = gt_multithread(compute_track_thread, &info, err);
+    for (i = 0; !had_err && i < info.num_of_blocks; i++) {
+      write_block(fp, track, info.first_block + i,
+                  info.buffer + i * 2 * SPLICE_SITE_TRACK_BLOCKSIZE);
+    }
+  }
+  gt_mutex_delete(info.mutex);
+  gt_free(info.buffer);
+
+  if (use_file_locking)
+    gt_fa_unlock(fp);
+  gt_fa_xfclose(fp);
+  if (had_err)
+    gt_xremove(filename);
+  return had_err;
+}
+
+GthSpliceSiteTrack* gth_splice_site_track_new_persistent(const GthBSSMParam
+                                                         *bssm_param,
+                                                         const unsigned char
+                                                         *gen_seq_tran,
+                                                         const unsigned char
+                                                         *gen_seq_tran_rc,
+                                                         GtUword
+                                                         gen_total_length,
+                                                         GtAlphabet
+                                                         *gen_alphabet,
+                                                         const char
+                                                         *genomicfile,
+                                                         GtError *err)
+{
+  GthSpliceSiteTrack *track;
+  GtStr *filename;
+  char *fingerprint;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(genomicfile);
+
+  track = splice_site_track_new(bssm_param, gen_seq_tran, gen_seq_tran_rc,
+                                gen_total_length, gen_alphabet);
+  filename = gt_str_new_cstr(genomicfile);
+  gt_str_append_cstr(filename, GTH_SPLICE_SITE_TRACK_FILE_SUFFIX);
+  fingerprint = bssm_param_fingerprint(bssm_param);
+
+  /* only try to read the track file if the genomic file was not modified in
+     the meantime */
+  if (!gt_file_exists(gt_str_get(filename)) ||
+      gt_file_is_newer(genomicfile, gt_str_get(filename)) ||
+      !read_track_file(track, gt_str_get(filename), fingerprint)) {
+    had_err = write_track_file(track, gt_str_get(filename), fingerprint,
+                               err);
+    if (!had_err && !read_track_file(track, gt_str_get(filename),
+                                     fingerprint)) {
+      gt_error_set(err, "could not map splice site track file \"%s\"",
+                   gt_str_get(filename));
+      had_err = -1;
+    }
+  }
+
+  gt_free(fingerprint);
+  gt_str_delete(filename);
+  if (had_err) {
+    gth_splice_site_track_delete(track);
+    return NULL;
+  }
+  return track;
+}
+
+void gth_splice_site_track_delete(GthSpliceSiteTrack *track)
+{
+  unsigned int strand;
+  GtUword i;
+  if (!track) return;
+  gt_fa_xmunmap(track->trackdata);
+  for (strand = 0; strand < 2; strand++) {
+    if (track->blocks[strand]) {
+      for (i = 0; i < track->num_of_blocks; i++)
+        gt_free(track->blocks[strand][i]);
+      gt_free(track->blocks[strand]);
+    }
+  }
+  gt_free(track->cached);
+  gt_mutex_delete(track->mutex);
+  gt_free(track);
+}
+
+/* Copies the probabilities of the positions <start> to <end> of block
+   <blocknum> from the cache. Returns false, if the block is not cached. */
+static bool copy_from_cache(GthSpliceSiteTrack *track, unsigned int strand,
+                            GtUword blocknum, GthFlt *donorprobs,
+                            GthFlt *acceptorprobs, GtUword start, GtUword end)
+{
+  GthFlt *block;
+  bool cached = false;
+  gt_mutex_lock(track->mutex);
+  if ((block = track->blocks[strand][blocknum])) {
+    GtUword offset = start - blocknum * SPLICE_SITE_TRACK_BLOCKSIZE;
+    memcpy(donorprobs, block + offset, sizeof (GthFlt) * (end - start + 1));
+    memcpy(acceptorprobs, block + SPLICE_SITE_TRACK_BLOCKSIZE + offset,
+           sizeof (GthFlt) * (end - start + 1));
+    cached = true;
+  }
+  gt_mutex_unlock(track->mutex);
+  return cached;
+}
+
+/* Adds <block> to the cache, the oldest block is evicted if the cache is
+   full. */
+static void add_to_cache(GthSpliceSiteTrack *track, unsigned int strand,
+                         GtUword blocknum, GthFlt *block)
+{
+  GtUword evict;
+  gt_mutex_lock(track->mutex);
+  if (track->blocks[strand][blocknum]) {
+    /* computed by another thread in the meantime */
+    gt_free(block);
+  }
+  else {
+    if (track->num_of_cached < SPLICE_SITE_TRACK_MAXBLOCKS)
+      track->cached[track->num_of_cached++] = 2 * blocknum + strand;
+    else {
+      evict = track->cached[track->next_to_evict];
+      gt_free(track->blocks[evict % 2][evict / 2]);
+      track->blocks[evict % 2][evict / 2] = NULL;
+      track->cached[track->next_to_evict] = 2 * blocknum + strand;
+      track->next_to_evict = (track->next_to_evict + 1)
+                             % SPLICE_SITE_TRACK_MAXBLOCKS;
+    }
+    track->blocks[strand][blocknum] = block;
+  }
+  gt_mutex_unlock(track->mutex);
+}
+
+static void get_from_track(GthSpliceSiteTrack *track, unsigned int strand,
+                           GthFlt *donorprobs, GthFlt *acceptorprobs,
+                           GtUword start, GtUword end)
+{
+  GtUword blocknum, blockend, offset, len;
+  GthFlt *block;
+
+  if (track->donorprobs[strand]) {
+    /* complete track */
+    memcpy(donorprobs, track->donorprobs[strand] + start,
+           sizeof (GthFlt) * (end - start + 1));
+    memcpy(acceptorprobs, track->acceptorprobs[strand] + start,
+           sizeof (GthFlt) * (end - start + 1));
+    return;
+  }
+
+  while (start <= end) {
+    blocknum = start / SPLICE_SITE_TRACK_BLOCKSIZE;
+    blockend = MIN((blocknum + 1) * SPLICE_SITE_TRACK_BLOCKSIZE - 1, end);
+    if (!copy_from_cache(track, strand, blocknum, donorprobs, acceptorprobs,
+                         start, blockend)) {
+      /* the block is computed without holding the lock */
+      block = gt_malloc(sizeof (GthFlt) * 2 * SPLICE_SITE_TRACK_BLOCKSIZE);
+      compute_block(track, strand, blocknum, block,
+                    block + SPLICE_SITE_TRACK_BLOCKSIZE);
+      offset = start - blocknum * SPLICE_SITE_TRACK_BLOCKSIZE;
+      len = blockend - start + 1;
+      memcpy(donorprobs, block + offset, sizeof (GthFlt) * len);
+      memcpy(acceptorprobs, block + SPLICE_SITE_TRACK_BLOCKSIZE + offset,
+             sizeof (GthFlt) * len);
+      add_to_cache(track, strand, blocknum, block);
+    }
+    donorprobs += blockend - start + 1;
+    acceptorprobs += blockend - start + 1;
+    start = blockend + 1;
+  }
+}
+
+void gth_splice_site_track_get(GthSpliceSiteTrack *track, GthFlt *donorprobs,
+                               GthFlt *acceptorprobs,
+                               const unsigned char *gen_seq_tran,
+                               const GtRange *gen_seq_bounds,
+                               GtUword start, GtUword end)
+{
+  GtUword inner_start, inner_end;
+  unsigned int strand;
+
+  gt_assert(track && donorprobs && acceptorprobs && gen_seq_tran);
+  gt_assert(gen_seq_bounds && start <= end);
+  gt_assert(start >= gen_seq_bounds->start && end <= gen_seq_bounds->end);
+
+  if (gen_seq_tran == track->gen_seq_tran[0])
+    strand = 0;
+  else if (gen_seq_tran == track->gen_seq_tran[1])
+    strand = 1;
+  else {
+    gth_splice_site_track_compute(donorprobs, acceptorprobs, gen_seq_tran,
+                                  gen_seq_bounds, start, end,
+                                  track->gen_alphabet_symbolmap,
+                                  track->bssm_param);
+    return;
+  }
+
+  /* only the positions whose BSSM windows lie within the sequence bounds are
+     taken from the track */
+  if (gt_range_length(gen_seq_bounds) <= 2 * track->margin) {
+    inner_start = end + 1;
+    inner_end = end;
+  }
+  else {
+    inner_start = MAX(start, gen_seq_bounds->start + track->margin);
+    inner_end = MIN(end, gen_seq_bounds->end - track->margin);
+    if (inner_start > inner_end) {
+      inner_start = end + 1;
+      inner_end = end;
+    }
+  }
+
+  if (start < inner_start) {
+    gth_splice_site_track_compute(donorprobs, acceptorprobs, gen_seq_tran,
+                                  gen_seq_bounds, start,
+                                  MIN(inner_start - 1, end),
+                                  track->gen_alphabet_symbolmap,
+                                  track->bssm_param);
+  }
+  if (inner_start <= inner_end) {
+    get_from_track(track, strand, donorprobs + inner_start - start,
+                   acceptorprobs + inner_start - start, inner_start,
+                   inner_end);
+    if (inner_end < end) {
+      gth_splice_site_track_compute(donorprobs + inner_end + 1 - start,
+                                    acceptorprobs + inner_end + 1 - start,
+                                    gen_seq_tran, gen_seq_bounds,
+                                    inner_end + 1, end,
+                                    track->gen_alphabet_symbolmap,
+                                    track->bssm_param);
+    }
+  }
+}
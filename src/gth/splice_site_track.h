@@ -0,0 +1,102 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef SPLICE_SITE_TRACK_H
+#define SPLICE_SITE_TRACK_H
+
+#include "core/alphabet.h"
+#include "core/error.h"
+#include "core/range.h"
+#include "gth/bssm_param.h"
+
+#define GTH_SPLICE_SITE_TRACK_FILE_SUFFIX  ".sst"
+
+/*
+  A splice site track stores the BSSM donor and acceptor site probabilities
+  of the positions of a genomic file (on both strands), so that they are
+  computed only once, although many DPs cover the same genomic region.
+
+  By default, the probabilities are computed on demand in blocks and a
+  limited number of blocks is kept in memory. A persistent track is computed
+  for the whole file at once, written block by block to the file
+  <genomic file>.sst and then memory mapped (also by later runs). The file
+  uses 16 bytes per genomic position if both strands are stored.
+
+  The probability of a position depends on the sequence bounds only if its
+  BSSM window exceeds them. Such positions are always computed directly, all
+  other positions are taken from the track.
+*/
+typedef struct GthSpliceSiteTrack GthSpliceSiteTrack;
+
+/* Returns a new track for the transformed genomic sequence <gen_seq_tran>
+   and its reverse complement <gen_seq_tran_rc> (which can be NULL) of total
+   length <gen_total_length>. The probabilities are computed with
+   <bssm_param>. */
+GthSpliceSiteTrack* gth_splice_site_track_new(const GthBSSMParam *bssm_param,
+                                              const unsigned char
+                                              *gen_seq_tran,
+                                              const unsigned char
+                                              *gen_seq_tran_rc,
+                                              GtUword gen_total_length,
+                                              GtAlphabet *gen_alphabet);
+/* Like <gth_splice_site_track_new()>, but the track is read from the track
+   file of <genomicfile>, if it is up to date and has been computed with the
+   same BSSM parameters. Otherwise the track is computed completely and the
+   track file is written. Returns NULL and sets <err> if the track file could
+   not be written. */
+GthSpliceSiteTrack* gth_splice_site_track_new_persistent(const GthBSSMParam
+                                                         *bssm_param,
+                                                         const unsigned char
+                                                         *gen_seq_tran,
+                                                         const unsigned char
+                                                         *gen_seq_tran_rc,
+                                                         GtUword
+                                                         gen_total_length,
+                                                         GtAlphabet
+                                                         *gen_alphabet,
+                                                         const char
+                                                         *genomicfile,
+                                                         GtError *err);
+void                gth_splice_site_track_delete(GthSpliceSiteTrack*);
+
+/* Store the donor and acceptor site probabilities of the positions <start>
+   to <end> of <gen_seq_tran> (which must lie within <gen_seq_bounds>) in
+   <donorprobs> and <acceptorprobs>. If <gen_seq_tran> is neither of the
+   sequences of the <track>, the probabilities are computed directly. Can be
+   called from multiple threads. */
+void                gth_splice_site_track_get(GthSpliceSiteTrack *track,
+                                              GthFlt *donorprobs,
+                                              GthFlt *acceptorprobs,
+                                              const unsigned char
+                                              *gen_seq_tran,
+                                              const GtRange *gen_seq_bounds,
+                                              GtUword start, GtUword end);
+
+/* Compute the donor and acceptor site probabilities of the positions <start>
+   to <end> of <gen_seq_tran> without a track. */
+void                gth_splice_site_track_compute(GthFlt *donorprobs,
+                                                  GthFlt *acceptorprobs,
+                                                  const unsigned char
+                                                  *gen_seq_tran,
+                                                  const GtRange
+                                                  *gen_seq_bounds,
+                                                  GtUword start, GtUword end,
+                                                  const GtUchar
+                                                  *gen_alphabet_symbolmap,
+                                                  const GthBSSMParam
+                                                  *bssm_param);
+
+#endif
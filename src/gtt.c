@@ -22,6 +22,7 @@
 #include "core/array2dim_sparse.h"
 #include "core/array3dim.h"
 #include "core/basename_api.h"
+#include "core/bgzf.h"
 #include "core/bitpackarray.h"
 #include "core/bitpackstring.h"
 #include "core/bittab.h"
@@ -38,12 +39,14 @@
 #include "core/disc_distri_api.h"
 #include "core/dlist.h"
 #include "core/dyn_bittab.h"
+#include "core/elias_fano.h"
 #include "core/encseq.h"
 #include "core/grep_api.h"
 #include "core/hashmap.h"
 #include "core/hashtable.h"
 #include "core/interval_tree.h"
 #include "core/mathsupport.h"
+#include "core/md5_fingerprint.h"
 #include "core/md5_seqid.h"
 #include "core/quality.h"
 #include "core/queue.h"
@@ -73,6 +76,7 @@
 #include "extended/intset.h"
 #include "extended/kmer_database.h"
 #include "extended/luaserialize.h"
+#include "extended/match_iterator_seedext.h"
 #include "extended/multieoplist.h"
 #include "extended/n_r_encseq.h"
 #include "extended/popcount_tab.h"
@@ -84,6 +88,10 @@
 #include "extended/string_matching.h"
 #include "extended/tag_value_map.h"
 #include "extended/uint64hashtable.h"
+#include "gth/align_dna.h"
+#include "gth/bin_inter.h"
+#include "gth/intermediate.h"
+#include "gth/similarity_filter.h"
 #include "ltr/gt_ltrclustering.h"
 #include "ltr/gt_ltrdigest.h"
 #include "ltr/gt_ltrharvest.h"
@@ -287,6 +295,7 @@ GtHashmap* gtt_unit_tests(void)
                                                    gt_array2dim_sparse_example);
   gt_hashmap_add(unit_tests, "array3dim example", gt_array3dim_example);
   gt_hashmap_add(unit_tests, "basename module", gt_basename_unit_test);
+  gt_hashmap_add(unit_tests, "bgzf module", gt_bgzf_unit_test);
   gt_hashmap_add(unit_tests, "bit pack array class", gt_bitpackarray_unit_test);
   gt_hashmap_add(unit_tests, "bit pack string module",
                                                     gt_bitPackString_unit_test);
@@ -313,6 +322,7 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "dlist example", gt_dlist_example);
   gt_hashmap_add(unit_tests, "dynamic bittab class", gt_dyn_bittab_unit_test);
   gt_hashmap_add(unit_tests, "editscript class", gt_editscript_unit_test);
+  gt_hashmap_add(unit_tests, "elias fano class", gt_elias_fano_unit_test);
   gt_hashmap_add(unit_tests, "elias gamma class", gt_elias_gamma_unit_test);
   gt_hashmap_add(unit_tests, "encdesc class", gt_encdesc_unit_test);
   gt_hashmap_add(unit_tests, "encseq builder class",
@@ -328,6 +338,13 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "gff3 escaping module",
                                                     gt_gff3_escaping_unit_test);
   gt_hashmap_add(unit_tests, "grep module", gt_grep_unit_test);
+  gt_hashmap_add(unit_tests, "gth DNA alignment", gth_align_dna_unit_test);
+  gt_hashmap_add(unit_tests, "gth binary intermediate module",
+                 gth_bin_inter_unit_test);
+  gt_hashmap_add(unit_tests, "gth intermediate module",
+                 gth_intermediate_unit_test);
+  gt_hashmap_add(unit_tests, "gth similarity filter",
+                 gth_similarity_filter_unit_test);
   gt_hashmap_add(unit_tests, "golomb class", gt_golomb_unit_test);
   gt_hashmap_add(unit_tests, "hashmap class", gt_hashmap_unit_test);
   gt_hashmap_add(unit_tests, "hashtable class", gt_hashtable_unit_test);
@@ -338,9 +355,13 @@ GtHashmap* gtt_unit_tests(void)
   gt_hashmap_add(unit_tests, "kmer_database class", gt_kmer_database_unit_test);
   gt_hashmap_add(unit_tests, "Lua serializer module",
                                                    gt_lua_serializer_unit_test);
+  gt_hashmap_add(unit_tests, "match iterator seedext class",
+                 gt_match_iterator_seedext_unit_test);
   gt_hashmap_add(unit_tests, "mathsupport module", gt_mathsupport_unit_test);
   gt_hashmap_add(unit_tests, "memory allocator module", gt_ma_unit_test);
   gt_hashmap_add(unit_tests, "multieoplist", gt_multieoplist_unit_test);
+  gt_hashmap_add(unit_tests, "MD5 fingerprint module",
+                                                  gt_md5_fingerprint_unit_test);
   gt_hashmap_add(unit_tests, "MD5 seqid module", gt_md5_seqid_unit_test);
   gt_hashmap_add(unit_tests, "n_r_encseq", gt_n_r_encseq_unit_test);
   gt_hashmap_add(unit_tests, "rdj: suffix-prefix matches list module",
@@ -16,12 +16,14 @@
 */
 
 #include "core/encseq.h"
+#include "core/intbits.h"
 #include "core/ma.h"
 #include "core/output_file_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "extended/gff3_in_stream.h"
 #include "extended/gff3_out_stream_api.h"
+#include "match/seed-extend.h"
 #include "ltr/ltr_cluster_stream.h"
 #include "ltr/ltr_classify_stream.h"
 #include "ltr/gt_ltrclustering.h"
@@ -31,10 +33,12 @@ typedef struct {
   GtOutputFileInfo *ofi;
   GtStr  *file_prefix;
   GtUword psmall,
-                plarge;
-  double xdrop,
-         identity;
-  int wordsize;
+                plarge,
+                wordsize,
+                minlength,
+                identity;
+  GtWord xdrop;
+  bool use_last;
 } GtLTRClusteringArguments;
 
 static void* gt_ltrclustering_arguments_new(void)
@@ -86,7 +90,47 @@ static GtOptionParser* gt_ltrclustering_option_parser_new(void *tool_arguments)
   gt_option_is_mandatory(option);
   gt_option_parser_add_option(op, option);
 
-  gt_option_is_mandatory(option);
+  /* -wordsize */
+  option = gt_option_new_uword_min_max("wordsize", "specify the length of the "
+                                       "exact seeds which are extended to "
+                                       "matches",
+                                       &arguments->wordsize,
+                                       GT_LTR_CLUSTER_STREAM_SEEDLENGTH, 1UL,
+                                       (GtUword) GT_UNITSIN2BITENC);
+  gt_option_parser_add_option(op, option);
+
+  /* -minlen */
+  option = gt_option_new_uword("minlen", "specify the minimum length of a "
+                               "match",
+                               &arguments->minlength,
+                               GT_LTR_CLUSTER_STREAM_MINLENGTH);
+  gt_option_parser_add_option(op, option);
+
+  /* -identity */
+  option = gt_option_new_uword_min_max("identity", "specify the minimum "
+                                       "identity of a match in percent",
+                                       &arguments->identity,
+                                       100UL -
+                                       GT_LTR_CLUSTER_STREAM_ERRORPERCENTAGE,
+                                       (GtUword)
+                                       GT_EXTEND_MIN_IDENTITY_PERCENTAGE,
+                                       100UL);
+  gt_option_parser_add_option(op, option);
+
+  /* -xdrop */
+  option = gt_option_new_word("xdrop", "specify the xdrop cutoff score of the "
+                              "seed extension (0 means that it is determined "
+                              "from the identity)",
+                              &arguments->xdrop, 0);
+  gt_option_parser_add_option(op, option);
+
+  /* -uselast */
+  option = gt_option_new_bool("uselast", "compute the matches with the "
+                              "external LAST tool instead of the built-in "
+                              "seed extension",
+                              &arguments->use_last, false);
+  gt_option_is_extended_option(option);
+  gt_option_parser_add_option(op, option);
 
   gt_output_file_info_register_options(arguments->ofi, op, &arguments->outfp);
 
@@ -138,6 +182,13 @@ static int gt_ltrclustering_runner(int argc, const char **argv,
                                                          arguments->psmall,
                                                          NULL,
                                                          err);
+    gt_ltr_cluster_stream_set_seedext((GtLTRClusterStream*) ltr_cluster_stream,
+                                      arguments->wordsize,
+                                      arguments->minlength,
+                                      100UL - arguments->identity,
+                                      arguments->xdrop);
+    gt_ltr_cluster_stream_use_last((GtLTRClusterStream*) ltr_cluster_stream,
+                                   arguments->use_last);
     last_stream = ltr_classify_stream = gt_ltr_classify_stream_new(last_stream,
                                                                    NULL,
                                                                    NULL,
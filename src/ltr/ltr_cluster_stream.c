@@ -36,6 +36,7 @@
 #include "extended/match_iterator_api.h"
 #include "extended/match_iterator_last.h"
 #include "extended/match_iterator_open.h"
+#include "extended/match_iterator_seedext.h"
 #include "ltr/ltr_cluster_stream.h"
 #include "ltr/ltr_cluster_prepare_seq_visitor.h"
 #include "match/sfx-run.h"
@@ -50,7 +51,12 @@ struct GtLTRClusterStream {
   bool first_next;
   GtUword psmall,
                 plarge,
-                next_index;
+                next_index,
+                seedlength,
+                minlength,
+                errorpercentage;
+  GtWord xdropbelowscore;
+  bool use_last;
   int match_score, mismatch_cost, gap_open_cost,
       gap_ext_cost, xdrop, ydrop, zdrop, mscoregapped,
       mscoregapless, k;
@@ -407,16 +413,23 @@ static int process_feature(GtLTRClusterStream *lcs,
   encseq = (GtEncseq*) gt_hashmap_get(lcs->feat_to_encseq, feature);
   gt_log_log("found encseq %p for feature %s", encseq, feature);
   if (!had_err) {
-    mi = gt_match_iterator_last_new(encseq, encseq, lcs->match_score,
-                                        lcs->mismatch_cost,
-                                        lcs->gap_open_cost,
-                                        lcs->gap_ext_cost,
-                                        lcs->xdrop,
-                                        lcs->ydrop,
-                                        lcs->zdrop,
-                                        lcs->k,
-                                        lcs->mscoregapped,
-                                        lcs->mscoregapless, err);
+    if (lcs->use_last) {
+      mi = gt_match_iterator_last_new(encseq, encseq, lcs->match_score,
+                                      lcs->mismatch_cost,
+                                      lcs->gap_open_cost,
+                                      lcs->gap_ext_cost,
+                                      lcs->xdrop,
+                                      lcs->ydrop,
+                                      lcs->zdrop,
+                                      lcs->k,
+                                      lcs->mscoregapped,
+                                      lcs->mscoregapless, err);
+    } else {
+      mi = gt_match_iterator_seedext_new(encseq, encseq, lcs->seedlength,
+                                         lcs->minlength,
+                                         lcs->errorpercentage,
+                                         lcs->xdropbelowscore, err);
+    }
     if (mi != NULL) {
       while ((status = gt_match_iterator_next(mi, &match, err))
              != GT_MATCHER_STATUS_END) {
@@ -600,5 +613,29 @@ GtNodeStream* gt_ltr_cluster_stream_new(GtNodeStream *in_stream,
   lcs->plarge = plarge;
   lcs->psmall = psmall;
   lcs->current_state = current_state;
+  lcs->use_last = false;
+  lcs->seedlength = GT_LTR_CLUSTER_STREAM_SEEDLENGTH;
+  lcs->minlength = GT_LTR_CLUSTER_STREAM_MINLENGTH;
+  lcs->errorpercentage = GT_LTR_CLUSTER_STREAM_ERRORPERCENTAGE;
+  lcs->xdropbelowscore = 0;
   return ns;
 }
+
+void gt_ltr_cluster_stream_set_seedext(GtLTRClusterStream *lcs,
+                                       GtUword seedlength,
+                                       GtUword minlength,
+                                       GtUword errorpercentage,
+                                       GtWord xdropbelowscore)
+{
+  gt_assert(lcs);
+  lcs->seedlength = seedlength;
+  lcs->minlength = minlength;
+  lcs->errorpercentage = errorpercentage;
+  lcs->xdropbelowscore = xdropbelowscore;
+}
+
+void gt_ltr_cluster_stream_use_last(GtLTRClusterStream *lcs, bool use_last)
+{
+  gt_assert(lcs);
+  lcs->use_last = use_last;
+}
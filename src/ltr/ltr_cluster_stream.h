@@ -20,6 +20,26 @@
 
 #include "ltr/ltr_cluster_stream_api.h"
 
+/* default parameters of the built-in seed extension matcher */
+#define GT_LTR_CLUSTER_STREAM_SEEDLENGTH       12UL
+#define GT_LTR_CLUSTER_STREAM_MINLENGTH        20UL
+#define GT_LTR_CLUSTER_STREAM_ERRORPERCENTAGE  20UL
+
 const GtNodeStreamClass* gt_ltr_cluster_stream_class(void);
 
+/* Sets the parameters of the built-in seed extension matcher of <lcs>, see
+   <gt_match_iterator_seedext_new()>. */
+void gt_ltr_cluster_stream_set_seedext(GtLTRClusterStream *lcs,
+                                       GtUword seedlength,
+                                       GtUword minlength,
+                                       GtUword errorpercentage,
+                                       GtWord xdropbelowscore);
+
+/* If <use_last> is true, <lcs> computes the matches with the external LAST
+   tool instead of the built-in seed extension matcher. The LAST scoring
+   parameters given to <gt_ltr_cluster_stream_new()> are only used in this
+   case, the parameters set by <gt_ltr_cluster_stream_set_seedext()> only in
+   the other. */
+void gt_ltr_cluster_stream_use_last(GtLTRClusterStream *lcs, bool use_last);
+
 #endif
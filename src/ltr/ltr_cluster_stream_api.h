@@ -25,7 +25,12 @@
 typedef struct GtLTRClusterStream GtLTRClusterStream;
 
 /* Implements the <GtNodeStream> interface. <GtLTRClusterStream> annotates
-   all LTR features with cluster IDs, based on matches. */
+   all LTR features with cluster IDs, based on matches. The matches are
+   computed in-process by seed extension. The LAST scoring parameters from
+   <match_score> to <mscoregapless> are ignored by the seed extension, they
+   are kept for compatibility and only used if the stream is switched to the
+   external LAST tool (see the <-uselast> option of <gt ltrclustering>).
+   Pass <GT_UNDEF_INT> for them to use the defaults of LAST. */
 GtNodeStream* gt_ltr_cluster_stream_new(GtNodeStream *in_stream,
                                         GtEncseq *encseq,
                                         int match_score,
@@ -0,0 +1,104 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#include "core/class_alloc_lock.h"
+#include "core/queue_api.h"
+#include "extended/node_stream_api.h"
+#include "ltr/ltrdigest_pdom_stream.h"
+
+struct GtLTRdigestPdomStream {
+  const GtNodeStream parent_instance;
+  GtNodeStream *in_stream;
+  GtLTRdigestPdomVisitor *pdom_v;
+  GtQueue *node_buffer;
+};
+
+#define ltrdigest_pdom_stream_cast(NS)\
+        gt_node_stream_cast(gt_ltrdigest_pdom_stream_class(), NS)
+
+static int ltrdigest_pdom_stream_next(GtNodeStream *ns, GtGenomeNode **gn,
+                                      GtError *err)
+{
+  GtLTRdigestPdomStream *ps;
+  GtGenomeNode *node = NULL;
+  int had_err = 0;
+  gt_error_check(err);
+  ps = ltrdigest_pdom_stream_cast(ns);
+
+  if (gt_queue_size(ps->node_buffer) == 0) {
+    /* fill the buffer until the visitor has annotated all candidates in it,
+       that is, a batch has been completed or the input is exhausted */
+    do {
+      had_err = gt_node_stream_next(ps->in_stream, &node, err);
+      if (!had_err && node) {
+        gt_queue_add(ps->node_buffer, node);
+        had_err = gt_genome_node_accept(node, (GtNodeVisitor*) ps->pdom_v,
+                                        err);
+      }
+    } while (!had_err && node &&
+             gt_ltrdigest_pdom_visitor_num_of_pending(ps->pdom_v) > 0);
+    if (!had_err && !node)
+      had_err = gt_ltrdigest_pdom_visitor_flush(ps->pdom_v, err);
+  }
+
+  if (had_err) {
+    /* we own the buffered nodes -> delete them */
+    while (gt_queue_size(ps->node_buffer))
+      gt_genome_node_delete(gt_queue_get(ps->node_buffer));
+    *gn = NULL;
+    return had_err;
+  }
+  *gn = gt_queue_size(ps->node_buffer) ? gt_queue_get(ps->node_buffer) : NULL;
+  return 0;
+}
+
+static void ltrdigest_pdom_stream_free(GtNodeStream *ns)
+{
+  GtLTRdigestPdomStream *ps = ltrdigest_pdom_stream_cast(ns);
+  while (gt_queue_size(ps->node_buffer))
+    gt_genome_node_delete(gt_queue_get(ps->node_buffer));
+  gt_queue_delete(ps->node_buffer);
+  gt_node_visitor_delete((GtNodeVisitor*) ps->pdom_v);
+  gt_node_stream_delete(ps->in_stream);
+}
+
+const GtNodeStreamClass* gt_ltrdigest_pdom_stream_class(void)
+{
+  static const GtNodeStreamClass *nsc = NULL;
+  gt_class_alloc_lock_enter();
+  if (!nsc) {
+    nsc = gt_node_stream_class_new(sizeof (GtLTRdigestPdomStream),
+                                   ltrdigest_pdom_stream_free,
+                                   ltrdigest_pdom_stream_next);
+  }
+  gt_class_alloc_lock_leave();
+  return nsc;
+}
+
+GtNodeStream* gt_ltrdigest_pdom_stream_new(GtNodeStream *in_stream,
+                                           GtLTRdigestPdomVisitor *pdom_v)
+{
+  GtLTRdigestPdomStream *ps;
+  GtNodeStream *ns;
+  gt_assert(in_stream && pdom_v);
+  ns = gt_node_stream_create(gt_ltrdigest_pdom_stream_class(),
+                             gt_node_stream_is_sorted(in_stream));
+  ps = ltrdigest_pdom_stream_cast(ns);
+  ps->in_stream = gt_node_stream_ref(in_stream);
+  ps->pdom_v = pdom_v;
+  ps->node_buffer = gt_queue_new();
+  return ns;
+}
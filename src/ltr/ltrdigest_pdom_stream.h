@@ -0,0 +1,34 @@
+/*
+  Copyright (c) 2026 Center for Bioinformatics, University of Hamburg
+
+  Permission to use, copy, modify, and distribute this software for any
+  purpose with or without fee is hereby granted, provided that the above
+  copyright notice and this permission notice appear in all copies.
+
+  THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+  WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+  MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+  ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+  WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+  ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+  OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+
+#ifndef LTRDIGEST_PDOM_STREAM_H
+#define LTRDIGEST_PDOM_STREAM_H
+
+#include "extended/node_stream_api.h"
+#include "ltr/ltrdigest_pdom_visitor.h"
+
+/* Implements the <GtNodeStream> interface. Like a visitor stream for the
+   <GtLTRdigestPdomVisitor> <pdom_v>, but nodes are held back until the
+   hmmscan batch of their LTR candidate has been processed. Takes ownership
+   of <pdom_v>. */
+typedef struct GtLTRdigestPdomStream GtLTRdigestPdomStream;
+
+const GtNodeStreamClass* gt_ltrdigest_pdom_stream_class(void);
+GtNodeStream*            gt_ltrdigest_pdom_stream_new(GtNodeStream *in_stream,
+                                                      GtLTRdigestPdomVisitor
+                                                      *pdom_v);
+
+#endif
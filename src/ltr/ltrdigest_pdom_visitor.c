@@ -31,6 +31,7 @@
 #include "core/codon_iterator_simple_api.h"
 #include "core/cstr_api.h"
 #include "core/cstr_array.h"
+#include "core/fa.h"
 #include "core/grep_api.h"
 #include "core/hashmap.h"
 #include "core/log.h"
@@ -45,6 +46,8 @@
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "core/warning_api.h"
+#include "core/xansi_api.h"
+#include "core/xposix.h"
 #include "extended/node_visitor_api.h"
 #include "extended/extract_feature_sequence.h"
 #include "extended/feature_node.h"
@@ -72,6 +75,9 @@ struct GtLTRdigestPdomVisitor {
   bool output_all_chains;
   char **args;
   const char *root_type;
+  GtArray *candidates;
+  GtStr *queries;
+  GtUword batch_size;
 };
 
 typedef struct {
@@ -91,6 +97,15 @@ typedef struct {
   char *modelname;
 } GtHMMERModelHit;
 
+/* An LTR candidate whose translations are part of the current hmmscan
+   input. The descriptions of its queries are its index in
+   <GtLTRdigestPdomVisitor.candidates>. */
+typedef struct {
+  GtFeatureNode *ltr_retrotrans;
+  GtUword leftLTR_5, rightLTR_3;
+  GtHMMERParseStatus *pstatus;
+} GtLTRdigestPdomCandidate;
+
 typedef struct {
   GtUword hmmfrom, hmmto, alifrom, alito, frame;
   double evalue, score;
@@ -284,10 +299,8 @@ static int gt_ltrdigest_pdom_visitor_parse_scores(GT_UNUSED
                                                   GtError *err)
 {
   int had_err = 0;
-  gt_assert(lv && instream);
+  gt_assert(lv && instream && buf);
   gt_error_check(err);
-  had_err = pdom_parser_get_next_line(buf, instream, err);
-  gt_assert(had_err || buf != NULL);
   if (!had_err && strncmp("Scores", buf, (size_t) 6) != 0) {
     gt_error_set(err, "expected 'Scores' at beginning of new scores "
                       "section, '%s' read instead", buf);
@@ -454,13 +467,13 @@ static int gt_ltrdigest_pdom_visitor_parse_domainhits(
 
 #ifndef _WIN32
 static int gt_ltrdigest_pdom_visitor_parse_query(GtLTRdigestPdomVisitor *lv,
-                                                 GtHMMERParseStatus *status,
                                                  bool *end,
                                                  FILE *instream, GtError *err)
 {
   int had_err = 0;
   char buf[GT_HMMER_BUF_LEN];
-  gt_assert(lv && instream && status);
+  GtHMMERParseStatus *status = NULL;
+  gt_assert(lv && instream);
   gt_error_check(err);
 
   had_err = pdom_parser_get_next_line(buf, instream, err);
@@ -468,9 +481,31 @@ static int gt_ltrdigest_pdom_visitor_parse_query(GtLTRdigestPdomVisitor *lv,
     *end = true;
   }
   if (!had_err && !(*end)) {
-    status->strand = gt_strand_get(buf[14]);
-    buf[14] = '\0';
-    status->frame = (unsigned) atoi(buf+13);
+    GtUword frame;
+    char strand;
+    if (sscanf(buf + 6, " "GT_WU"%c", &frame, &strand) != 2 || frame > 2UL
+          || (strand != '+' && strand != '-')) {
+      gt_error_set(err, "unexpected query in HMMER output: '%s'", buf);
+      had_err = -1;
+    }
+    if (!had_err)
+      had_err = pdom_parser_get_next_line(buf, instream, err);
+    /* the description of the query is the number of its candidate */
+    if (!had_err) {
+      GtUword candno;
+      if (sscanf(buf, "Description: "GT_WU"", &candno) != 1
+            || candno >= gt_array_size(lv->candidates)) {
+        gt_error_set(err, "expected candidate number in query description, "
+                          "'%s' read instead", buf);
+        had_err = -1;
+      } else {
+        status = ((GtLTRdigestPdomCandidate*)
+                              gt_array_get(lv->candidates, candno))->pstatus;
+        status->strand = gt_strand_get(strand);
+        status->frame = (unsigned) frame;
+        had_err = pdom_parser_get_next_line(buf, instream, err);
+      }
+    }
   }
   if (!had_err && !(*end)) {
     had_err = gt_ltrdigest_pdom_visitor_parse_scores(lv, buf, instream, err);
@@ -489,16 +524,14 @@ static int gt_ltrdigest_pdom_visitor_parse_query(GtLTRdigestPdomVisitor *lv,
 
 #ifndef _WIN32
 static int gt_ltrdigest_pdom_visitor_parse_output(GtLTRdigestPdomVisitor *lv,
-                                                  GtHMMERParseStatus *status,
                                                   FILE *instream, GtError *err)
 {
   int had_err = 0;
   bool end = false;
-  gt_assert(lv && instream && status);
+  gt_assert(lv && instream);
   gt_error_check(err);
   while (!had_err && !end) {
-    had_err = gt_ltrdigest_pdom_visitor_parse_query(lv, status, &end,
-                                                    instream, err);
+    had_err = gt_ltrdigest_pdom_visitor_parse_query(lv, &end, instream, err);
   }
   /* gt_hmmer_parse_status_show(status); */
   return had_err;
@@ -768,6 +801,121 @@ static int gt_ltrdigest_pdom_visitor_choose_strand(GtLTRdigestPdomVisitor *lv)
   return had_err;
 }
 
+#ifndef _WIN32
+/* Appends the translations of the current LTR candidate to the hmmscan input
+   and remembers the candidate for the demultiplexing of the results. */
+static void gt_ltrdigest_pdom_visitor_add_candidate(GtLTRdigestPdomVisitor *lv)
+{
+  GtLTRdigestPdomCandidate cand;
+  GtUword i, candno;
+  gt_assert(lv && lv->ltr_retrotrans);
+  candno = gt_array_size(lv->candidates);
+  for (i = 0UL; i < 3UL; i++) {
+    gt_str_append_char(lv->queries, '>');
+    gt_str_append_uword(lv->queries, i);
+    gt_str_append_cstr(lv->queries, "+ ");
+    gt_str_append_uword(lv->queries, candno);
+    gt_str_append_char(lv->queries, '\n');
+    gt_str_append_str(lv->queries, lv->fwd[i]);
+    gt_str_append_char(lv->queries, '\n');
+    gt_str_append_char(lv->queries, '>');
+    gt_str_append_uword(lv->queries, i);
+    gt_str_append_cstr(lv->queries, "- ");
+    gt_str_append_uword(lv->queries, candno);
+    gt_str_append_char(lv->queries, '\n');
+    gt_str_append_str(lv->queries, lv->rev[i]);
+    gt_str_append_char(lv->queries, '\n');
+  }
+  cand.ltr_retrotrans = lv->ltr_retrotrans;
+  cand.leftLTR_5 = lv->leftLTR_5;
+  cand.rightLTR_3 = lv->rightLTR_3;
+  cand.pstatus = gt_hmmer_parse_status_new();
+  gt_array_add(lv->candidates, cand);
+}
+#endif
+
+/* Runs a single hmmscan process on the translations of all pending
+   candidates and attaches the resulting hits to them. */
+static int gt_ltrdigest_pdom_visitor_run_hmmscan(GtLTRdigestPdomVisitor *lv,
+                                                 GtError *err)
+{
+  int had_err = 0;
+#ifndef _WIN32
+  GtUword i;
+  GtStr *tmpfilename;
+  FILE *tmpfp, *instream;
+  int pid, cp[2], status;
+  GT_UNUSED int rval;
+  gt_assert(lv);
+  gt_error_check(err);
+
+  if (gt_array_size(lv->candidates) == 0)
+    return 0;
+
+  /* the input is read from a file, so that hmmscan never blocks on a full
+     output pipe while we are still writing queries */
+  tmpfilename = gt_str_new();
+  tmpfp = gt_xtmpfp(tmpfilename);
+  gt_xfwrite(gt_str_get(lv->queries), sizeof (char),
+             (size_t) gt_str_length(lv->queries), tmpfp);
+  gt_fa_xfclose(tmpfp);
+
+  rval = pipe(cp);
+  gt_assert(rval == 0);
+
+  switch ((pid = (int) fork())) {
+    case -1:
+      perror("Can't fork");
+      exit(1);   /* XXX: error handling */
+    case 0:    /* child */
+      (void) close(1);    /* close current stdout. */
+      rval = dup(cp[1]);  /* make stdout go to write end of pipe. */
+      (void) close(cp[0]);
+      (void) close(cp[1]);
+      if (freopen(gt_str_get(tmpfilename), "r", stdin) == NULL) {
+        perror("couldn't open hmmscan input");
+        exit(1);
+      }
+      (void) execvp("hmmscan", lv->args); /* XXX: read path from env */
+      perror("couldn't execute hmmscan!");
+      exit(1);
+    default:    /* parent */
+      (void) close(cp[1]);
+      instream = fdopen(cp[0], "r");
+      had_err = gt_ltrdigest_pdom_visitor_parse_output(lv, instream, err);
+      (void) fclose(instream);
+      (void) waitpid(pid, &status, 0);
+      if (!had_err && (!WIFEXITED(status) || WEXITSTATUS(status) != 0)) {
+        gt_error_set(err, "hmmscan terminated with an error");
+        had_err = -1;
+      }
+  }
+  gt_xunlink(gt_str_get(tmpfilename));
+  gt_str_delete(tmpfilename);
+
+  for (i = 0; i < gt_array_size(lv->candidates); i++) {
+    GtLTRdigestPdomCandidate *cand = gt_array_get(lv->candidates, i);
+    if (!had_err) {
+      lv->ltr_retrotrans = cand->ltr_retrotrans;
+      lv->leftLTR_5 = cand->leftLTR_5;
+      lv->rightLTR_3 = cand->rightLTR_3;
+      had_err = gt_ltrdigest_pdom_visitor_process_hits(lv, cand->pstatus, err);
+      if (!had_err)
+        had_err = gt_ltrdigest_pdom_visitor_choose_strand(lv);
+    }
+    gt_hmmer_parse_status_delete(cand->pstatus);
+  }
+  gt_array_reset(lv->candidates);
+  gt_str_reset(lv->queries);
+  lv->ltr_retrotrans = NULL;
+#else
+  /* XXX */
+  gt_error_set(err, "HMMER call not implemented on Windows\n");
+  had_err = -1;
+#endif
+  return had_err;
+}
+
 static int gt_ltrdigest_pdom_visitor_feature_node(GtNodeVisitor *nv,
                                                   GtFeatureNode *fn,
                                                   GtError *err)
@@ -783,6 +931,7 @@ static int gt_ltrdigest_pdom_visitor_feature_node(GtNodeVisitor *nv,
   gt_error_check(err);
 
   /* traverse annotation subgraph and find LTR element */
+  lv->ltr_retrotrans = NULL;
   fni = gt_feature_node_iterator_new(fn);
   while (!had_err && (curnode = gt_feature_node_iterator_next(fni))) {
     if (strcmp(gt_feature_node_get_type(curnode), lv->root_type) == 0) {
@@ -797,10 +946,6 @@ static int gt_ltrdigest_pdom_visitor_feature_node(GtNodeVisitor *nv,
     GtTranslatorStatus status;
     GtUword seqlen;
     char translated, *rev_seq;
-#ifndef _WIN32
-    FILE *instream;
-    GtHMMERParseStatus *pstatus;
-#endif
     unsigned int frame;
     GtStr *seq;
 
@@ -851,62 +996,12 @@ static int gt_ltrdigest_pdom_visitor_feature_node(GtNodeVisitor *nv,
         gt_translator_delete(tr);
       }
 
-      /* run HMMER and handle results */
+      /* queue the translations, run HMMER once the batch is complete */
       if (!had_err) {
   #ifndef _WIN32
-        int pid, pc[2], cp[2];
-        GT_UNUSED int rval;
-
-        rval = pipe(pc);
-        gt_assert(rval == 0);
-        rval = pipe(cp);
-        gt_assert(rval == 0);
-
-        switch ((pid = (int) fork())) {
-          case -1:
-            perror("Can't fork");
-            exit(1);   /* XXX: error handling */
-          case 0:    /* child */
-            (void) close(1);    /* close current stdout. */
-            rval = dup(cp[1]);  /* make stdout go to write end of pipe. */
-            (void) close(0);    /* close current stdin. */
-            rval = dup(pc[0]);  /* make stdin come from read end of pipe. */
-            (void) close(pc[0]);
-            (void) close(pc[1]);
-            (void) close(cp[0]);
-            (void) close(cp[1]);
-            (void) execvp("hmmscan", lv->args); /* XXX: read path from env */
-            perror("couldn't execute hmmscan!");
-            exit(1);
-          default:    /* parent */
-            for (i = 0UL; i < 3UL; i++) {
-              char buf[5];
-              GT_UNUSED ssize_t written;
-              (void) sprintf(buf, ">"GT_WU"%c\n", i, '+');
-              written = write(pc[1], buf, 4 * sizeof (char));
-              written = write(pc[1], gt_str_get(lv->fwd[i]),
-                            (size_t) gt_str_length(lv->fwd[i]) * sizeof (char));
-              written = write(pc[1], "\n", 1 * sizeof (char));
-              (void) sprintf(buf, ">"GT_WU"%c\n", i, '-');
-              written = write(pc[1], buf, 4 * sizeof (char));
-              written = write(pc[1], gt_str_get(lv->rev[i]),
-                            (size_t) gt_str_length(lv->rev[i]) * sizeof (char));
-              written = write(pc[1], "\n", 1 * sizeof (char));
-            }
-            (void) close(pc[0]);
-            (void) close(pc[1]);
-            (void) close(cp[1]);
-            instream = fdopen(cp[0], "r");
-            pstatus = gt_hmmer_parse_status_new();
-            had_err = gt_ltrdigest_pdom_visitor_parse_output(lv, pstatus,
-                                                             instream, err);
-            (void) fclose(instream);
-            wait(NULL);
-            if (!had_err)
-              had_err = gt_ltrdigest_pdom_visitor_process_hits(lv, pstatus,
-                                                               err);
-            gt_hmmer_parse_status_delete(pstatus);
-        }
+        gt_ltrdigest_pdom_visitor_add_candidate(lv);
+        if (gt_array_size(lv->candidates) >= lv->batch_size)
+          had_err = gt_ltrdigest_pdom_visitor_run_hmmscan(lv, err);
   #else
         /* XXX */
         gt_error_set(err, "HMMER call not implemented on Windows\n");
@@ -920,11 +1015,11 @@ static int gt_ltrdigest_pdom_visitor_feature_node(GtNodeVisitor *nv,
             gt_genome_node_get_filename((GtGenomeNode*) lv->ltr_retrotrans),
             gt_genome_node_get_line_number((GtGenomeNode*) lv->ltr_retrotrans),
             gt_str_length(seq));
+      if (!had_err)
+        had_err = gt_ltrdigest_pdom_visitor_choose_strand(lv);
     }
     gt_str_delete(seq);
   }
-  if (!had_err)
-    had_err = gt_ltrdigest_pdom_visitor_choose_strand(lv);
   return had_err;
 }
 
@@ -941,6 +1036,14 @@ void gt_ltrdigest_pdom_visitor_free(GtNodeVisitor *nv)
   gt_str_delete(lv->cmdline);
   gt_str_delete(lv->tag);
   gt_cstr_array_delete(lv->args);
+#ifndef _WIN32
+  for (i = 0; i < gt_array_size(lv->candidates); i++) {
+    gt_hmmer_parse_status_delete(((GtLTRdigestPdomCandidate*)
+                                 gt_array_get(lv->candidates, i))->pstatus);
+  }
+#endif
+  gt_array_delete(lv->candidates);
+  gt_str_delete(lv->queries);
 }
 
 const GtNodeVisitorClass* gt_ltrdigest_pdom_visitor_class(void)
@@ -979,6 +1082,25 @@ void gt_ltrdigest_pdom_visitor_set_source_tag(GtLTRdigestPdomVisitor *lv,
   gt_str_append_cstr(lv->tag, tag);
 }
 
+void gt_ltrdigest_pdom_visitor_set_batch_size(GtLTRdigestPdomVisitor *lv,
+                                              GtUword batch_size)
+{
+  gt_assert(lv && batch_size > 0);
+  lv->batch_size = batch_size;
+}
+
+GtUword gt_ltrdigest_pdom_visitor_num_of_pending(GtLTRdigestPdomVisitor *lv)
+{
+  gt_assert(lv);
+  return gt_array_size(lv->candidates);
+}
+
+int gt_ltrdigest_pdom_visitor_flush(GtLTRdigestPdomVisitor *lv, GtError *err)
+{
+  gt_assert(lv);
+  return gt_ltrdigest_pdom_visitor_run_hmmscan(lv, err);
+}
+
 GtNodeVisitor* gt_ltrdigest_pdom_visitor_new(GtPdomModelSet *model,
                                              double eval_cutoff,
                                              unsigned int chain_max_gap_length,
@@ -1017,6 +1139,9 @@ GtNodeVisitor* gt_ltrdigest_pdom_visitor_new(GtPdomModelSet *model,
   lv->output_all_chains = false;
   lv->tag = gt_str_new_cstr("GenomeTools");
   lv->root_type = gt_symbol(gt_ft_LTR_retrotransposon);
+  lv->candidates = gt_array_new(sizeof (GtLTRdigestPdomCandidate));
+  lv->queries = gt_str_new();
+  lv->batch_size = 1UL;
 
   for (i = 0; i < 3; i++) {
     lv->fwd[i] = gt_str_new();
@@ -46,4 +46,17 @@ void           gt_ltrdigest_pdom_visitor_set_root_type(
 void           gt_ltrdigest_pdom_visitor_set_source_tag(
                                                      GtLTRdigestPdomVisitor *lv,
                                                      const char *tag);
+/* Search the translations of <batch_size> LTR candidates with a single
+   hmmscan call. Candidates are only annotated when the batch is complete or
+   <gt_ltrdigest_pdom_visitor_flush()> is called, use a
+   <GtLTRdigestPdomStream> to hold back their nodes until then. Default: 1 */
+void           gt_ltrdigest_pdom_visitor_set_batch_size(
+                                                     GtLTRdigestPdomVisitor *lv,
+                                                     GtUword batch_size);
+/* Returns the number of candidates waiting for the next hmmscan call. */
+GtUword        gt_ltrdigest_pdom_visitor_num_of_pending(
+                                                    GtLTRdigestPdomVisitor *lv);
+/* Annotate all pending candidates. */
+int            gt_ltrdigest_pdom_visitor_flush(GtLTRdigestPdomVisitor *lv,
+                                               GtError *err);
 #endif
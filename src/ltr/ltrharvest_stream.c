@@ -19,6 +19,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdbool.h>
+#include <string.h>
 #include "core/array_api.h"
 #include "core/arraydef.h"
 #include "core/assert_api.h"
@@ -47,6 +48,8 @@
 #include "ltr/ltrharvest_stream.h"
 
 #define GT_LTRHARVEST_NAME "LTRharvest"
+/* number of seeds a thread claims at once */
+#define GT_LTRHARVEST_SEED_CHUNK_SIZE 64UL
 
 typedef struct
 {
@@ -93,7 +96,8 @@ typedef struct
                 rightLTR_5,     /* 5' boundary of right LTR */
                 rightLTR_3,     /* 3' boundary of right LTR */
                 lenleftTSD,
-                lenrightTSD;
+                lenrightTSD,
+                seednum;        /* number of the seed of the prediction */
   bool          tsd,            /* If true, then TSDs exist. */
                 motif_near_tsd, /* If true, then motif near the TSD exists. */
                 motif_far_tsd,  /* If true, then motif at the inner borders
@@ -181,6 +185,16 @@ static int bdcompare(const void *a, const void *b, GT_UNUSED void *data)
   {
     return 1;
   }
+  /* the order of the seeds makes the result independent of the order in
+     which the threads deliver their predictions */
+  if (bda->seednum < bdb->seednum)
+  {
+    return -1;
+  }
+  if (bda->seednum > bdb->seednum)
+  {
+    return 1;
+  }
   return 0;
 }
 
@@ -902,12 +916,13 @@ static void adjustboundariesfromXdropextension(GtXdropbest xdropbest_left,
    to all candidate pairs */
 static int gt_searchforLTRs(GtLTRharvestStream *lo,
                             GtArrayLTRboundaries *arrayLTRboundaries,
-                            GT_UNUSED GtMutex *rmutex,
-                            GT_UNUSED GtMutex *wmutex,
+                            GtMutex *rmutex,
+                            GtMutex *wmutex,
                             GtUword *cur_seed,
                             GtError *err)
 {
-  GtUword my_seed;
+  GtUword my_seed = 0, last_seed = 0;
+  GtArrayLTRboundaries localLTRboundaries;
   GtXdropresources *xdropresources;
   GtXdropbest xdropbest_left, xdropbest_right;
 #undef GT_GREEDY_BUFFER
@@ -927,6 +942,9 @@ static int gt_searchforLTRs(GtLTRharvestStream *lo,
 
   gt_error_check(err);
   xdropresources = gt_xdrop_resources_new(&lo->arbitscores);
+  /* the predictions of this thread are collected without locking and added
+     to <arrayLTRboundaries> at the end */
+  GT_INITARRAY(&localLTRboundaries, LTRboundaries);
 
   /* XXX: do thread-synchronized error checking */
   while (true) {
@@ -934,15 +952,18 @@ static int gt_searchforLTRs(GtLTRharvestStream *lo,
                   vlen,
                   seqend,
                   seqstart;
-    gt_mutex_lock(rmutex);
-    if (*cur_seed < lo->repeatinfo.repeats.nextfreeRepeat)
-      my_seed = (*cur_seed)++;
-    else {
+    if (my_seed == last_seed) {
+      /* claim the next chunk of seeds */
+      gt_mutex_lock(rmutex);
+      my_seed = *cur_seed;
+      last_seed = MIN(my_seed + GT_LTRHARVEST_SEED_CHUNK_SIZE,
+                      lo->repeatinfo.repeats.nextfreeRepeat);
+      *cur_seed = last_seed;
       gt_mutex_unlock(rmutex);
-      break;
+      if (my_seed == last_seed)
+        break;
     }
-    gt_mutex_unlock(rmutex);
-    repeatptr = &(lo->repeatinfo.repeats.spaceRepeat[my_seed]);
+    repeatptr = &(lo->repeatinfo.repeats.spaceRepeat[my_seed++]);
 
     /* check whether max LTR length is exceeded by seed alone */
     if (lo->repeatinfo.lmax < repeatptr->len)
@@ -1044,6 +1065,7 @@ static int gt_searchforLTRs(GtLTRharvestStream *lo,
     boundaries.motif_far_tsd = false;
     boundaries.skipped = false;
     boundaries.similarity = 0.0;
+    boundaries.seednum = my_seed - 1;
 
     /* store new boundaries-positions in boundaries */
     adjustboundariesfromXdropextension(
@@ -1127,12 +1149,25 @@ static int gt_searchforLTRs(GtLTRharvestStream *lo,
     if (!gt_double_smaller_double(boundaries.similarity,
                                   lo->similaritythreshold))
     {
-      gt_mutex_lock(wmutex);
-      GT_GETNEXTFREEINARRAY(boundaries_ptr,arrayLTRboundaries,LTRboundaries,5);
+      GT_GETNEXTFREEINARRAY(boundaries_ptr,&localLTRboundaries,LTRboundaries,
+                            32);
       *boundaries_ptr = boundaries;
-      gt_mutex_unlock(wmutex);
     }
   }
+  if (localLTRboundaries.nextfreeLTRboundaries > 0)
+  {
+    gt_mutex_lock(wmutex);
+    GT_CHECKARRAYSPACEMULTI(arrayLTRboundaries,LTRboundaries,
+                            localLTRboundaries.nextfreeLTRboundaries);
+    memcpy(arrayLTRboundaries->spaceLTRboundaries +
+           arrayLTRboundaries->nextfreeLTRboundaries,
+           localLTRboundaries.spaceLTRboundaries,
+           sizeof (LTRboundaries) * localLTRboundaries.nextfreeLTRboundaries);
+    arrayLTRboundaries->nextfreeLTRboundaries +=
+      localLTRboundaries.nextfreeLTRboundaries;
+    gt_mutex_unlock(wmutex);
+  }
+  GT_FREEARRAY(&localLTRboundaries, LTRboundaries);
 #ifdef GT_GREEDY_BUFFER
   FREESPACE(useq);
   FREESPACE(vseq);
@@ -26,6 +26,7 @@
 #include "core/error.h"
 #include "core/fa.h"
 #include "core/format64.h"
+#include "core/ma.h"
 #include "core/mapspec.h"
 #include "core/mathsupport.h"
 #include "core/minmax.h"
@@ -472,27 +473,25 @@ GtBcktab *gt_bcktab_new(unsigned int numofchars,
     {
       allocsize_bounds = sizeof (*bcktab->leftborder.ulongbounds) *
                          (bcktab->numofallcodes+1);
-      bcktab->leftborder.ulongbounds = gt_malloc(allocsize_bounds);
-      memset(bcktab->leftborder.ulongbounds,0,allocsize_bounds);
+      bcktab->leftborder.ulongbounds = gt_calloc_large(1,allocsize_bounds);
       if (withspecialsuffixes)
       {
         allocsize_countspecialcodes = sizeof (*bcktab->ulongcountspecialcodes) *
                                       bcktab->numofspecialcodes;
-        bcktab->ulongcountspecialcodes = gt_malloc(allocsize_countspecialcodes);
-        memset(bcktab->ulongcountspecialcodes,0,allocsize_countspecialcodes);
+        bcktab->ulongcountspecialcodes
+          = gt_calloc_large(1,allocsize_countspecialcodes);
       }
     } else
     {
       allocsize_bounds = sizeof (*bcktab->leftborder.uintbounds) *
                          (bcktab->numofallcodes+1);
-      bcktab->leftborder.uintbounds = gt_malloc(allocsize_bounds);
-      memset(bcktab->leftborder.uintbounds,0,allocsize_bounds);
+      bcktab->leftborder.uintbounds = gt_calloc_large(1,allocsize_bounds);
       if (withspecialsuffixes)
       {
         allocsize_countspecialcodes = sizeof (*bcktab->uintcountspecialcodes) *
                                       bcktab->numofspecialcodes;
-        bcktab->uintcountspecialcodes = gt_malloc(allocsize_countspecialcodes);
-        memset(bcktab->uintcountspecialcodes,0,allocsize_countspecialcodes);
+        bcktab->uintcountspecialcodes
+          = gt_calloc_large(1,allocsize_countspecialcodes);
       }
     }
     gt_logger_log(logger,"sizeof (leftborder)="GT_WU" bytes",
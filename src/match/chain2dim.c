@@ -18,13 +18,14 @@
 #include <stdbool.h>
 #include <string.h>
 #include "core/error_api.h"
+#include "core/divmodmul.h"
 #include "core/minmax.h"
 #include "core/mathsupport.h" /* for gt_double_equals_double */
 #include "core/unused_api.h"
 #include "core/ma.h"
 #include "core/arraydef.h"
 #include "core/logger.h"
-#include "extended/rbtree.h"
+#include "core/radix_sort.h"
 #include "extended/ranked_list.h"
 #include "chain2dim.h"
 #include "prsqualint.h"
@@ -221,9 +222,6 @@ void gt_chain_applyweight(double weightfactor,
   }
 }
 
-#define MAKEENDPOINT(FID)       (FID)
-#define FRAGIDENT(FRAG)         ((FRAG)->fpident)
-
 #define GT_CHAIN2DIM_UNDEFPREVIOUS           matchtable->nextfree
 
 #define GT_CHAIN2DIM_GETSTOREDSTARTPOINT(DIM,IDX)\
@@ -240,16 +238,29 @@ typedef GtChain2Dimscoretype (*GtChain2Dimgapcostfunction)(
                                                   GtUword,
                                                   GtUword);
 
+/*
+  The activated matches are stored in a Fenwick tree over the ranks of the
+  end positions in the dimension not used for presorting. Each node stores
+  the match of maximal priority in the range of ranks it covers. If
+  several matches have the same maximal priority, then the one activated
+  first is stored. This is the match delivered by the previously used
+  dictionary of non-dominated matches, so the chains are the same.
+*/
+
 typedef struct
 {
-  GtUword fpident;
-  GtChain2Dimpostype fpposition;
-} GtChain2DimMatchpoint;
+  GtChain2Dimscoretype priority;
+  GtUword fpident,
+          activationtime;
+} GtChain2DimRangemaxentry;
 
 typedef struct
 {
-  GtRBTree *dictroot;
-  GtUword *endpointperm;
+  GtChain2Dimpostype *sortedpositions;
+  GtChain2DimRangemaxentry *rangemax; /* entries 1..numofpositions */
+  GtUword numofpositions,
+          numofactivated,
+          *endpointperm;
 } GtChain2DimMatchstore;
 
 typedef struct
@@ -788,117 +799,139 @@ static void gt_chain2dim_ndbfchainscores(GtChain2Dimmatchtable *matchtable)
   }
 }
 
-/*
-  The following function compares match points. These are
-  end points of matches in dimension 2.
-  If the match points are identical, then the order is undefined.
-*/
-
-static int gt_chain2dim_cmpendMatchpoint2(const void* keya,
-                                          const void* keyb,
-                                          GT_UNUSED void *info)
+static GtChain2Dimscoretype gt_chain2dim_evalpriority(bool addterminal,
+                                     const GtChain2Dimmatchtable *matchtable,
+                                     GtUword matchnum)
 {
-  if (((GtChain2DimMatchpoint *) keya)->fpposition <
-      ((GtChain2DimMatchpoint *) keyb)->fpposition)
+  if (addterminal)
   {
-    return -1;
+    return matchtable->matches[matchnum].score
+             - GT_CHAIN2DIM_TERMINALGAP(matchnum);
   }
-  if (((GtChain2DimMatchpoint *) keya)->fpposition >
-      ((GtChain2DimMatchpoint *) keyb)->fpposition)
+  return matchtable->matches[matchnum].score;
+}
+
+#define GT_CHAIN2DIM_UNDEFIDENT GT_UWORD_MAX
+
+static void gt_chain2dim_matchstore_init(GtChain2DimMatchstore *matchstore,
+                                     const GtChain2Dimmatchtable *matchtable,
+                                     unsigned int postsortdim)
+{
+  GtUword idx, numofpositions;
+
+  matchstore->sortedpositions
+    = gt_malloc(sizeof (*matchstore->sortedpositions) * matchtable->nextfree);
+  for (idx = 0; idx < matchtable->nextfree; idx++)
   {
-    return 1;
+    matchstore->sortedpositions[idx]
+      = GT_CHAIN2DIM_GETSTOREDENDPOINT(postsortdim,idx);
   }
-  if (FRAGIDENT((GtChain2DimMatchpoint *) keya) <
-      FRAGIDENT((GtChain2DimMatchpoint *) keyb))
+  gt_radixsort_inplace_ulong(matchstore->sortedpositions,matchtable->nextfree);
+  for (idx = 1UL, numofpositions = 1UL; idx < matchtable->nextfree; idx++)
   {
-    return -1;
+    if (matchstore->sortedpositions[numofpositions-1] <
+        matchstore->sortedpositions[idx])
+    {
+      matchstore->sortedpositions[numofpositions++]
+        = matchstore->sortedpositions[idx];
+    }
   }
-  if (FRAGIDENT((GtChain2DimMatchpoint *) keya) >
-      FRAGIDENT((GtChain2DimMatchpoint *) keyb))
+  matchstore->numofpositions = numofpositions;
+  matchstore->rangemax = gt_malloc(sizeof (*matchstore->rangemax) *
+                                   (numofpositions + 1));
+  for (idx = 0; idx <= numofpositions; idx++)
   {
-    return 1;
+    matchstore->rangemax[idx].fpident = GT_CHAIN2DIM_UNDEFIDENT;
   }
-  return 0;
+  matchstore->numofactivated = 0;
 }
 
-static GtChain2Dimscoretype gt_chain2dim_evalpriority(bool addterminal,
-                                     const GtChain2Dimmatchtable *matchtable,
-                                     GtUword matchnum)
+static void gt_chain2dim_matchstore_delete(GtChain2DimMatchstore *matchstore)
 {
-  if (addterminal)
-  {
-    return matchtable->matches[matchnum].score
-             - GT_CHAIN2DIM_TERMINALGAP(matchnum);
-  }
-  return matchtable->matches[matchnum].score;
+  gt_free(matchstore->sortedpositions);
+  gt_free(matchstore->rangemax);
 }
 
-static void gt_chain2dim_insertintodict(bool addterminal,
-                                        const GtChain2Dimmatchtable *matchtable,
-                                        GtChain2DimMatchstore *matchstore,
-                                        GtChain2DimMatchpoint *qmatch2)
+/* Return the number of stored positions which are <= <position>. */
+
+static GtUword gt_chain2dim_positionrank(const GtChain2DimMatchstore
+                                                                    *matchstore,
+                                         GtChain2Dimpostype position)
 {
-  GtChain2DimMatchpoint *retval2;
-  bool nodecreated;
+  GtUword left = 0, right = matchstore->numofpositions;
 
-  retval2 = (GtChain2DimMatchpoint *) gt_rbtree_search(matchstore->dictroot,
-                                                       qmatch2,
-                                                       &nodecreated);
-  gt_assert(retval2 != NULL);
-  if (!nodecreated)
+  while (left < right)
   {
-    if (gt_chain2dim_evalpriority(addterminal,matchtable,FRAGIDENT(retval2)) <
-        gt_chain2dim_evalpriority(addterminal,matchtable,FRAGIDENT(qmatch2)))
+    GtUword mid = left + GT_DIV2(right - left);
+
+    if (matchstore->sortedpositions[mid] <= position)
     {
-      gt_assert(retval2->fpposition == qmatch2->fpposition);
-      retval2->fpident = qmatch2->fpident;
+      left = mid + 1;
+    } else
+    {
+      right = mid;
     }
   }
+  return left;
 }
 
 static void gt_chain2dim_activatematchpoint(bool addterminal,
                                const GtChain2Dimmatchtable *matchtable,
                                GtChain2DimMatchstore *matchstore,
-                               GtChain2DimMatchpoint *qmatch2)
-{
-  GtChain2DimMatchpoint *tmp2;
-  GtChain2Dimscoretype qpriority;
-
-  qpriority = gt_chain2dim_evalpriority(addterminal,matchtable,
-                                        FRAGIDENT(qmatch2));
-  tmp2 = (GtChain2DimMatchpoint *) gt_rbtree_previous_equal_key(
-                                     matchstore->dictroot,
-                                     qmatch2,
-                                     gt_chain2dim_cmpendMatchpoint2,
-                                     NULL);
-  if (tmp2 == NULL ||
-      qpriority > gt_chain2dim_evalpriority(addterminal,matchtable,
-                                            FRAGIDENT(tmp2)))
-  {
-    gt_chain2dim_insertintodict(addterminal,matchtable,matchstore,qmatch2);
-    while (true)
+                               GtUword fpident,
+                               unsigned int postsortdim)
+{
+  GtUword rank;
+  const GtChain2Dimscoretype priority
+    = gt_chain2dim_evalpriority(addterminal,matchtable,fpident);
+  const GtUword activationtime = matchstore->numofactivated++;
+
+  rank = gt_chain2dim_positionrank(matchstore,
+                                   GT_CHAIN2DIM_GETSTOREDENDPOINT(postsortdim,
+                                                                  fpident));
+  gt_assert(rank > 0 &&
+            matchstore->sortedpositions[rank-1] ==
+            GT_CHAIN2DIM_GETSTOREDENDPOINT(postsortdim,fpident));
+  for (/* Nothing */; rank <= matchstore->numofpositions;
+       rank += rank & -rank)
+  {
+    GtChain2DimRangemaxentry *entry = matchstore->rangemax + rank;
+
+    if (entry->fpident == GT_CHAIN2DIM_UNDEFIDENT ||
+        entry->priority < priority)
     {
-      tmp2 = (GtChain2DimMatchpoint *) gt_rbtree_next_key(
-                                               matchstore->dictroot,
-                                               qmatch2,
-                                               gt_chain2dim_cmpendMatchpoint2,
-                                               NULL);
-      if (tmp2 == NULL ||
-          qpriority <= gt_chain2dim_evalpriority(addterminal,matchtable,
-                                                 FRAGIDENT(tmp2)))
-      {
-        break;
-      }
-      if (gt_rbtree_erase(matchstore->dictroot, tmp2) != 0)
-      {
-        fprintf(stderr,"cannot delete successor node\n");
-        exit(GT_EXIT_PROGRAMMING_ERROR);
-      }
+      entry->priority = priority;
+      entry->fpident = fpident;
+      entry->activationtime = activationtime;
     }
-  } else
+  }
+}
+
+/* Return the match of maximal priority among the activated matches whose
+   end position is <= <position>, or GT_CHAIN2DIM_UNDEFIDENT if there is
+   no such match. */
+
+static GtUword gt_chain2dim_maxmatchpoint(const GtChain2DimMatchstore
+                                                                    *matchstore,
+                                          GtChain2Dimpostype position)
+{
+  const GtChain2DimRangemaxentry *best = NULL;
+  GtUword rank;
+
+  for (rank = gt_chain2dim_positionrank(matchstore,position); rank > 0;
+       rank -= rank & -rank)
   {
-    gt_free(qmatch2);
+    const GtChain2DimRangemaxentry *entry = matchstore->rangemax + rank;
+
+    if (entry->fpident != GT_CHAIN2DIM_UNDEFIDENT &&
+        (best == NULL || best->priority < entry->priority ||
+         (best->priority == entry->priority &&
+          best->activationtime > entry->activationtime)))
+    {
+      best = entry;
+    }
   }
+  return best == NULL ? GT_CHAIN2DIM_UNDEFIDENT : best->fpident;
 }
 
 static void gt_chain2dim_evalmatchscore(const GtChain2Dimmode *chainmode,
@@ -908,40 +941,31 @@ static void gt_chain2dim_evalmatchscore(const GtChain2Dimmode *chainmode,
                                         GtUword matchpointident,
                                         unsigned int presortdim)
 {
-  GtUword previous;
+  GtUword previous, qmatch2;
   GtChain2Dimpostype startpos2;
-  GtChain2DimMatchpoint *qmatch2;
   GtChain2Dimscoretype score;
 
   startpos2 = GT_CHAIN2DIM_GETSTOREDSTARTPOINT(1-presortdim,matchpointident);
   if (startpos2 == 0)
   {
-    qmatch2 = NULL;
+    qmatch2 = GT_CHAIN2DIM_UNDEFIDENT;
   } else
   {
-    GtChain2DimMatchpoint keymatch2;
-
-    keymatch2.fpposition = startpos2 - 1;  /* it is a start position */
-    keymatch2.fpident = MAKEENDPOINT(matchpointident);
-                       /* but considered as endpoint */
-    qmatch2 = (GtChain2DimMatchpoint *) gt_rbtree_previous_equal_key(
-                                                 matchstore->dictroot,
-                                                 &keymatch2,
-                                                 gt_chain2dim_cmpendMatchpoint2,
-                                                 NULL);
-    if (qmatch2 != NULL)
+    qmatch2 = gt_chain2dim_maxmatchpoint(matchstore,startpos2 - 1);
+    if (qmatch2 != GT_CHAIN2DIM_UNDEFIDENT)
     {
+      gt_assert(qmatch2 < matchpointident);
       if (chainmode->maxgapwidth != 0 &&
           !gt_chain2dim_checkmaxgapwidth(matchtable,
                                          chainmode->maxgapwidth,
-                                         FRAGIDENT(qmatch2),
+                                         qmatch2,
                                          matchpointident))
       {
-        qmatch2 = NULL;
+        qmatch2 = GT_CHAIN2DIM_UNDEFIDENT;
       }
     }
   }
-  if (qmatch2 == NULL)
+  if (qmatch2 == GT_CHAIN2DIM_UNDEFIDENT)
   {
     score = matchtable->matches[matchpointident].weight;
     if (chainmode->chainkind == GLOBALCHAININGWITHGAPCOST)
@@ -951,26 +975,26 @@ static void gt_chain2dim_evalmatchscore(const GtChain2Dimmode *chainmode,
     previous = GT_CHAIN2DIM_UNDEFPREVIOUS;
   } else
   {
-    score = matchtable->matches[FRAGIDENT(qmatch2)].score;
+    score = matchtable->matches[qmatch2].score;
     if (chainmode->chainkind == GLOBALCHAINING)
     {
       score += matchtable->matches[matchpointident].weight;
-      previous = FRAGIDENT(qmatch2);
+      previous = qmatch2;
     } else
     {
       GtChain2Dimscoretype tmpgc;
 
       if (gapsL1)
       {
-        tmpgc = gapcostL1(matchtable,FRAGIDENT(qmatch2),matchpointident);
+        tmpgc = gapcostL1(matchtable,qmatch2,matchpointident);
       } else
       {
-        tmpgc = gapcostCc(matchtable,FRAGIDENT(qmatch2),matchpointident);
+        tmpgc = gapcostCc(matchtable,qmatch2,matchpointident);
       }
       if (chainmode->chainkind == GLOBALCHAININGWITHGAPCOST || score > tmpgc)
       {
         score += (matchtable->matches[matchpointident].weight - tmpgc);
-        previous = FRAGIDENT(qmatch2);
+        previous = qmatch2;
       } else
       {
         score = matchtable->matches[matchpointident].weight;
@@ -1221,20 +1245,6 @@ static int comparestartandend(const Matchchaininfo *sortedstartpoints,
   return -1;
 }
 
-static GtChain2DimMatchpoint *makeactivationpoint(
-                                       const GtChain2Dimmatchtable *matchtable,
-                                       GtUword fpident,
-                                       unsigned int postsortdim)
-{
-  GtChain2DimMatchpoint *fpptr;
-
-  fpptr = gt_malloc(sizeof (*fpptr));
-  gt_assert(fpptr != NULL);
-  fpptr->fpident = MAKEENDPOINT(fpident);
-  fpptr->fpposition = GT_CHAIN2DIM_GETSTOREDENDPOINT(postsortdim,fpident);
-  return fpptr;
-}
-
 static void mergestartandendpoints(const GtChain2Dimmode *chainmode,
                                    GtChain2Dimmatchtable *matchtable,
                                    GtChain2DimMatchstore *matchstore,
@@ -1245,8 +1255,6 @@ static void mergestartandendpoints(const GtChain2Dimmode *chainmode,
   const unsigned int postsortdim = 1U - presortdim;
   bool addterminal = (chainmode->chainkind == GLOBALCHAINING) ? false : true;
 
-  matchstore->dictroot = gt_rbtree_new(gt_chain2dim_cmpendMatchpoint2,
-                                       gt_free_func, NULL);
   for (xidx = 0, startcount = 0, endcount = 0;
        startcount < matchtable->nextfree &&
        endcount < matchtable->nextfree;
@@ -1267,10 +1275,8 @@ static void mergestartandendpoints(const GtChain2Dimmode *chainmode,
     } else
     {
       gt_chain2dim_activatematchpoint(addterminal,matchtable,matchstore,
-                        makeactivationpoint(matchtable,
-                                            matchstore->
-                                            endpointperm[endcount],
-                                            postsortdim));
+                                      matchstore->endpointperm[endcount],
+                                      postsortdim);
       endcount++;
     }
   }
@@ -1288,10 +1294,8 @@ static void mergestartandendpoints(const GtChain2Dimmode *chainmode,
   while (endcount < matchtable->nextfree)
   {
     gt_chain2dim_activatematchpoint(addterminal,matchtable,matchstore,
-                      makeactivationpoint(matchtable,
-                                          matchstore->
-                                          endpointperm[endcount],
-                                          postsortdim));
+                                    matchstore->endpointperm[endcount],
+                                    postsortdim);
     endcount++;
     xidx++;
   }
@@ -1309,7 +1313,6 @@ static unsigned int gt_chain2dim_findmaximalscores(
 {
   GtUword matchnum;
   GtChain2Dimscoretype minscore = 0;
-  GtChain2DimMatchpoint *maxpoint;
   GtChain2DimBestofclass *chainequivalenceclasses;
   unsigned int retval;
   bool minscoredefined = false;
@@ -1326,9 +1329,10 @@ static unsigned int gt_chain2dim_findmaximalscores(
   switch (chainmode->chainkind)
   {
     case GLOBALCHAINING:
-      maxpoint = gt_rbtree_maximum_key(matchstore->dictroot);
-      gt_assert(maxpoint != NULL);
-      matchnum = FRAGIDENT(maxpoint);
+      matchnum = gt_chain2dim_maxmatchpoint(matchstore,
+                                   matchstore->sortedpositions[
+                                   matchstore->numofpositions - 1]);
+      gt_assert(matchnum != GT_CHAIN2DIM_UNDEFIDENT);
       minscore = matchtable->matches[matchnum].score;
       minscoredefined = true;
       break;
@@ -1391,31 +1395,30 @@ static unsigned int gt_chain2dim_findmaximalscores(
   return retval;
 }
 
+/* The end points are sorted by the radix sort for pairs of keys, with the
+   match number as second key. So matches with identical end points are
+   activated in the order of their match numbers. */
+
 static void makesortedendpointpermutation(GtUword *perm,
                                           GtChain2Dimmatchtable *matchtable,
                                           unsigned int presortdim)
 {
-  GtUword temp, *iptr, *jptr, i, moves = 0;
+  GtUword idx;
+  Gtuint64keyPair *keypairs = gt_malloc(sizeof (*keypairs) *
+                                        matchtable->nextfree);
 
-  for (i = 0; i < matchtable->nextfree; i++)
+  for (idx = 0; idx < matchtable->nextfree; idx++)
   {
-    perm[i] = i;
+    keypairs[idx].uint64_a
+      = (uint64_t) GT_CHAIN2DIM_GETSTOREDENDPOINT(presortdim,idx);
+    keypairs[idx].uint64_b = (uint64_t) idx;
   }
-  for (iptr = perm + 1UL; iptr < perm + matchtable->nextfree; iptr++)
+  gt_radixsort_inplace_Gtuint64keyPair(keypairs,matchtable->nextfree);
+  for (idx = 0; idx < matchtable->nextfree; idx++)
   {
-    for (jptr = iptr; jptr > perm; jptr--)
-    {
-      if (GT_CHAIN2DIM_GETSTOREDENDPOINT(presortdim,*(jptr-1)) <=
-          GT_CHAIN2DIM_GETSTOREDENDPOINT(presortdim,*jptr))
-      {
-        break;
-      }
-      temp = *(jptr-1);
-      *(jptr-1) = *jptr;
-      *jptr = temp;
-      moves++;
-    }
+    perm[idx] = (GtUword) keypairs[idx].uint64_b;
   }
+  gt_free(keypairs);
 }
 
 static void fastchainingscores(const GtChain2Dimmode *chainmode,
@@ -1424,6 +1427,7 @@ static void fastchainingscores(const GtChain2Dimmode *chainmode,
                                unsigned int presortdim,
                                bool gapsL1)
 {
+  gt_chain2dim_matchstore_init(matchstore,matchtable,1U - presortdim);
   matchstore->endpointperm
     = gt_malloc(sizeof (*matchstore->endpointperm) *
                 matchtable->nextfree);
@@ -1497,7 +1501,8 @@ void gt_chain_fastchaining(const GtChain2Dimmode *chainmode,
     GtChain2DimMatchstore matchstore;
 
     gt_logger_log(logger,"compute chain scores");
-    matchstore.dictroot = NULL;
+    matchstore.sortedpositions = NULL;
+    matchstore.rangemax = NULL;
     if (chainmode->chainkind == GLOBALCHAININGWITHOVERLAPS)
     {
       gt_chain2dim_bruteforcechainingscores(chainmode,matchtable,
@@ -1528,7 +1533,7 @@ void gt_chain_fastchaining(const GtChain2Dimmode *chainmode,
     if (chainmode->chainkind != GLOBALCHAININGWITHOVERLAPS
         && chainmode->chainkind != GLOBALCHAININGALLCHAINS)
     {
-      gt_rbtree_delete(matchstore.dictroot);
+      gt_chain2dim_matchstore_delete(&matchstore);
     }
   } else
   {
@@ -1597,9 +1602,29 @@ void gt_chain_possiblysortmatches(GtLogger *logger,
     }
     if (!matchesaresorted)
     {
+      GtUword idx;
+      Gtuint64keyPair *keypairs;
+      Matchchaininfo *sortedmatches;
+
       gt_logger_log(logger,"input matches are not yet sorted => sort them");
-      qsort(matchtable->matches,(size_t) matchtable->nextfree,
-            sizeof (*matchtable->matches),qsortcomparefunction);
+      /* stable sort: the match number is the second key */
+      keypairs = gt_malloc(sizeof (*keypairs) * matchtable->nextfree);
+      for (idx = 0; idx < matchtable->nextfree; idx++)
+      {
+        keypairs[idx].uint64_a
+          = (uint64_t) matchtable->matches[idx].startpos[presortdim];
+        keypairs[idx].uint64_b = (uint64_t) idx;
+      }
+      gt_radixsort_inplace_Gtuint64keyPair(keypairs,matchtable->nextfree);
+      sortedmatches = gt_malloc(sizeof (*sortedmatches) *
+                                matchtable->allocated);
+      for (idx = 0; idx < matchtable->nextfree; idx++)
+      {
+        sortedmatches[idx] = matchtable->matches[keypairs[idx].uint64_b];
+      }
+      gt_free(keypairs);
+      gt_free(matchtable->matches);
+      matchtable->matches = sortedmatches;
     } else
     {
       gt_logger_log(logger,"matches are already sorted w.r.t. dimension %u",
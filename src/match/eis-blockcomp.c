@@ -2378,6 +2378,12 @@ tryMMapOfIndex(struct onDiskBlockCompIdx *idxData)
   return (idxData->idxMMap != NULL ? 0 : 1);
 }
 
+bool
+gt_EISIsMemoryMapped(const EISeq *seqIdx)
+{
+  return seqIdxUsesMMap(constEncIdxSeq2blockCompositionSeq(seqIdx));
+}
+
 static FILE *
 seekToHeader(const struct encIdxSeq *seqIdx, uint16_t headerID,
              uint32_t *lenRet)
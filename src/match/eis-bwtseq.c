@@ -145,6 +145,29 @@ gt_deleteBWTSeq(BWTSeq *bwtSeq)
   gt_free(bwtSeq);
 }
 
+BWTSeq *
+gt_newBWTSeqView(const BWTSeq *bwtSeq)
+{
+  BWTSeq *view;
+
+  gt_assert(bwtSeq);
+  if (!gt_EISIsMemoryMapped(bwtSeq->seqIdx))
+  {
+    return NULL;
+  }
+  view = gt_malloc(sizeof (*view));
+  *view = *bwtSeq;
+  view->hint = newEISHint(bwtSeq->seqIdx);
+  return view;
+}
+
+void
+gt_deleteBWTSeqView(BWTSeq *view)
+{
+  deleteEISHint(view->seqIdx, view->hint);
+  gt_free(view);
+}
+
 typedef struct
 {
   const Mbtab **mbtab;
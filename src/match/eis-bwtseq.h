@@ -106,6 +106,24 @@ gt_loadBWTSeq(const char *projectName, int BWTOptFlags, GtLogger *verbosity,
 void
 gt_deleteBWTSeq(BWTSeq *bwtseq);
 
+/**
+ * \brief Create a view of a BWT sequence object, which shares all
+ * index data with <bwtseq> but uses its own hint structure. Hence
+ * rank queries on different views can be run in different threads.
+ * @param bwtseq reference of object to create view for
+ * @return reference to new view or NULL if the underlying index is
+ * not memory mapped and thus cannot be shared
+ */
+BWTSeq *
+gt_newBWTSeqView(const BWTSeq *bwtseq);
+
+/**
+ * \brief Deallocate a view created by gt_newBWTSeqView.
+ * @param view reference of view to delete
+ */
+void
+gt_deleteBWTSeqView(BWTSeq *view);
+
 /**
  * \brief Query BWT sequence object for availability of added
  * information to locate matches.
@@ -430,6 +430,17 @@ static inline FILE *
 EISSeekToHeader(const EISeq *seqIdx, uint16_t headerID,
                 uint32_t *lenRet);
 
+/**
+ * @brief Query whether the constant and variable width data of the
+ * index is mapped into memory. Only then can rank queries with
+ * separate hints be issued concurrently, because otherwise every
+ * query reads through the shared index file pointer.
+ * @param seqIdx sequence index to query
+ * @return true if the index is memory mapped
+ */
+bool
+gt_EISIsMemoryMapped(const EISeq *seqIdx);
+
 /**
  * Given a position write debugging output for surrounding sequence.
  * @param seqIdx sequence index to query
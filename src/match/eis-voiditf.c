@@ -413,6 +413,16 @@ void gt_deletevoidBWTSeq(FMindex *fmindex)
   gt_deleteBWTSeq(bwtseq);
 }
 
+void *gt_newvoidBWTSeqview(const void *packedindex)
+{
+  return (void *) gt_newBWTSeqView((const BWTSeq *) packedindex);
+}
+
+void gt_deletevoidBWTSeqview(void *view)
+{
+  gt_deleteBWTSeqView((BWTSeq *) view);
+}
+
 GtUword gt_voidpackedindexuniqueforward(const void *fmindex,
                                               GT_UNUSED GtUword offset,
                                               GT_UNUSED GtUword left,
@@ -83,6 +83,13 @@ FMindex *gt_loadvoidBWTSeqForSA(const char *indexname,
 
 void gt_deletevoidBWTSeq(FMindex *packedindex);
 
+/* Return a view of <packedindex> which can be queried independently of
+   other views of the same index, for example in a different thread.
+   Returns NULL, if the index does not support this. */
+void *gt_newvoidBWTSeqview(const void *packedindex);
+
+void gt_deletevoidBWTSeqview(void *view);
+
 /* the parameter is const void *, as this is required by the other
    indexed based methods */
 
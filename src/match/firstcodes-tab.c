@@ -39,8 +39,8 @@ static void gt_firstcodes_countocc_new(GtFirstcodesspacelog *fcsl,
 {
   if (bitsforcount < (unsigned int) (sizeof (GtCountAFCtype) * CHAR_BIT))
   {
-    fct->countocc_small = gt_malloc((size_t) (numofsequences+1) *
-                                    sizeof (*fct->countocc_small));
+    fct->countocc_small = gt_malloc_large((size_t) (numofsequences+1) *
+                                          sizeof (*fct->countocc_small));
     GT_FCI_ADDWORKSPACE(fcsl,"countocc_small",
                         sizeof (*fct->countocc_small) *
                         (numofsequences+1));
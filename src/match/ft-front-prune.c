@@ -184,6 +184,103 @@ static GtUchar sequenceobject_get_char(Sequenceobject *seq,GtUword pos)
                                     GT_READMODE_FORWARD);
 }
 
+/* The following two functions extract <GT_UNITSIN2BITENC> consecutive
+   characters from the twobit encoding. In forward direction the word begins
+   at <pos> and <pos> occupies the most significant two bits, in reverse
+   direction the word ends at <pos> and <pos> occupies the least significant
+   two bits. So in both cases the characters are compared in the order they
+   are read by comparing the words from the left or from the right,
+   respectively. */
+
+static GtTwobitencoding gt_twobitencoding_fwd_word(
+                                      const GtTwobitencoding *twobitencoding,
+                                      GtUword pos)
+{
+  const GtUword unit = GT_DIVBYUNITSIN2BITENC(pos);
+  const unsigned int shift = GT_MULT2(GT_MODBYUNITSIN2BITENC(pos));
+
+  if (shift == 0)
+  {
+    return twobitencoding[unit];
+  }
+  return (twobitencoding[unit] << shift) |
+         (twobitencoding[unit+1] >> (GT_INTWORDSIZE - shift));
+}
+
+static GtTwobitencoding gt_twobitencoding_rev_word(
+                                      const GtTwobitencoding *twobitencoding,
+                                      GtUword pos)
+{
+  const GtUword unit = GT_DIVBYUNITSIN2BITENC(pos + 1);
+  const unsigned int shift = GT_MULT2(GT_MODBYUNITSIN2BITENC(pos + 1));
+
+  gt_assert(pos + 1 >= (GtUword) GT_UNITSIN2BITENC);
+  if (shift == 0)
+  {
+    return twobitencoding[unit-1];
+  }
+  return (twobitencoding[unit-1] << shift) |
+         (twobitencoding[unit] >> (GT_INTWORDSIZE - shift));
+}
+
+/* longest common extension of the two sequences beginning at the relative
+   positions <upos> and <vpos>, computed by comparing <GT_UNITSIN2BITENC>
+   characters at once. Both sequences must be accessed via the twobit
+   encoding, which implies that they do not contain wildcards. */
+
+static GtUword sequenceobject_twobit_lce(const Sequenceobject *useq,
+                                         GtUword upos,
+                                         const Sequenceobject *vseq,
+                                         GtUword vpos)
+{
+  GtUword lce = 0;
+
+  gt_assert(useq->twobitencoding != NULL && vseq->twobitencoding != NULL &&
+            useq->forward == vseq->forward);
+  while (upos + lce + GT_UNITSIN2BITENC <= useq->substringlength &&
+         vpos + lce + GT_UNITSIN2BITENC <= vseq->substringlength)
+  {
+    GtTwobitencoding uword, vword;
+
+    if (useq->forward)
+    {
+      uword = gt_twobitencoding_fwd_word(useq->twobitencoding,
+                                         useq->startpos + upos + lce);
+      vword = gt_twobitencoding_fwd_word(vseq->twobitencoding,
+                                         vseq->startpos + vpos + lce);
+      if (uword != vword)
+      {
+        return lce + gt_encseq_lcpofdifferenttwobitencodings(uword,vword);
+      }
+    } else
+    {
+      uword = gt_twobitencoding_rev_word(useq->twobitencoding,
+                                         useq->startpos - upos - lce);
+      vword = gt_twobitencoding_rev_word(vseq->twobitencoding,
+                                         vseq->startpos - vpos - lce);
+      if (uword != vword)
+      {
+        return lce + gt_encseq_lcsofdifferenttwobitencodings(uword,vword);
+      }
+    }
+    lce += GT_UNITSIN2BITENC;
+  }
+  while (upos + lce < useq->substringlength &&
+         vpos + lce < vseq->substringlength &&
+         gt_twobitencoding_char_at_pos(useq->twobitencoding,
+                                       useq->forward
+                                         ? useq->startpos + upos + lce
+                                         : useq->startpos - upos - lce) ==
+         gt_twobitencoding_char_at_pos(vseq->twobitencoding,
+                                       vseq->forward
+                                         ? vseq->startpos + vpos + lce
+                                         : vseq->startpos - vpos - lce))
+  {
+    lce++;
+  }
+  return lce;
+}
+
 #else
 typedef struct
 {
@@ -230,6 +327,39 @@ static void inline add_matches(Frontvalue *midfront,
 {
   GtUword upos, vpos;
 
+#ifndef OUTSIDE_OF_GT
+  if (useq->twobitencoding != NULL && vseq->twobitencoding != NULL)
+  {
+    GtUword lce;
+
+    upos = fv->row;
+    vpos = fv->row + FRONT_DIAGONAL(fv);
+    lce = (upos < useq->substringlength && vpos < vseq->substringlength)
+            ? sequenceobject_twobit_lce(useq,upos,vseq,vpos)
+            : 0;
+    if (lce > 0)
+    {
+      /* same effect on the match history as shifting in <lce> ones one
+         after the other: each unset bit leaving the window of size
+         <history> increments the count. */
+      const uint64_t leaving
+        = (lce >= (GtUword) 64 || (mask >> (lce - 1)) == 0)
+            ? (mask << 1) - 1
+            : (mask << 1) - (mask >> (lce - 1));
+
+      fv->matchhistory_count
+        += (Matchcounttype) __builtin_popcountll(~fv->matchhistory & leaving);
+      gt_assert(fv->matchhistory_count <= INT8_MAX);
+      fv->matchhistory = lce >= (GtUword) 64
+                           ? ~((uint64_t) 0)
+                           : (fv->matchhistory << lce) |
+                             ((((uint64_t) 1) << lce) - 1);
+    }
+    fv->localmatch_count = lce;
+    fv->row += lce;
+    return;
+  }
+#endif
   fv->localmatch_count = 0;
   for (upos = fv->row, vpos = fv->row + FRONT_DIAGONAL(fv);
        upos < useq->substringlength && vpos < vseq->substringlength &&
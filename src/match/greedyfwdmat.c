@@ -27,6 +27,9 @@
 #include "core/encseq.h"
 #include "core/format64.h"
 #include "core/ma_api.h"
+#include "core/str_array.h"
+#include "core/thread_api.h"
+#include "core/xansi_api.h"
 #include "optionargmode.h"
 #include "greedyfwdmat.h"
 #include "initbasepower.h"
@@ -38,6 +41,9 @@ typedef struct
        showsubjectpos;
   Definedunsignedlong minlength,
                       maxlength;
+  GtStr *outbuf;
+  char *decodebuf;
+  GtUword decodebufsize;
 } Rangespecinfo;
 
 typedef void (*Preprocessgmatchlength)(uint64_t,
@@ -167,14 +173,19 @@ static void gmatchposinsinglesequence(Substringinfo *substringinfo,
 
 static void showunitnum(uint64_t unitnum,
                         const char *desc,
-                        GT_UNUSED void *info)
+                        void *info)
 {
-  printf("unit " Formatuint64_t, PRINTuint64_tcast(unitnum));
+  Rangespecinfo *rangespecinfo = (Rangespecinfo *) info;
+
+  gt_str_append_cstr(rangespecinfo->outbuf,"unit ");
+  gt_str_append_uword(rangespecinfo->outbuf,(GtUword) unitnum);
   if (desc != NULL && desc[0] != '\0')
   {
-    printf(" (%s)",desc);
+    gt_str_append_cstr(rangespecinfo->outbuf," (");
+    gt_str_append_cstr(rangespecinfo->outbuf,desc);
+    gt_str_append_char(rangespecinfo->outbuf,')');
   }
-  printf("\n");
+  gt_str_append_char(rangespecinfo->outbuf,'\n');
 }
 
 static void showifinlengthrange(const GtAlphabet *alphabet,
@@ -193,27 +204,314 @@ static void showifinlengthrange(const GtAlphabet *alphabet,
   {
     if (rangespecinfo->showquerypos)
     {
-      printf(""GT_WU" ",querystart);
+      gt_str_append_uword(rangespecinfo->outbuf,querystart);
+      gt_str_append_char(rangespecinfo->outbuf,' ');
     }
-    printf(""GT_WU"",gmatchlength);
+    gt_str_append_uword(rangespecinfo->outbuf,gmatchlength);
     if (rangespecinfo->showsubjectpos)
     {
-      printf(" "GT_WU"",subjectpos);
+      gt_str_append_char(rangespecinfo->outbuf,' ');
+      gt_str_append_uword(rangespecinfo->outbuf,subjectpos);
     }
     if (rangespecinfo->showsequence)
     {
-      (void) putchar(' ');
-      gt_alphabet_decode_seq_to_fp(alphabet,stdout,start + querystart,
-                                   gmatchlength);
+      if (gmatchlength >= rangespecinfo->decodebufsize)
+      {
+        rangespecinfo->decodebufsize = gmatchlength + 1;
+        rangespecinfo->decodebuf
+          = gt_realloc(rangespecinfo->decodebuf,
+                       sizeof (*rangespecinfo->decodebuf) *
+                       rangespecinfo->decodebufsize);
+      }
+      gt_alphabet_decode_seq_to_cstr(alphabet,rangespecinfo->decodebuf,
+                                     start + querystart,gmatchlength);
+      gt_str_append_char(rangespecinfo->outbuf,' ');
+      gt_str_append_cstr_nt(rangespecinfo->outbuf,rangespecinfo->decodebuf,
+                            gmatchlength);
+    }
+    gt_str_append_char(rangespecinfo->outbuf,'\n');
+  }
+}
+
+static void gt_gfm_flushoutbuf(GtStr *outbuf)
+{
+  gt_xfwrite(gt_str_get(outbuf),sizeof (char),
+             (size_t) gt_str_length(outbuf),stdout);
+  gt_str_reset(outbuf);
+}
+
+/* The queries are read in blocks of at most the following number of
+   sequences or symbols. The queries of a block are distributed over the
+   threads one by one and the output of each query is collected in a
+   buffer of its own, so that the output is shown in the order of the
+   input, independent of the number of threads. */
+
+#define GFM_QUERYBLOCK_MAXQUERIES 4096UL
+#define GFM_QUERYBLOCK_MAXSYMBOLS (1UL << 22)
+
+typedef struct
+{
+  GtUchar *seqspace;
+  GtUword seqspaceallocated,
+          *seqoffset,
+          numofqueries,
+          nextquery;
+  uint64_t firstunitnum;
+  GtStrArray *descriptions;
+  GtStr **outbufs;
+  GtMutex *mutex;
+} Gfmqueryblock;
+
+static void gt_gfm_queryblock_init(Gfmqueryblock *queryblock)
+{
+  GtUword idx;
+
+  queryblock->seqspace = NULL;
+  queryblock->seqspaceallocated = 0;
+  queryblock->seqoffset = gt_malloc(sizeof (*queryblock->seqoffset) *
+                                    (GFM_QUERYBLOCK_MAXQUERIES + 1));
+  queryblock->seqoffset[0] = 0;
+  queryblock->numofqueries = 0;
+  queryblock->nextquery = 0;
+  queryblock->firstunitnum = 0;
+  queryblock->descriptions = gt_str_array_new();
+  queryblock->outbufs = gt_malloc(sizeof (*queryblock->outbufs) *
+                                  GFM_QUERYBLOCK_MAXQUERIES);
+  for (idx = 0; idx < GFM_QUERYBLOCK_MAXQUERIES; idx++)
+  {
+    queryblock->outbufs[idx] = gt_str_new();
+  }
+  queryblock->mutex = gt_mutex_new();
+}
+
+static void gt_gfm_queryblock_wrap(Gfmqueryblock *queryblock)
+{
+  GtUword idx;
+
+  gt_free(queryblock->seqspace);
+  gt_free(queryblock->seqoffset);
+  gt_str_array_delete(queryblock->descriptions);
+  for (idx = 0; idx < GFM_QUERYBLOCK_MAXQUERIES; idx++)
+  {
+    gt_str_delete(queryblock->outbufs[idx]);
+  }
+  gt_free(queryblock->outbufs);
+  gt_mutex_delete(queryblock->mutex);
+}
+
+static bool gt_gfm_queryblock_isfull(const Gfmqueryblock *queryblock)
+{
+  return queryblock->numofqueries == GFM_QUERYBLOCK_MAXQUERIES ||
+         queryblock->seqoffset[queryblock->numofqueries] >=
+         GFM_QUERYBLOCK_MAXSYMBOLS;
+}
+
+static void gt_gfm_queryblock_add(Gfmqueryblock *queryblock,
+                                  const GtUchar *query,
+                                  GtUword querylen,
+                                  const char *desc)
+{
+  GtUword seqspaceused = queryblock->seqoffset[queryblock->numofqueries];
+
+  gt_assert(queryblock->numofqueries < GFM_QUERYBLOCK_MAXQUERIES);
+  if (seqspaceused + querylen > queryblock->seqspaceallocated)
+  {
+    queryblock->seqspaceallocated = seqspaceused + querylen +
+                                    queryblock->seqspaceallocated / 5;
+    queryblock->seqspace = gt_realloc(queryblock->seqspace,
+                                      sizeof (*queryblock->seqspace) *
+                                      queryblock->seqspaceallocated);
+  }
+  memcpy(queryblock->seqspace + seqspaceused,query,
+         sizeof (*query) * querylen);
+  gt_str_array_add_cstr(queryblock->descriptions,desc == NULL ? "" : desc);
+  queryblock->seqoffset[++queryblock->numofqueries] = seqspaceused + querylen;
+}
+
+static void gt_gfm_queryblock_output(Gfmqueryblock *queryblock)
+{
+  GtUword idx;
+
+  for (idx = 0; idx < queryblock->numofqueries; idx++)
+  {
+    gt_gfm_flushoutbuf(queryblock->outbufs[idx]);
+  }
+  queryblock->firstunitnum += queryblock->numofqueries;
+  queryblock->numofqueries = 0;
+  queryblock->nextquery = 0;
+  gt_str_array_reset(queryblock->descriptions);
+}
+
+typedef struct
+{
+  Substringinfo substringinfo;
+  Rangespecinfo rangespecinfo;
+  Gfmqueryblock *queryblock;
+#ifdef GT_THREADS_ENABLED
+  GtThread *thread;
+#endif
+} Gfmthreadinfo;
+
+static void *gt_gfm_processqueryblock(void *data)
+{
+  Gfmthreadinfo *threadinfo = (Gfmthreadinfo *) data;
+  Gfmqueryblock *queryblock = threadinfo->queryblock;
+  GtUword idx;
+
+  while (true)
+  {
+    gt_mutex_lock(queryblock->mutex);
+    if (queryblock->nextquery == queryblock->numofqueries)
+    {
+      gt_mutex_unlock(queryblock->mutex);
+      break;
+    }
+    idx = queryblock->nextquery++;
+    gt_mutex_unlock(queryblock->mutex);
+    threadinfo->rangespecinfo.outbuf = queryblock->outbufs[idx];
+    gmatchposinsinglesequence(&threadinfo->substringinfo,
+                              queryblock->firstunitnum + idx,
+                              queryblock->seqspace + queryblock->seqoffset[idx],
+                              queryblock->seqoffset[idx+1] -
+                              queryblock->seqoffset[idx],
+                              gt_str_array_get(queryblock->descriptions,idx));
+  }
+  return NULL;
+}
+
+static int gt_gfm_runthreads(Gfmthreadinfo *threadinfo,
+                             unsigned int threads,
+                             GtError *err)
+{
+#ifdef GT_THREADS_ENABLED
+  unsigned int t;
+  bool haserr = false;
+
+  for (t = 1U; t < threads; t++)
+  {
+    threadinfo[t].thread = gt_thread_new(gt_gfm_processqueryblock,
+                                         threadinfo + t,err);
+    if (threadinfo[t].thread == NULL)
+    {
+      haserr = true;
+      break;
+    }
+  }
+  (void) gt_gfm_processqueryblock(threadinfo);
+  threads = t;
+  for (t = 1U; t < threads; t++)
+  {
+    gt_thread_join(threadinfo[t].thread);
+    gt_thread_delete(threadinfo[t].thread);
+  }
+  return haserr ? -1 : 0;
+#else
+  gt_assert(threads == 1U);
+  (void) gt_gfm_processqueryblock(threadinfo);
+  return 0;
+#endif
+}
+
+static int gt_findsubquerygmatchforward_threaded(
+                                        const Substringinfo *substringinfo,
+                                        const Rangespecinfo *rangespecinfo,
+                                        GtSeqIterator *seqit,
+                                        Greedygmatchforwardnewview newview,
+                                        Greedygmatchforwarddeleteview
+                                          deleteview,
+                                        unsigned int threads,
+                                        GtError *err)
+{
+  Gfmthreadinfo *threadinfo;
+  Gfmqueryblock queryblock;
+  const GtUchar *query;
+  GtUword querylen;
+  char *desc = NULL;
+  unsigned int t;
+  int retval;
+  bool haserr = false;
+
+  threadinfo = gt_malloc(sizeof (*threadinfo) * threads);
+  gt_gfm_queryblock_init(&queryblock);
+  for (t = 0; t < threads; t++)
+  {
+    threadinfo[t].substringinfo = *substringinfo;
+    threadinfo[t].rangespecinfo = *rangespecinfo;
+    threadinfo[t].substringinfo.processinfo = &threadinfo[t].rangespecinfo;
+    threadinfo[t].queryblock = &queryblock;
+    if (newview != NULL)
+    {
+      threadinfo[t].substringinfo.genericindex
+        = newview(substringinfo->genericindex);
+      gt_assert(threadinfo[t].substringinfo.genericindex != NULL);
+    }
+  }
+  do
+  {
+    retval = gt_seq_iterator_next(seqit,
+                                  &query,
+                                  &querylen,
+                                  &desc,
+                                  err);
+    if (retval < 0)
+    {
+      haserr = true;
+      break;
+    }
+    if (retval > 0)
+    {
+      gt_gfm_queryblock_add(&queryblock,query,querylen,desc);
     }
-    (void) putchar('\n');
+    if (queryblock.numofqueries > 0 &&
+        (retval == 0 || gt_gfm_queryblock_isfull(&queryblock)))
+    {
+      if (gt_gfm_runthreads(threadinfo,threads,err) != 0)
+      {
+        haserr = true;
+        break;
+      }
+      gt_gfm_queryblock_output(&queryblock);
+    }
+  } while (retval > 0);
+  for (t = 0; t < threads; t++)
+  {
+    if (deleteview != NULL)
+    {
+      deleteview((void *) threadinfo[t].substringinfo.genericindex);
+    }
+    gt_free(threadinfo[t].rangespecinfo.decodebuf);
+  }
+  gt_gfm_queryblock_wrap(&queryblock);
+  gt_free(threadinfo);
+  return haserr ? -1 : 0;
+}
+
+static bool gt_gfm_viewssupported(const void *genericindex,
+                                  Greedygmatchforwardnewview newview,
+                                  Greedygmatchforwarddeleteview deleteview)
+{
+  void *view;
+
+  if (newview == NULL)
+  {
+    return true;
   }
+  gt_assert(deleteview != NULL);
+  view = newview(genericindex);
+  if (view == NULL)
+  {
+    return false;
+  }
+  deleteview(view);
+  return true;
 }
 
 int gt_findsubquerygmatchforward(const GtEncseq *encseq,
                               const void *genericindex,
                               GtUword totallength,
                               Greedygmatchforwardfunction gmatchforward,
+                              Greedygmatchforwardnewview newview,
+                              Greedygmatchforwarddeleteview deleteview,
                               const GtAlphabet *alphabet,
                               const GtStrArray *queryfilenames,
                               Definedunsignedlong minlength,
@@ -221,6 +519,7 @@ int gt_findsubquerygmatchforward(const GtEncseq *encseq,
                               bool showsequence,
                               bool showquerypos,
                               bool showsubjectpos,
+                              unsigned int threads,
                               GtError *err)
 {
   Substringinfo substringinfo;
@@ -241,6 +540,9 @@ int gt_findsubquerygmatchforward(const GtEncseq *encseq,
   rangespecinfo.showsequence = showsequence;
   rangespecinfo.showquerypos = showquerypos;
   rangespecinfo.showsubjectpos = showsubjectpos;
+  rangespecinfo.outbuf = NULL;
+  rangespecinfo.decodebuf = NULL;
+  rangespecinfo.decodebufsize = 0;
   substringinfo.preprocessgmatchlength = showunitnum;
   substringinfo.processgmatchlength = showifinlengthrange;
   substringinfo.postprocessgmatchlength = NULL;
@@ -248,33 +550,57 @@ int gt_findsubquerygmatchforward(const GtEncseq *encseq,
   substringinfo.processinfo = &rangespecinfo;
   substringinfo.gmatchforward = gmatchforward;
   substringinfo.encseq = encseq;
+  if (threads > 1U &&
+      !gt_gfm_viewssupported(genericindex,newview,deleteview))
+  {
+    threads = 1U;
+  }
   seqit = gt_seq_iterator_sequence_buffer_new(queryfilenames, err);
   if (!seqit)
     haserr = true;
   if (!haserr)
   {
     gt_seq_iterator_set_symbolmap(seqit, gt_alphabet_symbolmap(alphabet));
-    for (unitnum = 0; /* Nothing */; unitnum++)
+    if (threads > 1U)
     {
-      retval = gt_seq_iterator_next(seqit,
-                                &query,
-                                &querylen,
-                                &desc,
-                                err);
-      if (retval < 0)
+      if (gt_findsubquerygmatchforward_threaded(&substringinfo,
+                                                &rangespecinfo,
+                                                seqit,
+                                                newview,
+                                                deleteview,
+                                                threads,
+                                                err) != 0)
       {
         haserr = true;
-        break;
       }
-      if (retval == 0)
+    } else
+    {
+      rangespecinfo.outbuf = gt_str_new();
+      for (unitnum = 0; /* Nothing */; unitnum++)
       {
-        break;
+        retval = gt_seq_iterator_next(seqit,
+                                  &query,
+                                  &querylen,
+                                  &desc,
+                                  err);
+        if (retval < 0)
+        {
+          haserr = true;
+          break;
+        }
+        if (retval == 0)
+        {
+          break;
+        }
+        gmatchposinsinglesequence(&substringinfo,
+                                  unitnum,
+                                  query,
+                                  querylen,
+                                  desc);
+        gt_gfm_flushoutbuf(rangespecinfo.outbuf);
       }
-      gmatchposinsinglesequence(&substringinfo,
-                                unitnum,
-                                query,
-                                querylen,
-                                desc);
+      gt_str_delete(rangespecinfo.outbuf);
+      gt_free(rangespecinfo.decodebuf);
     }
     gt_seq_iterator_delete(seqit);
   }
@@ -35,10 +35,19 @@ typedef GtUword (*Greedygmatchforwardfunction) (const void *,
                                                       const GtUchar *,
                                                       const GtUchar *);
 
+/* For indexes which keep some state while answering queries, the following
+   functions create and delete a view of the index, which can be used
+   concurrently to other views of the same index. If the function creating
+   the view returns <NULL>, the queries are processed by a single thread. */
+typedef void *(*Greedygmatchforwardnewview) (const void *);
+typedef void (*Greedygmatchforwarddeleteview) (void *);
+
 int gt_findsubquerygmatchforward(const GtEncseq *encseq,
                               const void *genericindex,
                               GtUword totallength,
                               Greedygmatchforwardfunction gmatchforward,
+                              Greedygmatchforwardnewview newview,
+                              Greedygmatchforwarddeleteview deleteview,
                               const GtAlphabet *alphabet,
                               const GtStrArray *queryfilenames,
                               Definedunsignedlong minlength,
@@ -46,6 +55,7 @@ int gt_findsubquerygmatchforward(const GtEncseq *encseq,
                               bool showsequence,
                               bool showquerypos,
                               bool showsubjectpos,
+                              unsigned int threads,
                               GtError *err);
 
 int runsubstringiteration(Greedygmatchforwardfunction gmatchforward,
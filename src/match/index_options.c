@@ -26,7 +26,7 @@
 #include "core/error.h"
 #include "core/grep_api.h"
 #include "core/logger.h"
-#include "core/ma_api.h"
+#include "core/ma.h"
 #include "core/option_api.h"
 #include "core/spacecalc.h"
 #include "core/str.h"
@@ -49,7 +49,8 @@ struct GtIndexOptions
   unsigned int numofparts,
                prefixlength;
   GtUword maximumspace;
-  GtStrArray *algbounds;
+  GtStrArray *algbounds,
+             *tablealloc;
   GtReadmode readmode;
   bool outsuftab,
        outlcptab,
@@ -82,6 +83,7 @@ struct GtIndexOptions
            *optionmemlimit,
            *optiondifferencecover,
            *optionuserdefinedsortmaxdepth,
+           *optiontablealloc,
            *optionkys;
 #ifndef S_SPLINT_S /* splint reports too many errors for the following and so
                       we exclude it */
@@ -114,6 +116,7 @@ static GtIndexOptions* gt_index_options_new(void)
   oi->optionprefixlength = NULL;
   oi->optionspmopt = NULL;
   oi->optionstorespecialcodes = NULL;
+  oi->optiontablealloc = NULL;
   oi->outbcktab = false;
   oi->outbwttab = false;
   oi->outkyssort = false;
@@ -122,6 +125,7 @@ static GtIndexOptions* gt_index_options_new(void)
   oi->outsuftab = false; /* only defined for GT_INDEX_OPTIONS_ESA */
   oi->prefixlength = GT_PREFIXLENGTH_AUTOMATIC;
   oi->swallow_tail = false;
+  oi->tablealloc = gt_str_array_new();
   oi->type = GT_INDEX_OPTIONS_UNDEFINED;
   return oi;
 }
@@ -207,6 +211,17 @@ static int gt_index_options_check_set_create_opts(void *oip, GtError *err)
     had_err = gt_option_parse_spacespec(&oi->maximumspace,"memlimit",
                                         oi->memlimit,err);
   }
+  if (!had_err && gt_option_is_set(oi->optiontablealloc))
+  {
+    GtUword idx;
+
+    (void) gt_ma_add_large_policy("default",err);
+    for (idx = 0; !had_err && idx < gt_str_array_size(oi->tablealloc); idx++)
+    {
+      had_err = gt_ma_add_large_policy(gt_str_array_get(oi->tablealloc,idx),
+                                       err);
+    }
+  }
   if (!had_err)
   {
     if (oi->sfxstrategy.maxinsertionsort > oi->sfxstrategy.maxbltriesort)
@@ -458,6 +473,16 @@ static GtIndexOptions* gt_index_options_register_generic_create(
     gt_option_exclude(idxo->optionmemlimit, idxo->optionparts);
   }
 
+  idxo->optiontablealloc
+    = gt_option_new_string_array("tablealloc",
+                                 "specify the allocation policies for large "
+                                 "tables (suffix array, bucket table): "
+                                 "any combination of hugepage, interleave "
+                                 "and firsttouch",
+                                 idxo->tablealloc);
+  gt_option_is_extended_option(idxo->optiontablealloc);
+  gt_option_parser_add_option(op, idxo->optiontablealloc);
+
   idxo->option = gt_option_new_bool("iterscan",
                                    "use iteratorbased-kmer scanning",
                                    &idxo->sfxstrategy.iteratorbasedkmerscanning,
@@ -558,6 +583,7 @@ void gt_index_options_delete(GtIndexOptions *oi)
   gt_str_delete(oi->dir);
   gt_str_delete(oi->memlimit);
   gt_str_array_delete(oi->algbounds);
+  gt_str_array_delete(oi->tablealloc);
   gt_free(oi);
 }
 
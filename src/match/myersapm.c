@@ -20,6 +20,7 @@
 #include "core/encseq.h"
 #include "core/defined-types.h"
 #include "core/ma_api.h"
+#include "core/intbits.h"
 #include "myersapm.h"
 #include "procmatch.h"
 #include "dist-short.h"
@@ -171,3 +172,208 @@ void gt_edistmyersbitvectorAPM(Myersonlineresources *mor,
     }
   }
 }
+
+/* A word holding the bit-vectors of several patterns. The pattern
+   <firstpattern + l> occupies the bits from <lanestart[l]> up to and
+   including <laneend[l]>, i.e. the bit of its last row. */
+
+typedef struct
+{
+  GtUword Pv, Mv,
+          lowbits,    /* the lowest bit of each lane */
+          highbits,   /* the highest bit of each lane */
+          firstpattern,
+          numofpatterns,
+          *eqsvectorrev;
+} Myerslanegroup;
+
+/* Lane-wise addition: carries do not cross lane boundaries */
+#define MYERS_LANEADD(A,B,HIGHBITS)\
+        ((((A) & ~(HIGHBITS)) + ((B) & ~(HIGHBITS))) ^\
+         (((A) ^ (B)) & (HIGHBITS)))
+
+static Myerslanegroup *myers_lanegroups_new(GtUword *numofgroups,
+                                            GtUword alphasize,
+                                            const GtUchar * const *patterns,
+                                            const GtUword *patternlengths,
+                                            GtUword numofpatterns)
+{
+  Myerslanegroup *groups = NULL;
+  GtUword idx, allocatedgroups = 0, usedbits = 0;
+  GtUword *tmpeqsvectorrev = gt_malloc(sizeof *tmpeqsvectorrev * alphasize);
+
+  *numofgroups = 0;
+  for (idx = 0; idx < numofpatterns; idx++)
+  {
+    Myerslanegroup *group;
+    GtUword cc;
+
+    gt_assert(patternlengths[idx] > 0 &&
+              patternlengths[idx] <= (GtUword) GT_INTWORDSIZE);
+    if (*numofgroups == 0 ||
+        usedbits + patternlengths[idx] > (GtUword) GT_INTWORDSIZE)
+    {
+      if (*numofgroups == allocatedgroups)
+      {
+        allocatedgroups += 16UL;
+        groups = gt_realloc(groups,sizeof *groups * allocatedgroups);
+      }
+      group = groups + *numofgroups;
+      group->lowbits = group->highbits = 0;
+      group->firstpattern = idx;
+      group->numofpatterns = 0;
+      group->eqsvectorrev = gt_calloc((size_t) alphasize,
+                                      sizeof *group->eqsvectorrev);
+      (*numofgroups)++;
+      usedbits = 0;
+    } else
+    {
+      group = groups + *numofgroups - 1;
+    }
+    gt_initeqsvectorrev(tmpeqsvectorrev,alphasize,patterns[idx],
+                        patternlengths[idx]);
+    for (cc = 0; cc < alphasize; cc++)
+    {
+      group->eqsvectorrev[cc] |= tmpeqsvectorrev[cc] << usedbits;
+    }
+    group->lowbits |= 1UL << usedbits;
+    group->highbits |= 1UL << (usedbits + patternlengths[idx] - 1);
+    group->numofpatterns++;
+    usedbits += patternlengths[idx];
+  }
+  gt_free(tmpeqsvectorrev);
+  return groups;
+}
+
+static void myers_lanegroups_reset(Myerslanegroup *groups,
+                                   GtUword numofgroups,
+                                   GtUword *score,
+                                   const GtUword *patternlengths,
+                                   GtUword numofpatterns)
+{
+  GtUword idx;
+
+  for (idx = 0; idx < numofgroups; idx++)
+  {
+    groups[idx].Pv = ~0UL;
+    groups[idx].Mv = 0UL;
+  }
+  for (idx = 0; idx < numofpatterns; idx++)
+  {
+    score[idx] = patternlengths[idx];
+  }
+}
+
+void gt_edistmyersbitvectorAPM_multi(Myersonlineresources *mor,
+                                     const GtUchar * const *patterns,
+                                     const GtUword *patternlengths,
+                                     GtUword numofpatterns,
+                                     GtUword maxdistance,
+                                     ProcessIdxMatchMulti processmatch,
+                                     void *processmatchinfo)
+{
+  GtUword pos, idx, numofgroups, *score;
+  Myerslanegroup *groups;
+  GtUchar cc;
+  GtIdxMatch match;
+
+  if (numofpatterns == 0)
+  {
+    return;
+  }
+  groups = myers_lanegroups_new(&numofgroups,(GtUword) mor->alphasize,
+                                patterns,patternlengths,numofpatterns);
+  score = gt_malloc(sizeof *score * numofpatterns);
+  myers_lanegroups_reset(groups,numofgroups,score,patternlengths,
+                         numofpatterns);
+  gt_encseq_reader_reinit_with_readmode(mor->esr, mor->encseq,
+                                        GT_READMODE_REVERSE, 0);
+  match.dbabsolute = NULL;
+  match.dbsubstring = NULL;
+  match.querystartpos = 0;
+  match.alignment = NULL;
+  for (pos = 0; pos < mor->totallength; pos++)
+  {
+    cc = gt_encseq_reader_next_encoded_char(mor->esr);
+    if (cc == (GtUchar) SEPARATOR)
+    {
+      myers_lanegroups_reset(groups,numofgroups,score,patternlengths,
+                             numofpatterns);
+      continue;
+    }
+    for (idx = 0; idx < numofgroups; idx++)
+    {
+      Myerslanegroup *group = groups + idx;
+      GtUword Eq, Xv, Xh, Ph, Mh, lane, ebits;
+
+      Eq = (cc == (GtUchar) WILDCARD) ? 0 : group->eqsvectorrev[cc];
+      Xv = Eq | group->Mv;
+      Xh = (MYERS_LANEADD(Eq & group->Pv,group->Pv,group->highbits)
+            ^ group->Pv) | Eq;
+      Ph = group->Mv | ~ (Xh | group->Pv);
+      Mh = group->Pv & Xh;
+      for (lane = 0, ebits = group->highbits; lane < group->numofpatterns;
+           lane++)
+      {
+        const GtUword patternnum = group->firstpattern + lane,
+                      Ebit = ebits & -ebits;
+
+        if (Ph & Ebit)
+        {
+          score[patternnum]++;
+        } else
+        {
+          if (Mh & Ebit)
+          {
+            gt_assert(score[patternnum] > 0);
+            score[patternnum]--;
+          }
+        }
+        ebits &= ~Ebit;
+      }
+      Ph = (Ph << 1) & ~group->lowbits;
+      Mh = (Mh << 1) & ~group->lowbits;
+      group->Pv = Mh | ~ (Xv | Ph);
+      group->Mv = Ph & Xv;
+    }
+    for (idx = 0; idx < numofpatterns; idx++)
+    {
+      if (score[idx] <= maxdistance)
+      {
+        GtUword dbstartpos = GT_REVERSEPOS(mor->totallength,pos);
+        Definedunsignedlong matchlength;
+
+        if (maxdistance > 0)
+        {
+          matchlength = gt_forwardprefixmatch(mor->encseq,
+                                              mor->alphasize,
+                                              dbstartpos,
+                                              mor->nowildcards,
+                                              mor->eqsvector,
+                                              patterns[idx],
+                                              patternlengths[idx],
+                                              maxdistance);
+        } else
+        {
+          matchlength.defined = true;
+          matchlength.valueunsignedlong = patternlengths[idx];
+        }
+        gt_assert(matchlength.defined || mor->nowildcards);
+        if (matchlength.defined)
+        {
+          match.dbstartpos = dbstartpos;
+          match.dblen = (GtUword) matchlength.valueunsignedlong;
+          match.querylen = patternlengths[idx];
+          match.distance = score[idx];
+          processmatch(processmatchinfo,idx,&match);
+        }
+      }
+    }
+  }
+  for (idx = 0; idx < numofgroups; idx++)
+  {
+    gt_free(groups[idx].eqsvectorrev);
+  }
+  gt_free(groups);
+  gt_free(score);
+}
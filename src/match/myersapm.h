@@ -38,4 +38,23 @@ void gt_edistmyersbitvectorAPM(Myersonlineresources *mor,
                             GtUword patternlength,
                             GtUword maxdistance);
 
+typedef void (*ProcessIdxMatchMulti)(void *processinfo,
+                                     GtUword patternnum,
+                                     const GtIdxMatch *match);
+
+/* Search all <numofpatterns> patterns in one scan over the sequence. The
+   patterns are packed into the lanes of as few machine words as possible
+   (each pattern must not be longer than a machine word) and the bit-vectors
+   of all lanes are updated by the same word operations. For each pattern
+   the matches are reported via <processmatch> in the same order as
+   <gt_edistmyersbitvectorAPM> reports them, with <patternnum> being the
+   index of the pattern in <patterns>. */
+void gt_edistmyersbitvectorAPM_multi(Myersonlineresources *mor,
+                                     const GtUchar * const *patterns,
+                                     const GtUword *patternlengths,
+                                     GtUword numofpatterns,
+                                     GtUword maxdistance,
+                                     ProcessIdxMatchMulti processmatch,
+                                     void *processmatchinfo);
+
 #endif
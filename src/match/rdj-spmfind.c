@@ -84,6 +84,7 @@ struct GtBUstate_spm {
   /* function called when results are found, and its data pointer: */
   GtSpmproc proc;
   void* procdata;
+  FILE *spmfile;
   GtUword nofvalidspm;
   GtUword nof_transitive_withrc;
   GtUword nof_transitive_other;
@@ -689,6 +690,7 @@ static GtBUstate_spm *gt_spmfind_state_new(bool eqlen, const GtEncseq *encseq,
   {
     state->proc = gt_spmproc_show_ascii;
     state->procdata = NULL;
+    state->spmfile = NULL;
   }
   else
   {
@@ -696,28 +698,13 @@ static GtBUstate_spm *gt_spmfind_state_new(bool eqlen, const GtEncseq *encseq,
     gt_str_append_char(suffix, '.');
     gt_str_append_uint(suffix, threadnum);
     gt_str_append_cstr(suffix, GT_READJOINER_SUFFIX_SPMLIST);
-    /*@ignore@*/
-    state->procdata = gt_fa_fopen_with_suffix(indexname, gt_str_get(suffix),
+    state->spmfile = gt_fa_fopen_with_suffix(indexname, gt_str_get(suffix),
         "wb", NULL);
-    /*@end@*/
     gt_str_delete(suffix);
-    if (state->procdata == NULL)
+    if (state->spmfile == NULL)
       exit(-1);
-    if (state->first_revcompl > UINT32_MAX ||
-        (state->first_revcompl == 0 && state->nofreads > UINT32_MAX))
-    {
-      state->proc = gt_spmproc_show_bin64;
-      /*@ignore@*/
-      gt_spmlist_write_header_bin64((FILE*)state->procdata);
-      /*@end@*/
-    }
-    else
-    {
-      state->proc = gt_spmproc_show_bin32;
-      /*@ignore@*/
-      gt_spmlist_write_header_bin32((FILE*)state->procdata);
-      /*@end@*/
-    }
+    state->proc = gt_spmproc_show_blocked;
+    state->procdata = gt_spmlist_block_writer_new(state->spmfile);
   }
 
   state->nofvalidspm = 0;
@@ -825,10 +812,11 @@ static void gt_spmfind_state_delete(bool eqlen, GtBUstate_spm *state)
           (GtArrayGtBUItvinfo_spmvar *)state->stack, state);
       gt_fa_fclose(state->cntfile);
     }
-    if (state->procdata != NULL)
-      /*@ignore@*/
-      gt_fa_fclose((FILE*)state->procdata);
-      /*@end@*/
+    if (state->spmfile != NULL)
+    {
+      gt_spmlist_block_writer_delete(state->procdata);
+      gt_fa_fclose(state->spmfile);
+    }
     gt_free(state);
   }
 }
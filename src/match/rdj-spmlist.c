@@ -19,8 +19,10 @@
 #include <string.h>
 #include <stdint.h>
 #include <limits.h>
+#include <zlib.h>
 #include "core/str.h"
 #include "core/assert_api.h"
+#include "core/fa.h"
 #include "core/file.h"
 #include "core/log_api.h"
 #include "core/parseutils.h"
@@ -28,7 +30,10 @@
 #include "core/ensure.h"
 #include "core/minmax.h"
 #include "core/ma.h"
+#include "core/multithread_api.h"
+#include "core/thread_api.h"
 #include "core/unused_api.h"
+#include "core/xposix.h"
 #include "match/rdj-spmlist.h"
 /* unit test: */
 #include "match/rdj-spmproc.h"
@@ -124,6 +129,307 @@ static int gt_spmlist_parse_bin ## BITS(FILE *file, GtUword min_length,\
 DEFINE_GT_SPMLIST_BIN_FORMAT(32);
 DEFINE_GT_SPMLIST_BIN_FORMAT(64);
 
+/* ---------------- Readjoiner blocked format ---------------- */
+
+/* at most 10 bytes of 7 bits are needed for a 64 bit value */
+#define GT_SPMLIST_VARINT_MAXLEN 10UL
+#define GT_SPMLIST_BLOCK_MAXSIZE \
+  (GT_SPMLIST_BLOCK_NOFSPM * 3UL * GT_SPMLIST_VARINT_MAXLEN)
+/* size of a block header (four uint64_t) */
+#define GT_SPMLIST_BLOCK_HEADER_SIZE (sizeof (uint64_t) * 4)
+/* number of blocks decoded in parallel before their SPMs are processed */
+#define GT_SPMLIST_BLOCKS_PER_BATCH 64UL
+
+struct GtSpmlistBlockWriter
+{
+  FILE *file;
+  unsigned char *buffer;
+  size_t used;
+  GtUword nofspm, maxlength, prev_suffix_seqnum;
+};
+
+static inline size_t gt_spmlist_put_varint(unsigned char *buf, GtUword value)
+{
+  size_t i = 0;
+  while (value >= (GtUword)0x80)
+  {
+    buf[i++] = (unsigned char)((value & 0x7f) | 0x80);
+    value >>= 7;
+  }
+  buf[i++] = (unsigned char)value;
+  return i;
+}
+
+static inline bool gt_spmlist_get_varint(GtUword *value,
+    const unsigned char **ptr, const unsigned char *end)
+{
+  const unsigned char *p;
+  unsigned int shift = 0;
+  GtUword v = 0;
+  for (p = *ptr; p < end && shift < 7U * GT_SPMLIST_VARINT_MAXLEN;
+       p++, shift += 7U)
+  {
+    v |= ((GtUword)(*p & 0x7f)) << shift;
+    if ((*p & 0x80) == 0)
+    {
+      *value = v;
+      *ptr = p + 1;
+      return true;
+    }
+  }
+  return false;
+}
+
+/* zigzag encoding of the difference <to> - <from> */
+#define GT_SPMLIST_ZIGZAG(FROM, TO)\
+  ((TO) >= (FROM) ? ((TO) - (FROM)) << 1 : (((FROM) - (TO)) << 1) - 1)
+
+#define GT_SPMLIST_UNZIGZAG(FROM, DELTA)\
+  (((DELTA) & 1) ? (FROM) - (((DELTA) + 1) >> 1) : (FROM) + ((DELTA) >> 1))
+
+static void gt_spmlist_block_writer_flush(GtSpmlistBlockWriter *writer)
+{
+  uint64_t header[4];
+  if (writer->nofspm == 0)
+    return;
+  header[0] = (uint64_t)writer->nofspm;
+  header[1] = (uint64_t)writer->used;
+  header[2] = (uint64_t)crc32(crc32(0L, Z_NULL, 0), writer->buffer,
+      (uInt)writer->used);
+  header[3] = (uint64_t)writer->maxlength;
+  gt_xfwrite(header, sizeof (*header), (size_t)4, writer->file);
+  gt_xfwrite(writer->buffer, sizeof (*writer->buffer), writer->used,
+      writer->file);
+  writer->used = 0;
+  writer->nofspm = 0;
+  writer->maxlength = 0;
+  writer->prev_suffix_seqnum = 0;
+}
+
+GtSpmlistBlockWriter* gt_spmlist_block_writer_new(FILE *file)
+{
+  GtSpmlistBlockWriter *writer;
+  gt_assert(file != NULL);
+  writer = gt_malloc(sizeof (*writer));
+  writer->file = file;
+  writer->buffer = gt_malloc(sizeof (*writer->buffer) *
+      GT_SPMLIST_BLOCK_MAXSIZE);
+  writer->used = 0;
+  writer->nofspm = 0;
+  writer->maxlength = 0;
+  writer->prev_suffix_seqnum = 0;
+  gt_xfputc((int)GT_SPMLIST_BLOCKED, file);
+  return writer;
+}
+
+void gt_spmlist_block_writer_delete(GtSpmlistBlockWriter *writer)
+{
+  if (writer == NULL)
+    return;
+  gt_spmlist_block_writer_flush(writer);
+  gt_free(writer->buffer);
+  gt_free(writer);
+}
+
+void gt_spmproc_show_blocked(GtUword suffix_seqnum, GtUword prefix_seqnum,
+    GtUword length, bool suffixseq_direct, bool prefixseq_direct,
+    void *data)
+{
+  GtSpmlistBlockWriter *writer = data;
+  unsigned char *buf;
+  GtUword info;
+
+  gt_assert(writer != NULL);
+  gt_assert(length <= (GT_UWORD_MAX >> 2));
+  buf = writer->buffer + writer->used;
+  info = (length << 2) | (suffixseq_direct ? 2UL : 0) |
+    (prefixseq_direct ? 1UL : 0);
+  buf += gt_spmlist_put_varint(buf,
+      GT_SPMLIST_ZIGZAG(writer->prev_suffix_seqnum, suffix_seqnum));
+  buf += gt_spmlist_put_varint(buf,
+      GT_SPMLIST_ZIGZAG(suffix_seqnum, prefix_seqnum));
+  buf += gt_spmlist_put_varint(buf, info);
+  writer->used = (size_t)(buf - writer->buffer);
+  writer->prev_suffix_seqnum = suffix_seqnum;
+  if (length > writer->maxlength)
+    writer->maxlength = length;
+  if (++writer->nofspm == GT_SPMLIST_BLOCK_NOFSPM)
+    gt_spmlist_block_writer_flush(writer);
+}
+
+typedef struct
+{
+  const unsigned char *payload;
+  GtUword nofspm, payloadsize, checksum, blocknum,
+          *spmdata; /* three values per SPM, as in the bin formats */
+  bool corrupt;
+} GtSpmlistBlock;
+
+typedef struct
+{
+  GtSpmlistBlock *blocks;
+  GtUword nofblocks, next;
+  GtMutex *mutex;
+} GtSpmlistBatch;
+
+static void gt_spmlist_decode_block(GtSpmlistBlock *block)
+{
+  const unsigned char *ptr = block->payload,
+                      *end = block->payload + block->payloadsize;
+  GtUword i, suffix_seqnum = 0, delta, *spmdata = block->spmdata;
+
+  block->corrupt = ((GtUword)crc32(crc32(0L, Z_NULL, 0), block->payload,
+        (uInt)block->payloadsize) != block->checksum);
+  for (i = 0; !block->corrupt && i < block->nofspm; i++)
+  {
+    if (!gt_spmlist_get_varint(&delta, &ptr, end))
+    {
+      block->corrupt = true;
+      break;
+    }
+    suffix_seqnum = GT_SPMLIST_UNZIGZAG(suffix_seqnum, delta);
+    *spmdata++ = suffix_seqnum;
+    if (!gt_spmlist_get_varint(&delta, &ptr, end) ||
+        !gt_spmlist_get_varint(spmdata + 1, &ptr, end))
+    {
+      block->corrupt = true;
+      break;
+    }
+    *spmdata = GT_SPMLIST_UNZIGZAG(suffix_seqnum, delta);
+    spmdata += 2;
+  }
+  if (ptr != end)
+    block->corrupt = true;
+}
+
+static void *gt_spmlist_decode_blocks_thread(void *data)
+{
+  GtSpmlistBatch *batch = data;
+  GtUword blocknum;
+
+  for (;;)
+  {
+    gt_mutex_lock(batch->mutex);
+    blocknum = batch->next++;
+    gt_mutex_unlock(batch->mutex);
+    if (blocknum >= batch->nofblocks)
+      break;
+    gt_spmlist_decode_block(batch->blocks + blocknum);
+  }
+  return NULL;
+}
+
+static int gt_spmlist_parse_blocked(const char *filename, GtUword min_length,
+    GtSpmproc processoverlap, void *data, GtError *err)
+{
+  int had_err = 0;
+  size_t filesize;
+  unsigned char *filedata;
+  const unsigned char *ptr, *end;
+  uint64_t header[4];
+  GtSpmlistBatch batch;
+  GtSpmlistBlock *block;
+  GtUword i, j, blocknum = 0, nofspm = 0, nofskipped = 0;
+
+  filedata = gt_fa_mmap_read(filename, &filesize, err);
+  if (filedata == NULL)
+    return -1;
+  /* the file is mapped again by its name, so it may have been replaced
+     after the caller checked its format byte */
+  if (filesize == 0 || filedata[0] != (unsigned char)GT_SPMLIST_BLOCKED)
+  {
+    gt_error_set(err, "%s: not a blocked SPM file", filename);
+    gt_fa_xmunmap(filedata);
+    return -1;
+  }
+  ptr = filedata + 1;
+  end = filedata + filesize;
+  batch.blocks = gt_calloc((size_t)GT_SPMLIST_BLOCKS_PER_BATCH,
+      sizeof (*batch.blocks));
+  batch.mutex = gt_mutex_new();
+  while (!had_err && ptr < end)
+  {
+    /* collect the next batch by reading the block headers */
+    batch.nofblocks = 0;
+    batch.next = 0;
+    while (ptr < end && batch.nofblocks < GT_SPMLIST_BLOCKS_PER_BATCH)
+    {
+      if ((size_t)(end - ptr) < GT_SPMLIST_BLOCK_HEADER_SIZE)
+      {
+        gt_error_set(err, "%s: SPM block "GT_WU": premature EOF", filename,
+            blocknum);
+        had_err = -1;
+        break;
+      }
+      memcpy(header, ptr, GT_SPMLIST_BLOCK_HEADER_SIZE);
+      ptr += GT_SPMLIST_BLOCK_HEADER_SIZE;
+      /* the number of SPMs is checked first, as the other checks and the
+         allocation depend on it */
+      if (header[0] == 0 || header[0] > (uint64_t)GT_SPMLIST_BLOCK_NOFSPM ||
+          header[1] > (uint64_t)(end - ptr) ||
+          header[1] > (uint64_t)(header[0] * 3 * GT_SPMLIST_VARINT_MAXLEN))
+      {
+        gt_error_set(err, "%s: SPM block "GT_WU": invalid block header",
+            filename, blocknum);
+        had_err = -1;
+        break;
+      }
+      if (header[3] >= (uint64_t)min_length)
+      {
+        block = batch.blocks + batch.nofblocks++;
+        block->payload = ptr;
+        block->nofspm = (GtUword)header[0];
+        block->payloadsize = (GtUword)header[1];
+        block->checksum = (GtUword)header[2];
+        block->blocknum = blocknum;
+        block->spmdata = gt_realloc(block->spmdata,
+            sizeof (*block->spmdata) * 3 * block->nofspm);
+      }
+      else
+        nofskipped += (GtUword)header[0];
+      ptr += header[1];
+      blocknum++;
+    }
+    if (had_err)
+      break;
+    if (batch.nofblocks > 1UL && gt_jobs > 1U)
+    {
+      if (gt_multithread(gt_spmlist_decode_blocks_thread, &batch, err) != 0)
+        had_err = -1;
+    }
+    else
+      (void)gt_spmlist_decode_blocks_thread(&batch);
+    /* process the SPMs in file order */
+    for (i = 0; !had_err && i < batch.nofblocks; i++)
+    {
+      block = batch.blocks + i;
+      if (block->corrupt)
+      {
+        gt_error_set(err, "%s: SPM block "GT_WU": checksum mismatch or "
+            "invalid data", filename, block->blocknum);
+        had_err = -1;
+        break;
+      }
+      for (j = 0; j < 3 * block->nofspm; j += 3)
+      {
+        GtUword info = block->spmdata[j + 2];
+        if ((info >> 2) >= min_length)
+          processoverlap(block->spmdata[j], block->spmdata[j + 1], info >> 2,
+              (info & 2) != 0, (info & 1) != 0, data);
+      }
+      nofspm += block->nofspm;
+    }
+  }
+  gt_log_log("%s: "GT_WU" SPM in "GT_WU" blocks, "GT_WU" SPM skipped by "
+      "block header", filename, nofspm + nofskipped, blocknum, nofskipped);
+  for (i = 0; i < GT_SPMLIST_BLOCKS_PER_BATCH; i++)
+    gt_free(batch.blocks[i].spmdata);
+  gt_free(batch.blocks);
+  gt_mutex_delete(batch.mutex);
+  gt_fa_xmunmap(filedata);
+  return had_err;
+}
+
 /* ---------------- Plain text format ---------------- */
 
 /*@notfunction@*/
@@ -279,6 +585,12 @@ int gt_spmlist_parse(const char* filename, GtUword min_length,
       retval = gt_spmlist_parse_bin64(file, min_length, processoverlap, data,
           err);
       break;
+    case GT_SPMLIST_BLOCKED:
+      /* only files starting with the format byte take the blocked path */
+      gt_log_log("Spm file %s format: readjoiner-blocked", filename);
+      retval = gt_spmlist_parse_blocked(filename, min_length, processoverlap,
+          data, err);
+      break;
     default:
       gt_file_unget_char(infp, c);
       gt_log_log("Spm file %s format: readjoiner-text", filename);
@@ -504,11 +816,125 @@ static int gt_spmproc_show_unit_test(GtError *err)
   return had_err;
 }
 
+struct GtSpmlistBlockedTestData
+{
+  GtUword nofspm, checksum;
+};
+
+static void gt_spmlist_blocked_test_sum(GtUword suffix_seqnum,
+    GtUword prefix_seqnum, GtUword length, bool suffixseq_direct,
+    bool prefixseq_direct, void *data)
+{
+  struct GtSpmlistBlockedTestData *d = data;
+  d->nofspm++;
+  d->checksum = d->checksum * 31UL + suffix_seqnum;
+  d->checksum = d->checksum * 31UL + prefix_seqnum;
+  d->checksum = d->checksum * 31UL + length;
+  d->checksum = d->checksum * 31UL + (suffixseq_direct ? 2UL : 0) +
+    (prefixseq_direct ? 1UL : 0);
+}
+
+#define GT_SPMLIST_BLOCKED_TEST_SPM(I, L)\
+  ((I) * 7919UL) % 100003UL, ((I) * 104729UL) % 99991UL,\
+  (L) + 10UL + (I) % 100UL, ((I) & 1) == 0, ((I) & 2) == 0
+
+static int gt_spmlist_blocked_unit_test(GtError *err)
+{
+  int had_err = 0;
+  GtStr *path;
+  FILE *fp;
+  GtSpmlistBlockWriter *writer;
+  struct GtSpmlistBlockedTestData written = {0, 0}, read = {0, 0},
+                                  written_long = {0, 0};
+  GtUword i, nofspm = 3 * GT_SPMLIST_BLOCK_NOFSPM + 17UL;
+
+  gt_error_check(err);
+  path = gt_str_new();
+  fp = gt_xtmpfp(path);
+  writer = gt_spmlist_block_writer_new(fp);
+  for (i = 0; i < nofspm; i++)
+  {
+    /* the SPMs of the last block are longer than those of the others */
+    GtUword length = i >= 3 * GT_SPMLIST_BLOCK_NOFSPM ? 200UL : 0;
+    gt_spmproc_show_blocked(GT_SPMLIST_BLOCKED_TEST_SPM(i, length),
+        writer);
+    gt_spmlist_blocked_test_sum(GT_SPMLIST_BLOCKED_TEST_SPM(i, length),
+        &written);
+    if (length > 0)
+      gt_spmlist_blocked_test_sum(GT_SPMLIST_BLOCKED_TEST_SPM(i, length),
+          &written_long);
+  }
+  gt_spmlist_block_writer_delete(writer);
+  gt_fa_xfclose(fp);
+
+  had_err = gt_spmlist_parse(gt_str_get(path), 0,
+      gt_spmlist_blocked_test_sum, &read, err);
+  gt_ensure(read.nofspm == written.nofspm);
+  gt_ensure(read.checksum == written.checksum);
+  if (!had_err)
+  {
+    /* only the last block is decoded */
+    read.nofspm = 0;
+    read.checksum = 0;
+    had_err = gt_spmlist_parse(gt_str_get(path), 200UL,
+        gt_spmlist_blocked_test_sum, &read, err);
+    gt_ensure(read.nofspm == written_long.nofspm);
+    gt_ensure(read.checksum == written_long.checksum);
+  }
+  gt_xunlink(gt_str_get(path));
+  gt_str_reset(path);
+  if (!had_err)
+  {
+    /* blocks with no or too many SPMs are rejected */
+    uint64_t header[4] = {0, 0, 0, 0};
+    const unsigned char type = (unsigned char)GT_SPMLIST_BLOCKED;
+    bool rejected;
+    for (i = 0; !had_err && i < 2UL; i++)
+    {
+      header[0] = i == 0 ? 0 : (uint64_t)GT_SPMLIST_BLOCK_NOFSPM + 1;
+      fp = gt_xtmpfp(path);
+      gt_xfwrite_one(&type, fp);
+      gt_xfwrite(header, sizeof (*header), (size_t)4, fp);
+      gt_fa_xfclose(fp);
+      rejected = gt_spmlist_parse(gt_str_get(path), 0,
+          gt_spmlist_blocked_test_sum, &read, err) != 0 &&
+        strstr(gt_error_get(err), "invalid block header") != NULL;
+      gt_error_unset(err);
+      gt_ensure(rejected);
+      gt_xunlink(gt_str_get(path));
+      gt_str_reset(path);
+    }
+  }
+  if (!had_err)
+  {
+    /* an empty file or one of another format is an error, not a crash */
+    const char *contents[2] = {"", "0 + 1 + 10\n"};
+    bool rejected;
+    for (i = 0; !had_err && i < 2UL; i++)
+    {
+      fp = gt_xtmpfp(path);
+      gt_xfputs(contents[i], fp);
+      gt_fa_xfclose(fp);
+      rejected = gt_spmlist_parse_blocked(gt_str_get(path), 0,
+          gt_spmlist_blocked_test_sum, &read, err) != 0 &&
+        gt_error_is_set(err);
+      gt_error_unset(err);
+      gt_ensure(rejected);
+      gt_xunlink(gt_str_get(path));
+      gt_str_reset(path);
+    }
+  }
+  gt_str_delete(path);
+  return had_err;
+}
+
 int gt_spmlist_unit_test(GtError *err)
 {
   int had_err = 0;
   had_err = gt_spmproc_show_unit_test(err);
   if (had_err == 0)
     had_err = gt_spmlist_parse_unit_test(err);
+  if (had_err == 0)
+    had_err = gt_spmlist_blocked_unit_test(err);
   return had_err;
 }
@@ -25,6 +25,7 @@
 typedef enum {
   GT_SPMLIST_BIN32      = 2,
   GT_SPMLIST_BIN64      = 3,
+  GT_SPMLIST_BLOCKED    = 4,
   GT_SPMLIST_ASCII   /* = any other value */,
 } GtSpmlistFormat;
 
@@ -37,7 +38,38 @@ void gt_spmproc_show_bin ## BITS(GtUword suffix_seqnum,\
 DECLARE_GT_SPMLIST_BIN_FORMAT(32);
 DECLARE_GT_SPMLIST_BIN_FORMAT(64);
 
-/* parse a spmlist file; format is recognized by reading the first byte */
+/*
+ * Blocked format: after the header byte, the SPMs are stored in blocks of at
+ * most GT_SPMLIST_BLOCK_NOFSPM records. Each block starts with four uint64_t
+ * values (number of SPMs, payload size in bytes, CRC32 checksum of the
+ * payload, maximal SPM length), followed by the payload. A record consists of
+ * three varints: the suffix_seqnum (zigzag encoded difference to the
+ * suffix_seqnum of the previous record of the block), the prefix_seqnum
+ * (zigzag encoded difference to the suffix_seqnum) and
+ * length << 2 + suffixseq_direct << 1 + prefixseq_direct.
+ * The blocks are independent of each other, so that they can be decoded in
+ * parallel, and blocks whose SPMs are all shorter than the minimal length
+ * are skipped without decoding them.
+ */
+
+#define GT_SPMLIST_BLOCK_NOFSPM 4096UL
+
+typedef struct GtSpmlistBlockWriter GtSpmlistBlockWriter;
+
+/* writes the header byte to <file>, which must be open until the writer is
+   deleted */
+GtSpmlistBlockWriter* gt_spmlist_block_writer_new(FILE *file);
+
+/* writes the last (incomplete) block; does not close the file */
+void gt_spmlist_block_writer_delete(GtSpmlistBlockWriter *writer);
+
+void gt_spmproc_show_blocked(GtUword suffix_seqnum, GtUword prefix_seqnum,
+    GtUword length, bool suffixseq_direct, bool prefixseq_direct,
+    void *writer /* GtSpmlistBlockWriter */);
+
+/* parse a spmlist file; format is recognized by reading the first byte;
+   the blocks of files in blocked format are decoded by <gt_jobs> threads,
+   <processoverlap> is always called by the calling thread, in file order */
 int gt_spmlist_parse(const char* filename, GtUword min_length,
     GtSpmproc processoverlap, void *data, GtError *err);
 
@@ -25,9 +25,13 @@
 #include "core/fileutils.h"
 #include "core/format64.h"
 #include "core/hashmap-generic.h"
+#include "core/intbits.h"
 #include "core/log.h"
 #include "core/ma.h"
+#include "core/minmax.h"
+#include "core/multithread_api.h"
 #include "core/progressbar.h"
+#include "core/thread_api.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
 #include "core/spacecalc.h"
@@ -976,33 +980,42 @@ GtUword gt_strgraph_redwithrc(GtStrgraph *strgraph, bool show_progressbar)
   return (counter >> 1);
 }
 
-/* return value: number of transitive edges */
-GtUword gt_strgraph_redtrans(GtStrgraph *strgraph, bool show_progressbar)
+/* number of vertices a thread of the transitive reduction claims at once */
+#define GT_STRGRAPH_REDTRANS_CHUNK 4096UL
+
+typedef struct {
+  GtStrgraphVnum     vnum;
+  GtStrgraphVEdgenum edgenum;
+} GtStrgraphEdgeRef;
+
+typedef struct {
+  GtStrgraph     *strgraph;
+  GtStrgraphVnum next_vnum;
+  GtUint64       *progress;
+  GtBitsequence  *transitive;
+  GtMutex        *mutex;
+} GtStrgraphRedtransInfo;
+
+/* Finds the transitive edges of the vertices <from> to <to> - 1, using the
+   bit array <inplay> instead of the vertex marks, and appends them to
+   <marks>. The graph is not modified. */
+static void gt_strgraph_find_transitive_edges(GtStrgraph *strgraph,
+                                              GtStrgraphVnum from,
+                                              GtStrgraphVnum to,
+                                              GtBitsequence *inplay,
+                                              GtArray *marks)
 {
   GtStrgraphLength jlen, klen, longest;
   GtStrgraphVEdgenum j, k, l;
   GtStrgraphVnum i, jdest, kdest;
-  GtUword counter;
-  GtUint64 progress = 0;
+  GtStrgraphEdgeRef ref;
 
-  gt_assert(strgraph != NULL);
-  gt_assert(strgraph->state == GT_STRGRAPH_SORTED_BY_L);
-
-  for (i = 0; i < GT_STRGRAPH_NOFVERTICES(strgraph); i++)
-    GT_STRGRAPH_V_SET_MARK(strgraph, i, GT_STRGRAPH_V_VACANT);
-
-  if (show_progressbar)
-    gt_progressbar_start(&progress,
-        (GtUint64)GT_STRGRAPH_NOFVERTICES(strgraph));
-  for (i = 0; i < GT_STRGRAPH_NOFVERTICES(strgraph); i++)
+  for (i = from; i < to; i++)
   {
     if (GT_STRGRAPH_V_OUTDEG(strgraph, i) > 0)
     {
       for (j = 0; j < GT_STRGRAPH_V_NOFEDGES(strgraph, i); j++)
-      {
-        GT_STRGRAPH_V_SET_MARK(strgraph, GT_STRGRAPH_EDGE_DEST(strgraph, i, j),
-            GT_STRGRAPH_V_INPLAY);
-      }
+        GT_SETIBIT(inplay, GT_STRGRAPH_EDGE_DEST(strgraph, i, j));
       GT_STRGRAPH_FIND_LONGEST_EDGE(strgraph, i, longest);
       for (j = 0; j < GT_STRGRAPH_V_NOFEDGES(strgraph, i); j++)
       {
@@ -1013,31 +1026,115 @@ GtUword gt_strgraph_redtrans(GtStrgraph *strgraph, bool show_progressbar)
         {
           kdest = GT_STRGRAPH_EDGE_DEST(strgraph, jdest, k);
           klen = GT_STRGRAPH_EDGE_LEN(strgraph, jdest, k);
-          if (GT_STRGRAPH_V_MARK(strgraph, kdest) == GT_STRGRAPH_V_INPLAY)
+          if (GT_ISIBITSET(inplay, kdest))
           {
             for (l = 0; l < GT_STRGRAPH_V_NOFEDGES(strgraph, i); l++)
             {
               if (GT_STRGRAPH_EDGE_DEST(strgraph, i, l) == kdest &&
                   GT_STRGRAPH_EDGE_LEN(strgraph, i, l) == jlen + klen)
               {
-                GT_STRGRAPH_EDGE_SET_MARK(strgraph, i, l);
+                ref.vnum = i;
+                ref.edgenum = l;
+                gt_array_add(marks, ref);
               }
             }
           }
         }
       }
       for (j = 0; j < GT_STRGRAPH_V_NOFEDGES(strgraph, i); j++)
-      {
-        GT_STRGRAPH_V_SET_MARK(strgraph, GT_STRGRAPH_EDGE_DEST(strgraph, i, j),
-            GT_STRGRAPH_V_VACANT);
-      }
+        GT_UNSETIBIT(inplay, GT_STRGRAPH_EDGE_DEST(strgraph, i, j));
     }
-    if (show_progressbar)
-      progress++;
   }
+}
+
+static void* gt_strgraph_redtrans_thread(void *data)
+{
+  GtStrgraphRedtransInfo *info = data;
+  GtStrgraph *strgraph = info->strgraph;
+  GtStrgraphVnum from, to, nofvertices = GT_STRGRAPH_NOFVERTICES(strgraph);
+  GtBitsequence *inplay;
+  GtArray *marks = gt_array_new(sizeof (GtStrgraphEdgeRef));
+  GtUword m;
+
+  GT_INITBITTAB(inplay, nofvertices);
+  for (;;)
+  {
+    gt_mutex_lock(info->mutex);
+    from = info->next_vnum;
+    to = MIN(from + GT_STRGRAPH_REDTRANS_CHUNK, nofvertices);
+    info->next_vnum = to;
+    gt_mutex_unlock(info->mutex);
+    if (from == to)
+      break;
+    gt_strgraph_find_transitive_edges(strgraph, from, to, inplay, marks);
+    /* in most edge representations the mark shares a memory word with the
+       destination and length read by the other threads, so the edges are
+       only read here; the transitive edges are collected in a separate bit
+       array (whose words may be shared by two chunks) under the lock and
+       marked after all threads have finished */
+    gt_mutex_lock(info->mutex);
+    for (m = 0; m < gt_array_size(marks); m++)
+    {
+      GtStrgraphEdgeRef *ref = gt_array_get(marks, m);
+      GT_SETIBIT(info->transitive, GT_STRGRAPH_V_NTH_EDGE_OFFSET(strgraph,
+                 ref->vnum, ref->edgenum));
+    }
+    if (info->progress != NULL)
+      *info->progress += (GtUint64) (to - from);
+    gt_mutex_unlock(info->mutex);
+    gt_array_reset(marks);
+  }
+  gt_free(inplay);
+  gt_array_delete(marks);
+  return NULL;
+}
+
+/* return value: number of transitive edges */
+GtUword gt_strgraph_redtrans(GtStrgraph *strgraph, bool show_progressbar)
+{
+  GtStrgraphVnum i;
+  GtStrgraphVEdgenum j;
+  GtUword counter;
+  GtUint64 progress = 0;
+  GtStrgraphRedtransInfo info;
+
+  gt_assert(strgraph != NULL);
+  gt_assert(strgraph->state == GT_STRGRAPH_SORTED_BY_L);
+
+  for (i = 0; i < GT_STRGRAPH_NOFVERTICES(strgraph); i++)
+    GT_STRGRAPH_V_SET_MARK(strgraph, i, GT_STRGRAPH_V_VACANT);
+
+  if (show_progressbar)
+    gt_progressbar_start(&progress,
+        (GtUint64)GT_STRGRAPH_NOFVERTICES(strgraph));
+  /* the vertices are partitioned into chunks, the edges of each vertex are
+     marked independently of the other vertices; therefore the result does
+     not depend on the number of threads */
+  info.strgraph = strgraph;
+  info.next_vnum = 0;
+  info.progress = show_progressbar ? &progress : NULL;
+  GT_INITBITTAB(info.transitive, GT_STRGRAPH_NOFEDGES(strgraph));
+  info.mutex = gt_mutex_new();
+  if (gt_multithread(gt_strgraph_redtrans_thread, &info, NULL) != 0)
+  {
+    /* no threads available, process the remaining vertices here */
+    (void) gt_strgraph_redtrans_thread(&info);
+  }
+  gt_mutex_delete(info.mutex);
   if (show_progressbar)
     gt_progressbar_stop();
 
+  for (i = 0; i < GT_STRGRAPH_NOFVERTICES(strgraph); i++)
+  {
+    for (j = 0; j < GT_STRGRAPH_V_NOFEDGES(strgraph, i); j++)
+    {
+      if (GT_ISIBITSET(info.transitive,
+                       GT_STRGRAPH_V_NTH_EDGE_OFFSET(strgraph, i, j)))
+        GT_STRGRAPH_EDGE_SET_MARK(strgraph, i, j);
+    }
+  }
+  gt_free(info.transitive);
+
   counter = gt_strgraph_reduce_marked_edges(strgraph);
   gt_log_log("transitive counter: "GT_WU"", counter);
   /* trans spm should be found twice, check number is even */
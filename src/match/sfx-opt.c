@@ -21,7 +21,7 @@
 #include "core/basename_api.h"
 #include "core/error.h"
 #include "core/logger.h"
-#include "core/ma_api.h"
+#include "core/ma.h"
 #include "core/option_api.h"
 #include "core/readmode.h"
 #include "core/spacecalc.h"
@@ -125,6 +125,15 @@ static GtOPrval parse_options(int *parsed_args,
 static void showoptions(const Suffixeratoroptions *so)
 {
   GtUword i;
+  unsigned int tablealloc;
+  static const struct
+  {
+    unsigned int flag;
+    const char *name;
+  } tableallocpolicies[] = {{GT_MA_LARGE_HUGEPAGE, "hugepage"},
+                            {GT_MA_LARGE_INTERLEAVE, "interleave"},
+                            {GT_MA_LARGE_FIRSTTOUCH, "firsttouch"}};
+  GtStr *tableallocnames;
   Sfxstrategy sfxtrategy;
   GtLogger *logger = gt_logger_new(true, GT_LOGGER_DEFLT_PREFIX, stdout);
 
@@ -209,6 +218,24 @@ static void showoptions(const Suffixeratoroptions *so)
                         gt_index_options_lcpdist_value(so->idxopts)
                           ? "true"
                           : "false");
+  tablealloc = gt_ma_get_large_policy();
+  tableallocnames = gt_str_new_cstr(tablealloc == GT_MA_LARGE_DEFAULT
+                                      ? "default"
+                                      : "");
+  for (i = 0; i < sizeof tableallocpolicies / sizeof tableallocpolicies[0];
+       i++)
+  {
+    if (tablealloc & tableallocpolicies[i].flag)
+    {
+      if (gt_str_length(tableallocnames) > 0)
+      {
+        gt_str_append_char(tableallocnames, ',');
+      }
+      gt_str_append_cstr(tableallocnames, tableallocpolicies[i].name);
+    }
+  }
+  gt_logger_log_force(logger, "tablealloc=%s", gt_str_get(tableallocnames));
+  gt_str_delete(tableallocnames);
   gt_logger_delete(logger);
 }
 
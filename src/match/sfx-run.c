@@ -27,8 +27,10 @@
 #include "core/encseq_metadata.h"
 #include "core/fa.h"
 #include "core/logger.h"
+#include "core/ma.h"
 #include "core/readmode.h"
 #include "core/showtime.h"
+#include "core/spacecalc.h"
 #include "core/timer_api.h"
 #include "core/unused_api.h"
 #include "core/xansi_api.h"
@@ -737,6 +739,15 @@ int gt_parseargsandcallsuffixerator(bool doesa,int argc,
     {
       haserr = true;
     }
+    if (!haserr && gt_ma_get_large_policy() != GT_MA_LARGE_DEFAULT)
+    {
+      GtUword numoftables, numofbytes;
+
+      gt_ma_get_large_stats(&numoftables,&numofbytes);
+      gt_logger_log(logger,"allocated "GT_WU" large tables with %.2f MB "
+                           "according to the policy for large tables",
+                    numoftables,GT_MEGABYTES(numofbytes));
+    }
     gt_logger_delete(logger);
     logger = NULL;
   } else
@@ -124,7 +124,7 @@ static GtSuffixsortspace *gt_suffixsortspace_new_generic(GtUword numofentries,
                                    numofentries,
                                    gt_suffixsortspace_overflow_abort,
                                    &numofentries);
-      suffixsortspace->uinttab = gt_malloc((size_t) sufspacesize);
+      suffixsortspace->uinttab = gt_malloc_large((size_t) sufspacesize);
       suffixsortspace->clonenumber = 0;
     } else
     {
@@ -142,7 +142,7 @@ static GtSuffixsortspace *gt_suffixsortspace_new_generic(GtUword numofentries,
                                    numofentries,
                                    gt_suffixsortspace_overflow_abort,
                                    &numofentries);
-      suffixsortspace->ulongtab = gt_malloc((size_t) sufspacesize);
+      suffixsortspace->ulongtab = gt_malloc_large((size_t) sufspacesize);
       suffixsortspace->clonenumber = 0;
     } else
     {
@@ -536,9 +536,163 @@ static void searchoverstrands(const TageratorOptions *tageratoroptions,
   }
 }
 
+static void tgr_showtagheader(const TageratorOptions *tageratoroptions,
+                              const GtAlphabet *alpha,
+                              const TgrTagwithlength *twl,
+                              uint64_t tagnumber)
+{
+  bool firstitem = true;
+
+  printf("#");
+  if (tageratoroptions->outputmode & TAGOUT_TAGNUM)
+  {
+    printf("\t" Formatuint64_t,PRINTuint64_tcast(tagnumber));
+    firstitem = false;
+  }
+  if (tageratoroptions->outputmode & TAGOUT_TAGLENGTH)
+  {
+    ADDTABULATOR;
+    printf(""GT_WU"",twl->taglen);
+  }
+  if (tageratoroptions->outputmode & TAGOUT_TAGSEQ)
+  {
+    ADDTABULATOR;
+    gt_alphabet_decode_seq_to_fp(alpha,stdout,twl->transformedtag,
+                                 twl->taglen);
+  }
+  printf("\n");
+}
+
+GT_DECLAREARRAYSTRUCT(GtIdxMatch);
+
+/* Tags collected for a simultaneous online search. Pattern <2*i> is the
+   forward and pattern <2*i+1> the reverse complemented strand of tag <i>. */
+
+typedef struct
+{
+  TgrTagwithlength *tags;
+  uint64_t *tagnumbers;
+  const GtUchar **patterns;
+  GtUword *patternlengths,
+          *patternnum2storeidx,
+          numoftags,
+          maxnumoftags;
+  GtArrayGtIdxMatch *storedmatches;
+} TgrOnlinebatch;
+
+static void tgr_onlinebatch_init(TgrOnlinebatch *batch,GtUword maxnumoftags)
+{
+  GtUword idx;
+
+  batch->maxnumoftags = maxnumoftags;
+  batch->numoftags = 0;
+  batch->tags = gt_malloc(sizeof *batch->tags * maxnumoftags);
+  batch->tagnumbers = gt_malloc(sizeof *batch->tagnumbers * maxnumoftags);
+  batch->patterns = gt_malloc(sizeof *batch->patterns * 2 * maxnumoftags);
+  batch->patternlengths
+    = gt_malloc(sizeof *batch->patternlengths * 2 * maxnumoftags);
+  batch->patternnum2storeidx
+    = gt_malloc(sizeof *batch->patternnum2storeidx * 2 * maxnumoftags);
+  batch->storedmatches
+    = gt_malloc(sizeof *batch->storedmatches * 2 * maxnumoftags);
+  for (idx = 0; idx < 2 * maxnumoftags; idx++)
+  {
+    GT_INITARRAY(batch->storedmatches + idx,GtIdxMatch);
+  }
+}
+
+static void tgr_onlinebatch_wrap(TgrOnlinebatch *batch)
+{
+  GtUword idx;
+
+  for (idx = 0; idx < 2 * batch->maxnumoftags; idx++)
+  {
+    GT_FREEARRAY(batch->storedmatches + idx,GtIdxMatch);
+  }
+  gt_free(batch->storedmatches);
+  gt_free(batch->patternnum2storeidx);
+  gt_free(batch->patternlengths);
+  gt_free(batch->patterns);
+  gt_free(batch->tagnumbers);
+  gt_free(batch->tags);
+}
+
+static void tgr_onlinebatch_storematch(void *processinfo,
+                                       GtUword patternnum,
+                                       const GtIdxMatch *match)
+{
+  TgrOnlinebatch *batch = (TgrOnlinebatch *) processinfo;
+
+  GT_STOREINARRAY(batch->storedmatches +
+                  batch->patternnum2storeidx[patternnum],
+                  GtIdxMatch,32,*match);
+}
+
+/* search all tags of the batch in one scan and output the matches tag by
+   tag, in the same order as the search for single tags does */
+
+static void tgr_onlinebatch_process(TgrOnlinebatch *batch,
+                                    const TageratorOptions *tageratoroptions,
+                                    const GtAlphabet *alpha,
+                                    Myersonlineresources *mor,
+                                    TgrShowmatchinfo *showmatchinfo)
+{
+  GtUword idx, numofpatterns = 0;
+  int try;
+
+  gt_assert(tageratoroptions->userdefinedmaxdistance >= 0);
+  for (idx = 0; idx < batch->numoftags; idx++)
+  {
+    for (try = 0; try < 2; try++)
+    {
+      batch->storedmatches[GT_MULT2(idx) + try].nextfreeGtIdxMatch = 0;
+      if ((try == 0 && !tageratoroptions->nofwdmatch) ||
+          (try == 1 && !tageratoroptions->norcmatch))
+      {
+        batch->patterns[numofpatterns]
+          = try == 0 ? batch->tags[idx].transformedtag
+                     : batch->tags[idx].rctransformedtag;
+        batch->patternlengths[numofpatterns] = batch->tags[idx].taglen;
+        batch->patternnum2storeidx[numofpatterns] = GT_MULT2(idx) + try;
+        numofpatterns++;
+      }
+    }
+  }
+  gt_edistmyersbitvectorAPM_multi(mor,batch->patterns,batch->patternlengths,
+                                  numofpatterns,
+                                  (GtUword)
+                                  tageratoroptions->userdefinedmaxdistance,
+                                  tgr_onlinebatch_storematch,
+                                  batch);
+  for (idx = 0; idx < batch->numoftags; idx++)
+  {
+    TgrTagwithlength *twl = batch->tags + idx;
+
+    tgr_showtagheader(tageratoroptions,alpha,twl,batch->tagnumbers[idx]);
+    showmatchinfo->twlptr = twl;
+    for (try = 0; try < 2; try++)
+    {
+      const GtArrayGtIdxMatch *storedmatches
+        = batch->storedmatches + GT_MULT2(idx) + try;
+      GtUword matchnum;
+
+      showmatchinfo->tagptr = twl->tagptr
+                            = try == 0 ? twl->transformedtag
+                                       : twl->rctransformedtag;
+      for (matchnum = 0; matchnum < storedmatches->nextfreeGtIdxMatch;
+           matchnum++)
+      {
+        tgr_showmatch(showmatchinfo,
+                      storedmatches->spaceGtIdxMatch + matchnum);
+      }
+    }
+  }
+  batch->numoftags = 0;
+}
+
 int gt_runtagerator(const TageratorOptions *tageratoroptions,GtError *err)
 {
-  bool haserr = false, firstitem;
+  bool haserr = false;
   int retval;
   Myersonlineresources *mor = NULL;
   Genericindex *genericindex = NULL;
@@ -678,18 +832,29 @@ int gt_runtagerator(const TageratorOptions *tageratoroptions,GtError *err)
     }
     if (!haserr)
     {
+      const bool withbatch = tageratoroptions->doonline &&
+                             tageratoroptions->onlinebatchsize > 1UL;
+      TgrOnlinebatch batch;
+
+      if (withbatch)
+      {
+        tgr_onlinebatch_init(&batch,tageratoroptions->onlinebatchsize);
+      }
       for (tagnumber = 0; !haserr; tagnumber++)
       {
-        retval = gt_seq_iterator_next(seqit, &currenttag, &twl.taglen, &desc,
-                                     err);
+        TgrTagwithlength *twlptr = withbatch ? batch.tags + batch.numoftags
+                                             : &twl;
+
+        retval = gt_seq_iterator_next(seqit, &currenttag, &twlptr->taglen,
+                                      &desc, err);
         if (retval != 1)
         {
           break;
         }
-        if (dotransformtag(twl.transformedtag,
+        if (dotransformtag(twlptr->transformedtag,
                            symbolmap,
                            currenttag,
-                           twl.taglen,
+                           twlptr->taglen,
                            tagnumber,
                            tageratoroptions->replacewildcard,
                            err) != 0)
@@ -697,47 +862,46 @@ int gt_runtagerator(const TageratorOptions *tageratoroptions,GtError *err)
           haserr = true;
           break;
         }
-        gt_copy_reversecomplement(twl.rctransformedtag,twl.transformedtag,
-                               twl.taglen);
-        twl.tagptr = twl.transformedtag;
-        firstitem = true;
-        printf("#");
-        if (tageratoroptions->outputmode & TAGOUT_TAGNUM)
-        {
-          printf("\t" Formatuint64_t,PRINTuint64_tcast(tagnumber));
-          firstitem = false;
-        }
-        if (tageratoroptions->outputmode & TAGOUT_TAGLENGTH)
-        {
-          ADDTABULATOR;
-          printf(""GT_WU"",twl.taglen);
-        }
-        if (tageratoroptions->outputmode & TAGOUT_TAGSEQ)
-        {
-          ADDTABULATOR;
-          gt_alphabet_decode_seq_to_fp(alpha,stdout,twl.transformedtag,
-                                       twl.taglen);
-        }
-        printf("\n");
-        storeoffline.nextfreeTgrSimplematch = 0;
-        storeonline.nextfreeTgrSimplematch = 0;
+        gt_copy_reversecomplement(twlptr->rctransformedtag,
+                                  twlptr->transformedtag,
+                                  twlptr->taglen);
+        twlptr->tagptr = twlptr->transformedtag;
         if (tageratoroptions->userdefinedmaxdistance > 0 &&
-            twl.taglen <= (GtUword)
-                          tageratoroptions->userdefinedmaxdistance)
+            twlptr->taglen <= (GtUword)
+                              tageratoroptions->userdefinedmaxdistance)
         {
+          if (withbatch && batch.numoftags > 0)
+          {
+            tgr_onlinebatch_process(&batch,tageratoroptions,alpha,mor,
+                                    &showmatchinfo);
+          }
+          tgr_showtagheader(tageratoroptions,alpha,twlptr,tagnumber);
           gt_error_set(err,"tag \"%*.*s\" of length "GT_WU"; "
                        "tags must be longer than the allowed number of errors "
                        "(which is "GT_WD")",
-                       (int) twl.taglen,
-                       (int) twl.taglen,currenttag,
-                       twl.taglen,
+                       (int) twlptr->taglen,
+                       (int) twlptr->taglen,currenttag,
+                       twlptr->taglen,
                        tageratoroptions->userdefinedmaxdistance);
           haserr = true;
           break;
         }
         gt_assert(tageratoroptions->userdefinedmaxdistance < 0 ||
-                  twl.taglen > (GtUword)
-                               tageratoroptions->userdefinedmaxdistance);
+                  twlptr->taglen > (GtUword)
+                                   tageratoroptions->userdefinedmaxdistance);
+        if (withbatch)
+        {
+          batch.tagnumbers[batch.numoftags++] = tagnumber;
+          if (batch.numoftags == batch.maxnumoftags)
+          {
+            tgr_onlinebatch_process(&batch,tageratoroptions,alpha,mor,
+                                    &showmatchinfo);
+          }
+          continue;
+        }
+        tgr_showtagheader(tageratoroptions,alpha,&twl,tagnumber);
+        storeoffline.nextfreeTgrSimplematch = 0;
+        storeonline.nextfreeTgrSimplematch = 0;
         searchoverstrands(tageratoroptions,
                           &twl,
                           dfst,
@@ -747,6 +911,15 @@ int gt_runtagerator(const TageratorOptions *tageratoroptions,GtError *err)
                           &storeonline,
                           &storeoffline);
       }
+      if (withbatch)
+      {
+        if (batch.numoftags > 0)
+        {
+          tgr_onlinebatch_process(&batch,tageratoroptions,alpha,mor,
+                                  &showmatchinfo);
+        }
+        tgr_onlinebatch_wrap(&batch);
+      }
       gt_seq_iterator_delete(seqit);
     }
     GT_FREEARRAY(&storeonline,TgrSimplematch);
@@ -26,6 +26,7 @@
 #include "gth/gt_gthbssmrmsd.h"
 #include "gth/gt_gthbssmtrain.h"
 #include "gth/gt_gthmkbssmfiles.h"
+#include "gth/gt_gthsplit.h"
 #include "tools/gt_compressedbits.h"
 #include "tools/gt_condenser.h"
 #include "tools/gt_consensus_sa.h"
@@ -62,6 +63,7 @@ static void* gt_dev_arguments_new(void)
   gt_toolbox_add(dev_toolbox, "gthbssmfileinfo", gt_gthbssmfileinfo);
   gt_toolbox_add(dev_toolbox, "gthbssmprint", gt_gthbssmprint);
   gt_toolbox_add(dev_toolbox, "gthmkbssmfiles", gt_gthmkbssmfiles);
+  gt_toolbox_add(dev_toolbox, "gthsplit", gt_gthsplit_without_plugins);
   gt_toolbox_add(dev_toolbox, "guessprot", gt_guessprot);
   gt_toolbox_add(dev_toolbox, "mergeesa", gt_mergeesa);
   gt_toolbox_add(dev_toolbox, "paircmp", gt_paircmp);
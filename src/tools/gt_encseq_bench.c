@@ -16,24 +16,34 @@
   OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 */
 
+#include <string.h>
 #include "core/ma.h"
 #include "core/unused_api.h"
 #include "core/encseq.h"
 #include "core/encseq_metadata.h"
+#include "core/encseq_workload.h"
+#include "core/fa.h"
+#include "core/fileutils_api.h"
 #include "core/mathsupport.h"
 #include "core/showtime.h"
 #include "core/logger.h"
+#include "core/xposix.h"
 #include "tools/gt_encseq_bench.h"
 
 typedef struct
 {
-  GtUword ccext;
-  bool sortlenprepare, verbose;
+  GtUword ccext, ops;
+  bool sortlenprepare, verbose,
+       workload[GT_ENCSEQ_WORKLOAD_UNDEFINED];
+  GtStrArray *workloads, *sats;
 } GtEncseqBenchArguments;
 
 static void* gt_encseq_bench_arguments_new(void)
 {
-  GtEncseqBenchArguments *arguments = gt_malloc(sizeof *arguments);
+  GtEncseqBenchArguments *arguments = gt_calloc((size_t) 1,
+                                                sizeof *arguments);
+  arguments->workloads = gt_str_array_new();
+  arguments->sats = gt_str_array_new();
   return arguments;
 }
 
@@ -43,6 +53,8 @@ static void gt_encseq_bench_arguments_delete(void *tool_arguments)
 
   if (arguments != NULL)
   {
+    gt_str_array_delete(arguments->workloads);
+    gt_str_array_delete(arguments->sats);
     gt_free(arguments);
   }
 }
@@ -69,6 +81,27 @@ static GtOptionParser* gt_encseq_bench_option_parser_new(void *tool_arguments)
                                &arguments->sortlenprepare, false);
   gt_option_parser_add_option(op, option);
 
+  option = gt_option_new_string_array("workload", "measure the given "
+                                      "workloads: sequential, random, range, "
+                                      "seqnum, seqstartpos, specialranges or "
+                                      "all",
+                                      arguments->workloads);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_uword("ops", "specify number of operations of the "
+                                      "random workloads",
+                               &arguments->ops,
+                               GT_ENCSEQ_WORKLOAD_DEFAULT_OPS);
+  gt_option_parser_add_option(op, option);
+
+  option = gt_option_new_string_array("sat", "measure the workloads for the "
+                                      "given sequence representations "
+                                      "(or all) instead of the one of the "
+                                      "index; the sequence files of the index "
+                                      "are encoded into temporary indexes",
+                                      arguments->sats);
+  gt_option_parser_add_option(op, option);
+
   option = gt_option_new_verbose(&arguments->verbose);
   gt_option_parser_add_option(op, option);
 
@@ -76,6 +109,61 @@ static GtOptionParser* gt_encseq_bench_option_parser_new(void *tool_arguments)
   return op;
 }
 
+static int gt_encseq_bench_arguments_check(GT_UNUSED int rest_argc,
+                                           void *tool_arguments,
+                                           GtError *err)
+{
+  GtEncseqBenchArguments *arguments = tool_arguments;
+  GtUword idx;
+  int had_err = 0;
+
+  gt_error_check(err);
+  gt_assert(arguments != NULL);
+  for (idx = 0; !had_err && idx < gt_str_array_size(arguments->workloads);
+       idx++)
+  {
+    const char *name = gt_str_array_get(arguments->workloads, idx);
+    GtEncseqWorkload workload;
+
+    if (strcmp(name, "all") == 0)
+    {
+      for (workload = 0; workload < GT_ENCSEQ_WORKLOAD_UNDEFINED; workload++)
+        arguments->workload[workload] = true;
+    } else
+    {
+      workload = gt_encseq_workload_get(name);
+      if (workload == GT_ENCSEQ_WORKLOAD_UNDEFINED)
+      {
+        gt_error_set(err, "illegal argument \"%s\" to option -workload: "
+                          "must be one of the following keywords: %s, all",
+                     name, gt_encseq_workload_list());
+        had_err = -1;
+      } else
+        arguments->workload[workload] = true;
+    }
+  }
+  for (idx = 0; !had_err && idx < gt_str_array_size(arguments->sats); idx++)
+  {
+    const char *name = gt_str_array_get(arguments->sats, idx);
+
+    if (strcmp(name, "all") != 0 &&
+        gt_encseq_access_type_get(name) == GT_ACCESS_TYPE_UNDEFINED)
+    {
+      gt_error_set(err, "illegal argument \"%s\" to option -sat: "
+                        "must be one of the following keywords: %s, all",
+                   name, gt_encseq_access_type_list());
+      had_err = -1;
+    }
+  }
+  if (!had_err && gt_str_array_size(arguments->sats) > 0 &&
+      gt_str_array_size(arguments->workloads) == 0)
+  {
+    gt_error_set(err, "option -sat requires option -workload");
+    had_err = -1;
+  }
+  return had_err;
+}
+
 static void gt_bench_character_extractions(const GtEncseq *encseq,
                                            GtUword ccext)
 {
@@ -263,6 +351,149 @@ GtUword gt_sortedlengthinfo_seqstart(const GtEncseq *encseq,
   }
 }
 
+static void gt_encseq_bench_workloads(const GtEncseq *encseq,
+                                      const char *satname,
+                                      const GtEncseqBenchArguments *arguments)
+{
+  GtEncseqWorkload workload;
+
+  for (workload = 0; workload < GT_ENCSEQ_WORKLOAD_UNDEFINED; workload++)
+  {
+    if (arguments->workload[workload])
+    {
+      if (!gt_encseq_workload_applicable(encseq, workload))
+      {
+        printf("%s\t%s\tnot applicable\n", satname,
+               gt_encseq_workload_str(workload));
+      } else
+      {
+        GtUword processed;
+        double seconds = gt_encseq_workload_run(encseq, workload,
+                                                arguments->ops, &processed);
+
+        printf("%s\t%s\t"GT_WU"\t%.3f\t%.2f\n", satname,
+               gt_encseq_workload_str(workload), processed, seconds,
+               processed > 0 ? seconds * 1e9 / (double) processed : 0.0);
+      }
+    }
+  }
+}
+
+static bool gt_encseq_bench_sat_selected(const GtStrArray *sats,
+                                         GtEncseqAccessType sat)
+{
+  GtUword idx;
+
+  for (idx = 0; idx < gt_str_array_size(sats); idx++)
+  {
+    const char *name = gt_str_array_get(sats, idx);
+
+    if (strcmp(name, "all") == 0 || gt_encseq_access_type_get(name) == sat)
+      return true;
+  }
+  return false;
+}
+
+/* Encodes the sequence files of <encseq> in each selected representation
+   into a temporary index and measures the workloads on it. If all
+   representations are requested, the ones not applicable to the input are
+   reported and skipped. */
+static int gt_encseq_bench_representations(const GtEncseq *encseq,
+                                           const GtEncseqBenchArguments
+                                             *arguments,
+                                           GtError *err)
+{
+  const char *suffixes[] = {"", GT_ENCSEQFILESUFFIX, GT_SSPTABFILESUFFIX,
+                            GT_ALPHABETFILESUFFIX};
+  const GtAlphabet *alphabet = gt_encseq_alphabet(encseq);
+  const GtStrArray *filenames = gt_encseq_filenames(encseq);
+  GtStrArray *seqfiles;
+  GtStr *tmpindex, *smapfile = NULL;
+  GtEncseqEncoder *ee;
+  GtEncseqLoader *el;
+  GtEncseqAccessType sat;
+  GtUword idx;
+  bool all = gt_encseq_bench_sat_selected(arguments->sats,
+                                          GT_ACCESS_TYPE_UNDEFINED);
+  int had_err = 0;
+
+  tmpindex = gt_str_new();
+  gt_fa_xfclose(gt_xtmpfp(tmpindex));
+  seqfiles = gt_str_array_new();
+  for (idx = 0; idx < gt_str_array_size(filenames); idx++)
+    gt_str_array_add_cstr(seqfiles, gt_str_array_get(filenames, idx));
+  ee = gt_encseq_encoder_new();
+  gt_encseq_encoder_disable_description_support(ee);
+  gt_encseq_encoder_disable_md5_support(ee);
+  if (gt_alphabet_is_dna(alphabet))
+    gt_encseq_encoder_set_input_dna(ee);
+  else if (gt_alphabet_is_protein(alphabet))
+    gt_encseq_encoder_set_input_protein(ee);
+  else
+  {
+    smapfile = gt_str_clone(tmpindex);
+    gt_str_append_cstr(smapfile, "-smap");
+    had_err = gt_alphabet_to_file(alphabet, gt_str_get(smapfile), err);
+    gt_str_append_cstr(smapfile, GT_ALPHABETFILESUFFIX);
+    if (!had_err)
+      had_err = gt_encseq_encoder_use_symbolmap_file(ee, gt_str_get(smapfile),
+                                                     err);
+  }
+  el = gt_encseq_loader_new();
+  for (sat = 0; !had_err && sat < GT_ACCESS_TYPE_UNDEFINED; sat++)
+  {
+    GtEncseq *tmpencseq;
+
+    if (!gt_encseq_bench_sat_selected(arguments->sats, sat))
+      continue;
+    had_err = gt_encseq_encoder_use_representation(ee,
+                                             gt_encseq_access_type_str(sat),
+                                             err);
+    if (!had_err &&
+        gt_encseq_encoder_encode(ee, seqfiles, gt_str_get(tmpindex), err) != 0)
+    {
+      if (all)
+      {
+        printf("# %s: %s\n", gt_encseq_access_type_str(sat), gt_error_get(err));
+        gt_error_unset(err);
+        continue;
+      }
+      had_err = -1;
+    }
+    if (!had_err)
+    {
+      tmpencseq = gt_encseq_loader_load(el, gt_str_get(tmpindex), err);
+      if (tmpencseq == NULL)
+        had_err = -1;
+      else
+      {
+        gt_encseq_bench_workloads(tmpencseq, gt_encseq_access_type_str(sat),
+                                  arguments);
+        gt_encseq_delete(tmpencseq);
+      }
+    }
+  }
+  for (idx = 0; idx < sizeof (suffixes)/sizeof (suffixes[0]); idx++)
+  {
+    if (gt_file_exists_with_suffix(gt_str_get(tmpindex), suffixes[idx]))
+    {
+      GtStr *path = gt_str_clone(tmpindex);
+
+      gt_str_append_cstr(path, suffixes[idx]);
+      gt_xunlink(gt_str_get(path));
+      gt_str_delete(path);
+    }
+  }
+  if (smapfile != NULL && gt_file_exists(gt_str_get(smapfile)))
+    gt_xunlink(gt_str_get(smapfile));
+  gt_encseq_loader_delete(el);
+  gt_encseq_encoder_delete(ee);
+  gt_str_array_delete(seqfiles);
+  gt_str_delete(smapfile);
+  gt_str_delete(tmpindex);
+  return had_err;
+}
+
 static int gt_encseq_bench_runner(GT_UNUSED int argc, const char **argv,
                                   int parsed_args, void *tool_arguments,
                                   GtError *err)
@@ -327,6 +558,17 @@ static int gt_encseq_bench_runner(GT_UNUSED int argc, const char **argv,
       gt_logger_log(logger,"perform character extractions");
       gt_bench_character_extractions(encseq,arguments->ccext);
     }
+    if (!had_err && gt_str_array_size(arguments->workloads) > 0) {
+      printf("# representation\tworkload\tprocessed\tseconds\t"
+             "ns per item\n");
+      if (gt_str_array_size(arguments->sats) == 0) {
+        GtEncseqAccessType sat = gt_encseq_accesstype_get(encseq);
+        gt_encseq_bench_workloads(encseq, gt_encseq_access_type_str(sat),
+                                  arguments);
+      }
+      else
+        had_err = gt_encseq_bench_representations(encseq, arguments, err);
+    }
   }
   gt_encseq_delete(encseq);
   gt_encseq_loader_delete(encseq_loader);
@@ -339,6 +581,6 @@ GtTool* gt_encseq_bench(void)
   return gt_tool_new(gt_encseq_bench_arguments_new,
                      gt_encseq_bench_arguments_delete,
                      gt_encseq_bench_option_parser_new,
-                     NULL,
+                     gt_encseq_bench_arguments_check,
                      gt_encseq_bench_runner);
 }
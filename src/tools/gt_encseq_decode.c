@@ -19,10 +19,12 @@
 #include <string.h>
 #include "core/ma.h"
 #include "core/chardef.h"
-#include "core/encseq_api.h"
+#include "core/encseq.h"
 #include "core/encseq_options.h"
 #include "core/fasta_separator.h"
 #include "core/log_api.h"
+#include "core/minmax.h"
+#include "core/multithread_api.h"
 #include "core/readmode.h"
 #include "core/undef_api.h"
 #include "core/unused_api.h"
@@ -30,6 +32,9 @@
 #include "core/xansi_api.h"
 #include "tools/gt_encseq_decode.h"
 
+/* number of sequence characters decoded into one output buffer */
+#define GT_ENCSEQ_DECODE_BATCHSIZE  ((GtUword) (1UL << 22))
+
 typedef struct {
   bool singlechars;
   GtStr *mode,
@@ -39,7 +44,8 @@ typedef struct {
   GtEncseqOptions *eopts;
   GtReadmode rm;
   GtStr *dir;
-  GtUword seq;
+  GtUword seq,
+          width;
 } GtEncseqDecodeArguments;
 
 static void* gt_encseq_decode_arguments_new(void)
@@ -108,6 +114,10 @@ static GtOptionParser* gt_encseq_decode_option_parser_new(void *tool_arguments)
   gt_option_parser_add_option(op, optionseqrange);
   gt_option_exclude(optionseqrange, optionseq);
 
+  /* -width */
+  option = gt_option_new_width(&arguments->width);
+  gt_option_parser_add_option(op, option);
+
   /* -output */
   optionmode = gt_option_new_choice("output",
                                     "specify output format "
@@ -172,9 +182,194 @@ int gt_encseq_decode_arguments_check(GT_UNUSED int rest_argc,
                       "'-output concat' option");
     had_err = -1;
   }
+  if (!had_err && args->width > 0
+        && strcmp(gt_str_get(args->mode), "fasta") != 0) {
+    gt_error_set(err, "'-width' can only be used with the "
+                      "'-output fasta' option");
+    had_err = -1;
+  }
   return had_err;
 }
 
+/* Returns the description of the <seqnum>-th sequence in the readmode given
+   in <args> and stores its length in <desclen>. The start position and the
+   length of the sequence are stored in <startpos> and <len>. If <encseq> has
+   no description support, a description is written to <buf>. */
+static const char* sequence_info(const GtEncseq *encseq,
+                                 const GtEncseqDecodeArguments *args,
+                                 bool has_desc,
+                                 GtUword seqnum,
+                                 GtUword *startpos,
+                                 GtUword *len,
+                                 GtUword *desclen,
+                                 char *buf)
+{
+  const char *desc = NULL;
+  GtUword descseqnum = seqnum;
+  /* XXX: maybe make this distinction in the functions via readmode? */
+  if (!GT_ISDIRREVERSE(args->rm)) {
+    *startpos = gt_encseq_seqstartpos(encseq, seqnum);
+    *len = gt_encseq_seqlength(encseq, seqnum);
+  } else {
+    descseqnum = gt_encseq_num_of_sequences(encseq) - 1 - seqnum;
+    *len = gt_encseq_seqlength(encseq, descseqnum);
+    *startpos = gt_encseq_total_length(encseq)
+                  - (gt_encseq_seqstartpos(encseq, descseqnum) + *len);
+  }
+  if (has_desc) {
+    desc = gt_encseq_description(encseq, desclen, descseqnum);
+  } else {
+    (void) snprintf(buf, BUFSIZ, "sequence "GT_WU"", seqnum);
+    *desclen = strlen(buf);
+    desc = buf;
+  }
+  gt_assert(desc);
+  return desc;
+}
+
+typedef struct {
+  GtUword firstseq,
+          endseq;
+  char *buf;
+  GtUword used,
+          allocated;
+} GtEncseqDecodeBatch;
+
+typedef struct {
+  const GtEncseq *encseq;
+  const GtEncseqDecodeArguments *args;
+  bool has_desc;
+  GtEncseqDecodeBatch *batches;
+  GtUword numofbatches,
+          nextbatch;
+  GtMutex *mutex;
+} GtEncseqDecodeThreadInfo;
+
+/* Appends the FASTA entries of the sequences of <batch> to its buffer. The
+   sequence of each entry is decoded directly into the buffer and the line
+   breaks are inserted afterwards, moving the lines from the last to the
+   first. */
+static void decode_batch(GtEncseqDecodeBatch *batch, GtEncseqReader *esr,
+                         const GtEncseqDecodeThreadInfo *info)
+{
+  const GtEncseqDecodeArguments *args = info->args;
+  GtUword i;
+
+  batch->used = 0;
+  for (i = batch->firstseq; i < batch->endseq; i++) {
+    GtUword desclen, startpos, len, numoflines = 0, line, needed;
+    char buf[BUFSIZ], *seqbuf;
+    const char *desc = sequence_info(info->encseq, args, info->has_desc, i,
+                                     &startpos, &len, &desclen, buf);
+
+    if (len > 0)
+      numoflines = args->width > 0 ? (len - 1) / args->width + 1 : 1;
+    needed = batch->used + desclen + len + numoflines + 3;
+    if (needed > batch->allocated) {
+      batch->allocated = MAX(needed, batch->allocated + batch->allocated / 2);
+      batch->buf = gt_realloc(batch->buf,
+                              sizeof (*batch->buf) * batch->allocated);
+    }
+    batch->buf[batch->used++] = GT_FASTA_SEPARATOR;
+    memcpy(batch->buf + batch->used, desc, (size_t) desclen);
+    batch->used += desclen;
+    batch->buf[batch->used++] = '\n';
+    seqbuf = batch->buf + batch->used;
+    if (len > 0) {
+      if (args->rm == GT_READMODE_FORWARD) {
+        gt_encseq_extract_decoded_with_reader(info->encseq, esr, seqbuf,
+                                              startpos, startpos + len - 1);
+      } else {
+        GtUword j;
+        gt_encseq_reader_reinit_with_readmode(esr, info->encseq, args->rm,
+                                              startpos);
+        for (j = 0; j < len; j++)
+          seqbuf[j] = gt_encseq_reader_next_decoded_char(esr);
+      }
+      for (line = numoflines - 1; line > 0; line--) {
+        GtUword linestart = line * args->width;
+        memmove(seqbuf + linestart + line, seqbuf + linestart,
+                (size_t) MIN(args->width, len - linestart));
+        seqbuf[linestart + line - 1] = '\n';
+      }
+      batch->used += len + numoflines - 1;
+    }
+    batch->buf[batch->used++] = '\n';
+  }
+}
+
+static void* decode_batches_thread(void *data)
+{
+  GtEncseqDecodeThreadInfo *info = data;
+  GtEncseqReader *esr;
+  GtUword batchnum;
+  gt_assert(info);
+  esr = gt_encseq_create_reader_with_readmode(info->encseq, info->args->rm, 0);
+  for (;;) {
+    gt_mutex_lock(info->mutex);
+    batchnum = info->nextbatch++;
+    gt_mutex_unlock(info->mutex);
+    if (batchnum >= info->numofbatches)
+      break;
+    decode_batch(info->batches + batchnum, esr, info);
+  }
+  gt_encseq_reader_delete(esr);
+  return NULL;
+}
+
+/* Shows the sequences from <sfrom> to <sto> - 1 in FASTA format. The
+   sequences are split into batches of about <GT_ENCSEQ_DECODE_BATCHSIZE>
+   characters, which are decoded by <gt_jobs> threads and shown in order. */
+static void output_fasta_batches(const GtEncseq *encseq,
+                                 const GtEncseqDecodeArguments *args,
+                                 bool has_desc,
+                                 GtUword sfrom,
+                                 GtUword sto)
+{
+  GtEncseqDecodeThreadInfo info;
+  GtUword i, b, maxbatches, seqnum = sfrom;
+  GtError *err;
+
+  info.encseq = encseq;
+  info.args = args;
+  info.has_desc = has_desc;
+  maxbatches = (GtUword) MAX(2U * gt_jobs, 1U);
+  info.batches = gt_calloc((size_t) maxbatches, sizeof (*info.batches));
+  info.mutex = gt_mutex_new();
+  err = gt_error_new();
+  while (seqnum < sto) {
+    for (b = 0; b < maxbatches && seqnum < sto; b++) {
+      GtUword numofchars = 0;
+      info.batches[b].firstseq = seqnum;
+      while (seqnum < sto && numofchars < GT_ENCSEQ_DECODE_BATCHSIZE) {
+        numofchars += gt_encseq_seqlength(encseq,
+                                          GT_ISDIRREVERSE(args->rm)
+                                          ? gt_encseq_num_of_sequences(encseq)
+                                              - 1 - seqnum
+                                          : seqnum) + 1;
+        seqnum++;
+      }
+      info.batches[b].endseq = seqnum;
+    }
+    info.numofbatches = b;
+    info.nextbatch = 0;
+    /* if no threads can be started, the batches are decoded sequentially */
+    if (gt_jobs == 1U || info.numofbatches == 1UL ||
+        gt_multithread(decode_batches_thread, &info, err) != 0) {
+      (void) decode_batches_thread(&info);
+    }
+    for (b = 0; b < info.numofbatches; b++) {
+      gt_xfwrite(info.batches[b].buf, 1, (size_t) info.batches[b].used,
+                 stdout);
+    }
+  }
+  gt_error_delete(err);
+  gt_mutex_delete(info.mutex);
+  for (i = 0; i < maxbatches; i++)
+    gt_free(info.batches[i].buf);
+  gt_free(info.batches);
+}
+
 static int output_sequence(GtEncseq *encseq, GtEncseqDecodeArguments *args,
                            const char *filename, GtError *err)
 {
@@ -219,61 +414,28 @@ static int output_sequence(GtEncseq *encseq, GtEncseqDecodeArguments *args,
       sfrom = 0;
       sto = gt_encseq_num_of_sequences(encseq);
     }
-    for (i = sfrom; i < sto; i++) {
-      GtUword desclen, startpos, len;
-      char buf[BUFSIZ];
-      const char *desc = NULL;
-      /* XXX: maybe make this distinction in the functions via readmode? */
-      if (!GT_ISDIRREVERSE(args->rm)) {
-        startpos = gt_encseq_seqstartpos(encseq, i);
-        len = gt_encseq_seqlength(encseq, i);
-        if (has_desc) {
-          desc = gt_encseq_description(encseq, &desclen, i);
-        } else {
-          (void) snprintf(buf, BUFSIZ, "sequence "GT_WU"", i);
-          desclen = strlen(buf);
-          desc = buf;
-        }
-      } else {
-        startpos = gt_encseq_seqstartpos(encseq, i);
-        len = gt_encseq_seqlength(encseq,
-                                  gt_encseq_num_of_sequences(encseq)-1-i);
-        startpos = gt_encseq_total_length(encseq)
-                     - (gt_encseq_seqstartpos(encseq,
-                                              gt_encseq_num_of_sequences(
-                                                encseq)-1-i) + len);
-        if (has_desc) {
-          desc = gt_encseq_description(encseq,
-                                       &desclen,
-                                       gt_encseq_num_of_sequences(encseq)-1-i);
-        } else {
-          (void) snprintf(buf, BUFSIZ, "sequence "GT_WU"", i);
-          desclen = strlen(buf);
-          desc = buf;
-        }
-      }
-      gt_assert(desc);
-      /* output description */
-      gt_xfputc(GT_FASTA_SEPARATOR, stdout);
-      gt_xfwrite(desc, 1, desclen, stdout);
-      gt_xfputc('\n', stdout);
-      /* XXX: make this more efficient by writing in a buffer first and then
-         showing the result */
-      if (args->singlechars) {
-        for (j = 0; j < len; j++) {
-           gt_xfputc(gt_encseq_get_decoded_char(encseq,
-                                                startpos + j,
-                                                args->rm),
-                     stdout);
-        }
-      } else {
-        esr = gt_encseq_create_reader_with_readmode(encseq, args->rm, startpos);
+    if (args->singlechars) {
+      for (i = sfrom; i < sto; i++) {
+        GtUword desclen, startpos, len;
+        char buf[BUFSIZ];
+        const char *desc = sequence_info(encseq, args, has_desc, i, &startpos,
+                                         &len, &desclen, buf);
+        /* output description */
+        gt_xfputc(GT_FASTA_SEPARATOR, stdout);
+        gt_xfwrite(desc, 1, desclen, stdout);
+        gt_xfputc('\n', stdout);
         for (j = 0; j < len; j++) {
-           gt_xfputc(gt_encseq_reader_next_decoded_char(esr), stdout);
+          if (args->width > 0 && j > 0 && j % args->width == 0)
+            gt_xfputc('\n', stdout);
+          gt_xfputc(gt_encseq_get_decoded_char(encseq,
+                                               startpos + j,
+                                               args->rm),
+                    stdout);
         }
-        gt_encseq_reader_delete(esr);
+        gt_xfputc('\n', stdout);
       }
-      gt_xfputc('\n', stdout);
+    } else {
+      output_fasta_batches(encseq, args, has_desc, sfrom, sto);
     }
   }
 
@@ -300,6 +462,21 @@ static int output_sequence(GtEncseq *encseq, GtEncseqDecodeArguments *args,
             cc = gt_str_get(args->sepchar)[0];
           gt_xfputc(cc, stdout);
         }
+      } else if (args->rm == GT_READMODE_FORWARD) {
+        char *buf = gt_malloc(sizeof (*buf) * GT_ENCSEQ_DECODE_BATCHSIZE);
+        esr = gt_encseq_create_reader_with_readmode(encseq, args->rm, from);
+        for (j = from; j <= to; j += GT_ENCSEQ_DECODE_BATCHSIZE) {
+          GtUword k, chunklen = MIN(GT_ENCSEQ_DECODE_BATCHSIZE, to - j + 1);
+          gt_encseq_extract_decoded_with_reader(encseq, esr, buf, j,
+                                                j + chunklen - 1);
+          for (k = 0; k < chunklen; k++) {
+            if (buf[k] == (char) SEPARATOR)
+              buf[k] = gt_str_get(args->sepchar)[0];
+          }
+          gt_xfwrite(buf, 1, (size_t) chunklen, stdout);
+        }
+        gt_encseq_reader_delete(esr);
+        gt_free(buf);
       } else {
         esr = gt_encseq_create_reader_with_readmode(encseq, args->rm, from);
         if (esr) {
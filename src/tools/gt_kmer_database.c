@@ -46,13 +46,17 @@ typedef struct {
                mean_cutoff,
                use_hash,
                bench;
-  GtStr        *print_filename;
+  GtStr        *print_filename,
+               *save_indexname,
+               *load_indexname;
 } GtKmerDatabaseArguments;
 
 static void* gt_kmer_database_arguments_new(void)
 {
   GtKmerDatabaseArguments *arguments = gt_calloc((size_t) 1, sizeof *arguments);
   arguments->print_filename = gt_str_new();
+  arguments->save_indexname = gt_str_new();
+  arguments->load_indexname = gt_str_new();
   return arguments;
 }
 
@@ -61,6 +65,8 @@ static void gt_kmer_database_arguments_delete(void *tool_arguments)
   GtKmerDatabaseArguments *arguments = tool_arguments;
   if (arguments != NULL) {
     gt_str_delete(arguments->print_filename);
+    gt_str_delete(arguments->save_indexname);
+    gt_str_delete(arguments->load_indexname);
     gt_free(arguments);
   }
 }
@@ -70,6 +76,7 @@ static GtOptionParser* gt_kmer_database_option_parser_new(void *tool_arguments)
   GtKmerDatabaseArguments *arguments = tool_arguments;
   GtOptionParser *op;
   GtOption *option,
+           *option_merge_only,
            *option_verbose,
            *option_use_cutoff,
            *option_hash,
@@ -92,12 +99,13 @@ static GtOptionParser* gt_kmer_database_option_parser_new(void *tool_arguments)
   gt_option_parser_add_option(op, option_verbose);
 
   /* -merge_only */
-  option = gt_option_new_bool("merge_only", "only uses merge to build DB, "
-                              "doesn_t build two DBs to compare merge with a "
-                              "different method (much faster). It also allows "
-                              "for random intervals which are biffer than the "
-                              "maximum buffer size (will be split internally).",
-                              &arguments->merge_only, false);
+  option_merge_only = option =
+    gt_option_new_bool("merge_only", "only uses merge to build DB, "
+                       "doesn_t build two DBs to compare merge with a "
+                       "different method (much faster). It also allows "
+                       "for random intervals which are biffer than the "
+                       "maximum buffer size (will be split internally).",
+                       &arguments->merge_only, false);
   gt_option_parser_add_option(op, option);
 
   /* -use_cutoff */
@@ -160,6 +168,27 @@ static GtOptionParser* gt_kmer_database_option_parser_new(void *tool_arguments)
                                 arguments->print_filename, NULL);
   gt_option_parser_add_option(op, option);
 
+  /* -save */
+  option = gt_option_new_string("save", "add all kmers of the input as one "
+                                "interval and write the database to the file "
+                                "with the given indexname and suffix "
+                                GT_KMER_DATABASE_FILE_SUFFIX,
+                                arguments->save_indexname, NULL);
+  gt_option_parser_add_option(op, option);
+  gt_option_exclude(option, option_hash);
+
+  /* -load */
+  option = gt_option_new_string("load", "map the database from the file with "
+                                "the given indexname, add the kmers of the "
+                                "part of the input not covered by it and "
+                                "compare the result with a database built "
+                                "from scratch",
+                                arguments->load_indexname, NULL);
+  gt_option_parser_add_option(op, option);
+  gt_option_exclude(option, option_hash);
+  gt_option_exclude(option, option_use_cutoff);
+  gt_option_imply(option, option_merge_only);
+
   return op;
 }
 
@@ -279,7 +308,14 @@ static int gt_kmer_database_runner(GT_UNUSED int argc, const char **argv,
       compare_db = gt_kmer_database_new(gt_alphabet_num_of_chars(alphabet),
                                 arguments->kmersize, arguments->sb_size, es);
     }
-    if (!arguments->use_hash) {
+    if (gt_str_length(arguments->load_indexname) > 0) {
+      db = gt_kmer_database_new_from_file(gt_str_get(arguments->load_indexname),
+                                          arguments->kmersize,
+                                          arguments->sb_size, es, err);
+      if (db == NULL)
+        had_err = -1;
+    }
+    else if (!arguments->use_hash) {
       db = gt_kmer_database_new(gt_alphabet_num_of_chars(alphabet),
                                 arguments->kmersize,
                                 arguments->sb_size, es);
@@ -296,7 +332,7 @@ static int gt_kmer_database_runner(GT_UNUSED int argc, const char **argv,
   }
 
   if (!had_err) {
-    GtUword startpos = 0,
+    GtUword startpos = db == NULL ? 0 : gt_kmer_database_get_covered_length(db),
             endpos;
     GtKmercodeiterator *iter;
     const GtKmercode *kmercode = NULL;
@@ -304,7 +340,13 @@ static int gt_kmer_database_runner(GT_UNUSED int argc, const char **argv,
                                           arguments->kmersize, 0);
     while (!had_err && startpos < es_length - (arguments->kmersize - 1)) {
       GtUword startpos_add_kmer = startpos;
-      if (arguments->merge_only) {
+      if (gt_str_length(arguments->save_indexname) > 0 ||
+          gt_str_length(arguments->load_indexname) > 0) {
+        /* a stored database has to contain all kmers of the covered part, so
+           it is built from one interval, which is split internally */
+        endpos = es_length - 1;
+      }
+      else if (arguments->merge_only) {
         endpos = startpos + (arguments->kmersize - 1) +
                  (gt_rand_max((arguments->sb_size - 1) * 2));
         if (endpos > es_length)
@@ -347,7 +389,20 @@ static int gt_kmer_database_runner(GT_UNUSED int argc, const char **argv,
         gt_kmer_database_print(compare_db, logger, true);
       if (!arguments->merge_only && !had_err && !arguments->bench)
         had_err = gt_kmer_database_compare(compare_db, db, err);
+      if (!had_err && gt_str_length(arguments->load_indexname) > 0) {
+        GtKmerDatabase *scratch_db =
+          gt_kmer_database_new(gt_alphabet_num_of_chars(gt_encseq_alphabet(es)),
+                               arguments->kmersize, arguments->sb_size, es);
+        gt_kmer_database_add_interval(scratch_db, 0, es_length - 1);
+        gt_kmer_database_flush(scratch_db);
+        had_err = gt_kmer_database_compare(scratch_db, db, err);
+        gt_kmer_database_delete(scratch_db);
+      }
       gt_kmer_database_print(db, logger, true);
+      if (!had_err && gt_str_length(arguments->save_indexname) > 0)
+        had_err = gt_kmer_database_write(db,
+                                         gt_str_get(arguments->save_indexname),
+                                         err);
     }
     gt_kmercodeiterator_delete(iter);
   }
@@ -20,6 +20,9 @@
 #include "core/error.h"
 #include "core/ma.h"
 #include "core/option_api.h"
+#ifdef GT_THREADS_ENABLED
+#include "core/thread_api.h"
+#endif
 #include "core/unused_api.h"
 #include "core/versionfunc.h"
 #include "match/eis-voiditf.h"
@@ -378,6 +381,13 @@ static int gt_matstat_runner(GT_UNUSED int argc, GT_UNUSED const char **argv,
   {
     const void *theindex;
     Greedygmatchforwardfunction gmatchforwardfunction;
+    Greedygmatchforwardnewview newviewfunction = NULL;
+    Greedygmatchforwarddeleteview deleteviewfunction = NULL;
+#ifdef GT_THREADS_ENABLED
+    const unsigned int threads = gt_jobs;
+#else
+    const unsigned int threads = 1U;
+#endif
 
     if (arguments->indextype == Fmindextype)
     {
@@ -405,6 +415,8 @@ static int gt_matstat_runner(GT_UNUSED int argc, GT_UNUSED const char **argv,
       {
         gt_assert(arguments->indextype == Packedindextype);
         theindex = (const void *) packedindex;
+        newviewfunction = gt_newvoidBWTSeqview;
+        deleteviewfunction = gt_deletevoidBWTSeqview;
         if (arguments->doms)
         {
           gmatchforwardfunction = gt_voidpackedindexmstatsforward;
@@ -440,6 +452,8 @@ static int gt_matstat_runner(GT_UNUSED int argc, GT_UNUSED const char **argv,
                                       theindex,
                                       totallength,
                                       gmatchforwardfunction,
+                                      newviewfunction,
+                                      deleteviewfunction,
                                       alphabet,
                                       arguments->queryfilenames,
                                       arguments->minlength,
@@ -450,6 +464,7 @@ static int gt_matstat_runner(GT_UNUSED int argc, GT_UNUSED const char **argv,
                                              ? true : false,
                                       (arguments->showmode & SHOWSUBJECTPOS)
                                              ? true : false,
+                                      threads,
                                       err) != 0)
       {
         haserr = true;
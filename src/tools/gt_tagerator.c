@@ -129,6 +129,15 @@ static GtOptionParser* gt_tagerator_option_parser_new(void *tool_arguments)
   gt_option_parser_add_option(op, optiononline);
   gt_option_is_development_option(optiononline);
 
+  option = gt_option_new_uword_min("batch",
+                                   "Search this number of tags in one scan "
+                                   "over the sequence (only with option "
+                                   "-online)",
+                                   &arguments->onlinebatchsize,1UL,1UL);
+  gt_option_parser_add_option(op, option);
+  gt_option_imply(option,optiononline);
+  gt_option_is_development_option(option);
+
   optioncmp = gt_option_new_bool("cmp","compare results of offline and online "
                                  "searches",
                                  &arguments->docompare, false);
@@ -328,6 +328,58 @@ Test do
   grep last_stderr, /can only be used with the/
 end
 
+[["#{$testdata}Atinsert.fna", ["direct", "bit", "uchar", "uint32", "ef"]],
+ ["#{$testdata}RandomN.fna", ["direct", "bit", "uchar", "uint32", "ef"]],
+ ["#{$testdata}at100K1", ["direct", "bit", "uchar", "uint32", "ef"]],
+ ["#{$testdata}foobar.fas", ["eqlen"]],
+ ["#{$testdata}test1.fasta", ["eqlen", "bit"]]].each do |file, sats|
+  sats.each do |sat|
+    Name "gt encseq decode bulk (#{file.split('/').last}, #{sat})"
+    Keywords "encseq gt_encseq_decode bulk"
+    Test do
+      run_test "#{$bin}gt encseq encode -sat #{sat} -indexname foo #{file}"
+      ["", "-width 60", "-width 7"].each do |width|
+        ["fwd", "cpl"].each do |readmode|
+          run_test "#{$bin}gt encseq decode -singlechars -dir #{readmode} " + \
+                   "#{width} foo > singlechars_#{readmode}.fas"
+          run_test "#{$bin}gt encseq decode -dir #{readmode} #{width} foo " + \
+                   "> bulk.fas"
+          run "diff bulk.fas singlechars_#{readmode}.fas"
+        end
+        run_test "#{$bin}gt -j 3 encseq decode #{width} foo > bulk.fas"
+        run "diff bulk.fas singlechars_fwd.fas"
+      end
+      run_test "#{$bin}gt encseq decode -singlechars -output concat foo " + \
+               "> singlechars.seq"
+      run_test "#{$bin}gt encseq decode -output concat foo > bulk.seq"
+      run "diff bulk.seq singlechars.seq"
+      run_test "#{$bin}gt encseq decode -singlechars -output concat " + \
+               "-range 8 14 foo > singlechars.seq"
+      run_test "#{$bin}gt encseq decode -output concat -range 8 14 foo " + \
+               "> bulk.seq"
+      run "diff bulk.seq singlechars.seq"
+    end
+  end
+end
+
+Name "gt encseq decode -width"
+Keywords "encseq gt_encseq_decode bulk"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname foo #{$testdata}Random.fna"
+  run_test "#{$bin}gt encseq decode -width 60 foo > bulk.fas"
+  run "#{$bin}gt seq -showfasta -width 60 #{$testdata}Random.fna > seq.fas"
+  run "diff bulk.fas seq.fas"
+end
+
+Name "gt encseq decode -width (with -output concat)"
+Keywords "encseq gt_encseq_decode bulk"
+Test do
+  run "#{$bin}gt encseq encode -indexname foo #{$testdata}Atinsert.fna"
+  run_test "#{$bin}gt encseq decode -output concat -width 60 foo", \
+           :retval => 1
+  grep last_stderr, /can only be used with the/
+end
+
 Name "gt encseq Lua bindings"
 Keywords "encseq gt_scripts "
 Test do
@@ -442,3 +494,77 @@ Test do
     end
   end
 end
+
+Name "gt encseq encode representation by workload"
+Keywords "encseq gt_encseq_encode satfor"
+Test do
+  ["random", "seqnum"].each do |workload|
+    run_test "#{$bin}gt encseq encode -satfor #{workload} -indexname foo " + \
+             "#{$testdata}Atinsert.fna"
+    run "#{$bin}gt encseq decode foo > foo.fas"
+    run "#{$bin}gt encseq encode -indexname bar #{$testdata}Atinsert.fna"
+    run "#{$bin}gt encseq decode bar"
+    run "diff #{last_stdout} foo.fas"
+  end
+  run_test "#{$bin}gt encseq encode -satfor foo -indexname foo " + \
+           "#{$testdata}Atinsert.fna", :retval => 1
+  grep last_stderr, /undefined workload/
+end
+
+Name "gt encseq bench workloads"
+Keywords "encseq gt_encseq_bench"
+Test do
+  run "#{$bin}gt encseq encode -indexname foo #{$testdata}Atinsert.fna"
+  run_test "#{$bin}gt encseq bench -ops 1000 -workload all -- foo"
+  grep last_stdout, /^bit\tspecialranges/
+  run_test "#{$bin}gt encseq bench -ops 1000 -sat all -workload all -- foo"
+  grep last_stdout, /^uint32\tseqnum/
+  grep last_stdout, /^# eqlen:/
+  run_test "#{$bin}gt encseq bench -workload foo -- foo", :retval => 1
+  grep last_stderr, /illegal argument "foo" to option -workload/
+end
+
+["Atinsert.fna", "U89959_ests.fas", "Random159.fna", "TTT-small.fna"].each do |file|
+  ["bit", "uchar", "uint32"].each do |sat|
+    Name "gt encseq encode Elias-Fano separator table (#{file}, #{sat})"
+    Keywords "encseq gt_encseq_encode sef"
+    Test do
+      run_test "#{$bin}gt encseq encode -sef -sat #{sat} -indexname foo " + \
+               "#{$testdata}#{file}"
+      run_test "#{$bin}gt encseq check foo"
+      run_test "#{$bin}gt encseq check -mirrored foo"
+      run "#{$bin}gt encseq encode -sat #{sat} -indexname foo " + \
+          "#{$testdata}#{file}"
+      if File.exist?("foo.sef") then
+        raise "stale Elias-Fano separator table is kept"
+      end
+    end
+  end
+end
+
+["Atinsert.fna", "RandomN.fna", "U89959_genomic.fas", "TTT-small.fna"].each do |file|
+  Name "gt encseq encode Elias-Fano wildcard ranges (#{file})"
+  Keywords "encseq gt_encseq_encode ef"
+  Test do
+    ["", "-lossless"].each do |lossless|
+      run_test "#{$bin}gt encseq encode #{lossless} -sat ef -indexname foo " + \
+               "#{$testdata}#{file}"
+      run_test "#{$bin}gt encseq check foo"
+      run_test "#{$bin}gt encseq check -mirrored foo"
+      run_test "#{$bin}gt encseq decode #{lossless} foo > ef.fas"
+      run "#{$bin}gt encseq encode #{lossless} -sat uint32 -indexname bar " + \
+          "#{$testdata}#{file}"
+      run "#{$bin}gt encseq decode #{lossless} bar > uint32.fas"
+      run "diff ef.fas uint32.fas"
+      run "rm -f foo.* bar.*"
+    end
+  end
+end
+
+Name "gt encseq encode Elias-Fano separator table without ssp"
+Keywords "encseq gt_encseq_encode sef"
+Test do
+  run_test "#{$bin}gt encseq encode -sef -ssp no -indexname foo " + \
+           "#{$testdata}Atinsert.fna", :retval => 1
+  grep last_stderr, /option "-sef yes" requires "-ssp yes"/
+end
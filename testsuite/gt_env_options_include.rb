@@ -11,3 +11,27 @@ Test do
   run "env GT_ENV_OPTIONS=-spacepeak #{$bin}gt gff3 #{$testdata}standard_gene_as_tree.gff3"
   grep last_stdout, /space peak in megabytes/
 end
+
+Name "$GT_ENV_OPTIONS parsing (-mappolicy)"
+Keywords "gt_env_options mappolicy"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname foo #{$testdata}Atinsert.fna"
+  run_test "#{$bin}gt encseq decode foo"
+  run "mv #{last_stdout} decoded.fas"
+  [["willneed", "willneed"], ["populate", "populate"],
+   ["hugepage", "hugepage"], ["warmup", "warmup"],
+   ["default populate:foo", "populate"]].each do |policies, policy|
+    run_test "env GT_ENV_OPTIONS='-mappolicy #{policies} -mapstats' " + \
+             "#{$bin}gt -j 2 encseq decode foo"
+    grep last_stderr, /files mapped with policy #{policy}/
+    grep last_stderr, /page faults during warm-up/
+    run "diff #{last_stdout} decoded.fas"
+  end
+end
+
+Name "$GT_ENV_OPTIONS parsing (-mappolicy unknown)"
+Keywords "gt_env_options mappolicy"
+Test do
+  run "env GT_ENV_OPTIONS='-mappolicy foo' #{$bin}gt -help"
+  grep last_stderr, /unknown mapping policy/
+end
@@ -8,12 +8,15 @@ allfiles = ["Atinsert.fna",
             "TTT-small.fna",
             "trna_glutamine.fna"]
 
-def makegreedyfwdmatcall(queryfile,indexarg,ms)
-  prog=""
+def makegreedyfwdmatcall(queryfile,indexarg,ms,jobs=1)
+  prog="#{$bin}gt "
+  if jobs > 1
+    prog+="-j #{jobs} "
+  end
   if ms
-    prog="#{$bin}gt matstat -verify"
+    prog+="matstat -verify"
   else
-    prog="#{$bin}gt uniquesub"
+    prog+="uniquesub"
   end
   constantargs="-min 1 -max 20 -query #{queryfile} #{indexarg}"
   return "#{prog} -output querypos #{constantargs}"
@@ -28,6 +31,10 @@ def checkgreedyfwdmat(queryfile,ms)
   run_test(makegreedyfwdmatcall(queryfile,"-pck pck",ms), :maxtime => 1200)
   run "mv #{last_stdout} tmp.pck"
   run "diff tmp.pck tmp.fmi"
+  ["-esa sfx","-pck pck"].each do |indexarg|
+    run_test(makegreedyfwdmatcall(queryfile,indexarg,ms,4), :maxtime => 1200)
+    run "diff #{last_stdout} tmp.fmi"
+  end
 end
 
 def checktagerator(queryfile,ms)
@@ -41,6 +48,12 @@ def checktagerator(queryfile,ms)
              "-withwildcards",:maxtime => 240)
     run_test("#{$bin}gt tagerator -rw -cmp -e 2 -esa sfx -q patternfile " +
              "-withwildcards",:maxtime => 240)
+    run_test("#{$bin}gt tagerator -rw -online -e 2 -esa sfx -q patternfile",
+             :maxtime => 240)
+    run "mv #{last_stdout} online-single.txt"
+    run_test("#{$bin}gt tagerator -rw -online -batch 16 -e 2 -esa sfx " +
+             "-q patternfile",:maxtime => 240)
+    run "cmp -s #{last_stdout} online-single.txt"
     run_test("#{$bin}gt tagerator -rw -cmp -esa sfx -q patternfile " +
              " -maxocc 10",
              :maxtime => 240)
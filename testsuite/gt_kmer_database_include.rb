@@ -65,6 +65,72 @@ Test do
     " 7 kmersize: 10"
 end
 
+Name "gt kmer_database save and extend"
+Keywords "gt_kmer_database persistent"
+Test do
+  run "#{$bin}gt seqfilter -maxseqnum 10 #{$testdata}Atinsert.fna > prefix.fna"
+  FileUtils.copy("#{$testdata}Atinsert.fna", ".")
+  run_test "#{$bin}gt encseq encode prefix.fna"
+  run_test "#{$bin}gt encseq encode Atinsert.fna"
+  [1, 4, 7].each do |k|
+    run_test "#{$bin}gt dev kmer_database -kmersize #{k} -merge_only " \
+      "-bsize 50 -save prefix prefix.fna"
+    run_test "#{$bin}gt dev kmer_database -kmersize #{k} -merge_only " \
+      "-bsize 60 -load prefix -save full Atinsert.fna"
+    run_test "#{$bin}gt dev kmer_database -kmersize #{k} -merge_only " \
+      "-load full Atinsert.fna"
+  end
+  run_test "#{$bin}gt dev kmer_database -kmersize 7 -merge_only " \
+    "-load full prefix.fna", :retval => 1
+  grep last_stderr, "was not built for a prefix"
+end
+
+Name "gt kmer_database save to loaded file"
+Keywords "gt_kmer_database persistent"
+Test do
+  FileUtils.copy("#{$testdata}Atinsert.fna", ".")
+  run_test "#{$bin}gt encseq encode Atinsert.fna"
+  run_test "#{$bin}gt dev kmer_database -kmersize 4 -merge_only " \
+    "-save db Atinsert.fna"
+  run "cp db.kdb orig.kdb"
+  run_test "#{$bin}gt dev kmer_database -kmersize 4 -merge_only " \
+    "-load db -save db Atinsert.fna"
+  run "cmp db.kdb orig.kdb"
+  if File.exist?("db.kdb.tmp") then
+    raise "temporary kmer database file is kept"
+  end
+end
+
+Name "gt kmer_database load mismatching file"
+Keywords "gt_kmer_database persistent fail"
+Test do
+  FileUtils.copy("#{$testdata}Atinsert.fna", ".")
+  run_test "#{$bin}gt encseq encode Atinsert.fna"
+  run_test "#{$bin}gt dev kmer_database -kmersize 4 -merge_only " \
+    "-save db Atinsert.fna"
+  run_test "#{$bin}gt dev kmer_database -kmersize 5 -merge_only " \
+    "-load db Atinsert.fna", :retval => 1
+  grep last_stderr, "uses kmersize 4, but kmersize 5 was requested"
+  run "head -c 200 Atinsert.fna > garbage.kdb"
+  run_test "#{$bin}gt dev kmer_database -kmersize 4 -merge_only " \
+    "-load garbage Atinsert.fna", :retval => 1
+  grep last_stderr, "is not a kmer database"
+  run "#{$bin}gt encseq encode -protein -indexname prot " \
+    "#{$testdata}trembl.faa"
+  run_test "#{$bin}gt dev kmer_database -kmersize 4 -merge_only " \
+    "-load db prot", :retval => 1
+  grep last_stderr, "uses alphabet size 4, but the alphabet"
+  run "#{$bin}gt seqfilter -maxseqnum 10 Atinsert.fna > prefix.fna"
+  run_test "#{$bin}gt encseq encode prefix.fna"
+  run_test "#{$bin}gt dev kmer_database -kmersize 4 -merge_only " \
+    "-save prefix prefix.fna"
+  FileUtils.copy("#{$testdata}Random.fna", ".")
+  run_test "#{$bin}gt encseq encode Random.fna"
+  run_test "#{$bin}gt dev kmer_database -kmersize 4 -merge_only " \
+    "-load prefix Random.fna", :retval => 1
+  grep last_stderr, "fingerprint of the first [0-9]+ characters differs"
+end
+
 if $gttestdata
   Name "gt kmer_database large files"
   Keywords "gt_kmer_database large"
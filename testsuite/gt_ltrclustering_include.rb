@@ -0,0 +1,22 @@
+Name "gt ltrclustering"
+Keywords "gt_ltrclustering"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname idx " + \
+           "#{$testdata}gt_ltrclustering.fna"
+  run_test "#{$bin}gt ltrclustering -psmall 80 -plarge 20 idx " + \
+           "#{$testdata}gt_ltrclustering.gff3"
+  run "diff #{last_stdout} #{$testdata}gt_ltrclustering.out"
+end
+
+Name "gt ltrclustering -j 1 vs. -j 4"
+Keywords "gt_ltrclustering threads"
+Test do
+  run_test "#{$bin}gt encseq encode -indexname idx " + \
+           "#{$testdata}gt_ltrclustering.fna"
+  [1, 4].each do |jobs|
+    run_test "#{$bin}gt -j #{jobs} ltrclustering -psmall 80 -plarge 20 " + \
+             "-wordsize 10 -identity 85 idx " + \
+             "#{$testdata}gt_ltrclustering.gff3 > out_j#{jobs}.gff3"
+  end
+  run "diff out_j1.gff3 out_j4.gff3"
+end
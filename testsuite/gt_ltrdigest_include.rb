@@ -685,3 +685,23 @@ if $gttestdata then
     end
   end
 end
+
+# the stub HMMER executables in testdata/hmmer_stub report fixed hits which
+# only depend on the translations, so the protein domain search can be tested
+# without HMMER
+Name "gt ltrdigest -pdombatch (stub hmmscan)"
+Keywords "gt_ltrdigest pdombatch"
+Test do
+  stubenv = "env PATH=#{$testdata}hmmer_stub:$PATH TMPDIR=."
+  run_test "#{$bin}gt encseq encode -lossless -indexname idx " + \
+           "#{$testdata}gt_ltrclustering.fna"
+  [[1, 1], [7, 1], [3, 2]].each do |batch, jobs|
+    run_test "#{stubenv} #{$bin}gt -j #{jobs} ltrdigest -encseq idx " + \
+             "-pdombatch #{batch} -hmms #{$testdata}hmmer_stub/stub.hmm -- " + \
+             "#{$testdata}gt_ltrdigest_pdombatch.gff3 > out_#{batch}.gff3"
+  end
+  grep "out_1.gff3", /protein_match.*name=STUB_A/
+  grep "out_1.gff3", /protein_match.*name=STUB_B/
+  run "diff out_1.gff3 out_7.gff3"
+  run "diff out_1.gff3 out_3.gff3"
+end
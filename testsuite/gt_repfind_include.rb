@@ -81,6 +81,23 @@ Test do
   end
 end
 
+Name "gt repfind extendgreedy character access modes"
+Keywords "gt_repfind extend"
+Test do
+  run "#{$scriptsdir}gen-randseq.rb --seedlength 200 --length 2200 --mirrored"
+  run_test "#{$bin}gt suffixerator -suftabuint -db #{last_stdout} " +
+           "-dna -suf -tis -lcp -md5 no -des no -sds no -indexname sfx"
+  ["","encseq","encseq_reader"].each do |cam|
+    camopt = if cam == "" then "" else "-cam #{cam}" end
+    run_test "#{$bin}gt repfind -minidentity 90 -percmathistory 55 " +
+             "-scan -seedlength 200 -extendgreedy -ii sfx " +
+             "-maxalilendiff 30 #{camopt}"
+    run "mv #{last_stdout} greedy-cam#{cam}.txt"
+  end
+  run "diff greedy-cam.txt greedy-camencseq.txt"
+  run "diff greedy-cam.txt greedy-camencseq_reader.txt"
+end
+
 Name "gt repfind small"
 Keywords "gt_repfind"
 Test do
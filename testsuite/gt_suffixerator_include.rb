@@ -187,7 +187,7 @@ Name "gt suffixerator all accesstypes"
 Keywords "gt_suffixerator tis"
 Test do
   all_fastafiles.each do |filename|
-    ["direct", "bit", "uchar", "ushort", "uint32"].each do |sat|
+    ["direct", "bit", "uchar", "ushort", "uint32", "ef"].each do |sat|
       run_test "#{$bin}gt suffixerator -tis -indexname sfx -sat #{sat} " +
                "-db #{$testdata}#{filename}"
     end
@@ -241,6 +241,31 @@ alldir.each do |dir|
   end
 end
 
+Name "gt suffixerator -tablealloc"
+Keywords "gt_suffixerator tablealloc"
+Test do
+  run_test "#{$bin}gt suffixerator -tis -suf -lcp -bck -pl 9 " +
+           "-indexname sfx -db #{$testdata}at1MB"
+  ["hugepage", "interleave", "firsttouch",
+   "hugepage interleave firsttouch"].each do |policy|
+    run_test "#{$bin}gt -j 2 suffixerator -v -tis -suf -lcp -bck -pl 9 " +
+             "-tablealloc #{policy} -indexname sfx2 -db #{$testdata}at1MB"
+    grep last_stdout, /# tablealloc=#{policy.gsub(' ', ',')}$/
+    grep last_stdout, /large tables with/
+    ["suf", "bck"].each do |suffix|
+      run "cmp sfx.#{suffix} sfx2.#{suffix}"
+    end
+  end
+  run_test "env GT_ENV_OPTIONS='-tablealloc firsttouch' " +
+           "#{$bin}gt suffixerator -v -tis -suf -lcp -bck -pl 9 " +
+           "-indexname sfx2 -db #{$testdata}at1MB"
+  grep last_stdout, /# tablealloc=firsttouch$/
+  run "cmp sfx.lcp sfx2.lcp"
+  run_test "#{$bin}gt suffixerator -tis -suf -tablealloc huge " +
+           "-indexname sfx2 -db #{$testdata}at1MB", :retval => 1
+  grep last_stderr, /unknown allocation policy "huge"/
+end
+
 faillist = ["-indexname sfx -db /nothing",
             "-indexname /nothing/sfx -db #{$testdata}TTT-small.fna",
             "-smap /nothing -db #{$testdata}TTT-small.fna",
@@ -392,7 +417,8 @@ if $gttestdata then
               "TransProt11")
 end
 
-SATS = ["direct", "bytecompress", "eqlen", "bit", "uchar", "ushort", "uint32"]
+SATS = ["direct", "bytecompress", "eqlen", "bit", "uchar", "ushort", "uint32",
+        "ef"]
 
 EQLENDNAFILE = {:filename => "#{$testdata}test1.fasta",
                 :desc => "equal length DNA",
@@ -411,7 +437,8 @@ EQLENAAFILE = {:filename => "#{$testdata}trembl-eqlen.faa",
                   "bit" => "as the sequence is not DNA",
                   "uchar" => "as the sequence is not DNA",
                   "ushort" => "as the sequence is not DNA",
-                  "uint32" => "as the sequence is not DNA"}}
+                  "uint32" => "as the sequence is not DNA",
+                  "ef" => "as the sequence is not DNA"}}
 AAFILE    = {:filename => "#{$testdata}trembl.faa",
                 :desc => "non-equal length AA",
                 :msgs => {
@@ -419,7 +446,8 @@ AAFILE    = {:filename => "#{$testdata}trembl.faa",
                   "bit" => "as the sequence is not DNA",
                   "uchar" => "as the sequence is not DNA",
                   "ushort" => "as the sequence is not DNA",
-                  "uint32" => "as the sequence is not DNA"}}
+                  "uint32" => "as the sequence is not DNA",
+                  "ef" => "as the sequence is not DNA"}}
 
 excludefiles = ["RandomN.fna","Small.fna","Verysmall.fna"]
 
@@ -0,0 +1,50 @@
+# the gth executable is not built in this tree, the following tests are only
+# run if its path is given with -gth
+if $arguments["gth"] then
+  gth = $arguments["gth"]
+  [["", "text"], ["-gff3out", "GFF3"]].each do |outopt, desc|
+    ["", "-first 1", "-first 3"].each do |first|
+      Name "gth -j 1 vs. -j 4 (#{desc} #{first})"
+      Keywords "gth threads"
+      Test do
+        [1, 4].each do |jobs|
+          run_test "#{gth} -j #{jobs} #{outopt} #{first} " + \
+                   "-genomic #{$testdata}U89959_genomic.fas " + \
+                   "-cdna #{$testdata}U89959_ests.fas"
+          # remove the command line and the time of the run
+          run "grep -v -e '^\\$' -e 'Date run' -e 'Time run' " + \
+              "-e 'Time used' #{last_stdout} > out_j#{jobs}"
+        end
+        run "diff out_j1 out_j4"
+      end
+    end
+  end
+end
+
+# gthsplit does not need the sequences, it is available as a development tool
+Name "gt dev gthsplit XML -> binary -> XML"
+Keywords "gth gthsplit bininter"
+Test do
+  run "cp #{$testdata}U89959_genomic.fas #{$testdata}U89959_ests.fas ."
+  run "cp #{$testdata}gth_intermediate.xml inter.xml"
+  run_test "#{$bin}gt dev gthsplit -alignmentscore -range 100 -bininter " + \
+           "inter.xml"
+  run "mv inter.xml.scr0-100 inter.bin"
+  run_test "#{$bin}gt dev gthsplit -alignmentscore -range 100 inter.bin"
+  run "diff inter.bin.scr0-100 #{$testdata}gth_intermediate.xml"
+end
+
+Name "gt dev gthsplit binary input"
+Keywords "gth gthsplit bininter"
+Test do
+  run "cp #{$testdata}U89959_genomic.fas #{$testdata}U89959_ests.fas ."
+  run "cp #{$testdata}gth_intermediate.xml inter.xml"
+  run_test "#{$bin}gt dev gthsplit -alignmentscore -range 50 inter.xml"
+  run "mv inter.xml.scr0-50 xml.scr0-50"
+  run "mv inter.xml.scr50-100 xml.scr50-100"
+  run_test "#{$bin}gt dev gthsplit -alignmentscore -range 100 -bininter inter.xml"
+  run "mv inter.xml.scr0-100 inter.bin"
+  run_test "#{$bin}gt dev gthsplit -alignmentscore -range 50 inter.bin"
+  run "diff inter.bin.scr0-50 xml.scr0-50"
+  run "diff inter.bin.scr50-100 xml.scr50-100"
+end
@@ -184,6 +184,7 @@ require 'gt_interfeat_include'
 require 'gt_kmer_database_include'
 require 'gt_linspace_align_include'
 require 'gt_loccheck_include'
+require 'gt_ltrclustering_include'
 require 'gt_ltrdigest_include'
 require 'gt_ltrharvest_include'
 require 'gt_magicmatch_include'
@@ -225,6 +226,7 @@ require 'gt_splitfasta_include'
 require 'gt_stat_include'
 require 'gt_tirvish_include'
 require 'gt_uniq_include'
+require 'gth_include'
 if not $arguments["nocairo"] then
   require 'gt_sketch_include'
 end